@@ -0,0 +1,810 @@
+// © 2025 NVIDIA Corporation
+
+// CPU overhead microbenchmarks on the NONE backend: the backend does no work, so timings represent the cost of the
+// function-table call path and the shared code, i.e. NRI's own per-call overhead. "validation/*" benchmarks measure
+// the validation layer on top of it. Results are emitted as JSON. Functional checks of the NONE backend, which the
+// benchmarks rely on, run first and fail the run if broken
+// Usage: NRI_Benchmarks [--out <file.json>] [--filter <substring>] [--min-time-ms <ms>] [--sample-num <num>]
+
+#include <cstddef>
+#include <cstdint>
+
+#include "NRI.h"
+
+#include "Extensions/NRIDeviceCreation.h"
+#include "Extensions/NRIHelper.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace nri;
+
+constexpr uint32_t DRAW_NUM = 64;            // per recorded command buffer
+constexpr uint32_t DRAWS_PER_PIPELINE = 8;   // pipeline switch frequency in the draw loop
+constexpr uint32_t DESCRIPTOR_NUM = 4;       // per updated descriptor range
+constexpr uint32_t DESCRIPTOR_SET_MAX_NUM = 1024;
+constexpr uint32_t VALIDATION_SAMPLE_RATE = 16; // "validationSampleRate" of the sampled async validation context
+constexpr uint32_t CHECK_PRODUCER_NUM = 4;      // threads submitting concurrently
+constexpr uint32_t CHECK_SUBMIT_NUM = 4096;     // per producer
+
+// A device per configuration, created only if a selected benchmark needs it
+enum class ContextType : uint8_t {
+    NO_VALIDATION,
+    VALIDATION_ALL,            // all categories
+    VALIDATION_NO_CATEGORIES,  // all categories disabled, i.e. the wrapper and its state tracking
+    VALIDATION_ASYNC,          // all categories, command buffers are logged and validated on a background thread
+    VALIDATION_ASYNC_SAMPLED,  // same, but only every "VALIDATION_SAMPLE_RATE"th command buffer is logged
+
+    MAX_NUM
+};
+
+struct Context {
+    CoreInterface NRI;
+    Device* device;
+    Queue* queue;
+    CommandAllocator* commandAllocator;
+    CommandBuffer* commandBuffer;
+    Fence* fence;
+    Buffer* buffer;
+    Texture* texture;
+    Descriptor* descriptors[DESCRIPTOR_NUM];
+    Descriptor* colorAttachment;
+    DescriptorPool* descriptorPool;
+    PipelineLayout* pipelineLayout;
+    Pipeline* pipelines[2];
+    DescriptorSet* descriptorSet;
+    uint64_t fenceValue;
+    uint32_t allocatedDescriptorSetNum;
+};
+
+struct Benchmark {
+    const char* name;
+    void (*Run)(Context& context, uint32_t iterationNum); // times "iterationNum" operations
+    uint32_t itemNum;                                     // work items per operation (e.g. draws per command buffer)
+    ContextType contextType;
+};
+
+struct BenchmarkResult {
+    const char* name;
+    uint32_t itemNum;
+    uint32_t iterationNum;
+    uint32_t sampleNum;
+    double minNs;
+    double medianNs;
+    double meanNs;
+    double maxNs;
+};
+
+//============================================================================================================================================================================================
+#pragma region[  Benchmarks  ]
+
+// Baseline: an indirect call of a trivial function, i.e. the cost of the harness itself
+static void NRI_CALL EmptyFunction(Context&) {
+}
+
+static void Baseline(Context& context, uint32_t iterationNum) {
+    void(NRI_CALL * volatile function)(Context&) = EmptyFunction;
+
+    for (uint32_t i = 0; i < iterationNum; i++)
+        function(context);
+}
+
+static void GetDeviceDesc(Context& context, uint32_t iterationNum) {
+    for (uint32_t i = 0; i < iterationNum; i++)
+        context.NRI.GetDeviceDesc(*context.device);
+}
+
+static void GetInterface(Context& context, uint32_t iterationNum) {
+    CoreInterface coreInterface = {};
+
+    for (uint32_t i = 0; i < iterationNum; i++)
+        nriGetInterface(*context.device, NRI_INTERFACE(nri::CoreInterface), &coreInterface);
+}
+
+// Cycles through all formats, i.e. the steady state of the per-device format support cache (on NONE, over a simulated query)
+static void GetFormatSupport(Context& context, uint32_t iterationNum) {
+    uint32_t format = 0;
+
+    for (uint32_t i = 0; i < iterationNum; i++) {
+        context.NRI.GetFormatSupport(*context.device, (Format)format);
+
+        if (++format == (uint32_t)Format::MAX_NUM)
+            format = 0;
+    }
+}
+
+static void CreateDestroyBuffer(Context& context, uint32_t iterationNum) {
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = 65536;
+    bufferDesc.usage = BufferUsageBits::VERTEX_BUFFER | BufferUsageBits::SHADER_RESOURCE;
+
+    for (uint32_t i = 0; i < iterationNum; i++) {
+        Buffer* buffer = nullptr;
+        context.NRI.CreateBuffer(*context.device, bufferDesc, buffer);
+        context.NRI.DestroyBuffer(*buffer);
+    }
+}
+
+static void CreateDestroyTexture(Context& context, uint32_t iterationNum) {
+    TextureDesc textureDesc = {};
+    textureDesc.type = TextureType::TEXTURE_2D;
+    textureDesc.usage = TextureUsageBits::SHADER_RESOURCE;
+    textureDesc.format = Format::RGBA8_UNORM;
+    textureDesc.width = 256;
+    textureDesc.height = 256;
+    textureDesc.mipNum = 1;
+    textureDesc.layerNum = 1;
+
+    for (uint32_t i = 0; i < iterationNum; i++) {
+        Texture* texture = nullptr;
+        context.NRI.CreateTexture(*context.device, textureDesc, texture);
+        context.NRI.DestroyTexture(*texture);
+    }
+}
+
+static void CreateDestroyBufferView(Context& context, uint32_t iterationNum) {
+    BufferViewDesc bufferViewDesc = {};
+    bufferViewDesc.buffer = context.buffer;
+    bufferViewDesc.viewType = BufferViewType::SHADER_RESOURCE;
+    bufferViewDesc.format = Format::R32_UINT;
+
+    for (uint32_t i = 0; i < iterationNum; i++) {
+        Descriptor* descriptor = nullptr;
+        context.NRI.CreateBufferView(bufferViewDesc, descriptor);
+        context.NRI.DestroyDescriptor(*descriptor);
+    }
+}
+
+static void CreateDestroyTextureView(Context& context, uint32_t iterationNum) {
+    Texture2DViewDesc textureViewDesc = {};
+    textureViewDesc.texture = context.texture;
+    textureViewDesc.viewType = Texture2DViewType::SHADER_RESOURCE_2D;
+    textureViewDesc.format = Format::RGBA8_UNORM;
+    textureViewDesc.mipNum = 1;
+    textureViewDesc.layerNum = 1;
+
+    for (uint32_t i = 0; i < iterationNum; i++) {
+        Descriptor* descriptor = nullptr;
+        context.NRI.CreateTexture2DView(textureViewDesc, descriptor);
+        context.NRI.DestroyDescriptor(*descriptor);
+    }
+}
+
+static void CreateDestroySampler(Context& context, uint32_t iterationNum) {
+    SamplerDesc samplerDesc = {};
+    samplerDesc.filters = {Filter::LINEAR, Filter::LINEAR, Filter::LINEAR};
+    samplerDesc.mipMax = 16.0f;
+
+    for (uint32_t i = 0; i < iterationNum; i++) {
+        Descriptor* descriptor = nullptr;
+        context.NRI.CreateSampler(*context.device, samplerDesc, descriptor);
+        context.NRI.DestroyDescriptor(*descriptor);
+    }
+}
+
+// The pool gets reset once it's full, the cost is amortized over "DESCRIPTOR_SET_MAX_NUM" allocations
+static void AllocateUpdateDescriptorSet(Context& context, uint32_t iterationNum) {
+    DescriptorRangeUpdateDesc rangeUpdateDesc = {};
+    rangeUpdateDesc.descriptors = context.descriptors;
+    rangeUpdateDesc.descriptorNum = DESCRIPTOR_NUM;
+
+    for (uint32_t i = 0; i < iterationNum; i++) {
+        if (context.allocatedDescriptorSetNum == DESCRIPTOR_SET_MAX_NUM) {
+            context.NRI.ResetDescriptorPool(*context.descriptorPool);
+            context.allocatedDescriptorSetNum = 0;
+        }
+
+        DescriptorSet* descriptorSet = nullptr;
+        context.NRI.AllocateDescriptorSets(*context.descriptorPool, *context.pipelineLayout, 0, &descriptorSet, 1, 0);
+        context.NRI.UpdateDescriptorRanges(*descriptorSet, 0, 1, &rangeUpdateDesc);
+        context.allocatedDescriptorSetNum++;
+    }
+}
+
+// A typical draw loop: a pipeline switch every few draws, per-draw descriptor set, vertex and index buffers
+static void RecordDrawLoop(Context& context, uint32_t iterationNum) {
+    const CoreInterface& NRI = context.NRI;
+    CommandBuffer& commandBuffer = *context.commandBuffer;
+
+    AttachmentsDesc attachmentsDesc = {};
+    attachmentsDesc.colors = &context.colorAttachment;
+    attachmentsDesc.colorNum = 1;
+
+    Viewport viewport = {0.0f, 0.0f, 1920.0f, 1080.0f, 0.0f, 1.0f};
+    Rect scissor = {0, 0, 1920, 1080};
+    uint64_t vertexBufferOffset = 0;
+
+    for (uint32_t i = 0; i < iterationNum; i++) {
+        NRI.BeginCommandBuffer(commandBuffer, context.descriptorPool);
+        {
+            NRI.CmdSetPipelineLayout(commandBuffer, *context.pipelineLayout);
+
+            NRI.CmdBeginRendering(commandBuffer, attachmentsDesc);
+            {
+                NRI.CmdSetViewports(commandBuffer, &viewport, 1);
+                NRI.CmdSetScissors(commandBuffer, &scissor, 1);
+
+                for (uint32_t j = 0; j < DRAW_NUM; j++) {
+                    if (j % DRAWS_PER_PIPELINE == 0)
+                        NRI.CmdSetPipeline(commandBuffer, *context.pipelines[(j / DRAWS_PER_PIPELINE) % 2]);
+
+                    NRI.CmdSetDescriptorSet(commandBuffer, 0, *context.descriptorSet, nullptr);
+                    NRI.CmdSetVertexBuffers(commandBuffer, 0, 1, &context.buffer, &vertexBufferOffset);
+                    NRI.CmdSetIndexBuffer(commandBuffer, *context.buffer, 0, IndexType::UINT16);
+                    NRI.CmdDrawIndexed(commandBuffer, {36, 1, 0, 0, 0});
+                }
+            }
+            NRI.CmdEndRendering(commandBuffer);
+        }
+        NRI.EndCommandBuffer(commandBuffer);
+    }
+}
+
+static void QueueSubmit(Context& context, uint32_t iterationNum) {
+    FenceSubmitDesc signalFence = {};
+    signalFence.fence = context.fence;
+
+    QueueSubmitDesc queueSubmitDesc = {};
+    queueSubmitDesc.commandBuffers = &context.commandBuffer;
+    queueSubmitDesc.commandBufferNum = 1;
+    queueSubmitDesc.signalFences = &signalFence;
+    queueSubmitDesc.signalFenceNum = 1;
+
+    for (uint32_t i = 0; i < iterationNum; i++) {
+        signalFence.value = ++context.fenceValue;
+        context.NRI.QueueSubmit(*context.queue, queueSubmitDesc);
+    }
+}
+
+static void GetFenceValue(Context& context, uint32_t iterationNum) {
+    for (uint32_t i = 0; i < iterationNum; i++)
+        context.NRI.GetFenceValue(*context.fence);
+}
+
+static void WaitSignaledFence(Context& context, uint32_t iterationNum) {
+    for (uint32_t i = 0; i < iterationNum; i++)
+        context.NRI.Wait(*context.fence, 0);
+}
+
+static const Benchmark g_Benchmarks[] = {
+    {"harness/Baseline", Baseline, 1},
+    {"callPath/GetDeviceDesc", GetDeviceDesc, 1},
+    {"callPath/nriGetInterface", GetInterface, 1},
+    {"callPath/GetFormatSupport", GetFormatSupport, 1},
+    {"resource/CreateDestroyBuffer", CreateDestroyBuffer, 1},
+    {"resource/CreateDestroyTexture", CreateDestroyTexture, 1},
+    {"descriptor/CreateDestroyBufferView", CreateDestroyBufferView, 1},
+    {"descriptor/CreateDestroyTextureView", CreateDestroyTextureView, 1},
+    {"descriptor/CreateDestroySampler", CreateDestroySampler, 1},
+    {"descriptorSet/AllocateUpdate", AllocateUpdateDescriptorSet, 1},
+    {"commandBuffer/RecordDrawLoop", RecordDrawLoop, DRAW_NUM},
+    {"queue/QueueSubmit", QueueSubmit, 1},
+    {"fence/GetFenceValue", GetFenceValue, 1},
+    {"fence/WaitSignaled", WaitSignaledFence, 1},
+    {"validation/CreateDestroyBuffer/All", CreateDestroyBuffer, 1, ContextType::VALIDATION_ALL},
+    {"validation/CreateDestroyBuffer/NoCategories", CreateDestroyBuffer, 1, ContextType::VALIDATION_NO_CATEGORIES},
+    {"validation/RecordDrawLoop/All", RecordDrawLoop, DRAW_NUM, ContextType::VALIDATION_ALL},
+    {"validation/RecordDrawLoop/NoCategories", RecordDrawLoop, DRAW_NUM, ContextType::VALIDATION_NO_CATEGORIES},
+    {"validation/RecordDrawLoop/Async", RecordDrawLoop, DRAW_NUM, ContextType::VALIDATION_ASYNC},
+    {"validation/RecordDrawLoop/AsyncSampled", RecordDrawLoop, DRAW_NUM, ContextType::VALIDATION_ASYNC_SAMPLED},
+    {"validation/QueueSubmit/All", QueueSubmit, 1, ContextType::VALIDATION_ALL},
+};
+
+#pragma endregion
+
+//============================================================================================================================================================================================
+#pragma region[  Checks  ]
+
+#define CHECK(condition) \
+    if (!(condition)) { \
+        fprintf(stderr, "NRI: check '%s' failed: %s (line %u)\n", __FUNCTION__, #condition, __LINE__); \
+        return false; \
+    }
+
+// Concurrent producers push into the submission thread, each signaling its own fence with increasing values. The thread
+// must process submits in the push order, i.e. a fence value never goes backwards and ends at the last signaled value
+static bool CheckSubmissionThreadOrder() {
+    QueueFamilyDesc queueFamilyDesc = {};
+    queueFamilyDesc.queueNum = 1;
+    queueFamilyDesc.queueType = QueueType::GRAPHICS;
+    queueFamilyDesc.enableSubmissionThread = true;
+
+    DeviceCreationDesc deviceCreationDesc = {};
+    deviceCreationDesc.graphicsAPI = GraphicsAPI::NONE;
+    deviceCreationDesc.queueFamilies = &queueFamilyDesc;
+    deviceCreationDesc.queueFamilyNum = 1;
+
+    Device* device = nullptr;
+    CHECK(nriCreateDevice(deviceCreationDesc, device) == Result::SUCCESS);
+
+    CoreInterface NRI = {};
+    CHECK(nriGetInterface(*device, NRI_INTERFACE(nri::CoreInterface), &NRI) == Result::SUCCESS);
+
+    HelperInterface helperInterface = {};
+    CHECK(nriGetInterface(*device, NRI_INTERFACE(nri::HelperInterface), &helperInterface) == Result::SUCCESS);
+
+    Queue* queue = nullptr;
+    NRI.GetQueue(*device, QueueType::GRAPHICS, 0, queue);
+
+    Fence* fences[CHECK_PRODUCER_NUM] = {};
+    for (Fence*& fence : fences)
+        NRI.CreateFence(*device, 0, fence);
+
+    bool isOrdered[CHECK_PRODUCER_NUM] = {};
+    std::vector<std::thread> producers;
+    for (uint32_t i = 0; i < CHECK_PRODUCER_NUM; i++) {
+        producers.emplace_back([&, i]() {
+            uint64_t prevValue = 0;
+            bool isOk = true;
+
+            for (uint64_t value = 1; value <= CHECK_SUBMIT_NUM; value++) {
+                FenceSubmitDesc fenceSubmitDesc = {fences[i], value};
+
+                QueueSubmitDesc queueSubmitDesc = {};
+                queueSubmitDesc.signalFences = &fenceSubmitDesc;
+                queueSubmitDesc.signalFenceNum = 1;
+
+                NRI.QueueSubmit(*queue, queueSubmitDesc);
+
+                uint64_t currValue = NRI.GetFenceValue(*fences[i]);
+                isOk = isOk && currValue >= prevValue;
+                prevValue = currValue;
+            }
+
+            isOrdered[i] = isOk;
+        });
+    }
+
+    for (std::thread& producer : producers)
+        producer.join();
+
+    helperInterface.WaitForIdle(*queue);
+
+    bool isOk = true;
+    for (uint32_t i = 0; i < CHECK_PRODUCER_NUM; i++)
+        isOk = isOk && isOrdered[i] && NRI.GetFenceValue(*fences[i]) == CHECK_SUBMIT_NUM;
+
+    for (Fence* fence : fences)
+        NRI.DestroyFence(*fence);
+
+    nriDestroyDevice(*device);
+
+    CHECK(isOk);
+
+    return true;
+}
+
+// Each "FenceWaitPolicy": a reached value completes right away, a value signaled later by another thread is reached
+// while polling or in the "block" phase, depending on the policy and "spinTimeUs"
+static bool CheckFenceWaitPolicies() {
+    DeviceCreationDesc deviceCreationDesc = {};
+    deviceCreationDesc.graphicsAPI = GraphicsAPI::NONE;
+
+    Device* device = nullptr;
+    CHECK(nriCreateDevice(deviceCreationDesc, device) == Result::SUCCESS);
+
+    CoreInterface NRI = {};
+    CHECK(nriGetInterface(*device, NRI_INTERFACE(nri::CoreInterface), &NRI) == Result::SUCCESS);
+
+    Queue* queue = nullptr;
+    NRI.GetQueue(*device, QueueType::GRAPHICS, 0, queue);
+
+    Fence* fence = nullptr;
+    NRI.CreateFence(*device, 0, fence);
+
+    uint64_t value = 0;
+    FenceWaitStats before = {};
+    FenceWaitStats after = {};
+
+    auto wait = [&](FenceWaitPolicy policy, uint32_t spinTimeUs, uint32_t signalDelayMs) {
+        std::thread signaler;
+        if (signalDelayMs) {
+            value++;
+
+            signaler = std::thread([&, signalDelayMs]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(signalDelayMs));
+
+                FenceSubmitDesc fenceSubmitDesc = {fence, value};
+
+                QueueSubmitDesc queueSubmitDesc = {};
+                queueSubmitDesc.signalFences = &fenceSubmitDesc;
+                queueSubmitDesc.signalFenceNum = 1;
+
+                NRI.QueueSubmit(*queue, queueSubmitDesc);
+            });
+        }
+
+        NRI.GetFenceWaitStats(*device, before);
+        NRI.WaitWithPolicy(*fence, value, {policy, spinTimeUs});
+        NRI.GetFenceWaitStats(*device, after);
+
+        if (signaler.joinable())
+            signaler.join();
+
+        return NRI.GetFenceValue(*fence) >= value && after.waitNum == before.waitNum + 1;
+    };
+
+    bool isOk = wait(FenceWaitPolicy::BLOCK, 0, 0) && after.completedNum == before.completedNum + 1;
+    isOk = isOk && wait(FenceWaitPolicy::BLOCK, 1000000, 10) && after.blockNum == before.blockNum + 1 && after.spinNum == before.spinNum;
+    isOk = isOk && wait(FenceWaitPolicy::SPIN_THEN_BLOCK, 2000000, 10) && after.spinNum == before.spinNum + 1;
+    isOk = isOk && wait(FenceWaitPolicy::HYBRID, 2000000, 10) && after.spinNum == before.spinNum + 1;
+    isOk = isOk && wait(FenceWaitPolicy::SPIN_THEN_BLOCK, 100, 20) && after.blockNum == before.blockNum + 1;
+    isOk = isOk && wait(FenceWaitPolicy::HYBRID, 100, 20) && after.blockNum == before.blockNum + 1;
+
+    NRI.DestroyFence(*fence);
+    nriDestroyDevice(*device);
+
+    CHECK(isOk);
+
+    return true;
+}
+
+// "GetCommandBufferStats" matches what was recorded, including "WHOLE_SIZE" copies, and restarts on "BeginCommandBuffer"
+static bool CheckCommandBufferStats(bool enableValidation) {
+    DeviceCreationDesc deviceCreationDesc = {};
+    deviceCreationDesc.graphicsAPI = GraphicsAPI::NONE;
+    deviceCreationDesc.enableNRIValidation = enableValidation;
+
+    Device* device = nullptr;
+    CHECK(nriCreateDevice(deviceCreationDesc, device) == Result::SUCCESS);
+
+    CoreInterface NRI = {};
+    CHECK(nriGetInterface(*device, NRI_INTERFACE(nri::CoreInterface), &NRI) == Result::SUCCESS);
+
+    HelperInterface helperInterface = {};
+    CHECK(nriGetInterface(*device, NRI_INTERFACE(nri::HelperInterface), &helperInterface) == Result::SUCCESS);
+
+    Queue* queue = nullptr;
+    NRI.GetQueue(*device, QueueType::GRAPHICS, 0, queue);
+
+    CommandAllocator* commandAllocator = nullptr;
+    NRI.CreateCommandAllocator(*queue, commandAllocator);
+
+    CommandBuffer* commandBuffer = nullptr;
+    NRI.CreateCommandBuffer(*commandAllocator, commandBuffer);
+
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = 1024;
+
+    Buffer* buffers[2] = {};
+    for (Buffer*& buffer : buffers)
+        NRI.CreateBuffer(*device, bufferDesc, buffer);
+
+    GlobalBarrierDesc globalBarrierDesc = {};
+    BufferBarrierDesc bufferBarrierDescs[2] = {};
+    bufferBarrierDescs[0].buffer = buffers[0];
+    bufferBarrierDescs[0].after = {AccessBits::COPY_DESTINATION, StageBits::COPY};
+    bufferBarrierDescs[1].buffer = buffers[1];
+    bufferBarrierDescs[1].after = {AccessBits::COPY_SOURCE, StageBits::COPY};
+
+    BarrierGroupDesc barrierGroupDesc = {};
+    barrierGroupDesc.globals = &globalBarrierDesc;
+    barrierGroupDesc.globalNum = 1;
+    barrierGroupDesc.buffers = bufferBarrierDescs;
+    barrierGroupDesc.bufferNum = 2;
+
+    NRI.BeginCommandBuffer(*commandBuffer, nullptr);
+    {
+        NRI.CmdBarrier(*commandBuffer, barrierGroupDesc);
+        NRI.CmdCopyBuffer(*commandBuffer, *buffers[0], 0, *buffers[1], 256, WHOLE_SIZE);
+        NRI.CmdCopyBuffer(*commandBuffer, *buffers[0], 0, *buffers[1], 0, 100);
+    }
+    NRI.EndCommandBuffer(*commandBuffer);
+
+    CommandBufferStats stats = {};
+    helperInterface.GetCommandBufferStats(*commandBuffer, stats);
+
+    bool isOk = stats.barrierGroupNum == 1 && stats.barrierNum == 3 && stats.copyNum == 2 && stats.copyBytes == 768 + 100;
+    isOk = isOk && stats.drawNum == 0 && stats.dispatchNum == 0 && stats.renderPassNum == 0;
+
+    NRI.BeginCommandBuffer(*commandBuffer, nullptr);
+    NRI.EndCommandBuffer(*commandBuffer);
+
+    helperInterface.GetCommandBufferStats(*commandBuffer, stats);
+    isOk = isOk && stats.barrierGroupNum == 0 && stats.copyNum == 0 && stats.copyBytes == 0;
+
+    for (Buffer* buffer : buffers)
+        NRI.DestroyBuffer(*buffer);
+
+    NRI.DestroyCommandBuffer(*commandBuffer);
+    NRI.DestroyCommandAllocator(*commandAllocator);
+    nriDestroyDevice(*device);
+
+    CHECK(isOk);
+
+    return true;
+}
+
+static bool RunChecks() {
+    bool isOk = CheckSubmissionThreadOrder();
+    isOk = CheckFenceWaitPolicies() && isOk;
+    isOk = CheckCommandBufferStats(false) && isOk;
+    isOk = CheckCommandBufferStats(true) && isOk;
+
+    return isOk;
+}
+
+#undef CHECK
+
+#pragma endregion
+
+//============================================================================================================================================================================================
+#pragma region[  Harness  ]
+
+static double MeasureNs(const Benchmark& benchmark, Context& context, uint32_t iterationNum) {
+    auto begin = std::chrono::steady_clock::now();
+    benchmark.Run(context, iterationNum);
+    auto end = std::chrono::steady_clock::now();
+
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+}
+
+// Doubles the iteration number until a sample takes at least "sampleMinNs", then collects "sampleNum" samples
+static BenchmarkResult RunBenchmark(const Benchmark& benchmark, Context& context, double sampleMinNs, uint32_t sampleNum) {
+    uint32_t iterationNum = 1;
+    while (MeasureNs(benchmark, context, iterationNum) < sampleMinNs && iterationNum < (1u << 30))
+        iterationNum *= 2;
+
+    std::vector<double> nsPerOp(sampleNum);
+    for (double& ns : nsPerOp)
+        ns = MeasureNs(benchmark, context, iterationNum) / iterationNum;
+
+    std::sort(nsPerOp.begin(), nsPerOp.end());
+
+    double sum = 0.0;
+    for (double ns : nsPerOp)
+        sum += ns;
+
+    BenchmarkResult result = {};
+    result.name = benchmark.name;
+    result.itemNum = benchmark.itemNum;
+    result.iterationNum = iterationNum;
+    result.sampleNum = sampleNum;
+    result.minNs = nsPerOp.front();
+    result.medianNs = nsPerOp[sampleNum / 2];
+    result.meanNs = sum / sampleNum;
+    result.maxNs = nsPerOp.back();
+
+    return result;
+}
+
+static void WriteJson(FILE* file, const std::vector<BenchmarkResult>& results, uint32_t minTimeMs, uint32_t sampleNum) {
+    fprintf(file, "{\n");
+    fprintf(file, "  \"nriVersion\": \"%u.%u\",\n", NRI_VERSION_MAJOR, NRI_VERSION_MINOR);
+    fprintf(file, "  \"graphicsAPI\": \"NONE\",\n");
+    fprintf(file, "  \"minTimeMs\": %u,\n", minTimeMs);
+    fprintf(file, "  \"sampleNum\": %u,\n", sampleNum);
+    fprintf(file, "  \"unit\": \"ns per operation\",\n");
+    fprintf(file, "  \"benchmarks\": [");
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult& result = results[i];
+
+        fprintf(file, "%s\n    {\"name\": \"%s\", \"itemNum\": %u, \"iterationNum\": %u, \"min\": %.3f, \"median\": %.3f, \"mean\": %.3f, \"max\": %.3f}",
+            i ? "," : "", result.name, result.itemNum, result.iterationNum, result.minNs, result.medianNs, result.meanNs, result.maxNs);
+    }
+
+    fprintf(file, "\n  ]\n}\n");
+}
+
+#pragma endregion
+
+//============================================================================================================================================================================================
+#pragma region[  Setup  ]
+
+static bool CreateContext(Context& context, ContextType contextType) {
+    context = {};
+
+    DeviceCreationDesc deviceCreationDesc = {};
+    deviceCreationDesc.graphicsAPI = GraphicsAPI::NONE;
+    deviceCreationDesc.enableNRIValidation = contextType != ContextType::NO_VALIDATION;
+
+    deviceCreationDesc.enableNRIValidationAsync = contextType == ContextType::VALIDATION_ASYNC || contextType == ContextType::VALIDATION_ASYNC_SAMPLED;
+
+    if (contextType == ContextType::VALIDATION_ASYNC_SAMPLED)
+        deviceCreationDesc.validationSampleRate = VALIDATION_SAMPLE_RATE;
+    else if (contextType == ContextType::VALIDATION_NO_CATEGORIES)
+        deviceCreationDesc.disabledValidationCategories = ValidationBits::ALL;
+
+    if (nriCreateDevice(deviceCreationDesc, context.device) != Result::SUCCESS)
+        return false;
+
+    if (nriGetInterface(*context.device, NRI_INTERFACE(nri::CoreInterface), &context.NRI) != Result::SUCCESS)
+        return false;
+
+    const CoreInterface& NRI = context.NRI;
+    Device& device = *context.device;
+
+    NRI.GetQueue(device, QueueType::GRAPHICS, 0, context.queue);
+    NRI.CreateCommandAllocator(*context.queue, context.commandAllocator);
+    NRI.CreateCommandBuffer(*context.commandAllocator, context.commandBuffer);
+    NRI.CreateFence(device, 0, context.fence);
+
+    // Resources and descriptors
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = 65536;
+    bufferDesc.usage = BufferUsageBits::VERTEX_BUFFER | BufferUsageBits::INDEX_BUFFER | BufferUsageBits::SHADER_RESOURCE;
+    NRI.CreateBuffer(device, bufferDesc, context.buffer);
+
+    TextureDesc textureDesc = {};
+    textureDesc.type = TextureType::TEXTURE_2D;
+    textureDesc.usage = TextureUsageBits::SHADER_RESOURCE | TextureUsageBits::COLOR_ATTACHMENT;
+    textureDesc.format = Format::RGBA8_UNORM;
+    textureDesc.width = 1920;
+    textureDesc.height = 1080;
+    textureDesc.mipNum = 1;
+    textureDesc.layerNum = 1;
+    NRI.CreateTexture(device, textureDesc, context.texture);
+
+    Texture2DViewDesc textureViewDesc = {};
+    textureViewDesc.texture = context.texture;
+    textureViewDesc.viewType = Texture2DViewType::SHADER_RESOURCE_2D;
+    textureViewDesc.format = Format::RGBA8_UNORM;
+    textureViewDesc.mipNum = 1;
+    textureViewDesc.layerNum = 1;
+
+    for (Descriptor*& descriptor : context.descriptors)
+        NRI.CreateTexture2DView(textureViewDesc, descriptor);
+
+    textureViewDesc.viewType = Texture2DViewType::COLOR_ATTACHMENT;
+    NRI.CreateTexture2DView(textureViewDesc, context.colorAttachment);
+
+    // Layout, pipelines and descriptor sets
+    DescriptorRangeDesc descriptorRangeDesc = {0, DESCRIPTOR_NUM, DescriptorType::TEXTURE, StageBits::FRAGMENT_SHADER};
+    DescriptorSetDesc descriptorSetDesc = {0, &descriptorRangeDesc, 1};
+
+    PipelineLayoutDesc pipelineLayoutDesc = {};
+    pipelineLayoutDesc.descriptorSets = &descriptorSetDesc;
+    pipelineLayoutDesc.descriptorSetNum = 1;
+    pipelineLayoutDesc.shaderStages = StageBits::VERTEX_SHADER | StageBits::FRAGMENT_SHADER;
+    NRI.CreatePipelineLayout(device, pipelineLayoutDesc, context.pipelineLayout);
+
+    // The bytecode is never compiled on NONE, it's only required to be non-empty
+    static const uint32_t dummyBytecode = 0;
+    ShaderDesc shaderDesc = {StageBits::VERTEX_SHADER, &dummyBytecode, sizeof(dummyBytecode)};
+
+    VertexStreamDesc vertexStreamDesc = {};
+    vertexStreamDesc.stride = 16;
+
+    VertexAttributeDesc vertexAttributeDesc = {};
+    vertexAttributeDesc.format = Format::RGBA32_SFLOAT;
+
+    VertexInputDesc vertexInputDesc = {};
+    vertexInputDesc.attributes = &vertexAttributeDesc;
+    vertexInputDesc.attributeNum = 1;
+    vertexInputDesc.streams = &vertexStreamDesc;
+    vertexInputDesc.streamNum = 1;
+
+    ColorAttachmentDesc colorAttachmentDesc = {};
+    colorAttachmentDesc.format = Format::RGBA8_UNORM;
+    colorAttachmentDesc.colorWriteMask = ColorWriteBits::RGBA;
+
+    GraphicsPipelineDesc graphicsPipelineDesc = {};
+    graphicsPipelineDesc.pipelineLayout = context.pipelineLayout;
+    graphicsPipelineDesc.vertexInput = &vertexInputDesc;
+    graphicsPipelineDesc.shaders = &shaderDesc;
+    graphicsPipelineDesc.shaderNum = 1;
+    graphicsPipelineDesc.outputMerger.colors = &colorAttachmentDesc;
+    graphicsPipelineDesc.outputMerger.colorNum = 1;
+
+    for (Pipeline*& pipeline : context.pipelines)
+        NRI.CreateGraphicsPipeline(device, graphicsPipelineDesc, pipeline);
+
+    DescriptorPoolDesc descriptorPoolDesc = {};
+    descriptorPoolDesc.descriptorSetMaxNum = DESCRIPTOR_SET_MAX_NUM + 1;
+    descriptorPoolDesc.textureMaxNum = (DESCRIPTOR_SET_MAX_NUM + 1) * DESCRIPTOR_NUM;
+    NRI.CreateDescriptorPool(device, descriptorPoolDesc, context.descriptorPool);
+
+    NRI.AllocateDescriptorSets(*context.descriptorPool, *context.pipelineLayout, 0, &context.descriptorSet, 1, 0);
+    context.allocatedDescriptorSetNum = 1;
+
+    return true;
+}
+
+static void DestroyContext(Context& context) {
+    const CoreInterface& NRI = context.NRI;
+
+    // First, since async validation of the last recording can still reference other objects
+    NRI.DestroyCommandBuffer(*context.commandBuffer);
+    NRI.DestroyCommandAllocator(*context.commandAllocator);
+
+    NRI.DestroyDescriptorPool(*context.descriptorPool);
+
+    for (Pipeline* pipeline : context.pipelines)
+        NRI.DestroyPipeline(*pipeline);
+
+    NRI.DestroyPipelineLayout(*context.pipelineLayout);
+    NRI.DestroyDescriptor(*context.colorAttachment);
+
+    for (Descriptor* descriptor : context.descriptors)
+        NRI.DestroyDescriptor(*descriptor);
+
+    NRI.DestroyTexture(*context.texture);
+    NRI.DestroyBuffer(*context.buffer);
+    NRI.DestroyFence(*context.fence);
+
+    nriDestroyDevice(*context.device);
+}
+
+#pragma endregion
+
+int main(int argc, char** argv) {
+    const char* outPath = nullptr;
+    const char* filter = nullptr;
+    uint32_t minTimeMs = 200; // per benchmark
+    uint32_t sampleNum = 15;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (!strcmp(arg, "--out") && value)
+            outPath = value;
+        else if (!strcmp(arg, "--filter") && value)
+            filter = value;
+        else if (!strcmp(arg, "--min-time-ms") && value)
+            minTimeMs = (uint32_t)std::max(atoi(value), 1);
+        else if (!strcmp(arg, "--sample-num") && value)
+            sampleNum = (uint32_t)std::max(atoi(value), 1);
+        else {
+            fprintf(stderr, "Usage: %s [--out <file.json>] [--filter <substring>] [--min-time-ms <ms>] [--sample-num <num>]\n", argv[0]);
+            return 1;
+        }
+
+        i++;
+    }
+
+    if (!RunChecks())
+        return 1;
+
+    Context contexts[(size_t)ContextType::MAX_NUM] = {};
+    bool isContextCreated[(size_t)ContextType::MAX_NUM] = {};
+
+    double sampleMinNs = minTimeMs * 1000000.0 / sampleNum;
+
+    std::vector<BenchmarkResult> results;
+    for (const Benchmark& benchmark : g_Benchmarks) {
+        if (filter && !strstr(benchmark.name, filter))
+            continue;
+
+        size_t contextIndex = (size_t)benchmark.contextType;
+        Context& context = contexts[contextIndex];
+
+        if (!isContextCreated[contextIndex]) {
+            if (!CreateContext(context, benchmark.contextType)) {
+                fprintf(stderr, "NRI: failed to create a NONE device\n");
+                return 1;
+            }
+
+            isContextCreated[contextIndex] = true;
+        }
+
+        results.push_back(RunBenchmark(benchmark, context, sampleMinNs, sampleNum));
+
+        const BenchmarkResult& result = results.back();
+        fprintf(stderr, "%-40s %10.2f ns (median), %u iterations x %u samples\n", result.name, result.medianNs, result.iterationNum, result.sampleNum);
+    }
+
+    for (size_t i = 0; i < (size_t)ContextType::MAX_NUM; i++) {
+        if (isContextCreated[i])
+            DestroyContext(contexts[i]);
+    }
+
+    FILE* file = outPath ? fopen(outPath, "w") : stdout;
+    if (!file) {
+        fprintf(stderr, "NRI: can't open '%s'\n", outPath);
+        return 1;
+    }
+
+    WriteJson(file, results, minTimeMs, sampleNum);
+
+    if (file != stdout)
+        fclose(file);
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+// © 2025 NVIDIA Corporation
+
+#pragma once
+
+NriNamespaceBegin
+
+NriForwardStruct(CommandBufferPool);
+
+NriStruct(CommandBufferPoolDesc) {
+    NriPtr(Queue) queue;
+    uint32_t threadNum; // max number of recording threads, "threadIndex" must be less than this value
+    uint32_t frameInFlightNum;
+};
+
+NriStruct(CommandBufferPoolStats) {
+    uint32_t commandAllocatorNum;
+    uint32_t commandBufferNum; // all command buffers created by the pool
+    uint32_t commandBufferAcquiredNum; // in the current frame
+    uint32_t commandBufferInFlightNum; // in previous frames, which are not completed yet
+};
+
+// Per-thread, per-frame rings of command allocators. Command buffers are handed out in the initial state and recycled
+// when the fence value associated with their frame is reached. No memory allocations after the warm-up
+NriStruct(CommandBufferPoolInterface) {
+    Nri(Result)     (NRI_CALL *CreateCommandBufferPool)         (NriRef(Device) device, const NriRef(CommandBufferPoolDesc) commandBufferPoolDesc, NriOut NriRef(CommandBufferPool*) commandBufferPool);
+    void            (NRI_CALL *DestroyCommandBufferPool)        (NriRef(CommandBufferPool) commandBufferPool);
+
+    // Switch to the next frame in the ring. Waits for the fence value of the frame (if any) and resets all its command allocators
+    void            (NRI_CALL *BeginCommandBufferPoolFrame)     (NriRef(CommandBufferPool) commandBufferPool);
+
+    // Associate the current frame with a fence value, which is expected to be signaled after the submission of the frame's command buffers
+    void            (NRI_CALL *EndCommandBufferPoolFrame)       (NriRef(CommandBufferPool) commandBufferPool, NriRef(Fence) fence, uint64_t value);
+
+    // Thread-safe if each "threadIndex" is used by one thread at a time. The command buffer stays valid until the frame gets recycled
+    Nri(Result)     (NRI_CALL *AcquireCommandBuffer)            (NriRef(CommandBufferPool) commandBufferPool, uint32_t threadIndex, NriOut NriRef(CommandBuffer*) commandBuffer);
+
+    // Not thread-safe with "AcquireCommandBuffer"
+    void            (NRI_CALL *GetCommandBufferPoolStats)       (const NriRef(CommandBufferPool) commandBufferPool, NriOut NriRef(CommandBufferPoolStats) commandBufferPoolStats);
+};
+
+NriNamespaceEnd
@@ -0,0 +1,51 @@
+// © 2025 NVIDIA Corporation
+
+#pragma once
+
+NriNamespaceBegin
+
+NriForwardStruct(DeferredReleaseQueue);
+
+NriEnum(DeferredReleaseType, uint8_t,
+    BUFFER,         // "DestroyBuffer"
+    TEXTURE,        // "DestroyTexture"
+    DESCRIPTOR,     // "DestroyDescriptor"
+    PIPELINE,       // "DestroyPipeline"
+    QUERY_POOL,     // "DestroyQueryPool"
+    MEMORY          // "FreeMemory"
+);
+
+NriStruct(DeferredReleaseCallback) {
+    void (*Callback)(void* userArg);
+    void* userArg;
+};
+
+NriStruct(DeferredReleaseQueueDesc) {
+    uint32_t releaseBudget;             // max number of releases per drain to spread destruction over several frames (0 - unlimited)
+    uint32_t backgroundThreadPeriodMs;  // if "enableBackgroundThread", fences are polled with this period (1 ms if 0)
+    bool enableBackgroundThread;        // drain in an NRI-owned thread, "DrainDeferredReleases" is not needed
+};
+
+NriStruct(DeferredReleaseQueueStats) {
+    uint32_t pendingNum;    // queue depth: releases waiting for their fences or for the release budget
+    uint32_t pendingMaxNum; // peak queue depth
+    uint64_t releasedNum;   // all releases done by the queue
+};
+
+// Objects and callbacks are queued against a "(Fence, value)" pair and released in bulk in order of queueing,
+// when "GetFenceValue" reaches the value. All functions are thread safe
+NriStruct(DeferredReleaseInterface) {
+    Nri(Result)     (NRI_CALL *CreateDeferredReleaseQueue)      (NriRef(Device) device, const NriRef(DeferredReleaseQueueDesc) deferredReleaseQueueDesc, NriOut NriRef(DeferredReleaseQueue*) deferredReleaseQueue);
+    void            (NRI_CALL *DestroyDeferredReleaseQueue)     (NriRef(DeferredReleaseQueue) deferredReleaseQueue); // waits for all fences and releases everything
+
+    // Queue
+    void            (NRI_CALL *DeferRelease)                    (NriRef(DeferredReleaseQueue) deferredReleaseQueue, NriRef(Fence) fence, uint64_t value, Nri(DeferredReleaseType) type, NriPtr(Object) object);
+    void            (NRI_CALL *DeferCallback)                   (NriRef(DeferredReleaseQueue) deferredReleaseQueue, NriRef(Fence) fence, uint64_t value, const NriRef(DeferredReleaseCallback) callback);
+
+    // Releases everything, which is ready, within the release budget. Returns the number of releases
+    uint32_t        (NRI_CALL *DrainDeferredReleases)           (NriRef(DeferredReleaseQueue) deferredReleaseQueue);
+
+    void            (NRI_CALL *GetDeferredReleaseQueueStats)    (const NriRef(DeferredReleaseQueue) deferredReleaseQueue, NriOut NriRef(DeferredReleaseQueueStats) deferredReleaseQueueStats);
+};
+
+NriNamespaceEnd
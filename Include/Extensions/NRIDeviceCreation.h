@@ -43,14 +43,29 @@ NriStruct(QueueFamilyDesc) {
     NriOptional const float* queuePriorities;   // [-1; 1]: low < 0, normal = 0, high > 0 ("queueNum" entries expected)
     uint32_t queueNum;
     Nri(QueueType) queueType;
+    bool enableSubmissionThread;                // "QueueSubmit(Batch)" returns immediately, submits are made by an NRI-owned thread in the same order (ignored on D3D11)
 };
 
+// NRI validation categories, object creation is always validated
+NriBits(ValidationBits, uint8_t,
+    NONE                    = 0,
+    OBJECT_LIFETIME         = NriBit(0),    // object states: recording state, memory binding, mapping
+    BARRIERS                = NriBit(1),    // "CmdBarrier"
+    DESCRIPTORS             = NriBit(2),    // descriptor sets, pools and bindings
+    SUBMISSION              = NriBit(3),    // queue submission, uploads and fences
+    COMMANDS                = NriBit(4),    // other commands: arguments, render pass and pipeline states
+
+    ALL                     = NriMember(ValidationBits, OBJECT_LIFETIME) | NriMember(ValidationBits, BARRIERS) | NriMember(ValidationBits, DESCRIPTORS)
+                            | NriMember(ValidationBits, SUBMISSION) | NriMember(ValidationBits, COMMANDS)
+);
+
 NriStruct(DeviceCreationDesc) {
     Nri(GraphicsAPI) graphicsAPI;
     NriOptional Nri(Robustness) robustness;
     NriOptional const NriPtr(AdapterDesc) adapterDesc;
     NriOptional Nri(CallbackInterface) callbackInterface;
     NriOptional Nri(AllocationCallbacks) allocationCallbacks;
+    NriOptional Nri(FenceWaitDesc) fenceWaitDesc; // default policy for host-side "Wait" (BLOCK)
 
     // 1 GRAPHICS queue is created by default
     NriOptional const NriPtr(QueueFamilyDesc) queueFamilies;
@@ -63,11 +78,20 @@ NriStruct(DeviceCreationDesc) {
     Nri(VKBindingOffsets) vkBindingOffsets;
     NriOptional Nri(VKExtensions) vkExtensions;
 
+    // NRI validation specific (requires "enableNRIValidation"). Disabled categories silence checks, but the wrapper and its state tracking
+    // remain, i.e. CPU overhead doesn't noticeably change. Sampling reduces it only with "enableNRIValidationAsync" (no command log for skipped command buffers)
+    NriOptional Nri(ValidationBits) disabledValidationCategories; // 0 - full validation
+    NriOptional uint32_t validationSampleRate;                    // only every Nth command buffer is validated (0 and 1 = all)
+
     // Switches (disabled by default)
     bool enableNRIValidation;
+    bool enableNRIValidationAsync;              // command buffer checks run on a background thread after "EndCommandBuffer" (errors are reported before "QueueSubmit", "MessageCallback" must be thread-safe)
     bool enableGraphicsAPIValidation;
     bool enableD3D12DrawParametersEmulation;    // not needed for VK, unsupported by D3D11
     bool enableD3D11CommandBufferEmulation;     // enable? but why? (auto-enabled if deferred contexts are not supported)
+    bool enableAllocationTracking;              // per category CPU memory statistics (see "HelperInterface::GetAllocationStats")
+    bool enableDescriptorCache;                 // identical views and samplers are shared (VK only, see "HelperInterface::GetDescriptorCacheStats")
+    bool enableNRIInstrumentation;              // per function call counts and CPU timings (see "InstrumentationInterface"), barrier call sites reported by validation stay the application's
 
     // Switches (enabled by default)
     bool disableVKRayTracing;                   // to save CPU memory in some implementations
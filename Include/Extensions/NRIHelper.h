@@ -9,6 +9,22 @@ NriStruct(VideoMemoryInfo) {
     uint64_t usageSize;     // specifies the application’s current video memory usage
 };
 
+NriEnum(BudgetEvent, uint8_t,
+    HIGH_WATERMARK_CROSSED,     // usage went above "highWatermark * budgetSize"
+    LOW_WATERMARK_CROSSED       // usage went back below "lowWatermark * budgetSize"
+);
+
+// Opt-in budget monitor: NRI-side allocations are tracked incrementally and periodically reconciled with the OS-provided budget.
+// "memoryLocation" in the callback is "DEVICE" for device-local heaps and "HOST_UPLOAD" for the rest. The callback can be invoked
+// from any thread (an allocating one or the monitor thread) and must not allocate/free memory or call "SetBudgetMonitor"
+NriStruct(BudgetMonitorDesc) {
+    void (NRI_CALL *BudgetCallback)(Nri(BudgetEvent) budgetEvent, Nri(MemoryLocation) memoryLocation, const NriRef(VideoMemoryInfo) videoMemoryInfo, void* userArg); // NULL stops monitoring
+    void* userArg;
+    float highWatermark;            // fraction of the budget, 0 = 0.9
+    float lowWatermark;             // fraction of the budget (hysteresis, <= "highWatermark"), 0 = 0.8
+    uint32_t reconcileIntervalMs;   // period of querying the OS, 0 = 100 ms
+};
+
 NriStruct(TextureSubresourceUploadDesc) {
     const void* slices;
     uint32_t sliceNum;
@@ -40,6 +56,72 @@ NriStruct(ResourceGroupDesc) {
     uint64_t preferredMemorySize; // desired chunk size (but can be greater if a resource doesn't fit), 256 Mb if 0
 };
 
+// Frequently created and destroyed objects live in device-owned slab pools
+NriEnum(ObjectPoolType, uint8_t,
+    DESCRIPTOR,
+    COMMAND_BUFFER
+);
+
+NriStruct(ObjectPoolStats) {
+    uint64_t allocationNum; // all allocations served by the pool
+    uint32_t liveNum;       // currently allocated objects
+    uint32_t peakNum;       // peak number of live objects
+    uint32_t capacityNum;   // number of objects, which fit into allocated pages
+    uint32_t pageNum;       // pages allocated via "AllocationCallbacks"
+    uint32_t objectSize;    // in bytes (0 if the pool has not been used yet)
+};
+
+// CPU memory requested via "AllocationCallbacks", tracked if "DeviceCreationDesc::enableAllocationTracking = true"
+NriEnum(AllocationCategory, uint8_t,
+    OTHER,
+    DESCRIPTOR,
+    COMMAND_BUFFER,
+    PIPELINE,
+    VALIDATION,
+    STREAMER
+);
+
+NriStruct(AllocationStats) {
+    uint64_t liveSize;       // currently allocated bytes
+    uint64_t peakSize;       // peak of "liveSize" since the last reset
+    uint64_t allocationSize; // bytes allocated since the last reset
+    uint32_t liveNum;        // currently allocated blocks
+    uint32_t allocationNum;  // allocations since the last reset (expected to be 0 in a steady state frame)
+};
+
+// "GetBufferMemoryDesc2" and "GetTextureMemoryDesc2" results are memoized (VK and D3D12 only)
+NriStruct(MemoryDescCacheStats) {
+    uint64_t hitNum;
+    uint64_t missNum;  // driver queries
+    uint32_t entryNum;
+    uint32_t flushNum; // the cache is bounded and gets flushed on overflow
+};
+
+// "enableDescriptorCache": views and samplers with identical descs are shared and refcounted, i.e. "DestroyDescriptor"
+// must still be called once per creation. A debug name set for a shared descriptor is visible to all its owners
+NriStruct(DescriptorCacheStats) {
+    uint64_t requestedNum; // "Create[View/Sampler]" calls
+    uint64_t createdNum;   // native objects created
+    uint32_t uniqueNum;    // alive unique descriptors in the cache
+};
+
+// Counters accumulated since "BeginCommandBuffer". Always on, i.e. not opt-in: they are plain increments in the recording path
+NriStruct(CommandBufferStats) {
+    uint32_t drawNum;
+    uint32_t drawIndexedNum;
+    uint32_t drawIndirectNum;       // including indexed
+    uint32_t dispatchNum;           // including indirect
+    uint32_t drawMeshTasksNum;      // including indirect
+    uint32_t dispatchRaysNum;       // including indirect
+    uint32_t barrierGroupNum;       // "CmdBarrier" calls
+    uint32_t barrierNum;            // global, buffer and texture barriers
+    uint32_t pipelineBindNum;
+    uint32_t descriptorSetBindNum;
+    uint32_t renderPassNum;         // "CmdBeginRendering" calls
+    uint32_t copyNum;               // buffer and texture copies, uploads and readbacks
+    uint64_t copyBytes;             // buffer to buffer copies only
+};
+
 NriStruct(FormatProps) {
     const char* name;            // format name
     Nri(Format) format;          // self
@@ -78,6 +160,26 @@ NriStruct(HelperInterface) {
 
     // Information about video memory
     Nri(Result) (NRI_CALL *QueryVideoMemoryInfo)        (const NriRef(Device) device, Nri(MemoryLocation) memoryLocation, NriOut NriRef(VideoMemoryInfo) videoMemoryInfo);
+
+    // Budget monitoring ("UNSUPPORTED" if the budget can't be queried), "GetTrackedVideoMemoryInfo" doesn't query the OS and requires an active monitor
+    Nri(Result) (NRI_CALL *SetBudgetMonitor)            (NriRef(Device) device, const NriRef(BudgetMonitorDesc) budgetMonitorDesc);
+    Nri(Result) (NRI_CALL *GetTrackedVideoMemoryInfo)   (const NriRef(Device) device, Nri(MemoryLocation) memoryLocation, NriOut NriRef(VideoMemoryInfo) videoMemoryInfo);
+
+    // Statistics of internal object pools (validation reports pools of the underlying implementation)
+    void        (NRI_CALL *GetObjectPoolStats)          (const NriRef(Device) device, Nri(ObjectPoolType) objectPoolType, NriOut NriRef(ObjectPoolStats) objectPoolStats);
+
+    // Allocation tracking ("UNSUPPORTED" if not enabled), "Reset" is expected to be called once per frame
+    Nri(Result) (NRI_CALL *GetAllocationStats)          (const NriRef(Device) device, Nri(AllocationCategory) allocationCategory, NriOut NriRef(AllocationStats) allocationStats);
+    void        (NRI_CALL *ResetAllocationStats)        (NriRef(Device) device);
+
+    // Statistics of memoized memory requirement queries
+    void        (NRI_CALL *GetMemoryDescCacheStats)     (const NriRef(Device) device, NriOut NriRef(MemoryDescCacheStats) memoryDescCacheStats);
+
+    // Statistics of the descriptor cache (requires "enableDescriptorCache", "UNSUPPORTED" otherwise)
+    Nri(Result) (NRI_CALL *GetDescriptorCacheStats)     (const NriRef(Device) device, NriOut NriRef(DescriptorCacheStats) descriptorCacheStats);
+
+    // Contents of a command buffer (validation reports counters of the underlying implementation)
+    void        (NRI_CALL *GetCommandBufferStats)       (const NriRef(CommandBuffer) commandBuffer, NriOut NriRef(CommandBufferStats) commandBufferStats);
 };
 
 // Format utilities
@@ -0,0 +1,27 @@
+// © 2025 NVIDIA Corporation
+
+#pragma once
+
+NriNamespaceBegin
+
+NriStruct(InstrumentationStats) {
+    const char* interfaceName;  // "CoreInterface"
+    const char* functionName;   // "CmdDraw"
+    uint64_t callNum;
+    uint64_t totalNs;
+    uint64_t medianNs;          // percentiles are approximate (log-linear histogram, ~12% precision)
+    uint64_t p95Ns;
+    uint64_t p99Ns;
+    uint64_t maxNs;
+};
+
+// Per function call counts and CPU timings of function tables returned by "nriGetInterface" (requires "enableNRIInstrumentation").
+// Statistics are process-wide. If devices of different graphics APIs are instrumented, only functions of the first one are timed
+NriStruct(InstrumentationInterface) {
+    // if "stats == NULL", then "statNum" is set to the number of called functions
+    // else "statNum" must be set to number of elements in "stats"
+    void    (NRI_CALL *GetInstrumentationStats)     (const NriRef(Device) device, NriPtr(InstrumentationStats) stats, NonNriRef(uint32_t) statNum);
+    void    (NRI_CALL *ResetInstrumentationStats)   (NriRef(Device) device); // e.g. once per frame
+};
+
+NriNamespaceEnd
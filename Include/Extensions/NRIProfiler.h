@@ -0,0 +1,55 @@
+// © 2025 NVIDIA Corporation
+
+#pragma once
+
+NriNamespaceBegin
+
+NriForwardStruct(Profiler);
+
+NriStruct(ProfilerDesc) {
+    uint32_t frameInFlightNum;  // zones of a frame get resolved "frameInFlightNum" frames later
+    uint32_t zoneMaxNum;        // per frame, extra zones are dropped
+    Nri(QueueType) queueType;   // zones must be recorded in command buffers of this queue type ("COPY" requires "isCopyQueueTimestampSupported")
+    bool captureAnnotations;    // "CmdBeginAnnotation/CmdEndAnnotation" ranges become zones (only one profiler per device)
+};
+
+NriStruct(ProfilerZone) {
+    const char* name;
+    uint64_t beginNs;       // relative to the earliest zone of the frame
+    uint64_t durationNs;
+    uint32_t parentIndex;   // "-1" for top-level zones of a command buffer
+    uint32_t depth;         // "0" for top-level zones of a command buffer
+};
+
+NriStruct(ProfilerFrame) {
+    const NriPtr(ProfilerZone) zones;   // in order of opening, i.e. parents go before children
+    uint32_t zoneNum;
+    uint32_t droppedZoneNum;            // "zoneMaxNum" is exceeded
+    uint64_t frameIndex;                // counted by "BeginProfilerFrame"
+};
+
+// Hierarchical GPU zone timings based on per-frame rings of timestamp queries, resolved into a readback buffer.
+// On NONE timestamps come from a simulated clock (+1 us per timestamp). Zone functions are thread safe and lock-free, but
+// must not overlap with "BeginProfilerFrame". Names get "64 * zoneMaxNum" bytes per frame, overflowing names become empty
+NriStruct(ProfilerInterface) {
+    Nri(Result)     (NRI_CALL *CreateProfiler)              (NriRef(Device) device, const NriRef(ProfilerDesc) profilerDesc, NriOut NriRef(Profiler*) profiler);
+    void            (NRI_CALL *DestroyProfiler)             (NriRef(Profiler) profiler);
+
+    // Switch to the next frame in the ring. Waits for the fence value of the frame (if any) and resolves its zones
+    void            (NRI_CALL *BeginProfilerFrame)          (NriRef(Profiler) profiler);
+
+    // Associate the current frame with a fence value, which is expected to be signaled after the submission of the frame's command buffers
+    void            (NRI_CALL *EndProfilerFrame)            (NriRef(Profiler) profiler, NriRef(Fence) fence, uint64_t value);
+
+    // Zones (timestamps only, no annotations). Nesting is tracked per command buffer, which can have open zones of only one profiler at a time
+    void            (NRI_CALL *CmdBeginProfilerZone)        (NriRef(Profiler) profiler, NriRef(CommandBuffer) commandBuffer, const char* name);
+    void            (NRI_CALL *CmdEndProfilerZone)          (NriRef(Profiler) profiler, NriRef(CommandBuffer) commandBuffer);
+
+    // Copies timestamps of the current frame into the readback buffer. Must be recorded after all zones of the frame, i.e. in the last submitted command buffer
+    void            (NRI_CALL *CmdResolveProfilerFrame)     (NriRef(Profiler) profiler, NriRef(CommandBuffer) commandBuffer);
+
+    // The latest resolved frame. Zones are valid until the next "BeginProfilerFrame"
+    void            (NRI_CALL *GetProfilerFrame)            (const NriRef(Profiler) profiler, NriOut NriRef(ProfilerFrame) profilerFrame);
+};
+
+NriNamespaceEnd
@@ -11,28 +11,111 @@
 
 NriNamespaceBegin
 
+NriForwardStruct(AllocatorPool);
+NriForwardStruct(Defragmentation);
+
+// A custom pool hosts either buffers ("bufferUsage != NONE") or textures with compatible usage (VK and D3D12 only)
+NriStruct(AllocatorPoolDesc) {
+    Nri(MemoryLocation) memoryLocation;
+    Nri(BufferUsageBits) bufferUsage;
+    Nri(TextureUsageBits) textureUsage;
+    uint64_t blockSize;     // 0 - default
+    uint32_t blockMinNum;
+    uint32_t blockMaxNum;   // 0 - unlimited
+    bool isLinear;          // linear algorithm: free-at-once, stack, double stack or ring buffer usage (i.e. per-frame transient resources)
+};
+
+NriStruct(AllocatorStats) {
+    uint64_t budgetSize;            // memory heaps matching "memoryLocation" (not reported for pools)
+    uint64_t usageSize;
+    uint64_t blockSize;             // allocated memory blocks
+    uint64_t allocationSize;        // occupied by allocations
+    uint64_t allocationSizeMin;
+    uint64_t allocationSizeMax;
+    uint64_t unusedRangeSizeMax;    // the largest free range, a measure of fragmentation
+    uint32_t blockNum;
+    uint32_t allocationNum;
+    uint32_t unusedRangeNum;
+};
+
+// Only listed resources (allocated via "AllocateBuffer" or "AllocateTexture") can be moved
+NriStruct(DefragmentationDesc) {
+    NriPtr(Buffer) const* buffers;
+    uint32_t bufferNum;
+    NriPtr(Texture) const* textures;
+    uint32_t textureNum;
+    NriOptional NriPtr(AllocatorPool) pool; // if set, only this pool is defragmented
+    uint64_t maxBytesPerPass;               // 0 - unlimited (a per-frame budget for incremental defragmentation)
+    uint32_t maxMovesPerPass;               // 0 - unlimited
+};
+
+// "src" and "dst" are either buffers or textures. "dst" is a temporary resource in the new location (textures are in "UNDEFINED" layout),
+// the application must record "src -> dst" copies and wait for completion before calling "EndDefragmentationPass". After it, "src" refers
+// to the former "dst", i.e. its access and layout are what the application left "dst" in (for example, "COPY_DESTINATION"), not the
+// pre-move ones. The next barrier on "src" must use them as "before"
+NriStruct(DefragmentationMove) {
+    NriOptional NriPtr(Buffer) srcBuffer;
+    NriOptional NriPtr(Texture) srcTexture;
+    NriOptional NriPtr(Buffer) dstBuffer;
+    NriOptional NriPtr(Texture) dstTexture;
+};
+
+NriStruct(DefragmentationPass) {
+    const NriPtr(DefragmentationMove) moves; // valid until "EndDefragmentationPass"
+    uint32_t moveNum;                        // 0 - nothing to move, defragmentation is complete
+};
+
+NriStruct(DefragmentationStats) {
+    uint64_t movedSize;
+    uint64_t freedSize;
+    uint32_t moveNum;
+    uint32_t freedBlockNum;
+};
+
 NriStruct(AllocateBufferDesc) {
     Nri(BufferDesc) desc;
     Nri(MemoryLocation) memoryLocation;
     float memoryPriority; // [-1; 1]: low < 0, normal = 0, high > 0
+    NriOptional NriPtr(AllocatorPool) pool; // "memoryLocation" must match the pool
 };
 
 NriStruct(AllocateTextureDesc) {
     Nri(TextureDesc) desc;
     Nri(MemoryLocation) memoryLocation;
     float memoryPriority;
+    NriOptional NriPtr(AllocatorPool) pool;
 };
 
 NriStruct(AllocateAccelerationStructureDesc) {
     Nri(AccelerationStructureDesc) desc;
     Nri(MemoryLocation) memoryLocation;
     float memoryPriority;
+    NriOptional NriPtr(AllocatorPool) pool; // a buffer pool
 };
 
 NriStruct(ResourceAllocatorInterface) {
     Nri(Result) (NRI_CALL *AllocateBuffer)                  (NriRef(Device) device, const NriRef(AllocateBufferDesc) bufferDesc, NriOut NriRef(Buffer*) buffer);
     Nri(Result) (NRI_CALL *AllocateTexture)                 (NriRef(Device) device, const NriRef(AllocateTextureDesc) textureDesc, NriOut NriRef(Texture*) texture);
     Nri(Result) (NRI_CALL *AllocateAccelerationStructure)   (NriRef(Device) device, const NriRef(AllocateAccelerationStructureDesc) accelerationStructureDesc, NriOut NriRef(AccelerationStructure*) accelerationStructure);
+
+    // Custom pools (resources allocated from a pool must be destroyed before the pool)
+    Nri(Result) (NRI_CALL *CreateAllocatorPool)             (NriRef(Device) device, const NriRef(AllocatorPoolDesc) allocatorPoolDesc, NriOut NriRef(AllocatorPool*) allocatorPool);
+    void        (NRI_CALL *DestroyAllocatorPool)            (NriRef(AllocatorPool) allocatorPool);
+
+    // Statistics of the default pools and all custom pools, or of a single custom pool
+    Nri(Result) (NRI_CALL *GetAllocatorStats)               (NriRef(Device) device, Nri(MemoryLocation) memoryLocation, NriOut NriRef(AllocatorStats) allocatorStats);
+    void        (NRI_CALL *GetAllocatorPoolStats)           (const NriRef(AllocatorPool) allocatorPool, NriOut NriRef(AllocatorStats) allocatorStats);
+
+    // Incremental defragmentation (VK and D3D12 only):
+    //  - "GetDefragmentationPass" reports moves, which the application copies using regular commands
+    //  - "EndDefragmentationPass" (after the copies are completed on the GPU) rebinds "src" objects to the new memory and destroys "dst" objects
+    //  - moved resources keep the state of "dst" after the copy (see "DefragmentationMove")
+    //  - descriptors of moved resources must be recreated, since native objects change
+    //  - "EndDefragmentation" destroys the context (an unfinished pass is canceled)
+    Nri(Result) (NRI_CALL *BeginDefragmentation)            (NriRef(Device) device, const NriRef(DefragmentationDesc) defragmentationDesc, NriOut NriRef(Defragmentation*) defragmentation);
+    Nri(Result) (NRI_CALL *GetDefragmentationPass)          (NriRef(Defragmentation) defragmentation, NriOut NriRef(DefragmentationPass) defragmentationPass);
+    Nri(Result) (NRI_CALL *EndDefragmentationPass)          (NriRef(Defragmentation) defragmentation);
+    void        (NRI_CALL *EndDefragmentation)              (NriRef(Defragmentation) defragmentation, NriOut NriRef(DefragmentationStats) defragmentationStats);
 };
 
 NriNamespaceEnd
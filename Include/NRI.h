@@ -36,7 +36,7 @@ NriNamespaceBegin
 NRI_API Nri(Result) NRI_CALL nriGetInterface(const NriRef(Device) device, const char* interfaceName, size_t interfaceSize, void* interfacePtr);
 
 // Annotations for profiling tools: host
-// - Host annotations currently use NVTX (NVIDIA Nsight Systems)
+// - Host annotations currently use NVTX (NVIDIA Nsight Systems) and the built-in tracer (see below)
 // - Device (command buffer and queue) annotations use GAPI or PIX (if "WinPixEventRuntime.dll" is nearby)
 // - Colorization requires PIX or NVTX
 NRI_API void NRI_CALL nriBeginAnnotation(const char* name, uint32_t bgra);  // start a named range
@@ -44,6 +44,14 @@ NRI_API void NRI_CALL nriEndAnnotation();                                   // e
 NRI_API void NRI_CALL nriAnnotation(const char* name, uint32_t bgra);       // emit a named simultaneous event
 NRI_API void NRI_CALL nriSetThreadName(const char* name);                   // assign a name to the current thread
 
+// CPU event tracer: records host annotations into per-thread rings (no external tools needed)
+// - "captureApiCalls" adds ranges for calls of exported "nri*" functions and interface functions (if "enableNRIInstrumentation")
+// - "eventMaxNumPerThread = 0" means 65536, the oldest events get overwritten
+// - the output is Chrome trace JSON ("chrome://tracing" or "ui.perfetto.dev"), write it after "nriEndTraceCapture" (it waits for in-flight events)
+NRI_API void NRI_CALL nriBeginTraceCapture(uint32_t eventMaxNumPerThread, bool captureApiCalls); // starts a new capture, discarding the previous one
+NRI_API void NRI_CALL nriEndTraceCapture();                                                      // stops recording
+NRI_API Nri(Result) NRI_CALL nriWriteTraceCapture(const char* path);                             // writes the last capture, "INVALID_ARGUMENT" if a capture is active
+
 NriStruct(CoreInterface) {
     // Get
     const NriRef(DeviceDesc)    (NRI_CALL *GetDeviceDesc)           (const NriRef(Device) device);
@@ -66,6 +74,7 @@ NriStruct(CoreInterface) {
     // "Allocation" emphasizes the fact that there is a chunk of memory allocated under the hood
     Nri(Result)         (NRI_CALL *CreateCommandAllocator)          (NriRef(Queue) queue, NriOut NriRef(CommandAllocator*) commandAllocator);
     Nri(Result)         (NRI_CALL *CreateCommandBuffer)             (NriRef(CommandAllocator) commandAllocator, NriOut NriRef(CommandBuffer*) commandBuffer);
+    Nri(Result)         (NRI_CALL *CreateSecondaryCommandBuffer)    (NriRef(CommandAllocator) commandAllocator, NriOut NriRef(CommandBuffer*) commandBuffer); // requires "isSecondaryCommandBufferSupported"
     Nri(Result)         (NRI_CALL *CreateFence)                     (NriRef(Device) device, uint64_t initialValue, NriOut NriRef(Fence*) fence);
     Nri(Result)         (NRI_CALL *CreateDescriptorPool)            (NriRef(Device) device, const NriRef(DescriptorPoolDesc) descriptorPoolDesc, NriOut NriRef(DescriptorPool*) descriptorPool);
     Nri(Result)         (NRI_CALL *CreateBuffer)                    (NriRef(Device) device, const NriRef(BufferDesc) bufferDesc, NriOut NriRef(Buffer*) buffer); // requires "BindBufferMemory"
@@ -117,6 +126,7 @@ NriStruct(CoreInterface) {
 
     // Command buffer (one time submit)
     Nri(Result)         (NRI_CALL *BeginCommandBuffer)              (NriRef(CommandBuffer) commandBuffer, const NriPtr(DescriptorPool) descriptorPool);
+    Nri(Result)         (NRI_CALL *BeginSecondaryCommandBuffer)     (NriRef(CommandBuffer) commandBuffer, const NriPtr(DescriptorPool) descriptorPool, const NriRef(InheritanceDesc) inheritanceDesc); // for secondary command buffers only
     // {                {
         // Change descriptor pool (initially can be set via "BeginCommandBuffer")
         void                (NRI_CALL *CmdSetDescriptorPool)        (NriRef(CommandBuffer) commandBuffer, const NriRef(DescriptorPool) descriptorPool);
@@ -166,6 +176,11 @@ NriStruct(CoreInterface) {
             //  - see "Modified draw command signatures"
             void                (NRI_CALL *CmdDrawIndirect)         (NriRef(CommandBuffer) commandBuffer, const NriRef(Buffer) buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, NriOptional const NriPtr(Buffer) countBuffer, uint64_t countBufferOffset); // "buffer" contains "Draw(Base)Desc" commands
             void                (NRI_CALL *CmdDrawIndexedIndirect)  (NriRef(CommandBuffer) commandBuffer, const NriRef(Buffer) buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, NriOptional const NriPtr(Buffer) countBuffer, uint64_t countBufferOffset); // "buffer" contains "DrawIndexed(Base)Desc" commands
+
+            // Secondary command buffers (can be recorded in parallel):
+            //  - requires "AttachmentsDesc::secondaryCommandBuffers = true", i.e. no other rendering commands in this rendering pass
+            //  - all bound state (pipeline layout, pipeline, descriptor sets, vertex and index buffers) is undefined after the call
+            void                (NRI_CALL *CmdExecuteCommandBuffers) (NriRef(CommandBuffer) commandBuffer, const NriPtr(CommandBuffer) const* commandBuffers, uint32_t commandBufferNum);
         // }                }
         void                (NRI_CALL *CmdEndRendering)             (NriRef(CommandBuffer) commandBuffer);
 
@@ -205,15 +220,25 @@ NriStruct(CoreInterface) {
 
     // Work submission and synchronization
     void                (NRI_CALL *QueueSubmit)                     (NriRef(Queue) queue, const NriRef(QueueSubmitDesc) queueSubmitDesc); // to device
+    void                (NRI_CALL *QueueSubmitBatch)                (NriRef(Queue) queue, const NriPtr(QueueSubmitDesc) queueSubmitDescs, uint32_t queueSubmitDescNum); // to device, in order, as a single submission
     void                (NRI_CALL *Wait)                            (NriRef(Fence) fence, uint64_t value); // on host
+    Nri(Result)         (NRI_CALL *WaitMany)                        (const NriPtr(Fence) const* fences, const uint64_t* values, uint32_t fenceNum, bool waitAll, uint64_t timeoutNs); // on host, "waitAll = false" returns as soon as any fence reaches its value, "timeoutNs = 0" polls, "timeoutNs = UINT64_MAX" waits infinitely
     uint64_t            (NRI_CALL *GetFenceValue)                   (NriRef(Fence) fence);
 
+    // Host-side waiting policy: "Wait" uses "DeviceCreationDesc::fenceWaitDesc", "WaitWithPolicy" overrides it per call
+    void                (NRI_CALL *WaitWithPolicy)                  (NriRef(Fence) fence, uint64_t value, const NriRef(FenceWaitDesc) fenceWaitDesc); // on host
+    void                (NRI_CALL *GetFenceWaitStats)               (const NriRef(Device) device, NriOut NriRef(FenceWaitStats) fenceWaitStats); // accumulated since device creation
+
     // Command allocator
     void                (NRI_CALL *ResetCommandAllocator)           (NriRef(CommandAllocator) commandAllocator);
 
     // Map / Unmap
     void*               (NRI_CALL *MapBuffer)                       (NriRef(Buffer) buffer, uint64_t offset, uint64_t size);
     void                (NRI_CALL *UnmapBuffer)                     (NriRef(Buffer) buffer);
+    void*               (NRI_CALL *MapBufferWithMode)               (NriRef(Buffer) buffer, uint64_t offset, uint64_t size, Nri(MapMode) mapMode); // "MapBuffer" is "FLUSH_ON_UNMAP"
+    Nri(Result)         (NRI_CALL *FlushBufferRanges)               (NriRef(Device) device, const NriPtr(BufferRange) bufferRanges, uint32_t bufferRangeNum); // host writes => device, a single driver call
+    Nri(Result)         (NRI_CALL *InvalidateBufferRanges)          (NriRef(Device) device, const NriPtr(BufferRange) bufferRanges, uint32_t bufferRangeNum); // device writes => host, a single driver call
+    void                (NRI_CALL *GetMappedMemoryStats)            (const NriRef(Device) device, NriOut NriRef(MappedMemoryStats) mappedMemoryStats); // accumulated since device creation
 
     // Debug name (skipped for buffers/textures in D3D if they are not bound to memory)
     void                (NRI_CALL *SetDebugName)                    (NriPtr(Object) object, const char* name);
@@ -86,7 +86,8 @@ NriEnum(Result, uint8_t,
     OUT_OF_MEMORY,
     UNSUPPORTED,
     DEVICE_LOST,
-    OUT_OF_DATE // VK only: swap chain is out of date
+    OUT_OF_DATE, // VK only: swap chain is out of date
+    TIMEOUT // "WaitMany": wait condition is not satisfied within the timeout
 );
 
 // left -> right : low -> high bits
@@ -955,6 +956,19 @@ NriStruct(AttachmentsDesc) {
     const NriPtr(Descriptor) const* colors;
     uint32_t colorNum;
     NriOptional uint32_t viewMask;
+    NriOptional bool secondaryCommandBuffers; // rendering commands are provided by "CmdExecuteCommandBuffers" only
+};
+
+// Rendering state inherited by secondary command buffers (must match "AttachmentsDesc" of the rendering pass they are executed in)
+// Secondary command buffers can contain only rendering commands: setup, input assembly, initial state and draws ("CmdClearAttachments" is not allowed, since the render area is unknown)
+// D3D12: secondary command buffers are bundles, i.e. queries are not allowed either
+// D3D12: viewports and scissors are inherited from the primary command buffer ("CmdSetViewports" and "CmdSetScissors" are ignored)
+NriStruct(InheritanceDesc) {
+    const Nri(Format)* colorFormats;
+    uint32_t colorNum;
+    NriOptional Nri(Format) depthStencilFormat;
+    Nri(Sample_t) sampleNum;
+    NriOptional uint32_t viewMask;
 };
 
 #pragma endregion
@@ -1160,6 +1174,47 @@ NriStruct(QueueSubmitDesc) {
     uint32_t signalFenceNum;
 };
 
+// Host-side fence waiting
+NriEnum(FenceWaitPolicy, uint8_t,
+    BLOCK,              // OS wait right away
+    SPIN_THEN_BLOCK,    // poll the fence value for "spinTimeUs", then OS wait
+    HYBRID              // same, but polling backs off exponentially ("pause" -> "yield")
+);
+
+NriStruct(FenceWaitDesc) {
+    Nri(FenceWaitPolicy) policy;
+    uint32_t spinTimeUs;
+};
+
+NriStruct(FenceWaitStats) {
+    uint64_t waitNum;           // all waits
+    uint64_t completedNum;      // the value was already reached
+    uint64_t spinNum;           // the value was reached while polling
+    uint64_t blockNum;          // an OS wait was needed
+    uint64_t spinTimeUs;        // total time spent polling
+    uint64_t blockTimeUs;       // total time spent in OS waits
+    uint64_t blockTimeMaxUs;    // the longest OS wait
+};
+
+// Mapped memory: only non host coherent memory needs flushes and invalidations (VK only, NOP in D3D)
+NriEnum(MapMode, uint8_t,
+    FLUSH_ON_UNMAP,     // "UnmapBuffer" flushes the mapped range
+    EXPLICIT_FLUSH      // "UnmapBuffer" doesn't flush, use "FlushBufferRanges" to batch flushes (for example, once per frame)
+);
+
+NriStruct(BufferRange) {
+    NriPtr(Buffer) buffer;
+    uint64_t offset;
+    uint64_t size;              // can be "WHOLE_SIZE"
+};
+
+NriStruct(MappedMemoryStats) {
+    uint64_t flushNum;          // "vkFlushMappedMemoryRanges" calls, including implicit ones in "UnmapBuffer"
+    uint64_t flushRangeNum;
+    uint64_t invalidateNum;     // "vkInvalidateMappedMemoryRanges" calls
+    uint64_t invalidateRangeNum;
+};
+
 // Memory
 NriStruct(MemoryDesc) {
     uint64_t size;
@@ -1515,6 +1570,7 @@ NriStruct(DeviceDesc) {
     uint32_t isViewportBasedMultiviewSupported : 1;     // see "Multiview::VIEWPORT_BASED"
     uint32_t isPresentFromComputeSupported : 1;         // see "SwapChainDesc::queue"
     uint32_t isWaitableSwapChainSupported : 1;          // see "SwapChainDesc::waitable"
+    uint32_t isSecondaryCommandBufferSupported : 1;     // see "CreateSecondaryCommandBuffer"
 
     // Shader features (I32 + atomics and F32 are always supported)
     uint32_t isShaderNativeI16Supported : 1;
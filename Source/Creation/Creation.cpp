@@ -2,6 +2,9 @@
 
 #include "SharedExternal.h"
 
+#include "Instrumentation.h"
+#include "Tracer.h"
+
 #define ADAPTER_MAX_NUM 32
 
 #if NRI_ENABLE_NVTX_SUPPORT
@@ -392,9 +395,10 @@ static Result EnumerateAdaptersVK(AdapterDesc* adapterDescs, uint32_t&, VkPhysic
 #endif
 
 static Result FinalizeDeviceCreation(const DeviceCreationDesc& deviceCreationDesc, DeviceBase& deviceImpl, Device*& device) {
-    MaybeUnused(deviceCreationDesc);
+    deviceImpl.SetFenceWaitDesc(deviceCreationDesc.fenceWaitDesc);
+
 #if NRI_ENABLE_VALIDATION_SUPPORT
-    if (deviceCreationDesc.enableNRIValidation && deviceCreationDesc.graphicsAPI != GraphicsAPI::NONE) {
+    if (deviceCreationDesc.enableNRIValidation) {
         Device* deviceVal = (Device*)CreateDeviceValidation(deviceCreationDesc, deviceImpl);
         if (!deviceVal) {
             nriDestroyDevice((Device&)deviceImpl);
@@ -406,6 +410,8 @@ static Result FinalizeDeviceCreation(const DeviceCreationDesc& deviceCreationDes
 #endif
         device = (Device*)&deviceImpl;
 
+    ((DeviceBase*)device)->SetInstrumented(deviceCreationDesc.enableNRIInstrumentation);
+
 #if NRI_ENABLE_NVTX_SUPPORT
     nvtxInitialize(nullptr); // needed only to avoid stalls on the first use
 #endif
@@ -413,44 +419,79 @@ static Result FinalizeDeviceCreation(const DeviceCreationDesc& deviceCreationDes
     return Result::SUCCESS;
 }
 
+template <typename T>
+static void InstrumentInterface(void* interfacePtr) {
+    InstrumentFunctionTable(*(T*)interfacePtr);
+}
+
 NRI_API Result NRI_CALL nriGetInterface(const Device& device, const char* interfaceName, size_t interfaceSize, void* interfacePtr) {
+    TraceScope traceScope("nriGetInterface");
+
     const uint64_t hash = Hash(interfaceName);
     size_t realInterfaceSize = size_t(-1);
     Result result = Result::INVALID_ARGUMENT;
     const DeviceBase& deviceBase = (DeviceBase&)device;
+    void (*instrument)(void* interfacePtr) = nullptr;
 
     memset(interfacePtr, 0, interfaceSize);
 
     if (hash == Hash(NRI_STRINGIFY(nri::CoreInterface)) || hash == Hash(NRI_STRINGIFY(NRI_NAME_C(CoreInterface)))) {
         realInterfaceSize = sizeof(CoreInterface);
+        instrument = InstrumentInterface<CoreInterface>;
         if (realInterfaceSize == interfaceSize)
             result = deviceBase.FillFunctionTable(*(CoreInterface*)interfacePtr);
+    } else if (hash == Hash(NRI_STRINGIFY(nri::CommandBufferPoolInterface)) || hash == Hash(NRI_STRINGIFY(NRI_NAME_C(CommandBufferPoolInterface)))) {
+        realInterfaceSize = sizeof(CommandBufferPoolInterface);
+        instrument = InstrumentInterface<CommandBufferPoolInterface>;
+        if (realInterfaceSize == interfaceSize)
+            result = deviceBase.FillFunctionTable(*(CommandBufferPoolInterface*)interfacePtr);
+    } else if (hash == Hash(NRI_STRINGIFY(nri::DeferredReleaseInterface)) || hash == Hash(NRI_STRINGIFY(NRI_NAME_C(DeferredReleaseInterface)))) {
+        realInterfaceSize = sizeof(DeferredReleaseInterface);
+        instrument = InstrumentInterface<DeferredReleaseInterface>;
+        if (realInterfaceSize == interfaceSize)
+            result = deviceBase.FillFunctionTable(*(DeferredReleaseInterface*)interfacePtr);
     } else if (hash == Hash(NRI_STRINGIFY(nri::HelperInterface)) || hash == Hash(NRI_STRINGIFY(NRI_NAME_C(HelperInterface)))) {
         realInterfaceSize = sizeof(HelperInterface);
+        instrument = InstrumentInterface<HelperInterface>;
         if (realInterfaceSize == interfaceSize)
             result = deviceBase.FillFunctionTable(*(HelperInterface*)interfacePtr);
+    } else if (hash == Hash(NRI_STRINGIFY(nri::InstrumentationInterface)) || hash == Hash(NRI_STRINGIFY(NRI_NAME_C(InstrumentationInterface)))) {
+        realInterfaceSize = sizeof(InstrumentationInterface);
+        if (realInterfaceSize == interfaceSize)
+            result = deviceBase.FillFunctionTable(*(InstrumentationInterface*)interfacePtr);
     } else if (hash == Hash(NRI_STRINGIFY(nri::LowLatencyInterface)) || hash == Hash(NRI_STRINGIFY(NRI_NAME_C(LowLatencyInterface)))) {
         realInterfaceSize = sizeof(LowLatencyInterface);
+        instrument = InstrumentInterface<LowLatencyInterface>;
         if (realInterfaceSize == interfaceSize)
             result = deviceBase.FillFunctionTable(*(LowLatencyInterface*)interfacePtr);
     } else if (hash == Hash(NRI_STRINGIFY(nri::MeshShaderInterface)) || hash == Hash(NRI_STRINGIFY(NRI_NAME_C(MeshShaderInterface)))) {
         realInterfaceSize = sizeof(MeshShaderInterface);
+        instrument = InstrumentInterface<MeshShaderInterface>;
         if (realInterfaceSize == interfaceSize)
             result = deviceBase.FillFunctionTable(*(MeshShaderInterface*)interfacePtr);
+    } else if (hash == Hash(NRI_STRINGIFY(nri::ProfilerInterface)) || hash == Hash(NRI_STRINGIFY(NRI_NAME_C(ProfilerInterface)))) {
+        realInterfaceSize = sizeof(ProfilerInterface);
+        instrument = InstrumentInterface<ProfilerInterface>;
+        if (realInterfaceSize == interfaceSize)
+            result = deviceBase.FillFunctionTable(*(ProfilerInterface*)interfacePtr);
     } else if (hash == Hash(NRI_STRINGIFY(nri::RayTracingInterface)) || hash == Hash(NRI_STRINGIFY(NRI_NAME_C(RayTracingInterface)))) {
         realInterfaceSize = sizeof(RayTracingInterface);
+        instrument = InstrumentInterface<RayTracingInterface>;
         if (realInterfaceSize == interfaceSize)
             result = deviceBase.FillFunctionTable(*(RayTracingInterface*)interfacePtr);
     } else if (hash == Hash(NRI_STRINGIFY(nri::StreamerInterface)) || hash == Hash(NRI_STRINGIFY(NRI_NAME_C(StreamerInterface)))) {
         realInterfaceSize = sizeof(StreamerInterface);
+        instrument = InstrumentInterface<StreamerInterface>;
         if (realInterfaceSize == interfaceSize)
             result = deviceBase.FillFunctionTable(*(StreamerInterface*)interfacePtr);
     } else if (hash == Hash(NRI_STRINGIFY(nri::SwapChainInterface)) || hash == Hash(NRI_STRINGIFY(NRI_NAME_C(SwapChainInterface)))) {
         realInterfaceSize = sizeof(SwapChainInterface);
+        instrument = InstrumentInterface<SwapChainInterface>;
         if (realInterfaceSize == interfaceSize)
             result = deviceBase.FillFunctionTable(*(SwapChainInterface*)interfacePtr);
     } else if (hash == Hash(NRI_STRINGIFY(nri::ResourceAllocatorInterface)) || hash == Hash(NRI_STRINGIFY(NRI_NAME_C(ResourceAllocatorInterface)))) {
         realInterfaceSize = sizeof(ResourceAllocatorInterface);
+        instrument = InstrumentInterface<ResourceAllocatorInterface>;
         if (realInterfaceSize == interfaceSize)
             result = deviceBase.FillFunctionTable(*(ResourceAllocatorInterface*)interfacePtr);
     } else if (hash == Hash(NRI_STRINGIFY(nri::WrapperD3D11Interface)) || hash == Hash(NRI_STRINGIFY(NRI_NAME_C(WrapperD3D11Interface)))) {
@@ -482,6 +523,9 @@ NRI_API Result NRI_CALL nriGetInterface(const Device& device, const char* interf
                 return Result::FAILURE;
             }
         }
+
+        if (instrument && deviceBase.IsInstrumented())
+            instrument(interfacePtr);
     }
 
     return result;
@@ -491,6 +535,8 @@ NRI_API void NRI_CALL nriBeginAnnotation(const char* name, uint32_t bgra) {
     MaybeUnused(name, bgra);
 
 #if NRI_ENABLE_DEBUG_NAMES_AND_ANNOTATIONS
+    Tracer::Get().Record(TraceEventType::BEGIN, name);
+
 #    if NRI_ENABLE_NVTX_SUPPORT
 
     nvtxEventAttributes_t eventAttrib = {};
@@ -513,6 +559,8 @@ NRI_API void NRI_CALL nriBeginAnnotation(const char* name, uint32_t bgra) {
 
 NRI_API void NRI_CALL nriEndAnnotation() {
 #if NRI_ENABLE_DEBUG_NAMES_AND_ANNOTATIONS
+    Tracer::Get().Record(TraceEventType::END, nullptr);
+
 #    if NRI_ENABLE_NVTX_SUPPORT
 
     nvtxRangePop();
@@ -529,6 +577,8 @@ NRI_API void NRI_CALL nriAnnotation(const char* name, uint32_t bgra) {
     MaybeUnused(name, bgra);
 
 #if NRI_ENABLE_DEBUG_NAMES_AND_ANNOTATIONS
+    Tracer::Get().Record(TraceEventType::INSTANT, name);
+
 #    if NRI_ENABLE_NVTX_SUPPORT
 
     nvtxEventAttributes_t eventAttrib = {};
@@ -560,6 +610,8 @@ NRI_API void NRI_CALL nriAnnotation(const char* name, uint32_t bgra) {
 #    endif
 
 NRI_API void NRI_CALL nriSetThreadName(const char* name) {
+    Tracer::Get().SetThreadName(name);
+
 #    if (defined __linux__)
     nvtxNameOsThreadA(syscall(SYS_gettid), name);
 #    elif (defined __APPLE__)
@@ -573,12 +625,27 @@ NRI_API void NRI_CALL nriSetThreadName(const char* name) {
 
 #else
 
-NRI_API void NRI_CALL nriSetThreadName(const char*) {
+NRI_API void NRI_CALL nriSetThreadName(const char* name) {
+    Tracer::Get().SetThreadName(name);
 }
 
 #endif
 
+NRI_API void NRI_CALL nriBeginTraceCapture(uint32_t eventMaxNumPerThread, bool captureApiCalls) {
+    Tracer::Get().BeginCapture(eventMaxNumPerThread, captureApiCalls);
+}
+
+NRI_API void NRI_CALL nriEndTraceCapture() {
+    Tracer::Get().EndCapture();
+}
+
+NRI_API Result NRI_CALL nriWriteTraceCapture(const char* path) {
+    return Tracer::Get().WriteCapture(path);
+}
+
 NRI_API Result NRI_CALL nriCreateDevice(const DeviceCreationDesc& deviceCreationDesc, Device*& device) {
+    TraceScope traceScope("nriCreateDevice");
+
     Result result = Result::UNSUPPORTED;
     DeviceBase* deviceImpl = nullptr;
 
@@ -643,6 +710,8 @@ NRI_API Result NRI_CALL nriCreateDevice(const DeviceCreationDesc& deviceCreation
 }
 
 NRI_API Result NRI_CALL nriCreateDeviceFromD3D11Device(const DeviceCreationD3D11Desc& deviceCreationD3D11Desc, Device*& device) {
+    TraceScope traceScope("nriCreateDeviceFromD3D11Device");
+
     DeviceCreationDesc deviceCreationDesc = {};
     deviceCreationDesc.graphicsAPI = GraphicsAPI::D3D11;
 
@@ -700,6 +769,8 @@ NRI_API Result NRI_CALL nriCreateDeviceFromD3D11Device(const DeviceCreationD3D11
 }
 
 NRI_API Result NRI_CALL nriCreateDeviceFromD3D12Device(const DeviceCreationD3D12Desc& deviceCreationD3D12Desc, Device*& device) {
+    TraceScope traceScope("nriCreateDeviceFromD3D12Device");
+
     DeviceCreationDesc deviceCreationDesc = {};
     deviceCreationDesc.graphicsAPI = GraphicsAPI::D3D12;
 
@@ -749,6 +820,8 @@ NRI_API Result NRI_CALL nriCreateDeviceFromD3D12Device(const DeviceCreationD3D12
 }
 
 NRI_API Result NRI_CALL nriCreateDeviceFromVkDevice(const DeviceCreationVKDesc& deviceCreationVKDesc, Device*& device) {
+    TraceScope traceScope("nriCreateDeviceFromVkDevice");
+
     DeviceCreationDesc deviceCreationDesc = {};
     deviceCreationDesc.graphicsAPI = GraphicsAPI::VK;
 
@@ -796,7 +869,19 @@ NRI_API Result NRI_CALL nriCreateDeviceFromVkDevice(const DeviceCreationVKDesc&
 }
 
 NRI_API void NRI_CALL nriDestroyDevice(Device& device) {
+    TraceScope traceScope("nriDestroyDevice");
+
+    ((DeviceBase&)device).GetBudgetMonitor().Stop();
+
+#if NRI_ENABLE_LOCK_STATS
+    CallbackInterface callbacks = ((DeviceBase&)device).GetCallbackInterface(); // the device owns most of the locks
+#endif
+
     ((DeviceBase&)device).Destruct();
+
+#if NRI_ENABLE_LOCK_STATS
+    ReportLockStats(callbacks);
+#endif
 }
 
 NRI_API Format NRI_CALL nriConvertVKFormatToNRI(uint32_t vkFormat) {
@@ -847,6 +932,8 @@ NRI_API const char* NRI_CALL nriGetGraphicsAPIString(GraphicsAPI graphicsAPI) {
 }
 
 NRI_API Result NRI_CALL nriEnumerateAdapters(AdapterDesc* adapterDescs, uint32_t& adapterDescNum) {
+    TraceScope traceScope("nriEnumerateAdapters");
+
     // Try VK first as capable to return real queue support
     Result result = EnumerateAdaptersVK(adapterDescs, adapterDescNum, 0, nullptr);
 
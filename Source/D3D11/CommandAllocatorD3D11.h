@@ -31,4 +31,6 @@ private:
 
 } // namespace nri
 
+NRI_ALLOCATION_CATEGORY(nri::CommandAllocatorD3D11, COMMAND_BUFFER);
+
 nri::Result CreateCommandBuffer(nri::DeviceD3D11& deviceImpl, ID3D11DeviceContext* precreatedContext, nri::CommandBuffer*& commandBuffer);
@@ -1,6 +1,8 @@
 // © 2021 NVIDIA Corporation
 
 Result CreateCommandBuffer(DeviceD3D11& device, ID3D11DeviceContext* precreatedContext, CommandBuffer*& commandBuffer) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::COMMAND_BUFFER);
+
     bool isImmediate = false;
     if (precreatedContext)
         isImmediate = precreatedContext->GetType() == D3D11_DEVICE_CONTEXT_IMMEDIATE;
@@ -113,3 +113,5 @@ private:
 };
 
 } // namespace nri
+
+NRI_ALLOCATION_CATEGORY(nri::CommandBufferD3D11, COMMAND_BUFFER);
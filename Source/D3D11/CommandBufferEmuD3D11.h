@@ -84,3 +84,5 @@ private:
 };
 
 } // namespace nri
+
+NRI_ALLOCATION_CATEGORY(nri::CommandBufferEmuD3D11, COMMAND_BUFFER);
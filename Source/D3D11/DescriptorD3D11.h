@@ -86,3 +86,6 @@ private:
 };
 
 } // namespace nri
+
+NRI_OBJECT_POOL(nri::DescriptorD3D11, DESCRIPTOR);
+NRI_ALLOCATION_CATEGORY(nri::DescriptorD3D11, DESCRIPTOR);
@@ -83,11 +83,13 @@ struct DeviceD3D11 final : public DeviceBase {
 
     template <typename Implementation, typename Interface, typename... Args>
     inline Result CreateImplementation(Interface*& entity, const Args&... args) {
-        Implementation* impl = Allocate<Implementation>(GetAllocationCallbacks(), *this);
+        AllocationCategoryScope allocationCategoryScope(AllocationCategoryTraits<Implementation>::category);
+
+        Implementation* impl = AllocateObject<Implementation>(*this, *this);
         Result result = impl->Create(args...);
 
         if (result != Result::SUCCESS) {
-            Destroy(GetAllocationCallbacks(), impl);
+            DestroyObject(*this, impl);
             entity = nullptr;
         } else
             entity = (Interface*)impl;
@@ -118,8 +120,11 @@ struct DeviceD3D11 final : public DeviceBase {
 
     void Destruct() override;
     Result FillFunctionTable(CoreInterface& table) const override;
+    Result FillFunctionTable(CommandBufferPoolInterface& table) const override;
+    Result FillFunctionTable(DeferredReleaseInterface& table) const override;
     Result FillFunctionTable(HelperInterface& table) const override;
     Result FillFunctionTable(LowLatencyInterface& table) const override;
+    Result FillFunctionTable(ProfilerInterface& table) const override;
     Result FillFunctionTable(StreamerInterface& table) const override;
     Result FillFunctionTable(SwapChainInterface& table) const override;
     Result FillFunctionTable(ResourceAllocatorInterface& table) const override;
@@ -136,6 +141,7 @@ struct DeviceD3D11 final : public DeviceBase {
     FormatSupportBits GetFormatSupport(Format format) const;
 
 private:
+    FormatSupportBits QueryFormatSupport(Format format) const;
     void FillDesc();
     void InitializeNvExt(bool isNVAPILoadedInApp, bool isImported);
     void InitializeAmdExt(AGSContext* agsContext, bool isImported);
@@ -153,6 +159,7 @@ private:
     std::array<std::vector<QueueD3D11*>, (size_t)QueueType::MAX_NUM> m_QueueFamilies = {}; // TODO: use Vector!
     CRITICAL_SECTION m_CriticalSection = {};                                               // TODO: Lock?
     CoreInterface m_CoreInterface = {};
+    FormatSupportCache m_FormatSupportCache;
     DeviceDesc m_Desc = {};
     uint8_t m_Version = 0;
     uint8_t m_ImmediateContextVersion = 0;
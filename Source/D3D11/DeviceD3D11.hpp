@@ -530,7 +530,7 @@ void DeviceD3D11::GetMemoryDesc(const TextureDesc& textureDesc, MemoryLocation m
 }
 
 void DeviceD3D11::Destruct() {
-    Destroy(GetAllocationCallbacks(), this);
+    Destroy(GetApplicationAllocationCallbacks(), this);
 }
 
 NRI_INLINE Result DeviceD3D11::GetQueue(QueueType queueType, uint32_t queueIndex, Queue*& queue) {
@@ -577,6 +577,10 @@ NRI_INLINE Result DeviceD3D11::BindTextureMemory(const TextureMemoryBindingDesc*
 }
 
 NRI_INLINE FormatSupportBits DeviceD3D11::GetFormatSupport(Format format) const {
+    return m_FormatSupportCache.Get(format, [this](Format f) { return QueryFormatSupport(f); });
+}
+
+NRI_INLINE FormatSupportBits DeviceD3D11::QueryFormatSupport(Format format) const {
     FormatSupportBits mask = FormatSupportBits::UNSUPPORTED;
 
     D3D11_FEATURE_DATA_FORMAT_SUPPORT formatSupport = {GetDxgiFormat(format).typed};
@@ -38,6 +38,12 @@ struct FenceD3D11 final : public DebugNameBase {
     void QueueSignal(uint64_t value);
     void QueueWait(uint64_t value);
     void Wait(uint64_t value);
+    void Wait(uint64_t value, const FenceWaitDesc& fenceWaitDesc);
+
+    static Result WaitMany(const Fence* const* fences, const uint64_t* values, uint32_t fenceNum, bool waitAll, uint64_t timeoutNs);
+
+private:
+    bool IsCompleted(uint64_t value) const;
 
 private:
     DeviceD3D11& m_Device;
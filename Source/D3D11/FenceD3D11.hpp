@@ -43,22 +43,122 @@ NRI_INLINE void FenceD3D11::QueueWait(uint64_t value) {
 }
 
 NRI_INLINE void FenceD3D11::Wait(uint64_t value) {
-    if (m_Fence) {
-        if (m_Event == 0 || m_Event == INVALID_HANDLE_VALUE) {
-            while (m_Fence->GetCompletedValue() < value)
-                ;
-        } else if (m_Fence->GetCompletedValue() < value) {
-            HRESULT hr = m_Fence->SetEventOnCompletion(value, m_Event);
-            RETURN_ON_FAILURE(&m_Device, hr == S_OK, ReturnVoid(), "ID3D11Fence::SetEventOnCompletion()  failed!");
-
-            uint32_t result = WaitForSingleObjectEx(m_Event, TIMEOUT_FENCE, TRUE);
-            RETURN_ON_FAILURE(&m_Device, result == WAIT_OBJECT_0, ReturnVoid(), "WaitForSingleObjectEx()  failed!");
+    Wait(value, m_Device.GetFenceWaitDesc());
+}
+
+NRI_INLINE void FenceD3D11::Wait(uint64_t value, const FenceWaitDesc& fenceWaitDesc) {
+    WaitForFence(fenceWaitDesc, m_Device.GetFenceWaitStats(), [&] { return IsCompleted(value); }, [&] {
+        if (m_Fence) {
+            if (m_Event == 0 || m_Event == INVALID_HANDLE_VALUE) {
+                while (m_Fence->GetCompletedValue() < value)
+                    ;
+            } else {
+                // A loop, because alertable waits can return early
+                while (m_Fence->GetCompletedValue() < value) {
+                    HRESULT hr = m_Fence->SetEventOnCompletion(value, m_Event);
+                    RETURN_ON_FAILURE(&m_Device, hr == S_OK, ReturnVoid(), "ID3D11Fence::SetEventOnCompletion()  failed!");
+
+                    uint32_t result = WaitForSingleObjectEx(m_Event, TIMEOUT_FENCE, TRUE);
+                    RETURN_ON_FAILURE(&m_Device, result == WAIT_OBJECT_0 || result == WAIT_IO_COMPLETION, ReturnVoid(), "WaitForSingleObjectEx()  failed!");
+                }
+            }
+        } else {
+            HRESULT hr = S_FALSE;
+            while (hr == S_FALSE)
+                hr = m_Device.GetImmediateContext()->GetData(m_Query, nullptr, 0, 0);
+
+            RETURN_ON_FAILURE(&m_Device, hr == S_OK, ReturnVoid(), "D3D11DeviceContext::GetData()  failed!");
         }
-    } else {
-        HRESULT hr = S_FALSE;
-        while (hr == S_FALSE)
-            hr = m_Device.GetImmediateContext()->GetData(m_Query, nullptr, 0, 0);
+    });
+}
+
+NRI_INLINE bool FenceD3D11::IsCompleted(uint64_t value) const {
+    if (m_Fence)
+        return m_Fence->GetCompletedValue() >= value;
+
+    // Queries are binary: the value is reached if it's not greater than the last signaled one and the query is done
+    return value <= m_Value && m_Device.GetImmediateContext()->GetData(m_Query, nullptr, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK;
+}
+
+// Dedicated events per thread, since fence events are used by "Wait", which can run concurrently
+struct WaitManyEventsD3D11 {
+    ~WaitManyEventsD3D11() {
+        for (HANDLE handle : handles) {
+            if (handle != 0 && handle != INVALID_HANDLE_VALUE)
+                CloseHandle(handle);
+        }
+    }
+
+    inline HANDLE Get(uint32_t index) {
+        if (handles[index] == 0)
+            handles[index] = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+
+        return handles[index];
+    }
+
+    HANDLE handles[MAXIMUM_WAIT_OBJECTS] = {};
+};
+
+NRI_INLINE Result FenceD3D11::WaitMany(const Fence* const* fences, const uint64_t* values, uint32_t fenceNum, bool waitAll, uint64_t timeoutNs) {
+    static thread_local WaitManyEventsD3D11 waitManyEvents;
+
+    DeviceD3D11& device = ((FenceD3D11*)fences[0])->m_Device;
+
+    // Merge duplicates: "all" needs the greatest value of a fence, "any" - the smallest
+    Scratch<FenceD3D11*> uniqueFences = AllocateScratch(device, FenceD3D11*, fenceNum);
+    Scratch<uint64_t> uniqueValues = AllocateScratch(device, uint64_t, fenceNum);
+    uint32_t uniqueNum = 0;
+
+    for (uint32_t i = 0; i < fenceNum; i++) {
+        FenceD3D11* fence = (FenceD3D11*)fences[i];
+
+        uint32_t j = 0;
+        while (j < uniqueNum && uniqueFences[j] != fence)
+            j++;
+
+        if (j == uniqueNum) {
+            uniqueFences[uniqueNum] = fence;
+            uniqueValues[uniqueNum++] = values[i];
+        } else
+            uniqueValues[j] = waitAll ? std::max(uniqueValues[j], values[i]) : std::min(uniqueValues[j], values[i]);
+    }
+
+    Scratch<HANDLE> events = AllocateScratch(device, HANDLE, uniqueNum);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(std::min<uint64_t>(timeoutNs, INT64_MAX / 2));
+
+    while (true) {
+        uint32_t completedNum = 0;
+        uint32_t eventNum = 0;
+        for (uint32_t i = 0; i < uniqueNum; i++) {
+            FenceD3D11& fence = *uniqueFences[i];
+
+            if (fence.IsCompleted(uniqueValues[i]))
+                completedNum++;
+            else if (fence.m_Fence && eventNum < MAXIMUM_WAIT_OBJECTS) {
+                HANDLE event = waitManyEvents.Get(eventNum);
+                if (event == 0 || event == INVALID_HANDLE_VALUE)
+                    continue;
+
+                HRESULT hr = fence.m_Fence->SetEventOnCompletion(uniqueValues[i], event);
+                RETURN_ON_BAD_HRESULT(&device, hr, "ID3D11Fence::SetEventOnCompletion()");
+
+                events[eventNum++] = event;
+            }
+        }
+
+        if (waitAll ? completedNum == uniqueNum : completedNum != 0)
+            return Result::SUCCESS;
+
+        auto now = std::chrono::steady_clock::now();
+        if (timeoutNs != UINT64_MAX && now >= deadline)
+            return Result::TIMEOUT;
 
-        RETURN_ON_FAILURE(&m_Device, hr == S_OK, ReturnVoid(), "D3D11DeviceContext::GetData()  failed!");
+        // Queries can't signal events, polling is used if there are any
+        if (completedNum + eventNum == uniqueNum) {
+            uint64_t remainingNs = timeoutNs == UINT64_MAX ? UINT64_MAX : (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count();
+            uint32_t result = WaitForMultipleObjectsEx(eventNum, events, waitAll, NsToMs(remainingNs), TRUE);
+            RETURN_ON_FAILURE(&device, result < WAIT_OBJECT_0 + eventNum || result == WAIT_TIMEOUT || result == WAIT_IO_COMPLETION, Result::FAILURE, "WaitForMultipleObjectsEx()  failed!"); // alertable wake-ups retry
+        } else
+            std::this_thread::yield();
     }
 }
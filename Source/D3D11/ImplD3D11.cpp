@@ -18,9 +18,12 @@
 #include "SwapChainD3D11.h"
 #include "TextureD3D11.h"
 
+#include "CommandBufferPool.h"
+#include "DeferredReleaseQueue.h"
 #include "HelperDataUpload.h"
 #include "HelperDeviceMemoryAllocator.h"
 #include "HelperWaitIdle.h"
+#include "Profiler.h"
 #include "Streamer.h"
 
 using namespace nri;
@@ -44,6 +47,10 @@ using namespace nri;
 
 Result CreateDeviceD3D11(const DeviceCreationDesc& desc, const DeviceCreationD3D11Desc& descD3D11, DeviceBase*& device) {
     DeviceD3D11* impl = Allocate<DeviceD3D11>(desc.allocationCallbacks, desc.callbackInterface, desc.allocationCallbacks);
+
+    if (desc.enableAllocationTracking)
+        impl->EnableAllocationTracking();
+
     Result result = impl->Create(desc, descD3D11);
 
     if (result != Result::SUCCESS) {
@@ -109,6 +116,10 @@ static Result NRI_CALL CreateCommandBuffer(CommandAllocator& commandAllocator, C
     return ((CommandAllocatorD3D11&)commandAllocator).CreateCommandBuffer(commandBuffer);
 }
 
+static Result NRI_CALL CreateSecondaryCommandBuffer(CommandAllocator&, CommandBuffer*&) {
+    return Result::UNSUPPORTED;
+}
+
 static Result NRI_CALL CreateFence(Device& device, uint64_t initialValue, Fence*& fence) {
     return ((DeviceD3D11&)device).CreateImplementation<FenceD3D11>(fence, initialValue);
 }
@@ -226,9 +237,15 @@ static void NRI_CALL FreeMemory(Memory& memory) {
 }
 
 static Result NRI_CALL BeginCommandBuffer(CommandBuffer& commandBuffer, const DescriptorPool* descriptorPool) {
+    ((CommandBufferD3D11&)commandBuffer).GetStats() = {};
+
     return ((CommandBufferD3D11&)commandBuffer).Begin(descriptorPool);
 }
 
+static Result NRI_CALL BeginSecondaryCommandBuffer(CommandBuffer&, const DescriptorPool*, const InheritanceDesc&) {
+    return Result::UNSUPPORTED;
+}
+
 static void NRI_CALL CmdSetDescriptorPool(CommandBuffer& commandBuffer, const DescriptorPool& descriptorPool) {
     ((CommandBufferD3D11&)commandBuffer).SetDescriptorPool(descriptorPool);
 }
@@ -238,6 +255,7 @@ static void NRI_CALL CmdSetPipelineLayout(CommandBuffer& commandBuffer, const Pi
 }
 
 static void NRI_CALL CmdSetDescriptorSet(CommandBuffer& commandBuffer, uint32_t setIndex, const DescriptorSet& descriptorSet, const uint32_t* dynamicConstantBufferOffsets) {
+    ((CommandBufferD3D11&)commandBuffer).GetStats().descriptorSetBindNum++;
     ((CommandBufferD3D11&)commandBuffer).SetDescriptorSet(setIndex, descriptorSet, dynamicConstantBufferOffsets);
 }
 
@@ -250,10 +268,12 @@ static void NRI_CALL CmdSetRootDescriptor(CommandBuffer& commandBuffer, uint32_t
 }
 
 static void NRI_CALL CmdSetPipeline(CommandBuffer& commandBuffer, const Pipeline& pipeline) {
+    ((CommandBufferD3D11&)commandBuffer).GetStats().pipelineBindNum++;
     ((CommandBufferD3D11&)commandBuffer).SetPipeline(pipeline);
 }
 
 static void NRI_CALL CmdBarrier(CommandBuffer& commandBuffer, const BarrierGroupDesc& barrierGroupDesc) {
+    AccountBarriers(((CommandBufferD3D11&)commandBuffer).GetStats(), barrierGroupDesc);
     ((CommandBufferD3D11&)commandBuffer).Barrier(barrierGroupDesc);
 }
 
@@ -296,6 +316,7 @@ static void NRI_CALL CmdSetDepthBias(CommandBuffer&, const DepthBiasDesc&) {
 }
 
 static void NRI_CALL CmdBeginRendering(CommandBuffer& commandBuffer, const AttachmentsDesc& attachmentsDesc) {
+    ((CommandBufferD3D11&)commandBuffer).GetStats().renderPassNum++;
     ((CommandBufferD3D11&)commandBuffer).BeginRendering(attachmentsDesc);
 }
 
@@ -304,38 +325,49 @@ static void NRI_CALL CmdClearAttachments(CommandBuffer& commandBuffer, const Cle
 }
 
 static void NRI_CALL CmdDraw(CommandBuffer& commandBuffer, const DrawDesc& drawDesc) {
+    ((CommandBufferD3D11&)commandBuffer).GetStats().drawNum++;
     ((CommandBufferD3D11&)commandBuffer).Draw(drawDesc);
 }
 
 static void NRI_CALL CmdDrawIndexed(CommandBuffer& commandBuffer, const DrawIndexedDesc& drawIndexedDesc) {
+    ((CommandBufferD3D11&)commandBuffer).GetStats().drawIndexedNum++;
     ((CommandBufferD3D11&)commandBuffer).DrawIndexed(drawIndexedDesc);
 }
 
 static void NRI_CALL CmdDrawIndirect(CommandBuffer& commandBuffer, const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset) {
+    ((CommandBufferD3D11&)commandBuffer).GetStats().drawIndirectNum++;
     ((CommandBufferD3D11&)commandBuffer).DrawIndirect(buffer, offset, drawNum, stride, countBuffer, countBufferOffset);
 }
 
 static void NRI_CALL CmdDrawIndexedIndirect(CommandBuffer& commandBuffer, const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset) {
+    ((CommandBufferD3D11&)commandBuffer).GetStats().drawIndirectNum++;
     ((CommandBufferD3D11&)commandBuffer).DrawIndexedIndirect(buffer, offset, drawNum, stride, countBuffer, countBufferOffset);
 }
 
+static void NRI_CALL CmdExecuteCommandBuffers(CommandBuffer&, const CommandBuffer* const*, uint32_t) {
+}
+
 static void NRI_CALL CmdEndRendering(CommandBuffer& commandBuffer) {
     ((CommandBufferD3D11&)commandBuffer).ResetAttachments();
 }
 
 static void NRI_CALL CmdDispatch(CommandBuffer& commandBuffer, const DispatchDesc& dispatchDesc) {
+    ((CommandBufferD3D11&)commandBuffer).GetStats().dispatchNum++;
     ((CommandBufferD3D11&)commandBuffer).Dispatch(dispatchDesc);
 }
 
 static void NRI_CALL CmdDispatchIndirect(CommandBuffer& commandBuffer, const Buffer& buffer, uint64_t offset) {
+    ((CommandBufferD3D11&)commandBuffer).GetStats().dispatchNum++;
     ((CommandBufferD3D11&)commandBuffer).DispatchIndirect(buffer, offset);
 }
 
 static void NRI_CALL CmdCopyBuffer(CommandBuffer& commandBuffer, Buffer& dstBuffer, uint64_t dstOffset, const Buffer& srcBuffer, uint64_t srcOffset, uint64_t size) {
+    AccountBufferCopy(((CommandBufferD3D11&)commandBuffer).GetStats(), ((BufferD3D11&)srcBuffer).GetDesc().size, srcOffset, size);
     ((CommandBufferD3D11&)commandBuffer).CopyBuffer(dstBuffer, dstOffset, srcBuffer, srcOffset, size);
 }
 
 static void NRI_CALL CmdCopyTexture(CommandBuffer& commandBuffer, Texture& dstTexture, const TextureRegionDesc* dstRegionDesc, const Texture& srcTexture, const TextureRegionDesc* srcRegionDesc) {
+    ((CommandBufferD3D11&)commandBuffer).GetStats().copyNum++;
     ((CommandBufferD3D11&)commandBuffer).CopyTexture(dstTexture, dstRegionDesc, srcTexture, srcRegionDesc);
 }
 
@@ -344,10 +376,12 @@ static void NRI_CALL CmdResolveTexture(CommandBuffer& commandBuffer, Texture& ds
 }
 
 static void NRI_CALL CmdUploadBufferToTexture(CommandBuffer& commandBuffer, Texture& dstTexture, const TextureRegionDesc& dstRegionDesc, const Buffer& srcBuffer, const TextureDataLayoutDesc& srcDataLayoutDesc) {
+    ((CommandBufferD3D11&)commandBuffer).GetStats().copyNum++;
     ((CommandBufferD3D11&)commandBuffer).UploadBufferToTexture(dstTexture, dstRegionDesc, srcBuffer, srcDataLayoutDesc);
 }
 
 static void NRI_CALL CmdReadbackTextureToBuffer(CommandBuffer& commandBuffer, Buffer& dstBuffer, const TextureDataLayoutDesc& dstDataLayoutDesc, const Texture& srcTexture, const TextureRegionDesc& srcRegionDesc) {
+    ((CommandBufferD3D11&)commandBuffer).GetStats().copyNum++;
     ((CommandBufferD3D11&)commandBuffer).ReadbackTextureToBuffer(dstBuffer, dstDataLayoutDesc, srcTexture, srcRegionDesc);
 }
 
@@ -379,10 +413,17 @@ static void NRI_CALL CmdBeginAnnotation(CommandBuffer& commandBuffer, const char
 #if NRI_ENABLE_DEBUG_NAMES_AND_ANNOTATIONS
     ((CommandBufferD3D11&)commandBuffer).BeginAnnotation(name, bgra);
 #endif
+
+    ProfilerImpl* profiler = ((CommandBufferD3D11&)commandBuffer).GetDevice().GetAnnotationProfiler();
+    if (profiler)
+        profiler->BeginZone(commandBuffer, ((CommandBufferD3D11&)commandBuffer).GetProfilerZoneState(), name);
 }
 
 static void NRI_CALL CmdEndAnnotation(CommandBuffer& commandBuffer) {
-    MaybeUnused(commandBuffer);
+    ProfilerImpl* profiler = ((CommandBufferD3D11&)commandBuffer).GetDevice().GetAnnotationProfiler();
+    if (profiler)
+        profiler->EndZone(commandBuffer, ((CommandBufferD3D11&)commandBuffer).GetProfilerZoneState());
+
 #if NRI_ENABLE_DEBUG_NAMES_AND_ANNOTATIONS
     ((CommandBufferD3D11&)commandBuffer).EndAnnotation();
 #endif
@@ -412,17 +453,36 @@ static void NRI_CALL ResetQueries(QueryPool&, uint32_t, uint32_t) {
 }
 
 static void NRI_CALL QueueSubmit(Queue& queue, const QueueSubmitDesc& queueSubmitDesc) {
-    ((QueueD3D11&)queue).Submit(queueSubmitDesc);
+    ((QueueD3D11&)queue).Submit(&queueSubmitDesc, 1);
+}
+
+static void NRI_CALL QueueSubmitBatch(Queue& queue, const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum) {
+    ((QueueD3D11&)queue).Submit(queueSubmitDescs, queueSubmitDescNum);
 }
 
 static void NRI_CALL Wait(Fence& fence, uint64_t value) {
     ((FenceD3D11&)fence).Wait(value);
 }
 
+static Result NRI_CALL WaitMany(const Fence* const* fences, const uint64_t* values, uint32_t fenceNum, bool waitAll, uint64_t timeoutNs) {
+    if (!fenceNum)
+        return Result::SUCCESS;
+
+    return FenceD3D11::WaitMany(fences, values, fenceNum, waitAll, timeoutNs);
+}
+
 static uint64_t NRI_CALL GetFenceValue(Fence& fence) {
     return ((FenceD3D11&)fence).GetFenceValue();
 }
 
+static void NRI_CALL WaitWithPolicy(Fence& fence, uint64_t value, const FenceWaitDesc& fenceWaitDesc) {
+    ((FenceD3D11&)fence).Wait(value, fenceWaitDesc);
+}
+
+static void NRI_CALL GetFenceWaitStats(const Device& device, FenceWaitStats& fenceWaitStats) {
+    ((const DeviceD3D11&)device).GetFenceWaitStats().Get(fenceWaitStats);
+}
+
 static void NRI_CALL UpdateDescriptorRanges(DescriptorSet& descriptorSet, uint32_t baseRange, uint32_t rangeNum, const DescriptorRangeUpdateDesc* rangeUpdateDescs) {
     ((DescriptorSetD3D11&)descriptorSet).UpdateDescriptorRanges(baseRange, rangeNum, rangeUpdateDescs);
 }
@@ -455,6 +515,22 @@ static void NRI_CALL UnmapBuffer(Buffer& buffer) {
     ((BufferD3D11&)buffer).Unmap();
 }
 
+static void* NRI_CALL MapBufferWithMode(Buffer& buffer, uint64_t offset, uint64_t, MapMode) {
+    return ((BufferD3D11&)buffer).Map(offset);
+}
+
+static Result NRI_CALL FlushBufferRanges(Device&, const BufferRange*, uint32_t) {
+    return Result::SUCCESS;
+}
+
+static Result NRI_CALL InvalidateBufferRanges(Device&, const BufferRange*, uint32_t) {
+    return Result::SUCCESS;
+}
+
+static void NRI_CALL GetMappedMemoryStats(const Device& device, MappedMemoryStats& mappedMemoryStats) {
+    ((const DeviceD3D11&)device).GetMappedMemoryStats().Get(mappedMemoryStats);
+}
+
 static void NRI_CALL SetDebugName(Object* object, const char* name) {
     MaybeUnused(object, name);
 #if NRI_ENABLE_DEBUG_NAMES_AND_ANNOTATIONS
@@ -505,6 +581,8 @@ static uint64_t NRI_CALL GetTextureNativeObject(const Texture& texture) {
 // Command buffer emulation
 
 static Result NRI_CALL EmuBeginCommandBuffer(CommandBuffer& commandBuffer, const DescriptorPool* descriptorPool) {
+    ((CommandBufferEmuD3D11&)commandBuffer).GetStats() = {};
+
     return ((CommandBufferEmuD3D11&)commandBuffer).Begin(descriptorPool);
 }
 
@@ -516,6 +594,7 @@ static void NRI_CALL EmuCmdSetPipelineLayout(CommandBuffer& commandBuffer, const
 }
 
 static void NRI_CALL EmuCmdSetDescriptorSet(CommandBuffer& commandBuffer, uint32_t setIndex, const DescriptorSet& descriptorSet, const uint32_t* dynamicConstantBufferOffsets) {
+    ((CommandBufferEmuD3D11&)commandBuffer).GetStats().descriptorSetBindNum++;
     ((CommandBufferEmuD3D11&)commandBuffer).SetDescriptorSet(setIndex, descriptorSet, dynamicConstantBufferOffsets);
 }
 
@@ -528,10 +607,12 @@ static void NRI_CALL EmuCmdSetRootDescriptor(CommandBuffer& commandBuffer, uint3
 }
 
 static void NRI_CALL EmuCmdSetPipeline(CommandBuffer& commandBuffer, const Pipeline& pipeline) {
+    ((CommandBufferEmuD3D11&)commandBuffer).GetStats().pipelineBindNum++;
     ((CommandBufferEmuD3D11&)commandBuffer).SetPipeline(pipeline);
 }
 
 static void NRI_CALL EmuCmdBarrier(CommandBuffer& commandBuffer, const BarrierGroupDesc& barrierGroupDesc) {
+    AccountBarriers(((CommandBufferEmuD3D11&)commandBuffer).GetStats(), barrierGroupDesc);
     ((CommandBufferEmuD3D11&)commandBuffer).Barrier(barrierGroupDesc);
 }
 
@@ -574,6 +655,7 @@ static void NRI_CALL EmuCmdSetDepthBias(CommandBuffer&, const DepthBiasDesc&) {
 }
 
 static void NRI_CALL EmuCmdBeginRendering(CommandBuffer& commandBuffer, const AttachmentsDesc& attachmentsDesc) {
+    ((CommandBufferEmuD3D11&)commandBuffer).GetStats().renderPassNum++;
     ((CommandBufferEmuD3D11&)commandBuffer).BeginRendering(attachmentsDesc);
 }
 
@@ -582,18 +664,22 @@ static void NRI_CALL EmuCmdClearAttachments(CommandBuffer& commandBuffer, const
 }
 
 static void NRI_CALL EmuCmdDraw(CommandBuffer& commandBuffer, const DrawDesc& drawDesc) {
+    ((CommandBufferEmuD3D11&)commandBuffer).GetStats().drawNum++;
     ((CommandBufferEmuD3D11&)commandBuffer).Draw(drawDesc);
 }
 
 static void NRI_CALL EmuCmdDrawIndexed(CommandBuffer& commandBuffer, const DrawIndexedDesc& drawIndexedDesc) {
+    ((CommandBufferEmuD3D11&)commandBuffer).GetStats().drawIndexedNum++;
     ((CommandBufferEmuD3D11&)commandBuffer).DrawIndexed(drawIndexedDesc);
 }
 
 static void NRI_CALL EmuCmdDrawIndirect(CommandBuffer& commandBuffer, const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset) {
+    ((CommandBufferEmuD3D11&)commandBuffer).GetStats().drawIndirectNum++;
     ((CommandBufferEmuD3D11&)commandBuffer).DrawIndirect(buffer, offset, drawNum, stride, countBuffer, countBufferOffset);
 }
 
 static void NRI_CALL EmuCmdDrawIndexedIndirect(CommandBuffer& commandBuffer, const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset) {
+    ((CommandBufferEmuD3D11&)commandBuffer).GetStats().drawIndirectNum++;
     ((CommandBufferEmuD3D11&)commandBuffer).DrawIndexedIndirect(buffer, offset, drawNum, stride, countBuffer, countBufferOffset);
 }
 
@@ -602,18 +688,22 @@ static void NRI_CALL EmuCmdEndRendering(CommandBuffer& commandBuffer) {
 }
 
 static void NRI_CALL EmuCmdDispatch(CommandBuffer& commandBuffer, const DispatchDesc& dispatchDesc) {
+    ((CommandBufferEmuD3D11&)commandBuffer).GetStats().dispatchNum++;
     ((CommandBufferEmuD3D11&)commandBuffer).Dispatch(dispatchDesc);
 }
 
 static void NRI_CALL EmuCmdDispatchIndirect(CommandBuffer& commandBuffer, const Buffer& buffer, uint64_t offset) {
+    ((CommandBufferEmuD3D11&)commandBuffer).GetStats().dispatchNum++;
     ((CommandBufferEmuD3D11&)commandBuffer).DispatchIndirect(buffer, offset);
 }
 
 static void NRI_CALL EmuCmdCopyBuffer(CommandBuffer& commandBuffer, Buffer& dstBuffer, uint64_t dstOffset, const Buffer& srcBuffer, uint64_t srcOffset, uint64_t size) {
+    AccountBufferCopy(((CommandBufferEmuD3D11&)commandBuffer).GetStats(), ((BufferD3D11&)srcBuffer).GetDesc().size, srcOffset, size);
     ((CommandBufferEmuD3D11&)commandBuffer).CopyBuffer(dstBuffer, dstOffset, srcBuffer, srcOffset, size);
 }
 
 static void NRI_CALL EmuCmdCopyTexture(CommandBuffer& commandBuffer, Texture& dstTexture, const TextureRegionDesc* dstRegionDesc, const Texture& srcTexture, const TextureRegionDesc* srcRegionDesc) {
+    ((CommandBufferEmuD3D11&)commandBuffer).GetStats().copyNum++;
     ((CommandBufferEmuD3D11&)commandBuffer).CopyTexture(dstTexture, dstRegionDesc, srcTexture, srcRegionDesc);
 }
 
@@ -622,10 +712,12 @@ static void NRI_CALL EmuCmdResolveTexture(CommandBuffer& commandBuffer, Texture&
 }
 
 static void NRI_CALL EmuCmdUploadBufferToTexture(CommandBuffer& commandBuffer, Texture& dstTexture, const TextureRegionDesc& dstRegionDesc, const Buffer& srcBuffer, const TextureDataLayoutDesc& srcDataLayoutDesc) {
+    ((CommandBufferEmuD3D11&)commandBuffer).GetStats().copyNum++;
     ((CommandBufferEmuD3D11&)commandBuffer).UploadBufferToTexture(dstTexture, dstRegionDesc, srcBuffer, srcDataLayoutDesc);
 }
 
 static void NRI_CALL EmuCmdReadbackTextureToBuffer(CommandBuffer& commandBuffer, Buffer& dstBuffer, const TextureDataLayoutDesc& dstDataLayoutDesc, const Texture& srcTexture, const TextureRegionDesc& srcRegionDesc) {
+    ((CommandBufferEmuD3D11&)commandBuffer).GetStats().copyNum++;
     ((CommandBufferEmuD3D11&)commandBuffer).ReadbackTextureToBuffer(dstBuffer, dstDataLayoutDesc, srcTexture, srcRegionDesc);
 }
 
@@ -657,10 +749,17 @@ static void NRI_CALL EmuCmdBeginAnnotation(CommandBuffer& commandBuffer, const c
 #if NRI_ENABLE_DEBUG_NAMES_AND_ANNOTATIONS
     ((CommandBufferEmuD3D11&)commandBuffer).BeginAnnotation(name, bgra);
 #endif
+
+    ProfilerImpl* profiler = ((CommandBufferEmuD3D11&)commandBuffer).GetDevice().GetAnnotationProfiler();
+    if (profiler)
+        profiler->BeginZone(commandBuffer, ((CommandBufferEmuD3D11&)commandBuffer).GetProfilerZoneState(), name);
 }
 
 static void NRI_CALL EmuCmdEndAnnotation(CommandBuffer& commandBuffer) {
-    MaybeUnused(commandBuffer);
+    ProfilerImpl* profiler = ((CommandBufferEmuD3D11&)commandBuffer).GetDevice().GetAnnotationProfiler();
+    if (profiler)
+        profiler->EndZone(commandBuffer, ((CommandBufferEmuD3D11&)commandBuffer).GetProfilerZoneState());
+
 #if NRI_ENABLE_DEBUG_NAMES_AND_ANNOTATIONS
     ((CommandBufferEmuD3D11&)commandBuffer).EndAnnotation();
 #endif
@@ -698,6 +797,7 @@ Result DeviceD3D11::FillFunctionTable(CoreInterface& table) const {
     table.GetQueue = ::GetQueue;
     table.CreateCommandAllocator = ::CreateCommandAllocator;
     table.CreateCommandBuffer = ::CreateCommandBuffer;
+    table.CreateSecondaryCommandBuffer = ::CreateSecondaryCommandBuffer;
     table.CreateDescriptorPool = ::CreateDescriptorPool;
     table.CreateBuffer = ::CreateBuffer;
     table.CreateTexture = ::CreateTexture;
@@ -730,8 +830,12 @@ Result DeviceD3D11::FillFunctionTable(CoreInterface& table) const {
     table.QueueAnnotation = ::QueueAnnotation;
     table.ResetQueries = ::ResetQueries;
     table.QueueSubmit = ::QueueSubmit;
+    table.QueueSubmitBatch = ::QueueSubmitBatch;
     table.Wait = ::Wait;
+    table.WaitMany = ::WaitMany;
     table.GetFenceValue = ::GetFenceValue;
+    table.WaitWithPolicy = ::WaitWithPolicy;
+    table.GetFenceWaitStats = ::GetFenceWaitStats;
     table.UpdateDescriptorRanges = ::UpdateDescriptorRanges;
     table.UpdateDynamicConstantBuffers = ::UpdateDynamicConstantBuffers;
     table.CopyDescriptorSet = ::CopyDescriptorSet;
@@ -740,6 +844,10 @@ Result DeviceD3D11::FillFunctionTable(CoreInterface& table) const {
     table.ResetCommandAllocator = ::ResetCommandAllocator;
     table.MapBuffer = ::MapBuffer;
     table.UnmapBuffer = ::UnmapBuffer;
+    table.MapBufferWithMode = ::MapBufferWithMode;
+    table.FlushBufferRanges = ::FlushBufferRanges;
+    table.InvalidateBufferRanges = ::InvalidateBufferRanges;
+    table.GetMappedMemoryStats = ::GetMappedMemoryStats;
     table.SetDebugName = ::SetDebugName;
     table.GetDeviceNativeObject = ::GetDeviceNativeObject;
     table.GetQueueNativeObject = ::GetQueueNativeObject;
@@ -749,6 +857,7 @@ Result DeviceD3D11::FillFunctionTable(CoreInterface& table) const {
 
     if (m_IsDeferredContextEmulated) {
         table.BeginCommandBuffer = ::EmuBeginCommandBuffer;
+        table.BeginSecondaryCommandBuffer = ::BeginSecondaryCommandBuffer;
         table.CmdSetDescriptorPool = ::EmuCmdSetDescriptorPool;
         table.CmdSetDescriptorSet = ::EmuCmdSetDescriptorSet;
         table.CmdSetPipelineLayout = ::EmuCmdSetPipelineLayout;
@@ -772,6 +881,7 @@ Result DeviceD3D11::FillFunctionTable(CoreInterface& table) const {
         table.CmdDrawIndexed = ::EmuCmdDrawIndexed;
         table.CmdDrawIndirect = ::EmuCmdDrawIndirect;
         table.CmdDrawIndexedIndirect = ::EmuCmdDrawIndexedIndirect;
+        table.CmdExecuteCommandBuffers = ::CmdExecuteCommandBuffers;
         table.CmdEndRendering = ::EmuCmdEndRendering;
         table.CmdDispatch = ::EmuCmdDispatch;
         table.CmdDispatchIndirect = ::EmuCmdDispatchIndirect;
@@ -793,6 +903,7 @@ Result DeviceD3D11::FillFunctionTable(CoreInterface& table) const {
         table.GetCommandBufferNativeObject = ::EmuGetCommandBufferNativeObject;
     } else {
         table.BeginCommandBuffer = ::BeginCommandBuffer;
+        table.BeginSecondaryCommandBuffer = ::BeginSecondaryCommandBuffer;
         table.CmdSetDescriptorPool = ::CmdSetDescriptorPool;
         table.CmdSetDescriptorSet = ::CmdSetDescriptorSet;
         table.CmdSetPipelineLayout = ::CmdSetPipelineLayout;
@@ -816,6 +927,7 @@ Result DeviceD3D11::FillFunctionTable(CoreInterface& table) const {
         table.CmdDrawIndexed = ::CmdDrawIndexed;
         table.CmdDrawIndirect = ::CmdDrawIndirect;
         table.CmdDrawIndexedIndirect = ::CmdDrawIndexedIndirect;
+        table.CmdExecuteCommandBuffers = ::CmdExecuteCommandBuffers;
         table.CmdEndRendering = ::CmdEndRendering;
         table.CmdDispatch = ::CmdDispatch;
         table.CmdDispatchIndirect = ::CmdDispatchIndirect;
@@ -842,6 +954,106 @@ Result DeviceD3D11::FillFunctionTable(CoreInterface& table) const {
 
 #pragma endregion
 
+//============================================================================================================================================================================================
+#pragma region[  CommandBufferPool  ]
+
+static Result CreateCommandBufferPool(Device& device, const CommandBufferPoolDesc& commandBufferPoolDesc, CommandBufferPool*& commandBufferPool) {
+    DeviceD3D11& deviceD3D11 = (DeviceD3D11&)device;
+    CommandBufferPoolImpl* impl = Allocate<CommandBufferPoolImpl>(deviceD3D11.GetAllocationCallbacks(), device, deviceD3D11.GetCoreInterface());
+    Result result = impl->Create(commandBufferPoolDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceD3D11.GetAllocationCallbacks(), impl);
+        commandBufferPool = nullptr;
+    } else
+        commandBufferPool = (CommandBufferPool*)impl;
+
+    return result;
+}
+
+static void DestroyCommandBufferPool(CommandBufferPool& commandBufferPool) {
+    Destroy(((DeviceBase&)((CommandBufferPoolImpl&)commandBufferPool).GetDevice()).GetAllocationCallbacks(), (CommandBufferPoolImpl*)&commandBufferPool);
+}
+
+static void BeginCommandBufferPoolFrame(CommandBufferPool& commandBufferPool) {
+    ((CommandBufferPoolImpl&)commandBufferPool).BeginFrame();
+}
+
+static void EndCommandBufferPoolFrame(CommandBufferPool& commandBufferPool, Fence& fence, uint64_t value) {
+    ((CommandBufferPoolImpl&)commandBufferPool).EndFrame(fence, value);
+}
+
+static Result AcquireCommandBuffer(CommandBufferPool& commandBufferPool, uint32_t threadIndex, CommandBuffer*& commandBuffer) {
+    return ((CommandBufferPoolImpl&)commandBufferPool).AcquireCommandBuffer(threadIndex, commandBuffer);
+}
+
+static void GetCommandBufferPoolStats(const CommandBufferPool& commandBufferPool, CommandBufferPoolStats& commandBufferPoolStats) {
+    ((const CommandBufferPoolImpl&)commandBufferPool).GetStats(commandBufferPoolStats);
+}
+
+Result DeviceD3D11::FillFunctionTable(CommandBufferPoolInterface& table) const {
+    table.CreateCommandBufferPool = ::CreateCommandBufferPool;
+    table.DestroyCommandBufferPool = ::DestroyCommandBufferPool;
+    table.BeginCommandBufferPoolFrame = ::BeginCommandBufferPoolFrame;
+    table.EndCommandBufferPoolFrame = ::EndCommandBufferPoolFrame;
+    table.AcquireCommandBuffer = ::AcquireCommandBuffer;
+    table.GetCommandBufferPoolStats = ::GetCommandBufferPoolStats;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
+//============================================================================================================================================================================================
+#pragma region[  DeferredRelease  ]
+
+static Result CreateDeferredReleaseQueue(Device& device, const DeferredReleaseQueueDesc& deferredReleaseQueueDesc, DeferredReleaseQueue*& deferredReleaseQueue) {
+    DeviceD3D11& deviceD3D11 = (DeviceD3D11&)device;
+    DeferredReleaseQueueImpl* impl = Allocate<DeferredReleaseQueueImpl>(deviceD3D11.GetAllocationCallbacks(), device, deviceD3D11.GetCoreInterface());
+    Result result = impl->Create(deferredReleaseQueueDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceD3D11.GetAllocationCallbacks(), impl);
+        deferredReleaseQueue = nullptr;
+    } else
+        deferredReleaseQueue = (DeferredReleaseQueue*)impl;
+
+    return result;
+}
+
+static void DestroyDeferredReleaseQueue(DeferredReleaseQueue& deferredReleaseQueue) {
+    Destroy(((DeviceBase&)((DeferredReleaseQueueImpl&)deferredReleaseQueue).GetDevice()).GetAllocationCallbacks(), (DeferredReleaseQueueImpl*)&deferredReleaseQueue);
+}
+
+static void DeferRelease(DeferredReleaseQueue& deferredReleaseQueue, Fence& fence, uint64_t value, DeferredReleaseType type, Object* object) {
+    ((DeferredReleaseQueueImpl&)deferredReleaseQueue).DeferRelease(fence, value, type, object);
+}
+
+static void DeferCallback(DeferredReleaseQueue& deferredReleaseQueue, Fence& fence, uint64_t value, const DeferredReleaseCallback& callback) {
+    ((DeferredReleaseQueueImpl&)deferredReleaseQueue).DeferCallback(fence, value, callback);
+}
+
+static uint32_t DrainDeferredReleases(DeferredReleaseQueue& deferredReleaseQueue) {
+    return ((DeferredReleaseQueueImpl&)deferredReleaseQueue).Drain();
+}
+
+static void GetDeferredReleaseQueueStats(const DeferredReleaseQueue& deferredReleaseQueue, DeferredReleaseQueueStats& deferredReleaseQueueStats) {
+    ((const DeferredReleaseQueueImpl&)deferredReleaseQueue).GetStats(deferredReleaseQueueStats);
+}
+
+Result DeviceD3D11::FillFunctionTable(DeferredReleaseInterface& table) const {
+    table.CreateDeferredReleaseQueue = ::CreateDeferredReleaseQueue;
+    table.DestroyDeferredReleaseQueue = ::DestroyDeferredReleaseQueue;
+    table.DeferRelease = ::DeferRelease;
+    table.DeferCallback = ::DeferCallback;
+    table.DrainDeferredReleases = ::DrainDeferredReleases;
+    table.GetDeferredReleaseQueueStats = ::GetDeferredReleaseQueueStats;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
 //============================================================================================================================================================================================
 #pragma region[  Helper  ]
 
@@ -876,12 +1088,61 @@ static Result NRI_CALL QueryVideoMemoryInfo(const Device& device, MemoryLocation
     return QueryVideoMemoryInfoDXGI(luid, memoryLocation, videoMemoryInfo);
 }
 
+static Result NRI_CALL SetBudgetMonitor(Device& device, const BudgetMonitorDesc& budgetMonitorDesc) {
+    return ((DeviceD3D11&)device).GetBudgetMonitor().Start(device, ::QueryVideoMemoryInfo, budgetMonitorDesc);
+}
+
+static Result NRI_CALL GetTrackedVideoMemoryInfo(const Device& device, MemoryLocation memoryLocation, VideoMemoryInfo& videoMemoryInfo) {
+    return ((DeviceD3D11&)device).GetBudgetMonitor().GetInfo(memoryLocation, videoMemoryInfo);
+}
+
+static void NRI_CALL GetObjectPoolStats(const Device& device, ObjectPoolType objectPoolType, ObjectPoolStats& objectPoolStats) {
+    ((DeviceD3D11&)device).GetObjectPool(objectPoolType).GetStats(objectPoolStats);
+}
+
+static Result NRI_CALL GetAllocationStats(const Device& device, AllocationCategory allocationCategory, AllocationStats& allocationStats) {
+    const AllocationTracker& allocationTracker = ((DeviceD3D11&)device).GetAllocationTracker();
+    if (!allocationTracker.IsEnabled()) {
+        allocationStats = {};
+        return Result::UNSUPPORTED;
+    }
+
+    allocationTracker.GetStats(allocationCategory, allocationStats);
+
+    return Result::SUCCESS;
+}
+
+static void NRI_CALL ResetAllocationStats(Device& device) {
+    ((DeviceD3D11&)device).GetAllocationTracker().ResetStats();
+}
+
+static void NRI_CALL GetMemoryDescCacheStats(const Device&, MemoryDescCacheStats& memoryDescCacheStats) {
+    memoryDescCacheStats = {};
+}
+
+static Result NRI_CALL GetDescriptorCacheStats(const Device&, DescriptorCacheStats& descriptorCacheStats) {
+    descriptorCacheStats = {};
+    return Result::UNSUPPORTED;
+}
+
+static void NRI_CALL GetCommandBufferStats(const CommandBuffer& commandBuffer, CommandBufferStats& commandBufferStats) {
+    commandBufferStats = ((CommandBufferBase&)commandBuffer).GetStats();
+}
+
 Result DeviceD3D11::FillFunctionTable(HelperInterface& table) const {
     table.CalculateAllocationNumber = ::CalculateAllocationNumber;
     table.AllocateAndBindMemory = ::AllocateAndBindMemory;
     table.UploadData = ::UploadData;
     table.WaitForIdle = ::WaitForIdle;
     table.QueryVideoMemoryInfo = ::QueryVideoMemoryInfo;
+    table.SetBudgetMonitor = ::SetBudgetMonitor;
+    table.GetTrackedVideoMemoryInfo = ::GetTrackedVideoMemoryInfo;
+    table.GetObjectPoolStats = ::GetObjectPoolStats;
+    table.GetAllocationStats = ::GetAllocationStats;
+    table.ResetAllocationStats = ::ResetAllocationStats;
+    table.GetMemoryDescCacheStats = ::GetMemoryDescCacheStats;
+    table.GetDescriptorCacheStats = ::GetDescriptorCacheStats;
+    table.GetCommandBufferStats = ::GetCommandBufferStats;
 
     return Result::SUCCESS;
 }
@@ -908,7 +1169,7 @@ static Result GetLatencyReport(const SwapChain& swapChain, LatencyReport& latenc
 }
 
 static void NRI_CALL QueueSubmitTrackable(Queue& queue, const QueueSubmitDesc& workSubmissionDesc, const SwapChain&) {
-    ((QueueD3D11&)queue).Submit(workSubmissionDesc);
+    ((QueueD3D11&)queue).Submit(&workSubmissionDesc, 1);
 }
 
 Result DeviceD3D11::FillFunctionTable(LowLatencyInterface& table) const {
@@ -926,6 +1187,66 @@ Result DeviceD3D11::FillFunctionTable(LowLatencyInterface& table) const {
 
 #pragma endregion
 
+//============================================================================================================================================================================================
+#pragma region[  Profiler  ]
+
+static Result CreateProfiler(Device& device, const ProfilerDesc& profilerDesc, Profiler*& profiler) {
+    DeviceD3D11& deviceD3D11 = (DeviceD3D11&)device;
+    ProfilerImpl* impl = Allocate<ProfilerImpl>(deviceD3D11.GetAllocationCallbacks(), device, deviceD3D11.GetCoreInterface());
+    Result result = impl->Create(profilerDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceD3D11.GetAllocationCallbacks(), impl);
+        profiler = nullptr;
+    } else
+        profiler = (Profiler*)impl;
+
+    return result;
+}
+
+static void DestroyProfiler(Profiler& profiler) {
+    Destroy(((DeviceBase&)((ProfilerImpl&)profiler).GetDevice()).GetAllocationCallbacks(), (ProfilerImpl*)&profiler);
+}
+
+static void BeginProfilerFrame(Profiler& profiler) {
+    ((ProfilerImpl&)profiler).BeginFrame();
+}
+
+static void EndProfilerFrame(Profiler& profiler, Fence& fence, uint64_t value) {
+    ((ProfilerImpl&)profiler).EndFrame(fence, value);
+}
+
+static void CmdBeginProfilerZone(Profiler& profiler, CommandBuffer& commandBuffer, const char* name) {
+    ((ProfilerImpl&)profiler).BeginZone(commandBuffer, ((CommandBufferBase&)commandBuffer).GetProfilerZoneState(), name);
+}
+
+static void CmdEndProfilerZone(Profiler& profiler, CommandBuffer& commandBuffer) {
+    ((ProfilerImpl&)profiler).EndZone(commandBuffer, ((CommandBufferBase&)commandBuffer).GetProfilerZoneState());
+}
+
+static void CmdResolveProfilerFrame(Profiler& profiler, CommandBuffer& commandBuffer) {
+    ((ProfilerImpl&)profiler).ResolveFrame(commandBuffer);
+}
+
+static void GetProfilerFrame(const Profiler& profiler, ProfilerFrame& profilerFrame) {
+    ((const ProfilerImpl&)profiler).GetFrame(profilerFrame);
+}
+
+Result DeviceD3D11::FillFunctionTable(ProfilerInterface& table) const {
+    table.CreateProfiler = ::CreateProfiler;
+    table.DestroyProfiler = ::DestroyProfiler;
+    table.BeginProfilerFrame = ::BeginProfilerFrame;
+    table.EndProfilerFrame = ::EndProfilerFrame;
+    table.CmdBeginProfilerZone = ::CmdBeginProfilerZone;
+    table.CmdEndProfilerZone = ::CmdEndProfilerZone;
+    table.CmdResolveProfilerFrame = ::CmdResolveProfilerFrame;
+    table.GetProfilerFrame = ::GetProfilerFrame;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
 //============================================================================================================================================================================================
 #pragma region[  ResourceAllocator  ]
 
@@ -961,10 +1282,57 @@ static Result AllocateAccelerationStructure(Device&, const AllocateAccelerationS
     return Result::UNSUPPORTED;
 }
 
+static Result CreateAllocatorPool(Device&, const AllocatorPoolDesc&, AllocatorPool*& allocatorPool) {
+    allocatorPool = nullptr;
+
+    return Result::UNSUPPORTED;
+}
+
+static void DestroyAllocatorPool(AllocatorPool&) {
+}
+
+static Result GetAllocatorStats(Device&, MemoryLocation, AllocatorStats& allocatorStats) {
+    allocatorStats = {};
+
+    return Result::UNSUPPORTED;
+}
+
+static void GetAllocatorPoolStats(const AllocatorPool&, AllocatorStats& allocatorStats) {
+    allocatorStats = {};
+}
+
+static Result BeginDefragmentation(Device&, const DefragmentationDesc&, Defragmentation*& defragmentation) {
+    defragmentation = nullptr;
+
+    return Result::UNSUPPORTED;
+}
+
+static Result GetDefragmentationPass(Defragmentation&, DefragmentationPass& defragmentationPass) {
+    defragmentationPass = {};
+
+    return Result::UNSUPPORTED;
+}
+
+static Result EndDefragmentationPass(Defragmentation&) {
+    return Result::UNSUPPORTED;
+}
+
+static void EndDefragmentation(Defragmentation&, DefragmentationStats& defragmentationStats) {
+    defragmentationStats = {};
+}
+
 Result DeviceD3D11::FillFunctionTable(ResourceAllocatorInterface& table) const {
     table.AllocateBuffer = ::AllocateBuffer;
     table.AllocateTexture = ::AllocateTexture;
     table.AllocateAccelerationStructure = ::AllocateAccelerationStructure;
+    table.CreateAllocatorPool = ::CreateAllocatorPool;
+    table.DestroyAllocatorPool = ::DestroyAllocatorPool;
+    table.GetAllocatorStats = ::GetAllocatorStats;
+    table.GetAllocatorPoolStats = ::GetAllocatorPoolStats;
+    table.BeginDefragmentation = ::BeginDefragmentation;
+    table.GetDefragmentationPass = ::GetDefragmentationPass;
+    table.EndDefragmentationPass = ::EndDefragmentationPass;
+    table.EndDefragmentation = ::EndDefragmentation;
 
     return Result::SUCCESS;
 }
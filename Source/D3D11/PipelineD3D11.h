@@ -73,3 +73,5 @@ private:
 };
 
 } // namespace nri
+
+NRI_ALLOCATION_CATEGORY(nri::PipelineD3D11, PIPELINE);
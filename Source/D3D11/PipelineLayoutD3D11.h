@@ -69,3 +69,5 @@ private:
 };
 
 } // namespace nri
+
+NRI_ALLOCATION_CATEGORY(nri::PipelineLayoutD3D11, PIPELINE);
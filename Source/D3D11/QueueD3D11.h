@@ -20,7 +20,7 @@ struct QueueD3D11 final : public DebugNameBase {
     // NRI
     //================================================================================================================
 
-    void Submit(const QueueSubmitDesc& queueSubmitDesc);
+    void Submit(const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum);
     Result UploadData(const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum);
     Result WaitForIdle();
 
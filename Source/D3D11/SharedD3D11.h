@@ -148,10 +148,22 @@ struct CommandBufferBase : public DebugNameBase {
     virtual ~CommandBufferBase() {
     }
 
+    inline CommandBufferStats& GetStats() {
+        return m_Stats;
+    }
+
+    inline ProfilerZoneState& GetProfilerZoneState() {
+        return m_ProfilerZoneState;
+    }
+
     virtual Result Create(ID3D11DeviceContext* precreatedContext) = 0;
     virtual void Submit() = 0;
     virtual ID3D11DeviceContext* GetNativeObject() const = 0;
     virtual const AllocationCallbacks& GetAllocationCallbacks() const = 0;
+
+protected:
+    CommandBufferStats m_Stats = {};
+    ProfilerZoneState m_ProfilerZoneState;
 };
 
 static inline uint64_t ComputeHash(const void* key, uint32_t len) {
@@ -187,6 +199,8 @@ struct SamplePositionsState {
 
 } // namespace nri
 
+NRI_ALLOCATION_CATEGORY(nri::CommandBufferBase, COMMAND_BUFFER);
+
 #if NRI_ENABLE_D3D_EXTENSIONS
 #    include "amd_ags.h"
 #    include "nvShaderExtnEnums.h"
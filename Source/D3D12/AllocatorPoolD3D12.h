@@ -0,0 +1,41 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+struct AllocatorPoolD3D12 final : public DebugNameBase {
+    inline AllocatorPoolD3D12(DeviceD3D12& device)
+        : m_Device(device) {
+    }
+
+    inline D3D12MA::Pool* GetPool() const {
+        return m_Pool;
+    }
+
+    inline DeviceD3D12& GetDevice() const {
+        return m_Device;
+    }
+
+    inline const AllocatorPoolDesc& GetDesc() const {
+        return m_Desc;
+    }
+
+    ~AllocatorPoolD3D12();
+
+    Result Create(const AllocatorPoolDesc& allocatorPoolDesc);
+    void GetStats(AllocatorStats& allocatorStats) const;
+
+    //================================================================================================================
+    // DebugNameBase
+    //================================================================================================================
+
+    void SetDebugName(const char* name) DEBUG_NAME_OVERRIDE;
+
+private:
+    DeviceD3D12& m_Device;
+    D3D12MA::Pool* m_Pool = nullptr;
+    AllocatorPoolDesc m_Desc = {};
+};
+
+} // namespace nri
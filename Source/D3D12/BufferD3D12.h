@@ -38,10 +38,16 @@ struct BufferD3D12 final : public DebugNameBase {
         return m_Device;
     }
 
+    inline D3D12MA::Allocation* GetVmaAllocation() const {
+        return m_VmaAllocation.GetInterface();
+    }
+
     Result Create(const BufferDesc& bufferDesc);
     Result Create(const BufferD3D12Desc& bufferDesc);
     Result Create(const AllocateBufferDesc& bufferDesc);
     Result BindMemory(const MemoryD3D12* memory, uint64_t offset);
+    Result BindDefragmentationTarget(D3D12MA::Allocation* allocation);
+    void FinishDefragmentationMove();
 
     //================================================================================================================
     // DebugNameBase
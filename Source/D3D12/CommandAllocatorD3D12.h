@@ -37,13 +37,16 @@ struct CommandAllocatorD3D12 final : public DebugNameBase {
     // NRI
     //================================================================================================================
 
-    Result CreateCommandBuffer(CommandBuffer*& commandBuffer);
+    Result CreateCommandBuffer(CommandBuffer*& commandBuffer, bool isSecondary);
     void Reset();
 
 private:
     DeviceD3D12& m_Device;
     ComPtr<ID3D12CommandAllocator> m_CommandAllocator;
+    ComPtr<ID3D12CommandAllocator> m_BundleAllocator; // created on demand
     D3D12_COMMAND_LIST_TYPE m_CommandListType = D3D12_COMMAND_LIST_TYPE(-1);
 };
 
 } // namespace nri
+
+NRI_ALLOCATION_CATEGORY(nri::CommandAllocatorD3D12, COMMAND_BUFFER);
@@ -9,20 +9,29 @@ Result CommandAllocatorD3D12::Create(const Queue& queue) {
     return Result::SUCCESS;
 }
 
-NRI_INLINE Result CommandAllocatorD3D12::CreateCommandBuffer(CommandBuffer*& commandBuffer) {
-    CommandBufferD3D12* commandBufferD3D12 = Allocate<CommandBufferD3D12>(m_Device.GetAllocationCallbacks(), m_Device);
-    const Result result = commandBufferD3D12->Create(m_CommandListType, m_CommandAllocator);
+NRI_INLINE Result CommandAllocatorD3D12::CreateCommandBuffer(CommandBuffer*& commandBuffer, bool isSecondary) {
+    // Secondary command buffers are bundles, which require a dedicated allocator
+    if (isSecondary && !m_BundleAllocator) {
+        HRESULT hr = m_Device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_BUNDLE, IID_PPV_ARGS(&m_BundleAllocator));
+        RETURN_ON_BAD_HRESULT(&m_Device, hr, "ID3D12Device::CreateCommandAllocator()");
+    }
+
+    CommandBufferD3D12* commandBufferD3D12 = AllocateObject<CommandBufferD3D12>(m_Device, m_Device);
+    const Result result = isSecondary ? commandBufferD3D12->Create(D3D12_COMMAND_LIST_TYPE_BUNDLE, m_BundleAllocator) : commandBufferD3D12->Create(m_CommandListType, m_CommandAllocator);
 
     if (result == Result::SUCCESS) {
         commandBuffer = (CommandBuffer*)commandBufferD3D12;
         return Result::SUCCESS;
     }
 
-    Destroy(m_Device.GetAllocationCallbacks(), commandBufferD3D12);
+    Destroy(commandBufferD3D12);
 
     return result;
 }
 
 NRI_INLINE void CommandAllocatorD3D12::Reset() {
     m_CommandAllocator->Reset();
+
+    if (m_BundleAllocator)
+        m_BundleAllocator->Reset();
 }
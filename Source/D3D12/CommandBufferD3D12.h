@@ -35,6 +35,14 @@ struct CommandBufferD3D12 final : public DebugNameBase {
         return m_Device;
     }
 
+    inline CommandBufferStats& GetStats() {
+        return m_Stats;
+    }
+
+    inline ProfilerZoneState& GetProfilerZoneState() {
+        return m_ProfilerZoneState;
+    }
+
     inline void ResetAttachments() {
         m_RenderTargetNum = 0;
         for (size_t i = 0; i < m_RenderTargets.size(); i++)
@@ -59,6 +67,7 @@ struct CommandBufferD3D12 final : public DebugNameBase {
     //================================================================================================================
 
     Result Begin(const DescriptorPool* descriptorPool);
+    Result BeginSecondary(const DescriptorPool* descriptorPool, const InheritanceDesc& inheritanceDesc);
     Result End();
     void SetViewports(const Viewport* viewports, uint32_t viewportNum);
     void SetScissors(const Rect* rects, uint32_t rectNum);
@@ -84,6 +93,7 @@ struct CommandBufferD3D12 final : public DebugNameBase {
     void DrawIndexed(const DrawIndexedDesc& drawIndexedDesc);
     void DrawIndirect(const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset);
     void DrawIndexedIndirect(const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset);
+    void ExecuteCommandBuffers(const CommandBuffer* const* commandBuffers, uint32_t commandBufferNum);
     void CopyBuffer(Buffer& dstBuffer, uint64_t dstOffset, const Buffer& srcBuffer, uint64_t srcOffset, uint64_t size);
     void CopyTexture(Texture& dstTexture, const TextureRegionDesc* dstRegionDesc, const Texture& srcTexture, const TextureRegionDesc* srcRegionDesc);
     void ResolveTexture(Texture& dstTexture, const TextureRegionDesc* dstRegionDesc, const Texture& srcTexture, const TextureRegionDesc* srcRegionDesc);
@@ -119,9 +129,15 @@ private:
     const PipelineLayoutD3D12* m_PipelineLayout = nullptr;
     PipelineD3D12* m_Pipeline = nullptr;
     D3D12_PRIMITIVE_TOPOLOGY m_PrimitiveTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+    CommandBufferStats m_Stats = {};
+    ProfilerZoneState m_ProfilerZoneState;
     uint32_t m_RenderTargetNum = 0;
     uint8_t m_Version = 0;
     bool m_IsGraphicsPipelineLayout = false;
+    bool m_IsBundle = false;
 };
 
 } // namespace nri
+
+NRI_OBJECT_POOL(nri::CommandBufferD3D12, COMMAND_BUFFER);
+NRI_ALLOCATION_CATEGORY(nri::CommandBufferD3D12, COMMAND_BUFFER);
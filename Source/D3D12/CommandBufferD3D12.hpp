@@ -245,6 +245,7 @@ Result CommandBufferD3D12::Create(D3D12_COMMAND_LIST_TYPE commandListType, ID3D1
     RETURN_ON_BAD_HRESULT(&m_Device, hr, "ID3D12GraphicsCommandList::Close()");
 
     m_CommandAllocator = commandAllocator;
+    m_IsBundle = commandListType == D3D12_COMMAND_LIST_TYPE_BUNDLE;
 
     return Result::SUCCESS;
 }
@@ -277,6 +278,11 @@ NRI_INLINE Result CommandBufferD3D12::Begin(const DescriptorPool* descriptorPool
     return Result::SUCCESS;
 }
 
+NRI_INLINE Result CommandBufferD3D12::BeginSecondary(const DescriptorPool* descriptorPool, const InheritanceDesc&) {
+    // Bundles inherit render targets from the primary command list, nothing to do with "inheritanceDesc"
+    return Begin(descriptorPool);
+}
+
 NRI_INLINE Result CommandBufferD3D12::End() {
     if (FAILED(m_GraphicsCommandList->Close()))
         return Result::FAILURE;
@@ -285,6 +291,9 @@ NRI_INLINE Result CommandBufferD3D12::End() {
 }
 
 NRI_INLINE void CommandBufferD3D12::SetViewports(const Viewport* viewports, uint32_t viewportNum) {
+    if (m_IsBundle) // inherited
+        return;
+
     Scratch<D3D12_VIEWPORT> d3dViewports = AllocateScratch(m_Device, D3D12_VIEWPORT, viewportNum);
     for (uint32_t i = 0; i < viewportNum; i++) {
         const Viewport& in = viewports[i];
@@ -307,6 +316,9 @@ NRI_INLINE void CommandBufferD3D12::SetViewports(const Viewport* viewports, uint
 }
 
 NRI_INLINE void CommandBufferD3D12::SetScissors(const Rect* rects, uint32_t rectNum) {
+    if (m_IsBundle) // inherited
+        return;
+
     Scratch<D3D12_RECT> d3dRects = AllocateScratch(m_Device, D3D12_RECT, rectNum);
     ConvertRects(rects, rectNum, d3dRects);
 
@@ -358,7 +370,8 @@ NRI_INLINE void CommandBufferD3D12::SetDepthBias(const DepthBiasDesc& depthBiasD
 }
 
 NRI_INLINE void CommandBufferD3D12::ClearAttachments(const ClearDesc* clearDescs, uint32_t clearDescNum, const Rect* rects, uint32_t rectNum) {
-    if (!clearDescNum)
+    // Not allowed in bundles (see "InheritanceDesc")
+    if (!clearDescNum || m_IsBundle)
         return;
 
     Scratch<D3D12_RECT> d3dRects = AllocateScratch(m_Device, D3D12_RECT, rectNum);
@@ -573,6 +586,17 @@ NRI_INLINE void CommandBufferD3D12::DrawIndexedIndirect(const Buffer& buffer, ui
     m_GraphicsCommandList->ExecuteIndirect(m_Device.GetDrawIndexedCommandSignature(stride, *m_PipelineLayout), drawNum, (BufferD3D12&)buffer, offset, pCountBuffer, countBufferOffset);
 }
 
+NRI_INLINE void CommandBufferD3D12::ExecuteCommandBuffers(const CommandBuffer* const* commandBuffers, uint32_t commandBufferNum) {
+    for (uint32_t i = 0; i < commandBufferNum; i++)
+        m_GraphicsCommandList->ExecuteBundle(*(CommandBufferD3D12*)commandBuffers[i]);
+
+    // Bundles leak their state into the primary command list, but it's not tracked here
+    m_PipelineLayout = nullptr;
+    m_IsGraphicsPipelineLayout = false;
+    m_Pipeline = nullptr;
+    m_PrimitiveTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+}
+
 NRI_INLINE void CommandBufferD3D12::CopyBuffer(Buffer& dstBuffer, uint64_t dstOffset, const Buffer& srcBuffer, uint64_t srcOffset, uint64_t size) {
     if (size == WHOLE_SIZE)
         size = ((BufferD3D12&)srcBuffer).GetDesc().size;
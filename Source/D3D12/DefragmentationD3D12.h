@@ -0,0 +1,34 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+struct DefragmentationD3D12 final : public DebugNameBase {
+    inline DefragmentationD3D12(DeviceD3D12& device)
+        : m_Device(device)
+        , m_Resources(device.GetStdAllocator())
+        , m_Moves(device.GetStdAllocator()) {
+    }
+
+    inline DeviceD3D12& GetDevice() const {
+        return m_Device;
+    }
+
+    ~DefragmentationD3D12();
+
+    Result Create(const DefragmentationDesc& defragmentationDesc);
+    Result GetPass(DefragmentationPass& defragmentationPass);
+    Result EndPass();
+    void End(DefragmentationStats& defragmentationStats);
+
+private:
+    DeviceD3D12& m_Device;
+    UnorderedMap<D3D12MA::Allocation*, DefragmentationMove> m_Resources; // only "src" is set
+    Vector<DefragmentationMove> m_Moves;                                  // the current pass
+    D3D12MA::DefragmentationContext* m_Context = nullptr;
+    D3D12MA::DEFRAGMENTATION_MOVE* m_VmaMoves = nullptr; // owned by D3D12MA, "nullptr" if there is no pass in progress
+    uint32_t m_VmaMoveNum = 0;
+};
+
+} // namespace nri
@@ -65,3 +65,6 @@ private:
 };
 
 } // namespace nri
+
+NRI_OBJECT_POOL(nri::DescriptorD3D12, DESCRIPTOR);
+NRI_ALLOCATION_CATEGORY(nri::DescriptorD3D12, DESCRIPTOR);
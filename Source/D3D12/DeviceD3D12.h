@@ -45,6 +45,10 @@ struct DeviceD3D12 final : public DeviceBase {
         return m_CoreInterface;
     }
 
+    inline const MemoryDescCache& GetMemoryDescCache() const {
+        return m_MemoryDescCache;
+    }
+
     inline D3D12MA::Allocator* GetVma() const {
         return m_Vma;
     }
@@ -84,11 +88,13 @@ struct DeviceD3D12 final : public DeviceBase {
 
     template <typename Implementation, typename Interface, typename... Args>
     inline Result CreateImplementation(Interface*& entity, const Args&... args) {
-        Implementation* impl = Allocate<Implementation>(GetAllocationCallbacks(), *this);
+        AllocationCategoryScope allocationCategoryScope(AllocationCategoryTraits<Implementation>::category);
+
+        Implementation* impl = AllocateObject<Implementation>(*this, *this);
         Result result = impl->Create(args...);
 
         if (result != Result::SUCCESS) {
-            Destroy(GetAllocationCallbacks(), impl);
+            DestroyObject(*this, impl);
             entity = nullptr;
         } else
             entity = (Interface*)impl;
@@ -102,6 +108,8 @@ struct DeviceD3D12 final : public DeviceBase {
     Result GetDescriptorHandle(D3D12_DESCRIPTOR_HEAP_TYPE type, DescriptorHandle& descriptorHandle);
     DescriptorPointerCPU GetDescriptorPointerCPU(const DescriptorHandle& descriptorHandle);
     void GetMemoryDesc(MemoryLocation memoryLocation, const D3D12_RESOURCE_DESC& resourceDesc, MemoryDesc& memoryDesc) const;
+    void GetMemoryDesc2(const BufferDesc& bufferDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) const;
+    void GetMemoryDesc2(const TextureDesc& textureDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) const;
     void GetMemoryDesc(const AccelerationStructureDesc& accelerationStructureDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc);
     void GetAccelerationStructurePrebuildInfo(const AccelerationStructureDesc& accelerationStructureDesc, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO& prebuildInfo);
     ID3D12CommandSignature* GetDrawCommandSignature(uint32_t stride, ID3D12RootSignature* rootSignature);
@@ -110,6 +118,7 @@ struct DeviceD3D12 final : public DeviceBase {
     ID3D12CommandSignature* GetDispatchRaysCommandSignature() const;
     ID3D12CommandSignature* GetDispatchCommandSignature() const;
     Result CreateVma();
+    Result GetAllocatorStats(MemoryLocation memoryLocation, AllocatorStats& allocatorStats);
 
     //================================================================================================================
     // DebugNameBase
@@ -129,9 +138,12 @@ struct DeviceD3D12 final : public DeviceBase {
 
     void Destruct() override;
     Result FillFunctionTable(CoreInterface& table) const override;
+    Result FillFunctionTable(CommandBufferPoolInterface& table) const override;
+    Result FillFunctionTable(DeferredReleaseInterface& table) const override;
     Result FillFunctionTable(HelperInterface& table) const override;
     Result FillFunctionTable(LowLatencyInterface& table) const override;
     Result FillFunctionTable(MeshShaderInterface& table) const override;
+    Result FillFunctionTable(ProfilerInterface& table) const override;
     Result FillFunctionTable(RayTracingInterface& table) const override;
     Result FillFunctionTable(StreamerInterface& table) const override;
     Result FillFunctionTable(SwapChainInterface& table) const override;
@@ -149,6 +161,7 @@ struct DeviceD3D12 final : public DeviceBase {
     FormatSupportBits GetFormatSupport(Format format) const;
 
 private:
+    FormatSupportBits QueryFormatSupport(Format format) const;
     void FillDesc(const DeviceCreationDesc& deviceCreationDesc);
     void InitializeNvExt(bool isNVAPILoadedInApp, bool isImported);
     void InitializeAmdExt(AGSContext* agsContext, bool isImported);
@@ -174,13 +187,15 @@ private:
     UnorderedMap<uint32_t, ComPtr<ID3D12CommandSignature>> m_DrawMeshCommandSignatures;
     std::array<std::vector<QueueD3D12*>, (size_t)QueueType::MAX_NUM> m_QueueFamilies = {}; // TODO: use Vector!
     CoreInterface m_CoreInterface = {};
+    FormatSupportCache m_FormatSupportCache;
+    mutable MemoryDescCache m_MemoryDescCache;
     DeviceDesc m_Desc = {};
     uint8_t m_Version = 0;
     bool m_IsWrapped = false;
     bool m_Disable3rdPartyAllocationCallbacks = false;
 
     std::array<Lock, D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES> m_FreeDescriptorLocks;
-    Lock m_DescriptorHeapLock;
+    Lock m_DescriptorHeapLock{"DeviceD3D12::DescriptorHeap"};
 };
 
 } // namespace nri
@@ -43,7 +43,8 @@ DeviceD3D12::DeviceD3D12(const CallbackInterface& callbacks, const AllocationCal
     , m_FreeDescriptors(GetStdAllocator())
     , m_DrawCommandSignatures(GetStdAllocator())
     , m_DrawIndexedCommandSignatures(GetStdAllocator())
-    , m_DrawMeshCommandSignatures(GetStdAllocator()) {
+    , m_DrawMeshCommandSignatures(GetStdAllocator())
+    , m_MemoryDescCache(GetStdAllocator()) {
     m_FreeDescriptors.resize(D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES, Vector<DescriptorHandle>(GetStdAllocator()));
 
     m_Desc.graphicsAPI = GraphicsAPI::D3D12;
@@ -195,7 +196,7 @@ Result DeviceD3D12::Create(const DeviceCreationDesc& desc, const DeviceCreationD
                 float priority = queueFamilyDesc.queuePriorities ? queueFamilyDesc.queuePriorities[j] : 0.0f;
 
                 QueueD3D12* queue = nullptr;
-                Result result = CreateImplementation<QueueD3D12>(queue, queueFamilyDesc.queueType, priority);
+                Result result = CreateImplementation<QueueD3D12>(queue, queueFamilyDesc.queueType, priority, queueFamilyDesc.enableSubmissionThread);
                 if (result == Result::SUCCESS)
                     queueFamily.push_back(queue);
             }
@@ -530,6 +531,7 @@ void DeviceD3D12::FillDesc(const DeviceCreationDesc& desc) {
     m_Desc.isLayerBasedMultiviewSupported = options3.ViewInstancingTier != D3D12_VIEW_INSTANCING_TIER_NOT_SUPPORTED;
     m_Desc.isViewportBasedMultiviewSupported = options3.ViewInstancingTier != D3D12_VIEW_INSTANCING_TIER_NOT_SUPPORTED;
     m_Desc.isWaitableSwapChainSupported = true; // TODO: swap chain version >= 2?
+    m_Desc.isSecondaryCommandBufferSupported = true;
 
     m_Desc.isShaderNativeI16Supported = options4.Native16BitShaderOpsSupported;
     m_Desc.isShaderNativeF16Supported = options4.Native16BitShaderOpsSupported;
@@ -748,6 +750,24 @@ void DeviceD3D12::GetMemoryDesc(MemoryLocation memoryLocation, const D3D12_RESOU
     memoryDesc.mustBeDedicated = mustBeDedicated;
 }
 
+void DeviceD3D12::GetMemoryDesc2(const BufferDesc& bufferDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) const {
+    m_MemoryDescCache.Get(bufferDesc, memoryLocation, memoryDesc, [this](const BufferDesc& desc, MemoryLocation location, MemoryDesc& result) {
+        D3D12_RESOURCE_DESC resourceDesc = {};
+        GetResourceDesc(&resourceDesc, desc);
+
+        GetMemoryDesc(location, resourceDesc, result);
+    });
+}
+
+void DeviceD3D12::GetMemoryDesc2(const TextureDesc& textureDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) const {
+    m_MemoryDescCache.Get(textureDesc, memoryLocation, memoryDesc, [this](const TextureDesc& desc, MemoryLocation location, MemoryDesc& result) {
+        D3D12_RESOURCE_DESC resourceDesc = {};
+        GetResourceDesc(&resourceDesc, desc);
+
+        GetMemoryDesc(location, resourceDesc, result);
+    });
+}
+
 void DeviceD3D12::GetMemoryDesc(const AccelerationStructureDesc& accelerationStructureDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) {
     D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO prebuildInfo = {};
     GetAccelerationStructurePrebuildInfo(accelerationStructureDesc, prebuildInfo);
@@ -857,7 +877,7 @@ ID3D12CommandSignature* DeviceD3D12::GetDispatchCommandSignature() const {
 }
 
 void DeviceD3D12::Destruct() {
-    Destroy(GetAllocationCallbacks(), this);
+    Destroy(GetApplicationAllocationCallbacks(), this);
 }
 
 NRI_INLINE Result DeviceD3D12::GetQueue(QueueType queueType, uint32_t queueIndex, Queue*& queue) {
@@ -904,6 +924,10 @@ NRI_INLINE Result DeviceD3D12::BindAccelerationStructureMemory(const Acceleratio
 }
 
 NRI_INLINE FormatSupportBits DeviceD3D12::GetFormatSupport(Format format) const {
+    return m_FormatSupportCache.Get(format, [this](Format f) { return QueryFormatSupport(f); });
+}
+
+NRI_INLINE FormatSupportBits DeviceD3D12::QueryFormatSupport(Format format) const {
     FormatSupportBits mask = FormatSupportBits::UNSUPPORTED;
 
     D3D12_FEATURE_DATA_FORMAT_SUPPORT formatSupport = {GetDxgiFormat(format).typed};
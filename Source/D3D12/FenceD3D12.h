@@ -39,6 +39,9 @@ struct FenceD3D12 final : public DebugNameBase {
     void QueueSignal(QueueD3D12& queue, uint64_t value);
     void QueueWait(QueueD3D12& queue, uint64_t value);
     void Wait(uint64_t value);
+    void Wait(uint64_t value, const FenceWaitDesc& fenceWaitDesc);
+
+    static Result WaitMany(const Fence* const* fences, const uint64_t* values, uint32_t fenceNum, bool waitAll, uint64_t timeoutNs);
 
 private:
     DeviceD3D12& m_Device;
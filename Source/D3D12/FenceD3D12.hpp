@@ -23,14 +23,74 @@ NRI_INLINE void FenceD3D12::QueueWait(QueueD3D12& queue, uint64_t value) {
 }
 
 NRI_INLINE void FenceD3D12::Wait(uint64_t value) {
-    if (m_Event == 0 || m_Event == INVALID_HANDLE_VALUE) {
-        while (m_Fence->GetCompletedValue() < value)
-            ;
-    } else if (m_Fence->GetCompletedValue() < value) {
-        HRESULT hr = m_Fence->SetEventOnCompletion(value, m_Event);
-        RETURN_ON_FAILURE(&m_Device, hr == S_OK, ReturnVoid(), "ID3D12Fence::SetEventOnCompletion()  failed!");
-
-        uint32_t result = WaitForSingleObjectEx(m_Event, TIMEOUT_FENCE, TRUE);
-        RETURN_ON_FAILURE(&m_Device, result == WAIT_OBJECT_0, ReturnVoid(), "WaitForSingleObjectEx()  failed!");
+    Wait(value, m_Device.GetFenceWaitDesc());
+}
+
+NRI_INLINE void FenceD3D12::Wait(uint64_t value, const FenceWaitDesc& fenceWaitDesc) {
+    WaitForFence(fenceWaitDesc, m_Device.GetFenceWaitStats(), [&] { return GetFenceValue() >= value; }, [&] {
+        if (m_Event == 0 || m_Event == INVALID_HANDLE_VALUE) {
+            while (m_Fence->GetCompletedValue() < value)
+                ;
+        } else {
+            // A loop, because alertable waits can return early
+            while (m_Fence->GetCompletedValue() < value) {
+                HRESULT hr = m_Fence->SetEventOnCompletion(value, m_Event);
+                RETURN_ON_FAILURE(&m_Device, hr == S_OK, ReturnVoid(), "ID3D12Fence::SetEventOnCompletion()  failed!");
+
+                uint32_t result = WaitForSingleObjectEx(m_Event, TIMEOUT_FENCE, TRUE);
+                RETURN_ON_FAILURE(&m_Device, result == WAIT_OBJECT_0 || result == WAIT_IO_COMPLETION, ReturnVoid(), "WaitForSingleObjectEx()  failed!");
+            }
+        }
+    });
+}
+
+// A dedicated event per thread, since fence events are used by "Wait", which can run concurrently
+struct WaitManyEventD3D12 {
+    ~WaitManyEventD3D12() {
+        if (handle != 0 && handle != INVALID_HANDLE_VALUE)
+            CloseHandle(handle);
+    }
+
+    HANDLE handle = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+};
+
+NRI_INLINE Result FenceD3D12::WaitMany(const Fence* const* fences, const uint64_t* values, uint32_t fenceNum, bool waitAll, uint64_t timeoutNs) {
+    static thread_local WaitManyEventD3D12 waitManyEvent;
+
+    DeviceD3D12& device = ((FenceD3D12*)fences[0])->m_Device;
+    HANDLE event = waitManyEvent.handle;
+
+    Scratch<ID3D12Fence*> d3dFences = AllocateScratch(device, ID3D12Fence*, fenceNum);
+    for (uint32_t i = 0; i < fenceNum; i++)
+        d3dFences[i] = ((FenceD3D12*)fences[i])->m_Fence;
+
+    bool useEvent = device.GetVersion() >= 1 && event != 0 && event != INVALID_HANDLE_VALUE;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(std::min<uint64_t>(timeoutNs, INT64_MAX / 2));
+
+    while (true) {
+        // Completed values are checked first, since the event can be left signaled by a previous timed out wait
+        uint32_t completedNum = 0;
+        for (uint32_t i = 0; i < fenceNum; i++) {
+            if (d3dFences[i]->GetCompletedValue() >= values[i])
+                completedNum++;
+        }
+
+        if (waitAll ? completedNum == fenceNum : completedNum != 0)
+            return Result::SUCCESS;
+
+        auto now = std::chrono::steady_clock::now();
+        if (timeoutNs != UINT64_MAX && now >= deadline)
+            return Result::TIMEOUT;
+
+        if (useEvent) {
+            D3D12_MULTIPLE_FENCE_WAIT_FLAGS flags = waitAll ? D3D12_MULTIPLE_FENCE_WAIT_FLAG_ALL : D3D12_MULTIPLE_FENCE_WAIT_FLAG_ANY;
+            HRESULT hr = device->SetEventOnMultipleFenceCompletion(d3dFences, values, fenceNum, flags, event);
+            RETURN_ON_BAD_HRESULT(&device, hr, "ID3D12Device1::SetEventOnMultipleFenceCompletion()");
+
+            uint64_t remainingNs = timeoutNs == UINT64_MAX ? UINT64_MAX : (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count();
+            uint32_t result = WaitForSingleObjectEx(event, NsToMs(remainingNs), TRUE);
+            RETURN_ON_FAILURE(&device, result == WAIT_OBJECT_0 || result == WAIT_TIMEOUT || result == WAIT_IO_COMPLETION, Result::FAILURE, "WaitForSingleObjectEx()  failed!"); // alertable wake-ups retry
+        } else
+            std::this_thread::yield();
     }
 }
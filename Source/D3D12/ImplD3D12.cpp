@@ -3,9 +3,11 @@
 #include "SharedD3D12.h"
 
 #include "AccelerationStructureD3D12.h"
+#include "AllocatorPoolD3D12.h"
 #include "BufferD3D12.h"
 #include "CommandAllocatorD3D12.h"
 #include "CommandBufferD3D12.h"
+#include "DefragmentationD3D12.h"
 #include "DescriptorD3D12.h"
 #include "DescriptorPoolD3D12.h"
 #include "DescriptorSetD3D12.h"
@@ -18,10 +20,14 @@
 #include "SwapChainD3D12.h"
 #include "TextureD3D12.h"
 
+#include "CommandBufferPool.h"
+#include "DeferredReleaseQueue.h"
 #include "HelperDataUpload.h"
 #include "HelperDeviceMemoryAllocator.h"
 #include "HelperWaitIdle.h"
+#include "Profiler.h"
 #include "Streamer.h"
+#include "SubmissionThread.h"
 
 using namespace nri;
 
@@ -46,6 +52,10 @@ using namespace nri;
 
 Result CreateDeviceD3D12(const DeviceCreationDesc& desc, const DeviceCreationD3D12Desc& descD3D12, DeviceBase*& device) {
     DeviceD3D12* impl = Allocate<DeviceD3D12>(desc.allocationCallbacks, desc.callbackInterface, desc.allocationCallbacks);
+
+    if (desc.enableAllocationTracking)
+        impl->EnableAllocationTracking();
+
     Result result = impl->Create(desc, descD3D12);
 
     if (result != Result::SUCCESS) {
@@ -99,17 +109,11 @@ static void NRI_CALL GetTextureMemoryDesc(const Texture& texture, MemoryLocation
 }
 
 static void NRI_CALL GetBufferMemoryDesc2(const Device& device, const BufferDesc& bufferDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) {
-    D3D12_RESOURCE_DESC desc = {};
-    GetResourceDesc(&desc, bufferDesc);
-
-    ((const DeviceD3D12&)device).GetMemoryDesc(memoryLocation, desc, memoryDesc);
+    ((const DeviceD3D12&)device).GetMemoryDesc2(bufferDesc, memoryLocation, memoryDesc);
 }
 
 static void NRI_CALL GetTextureMemoryDesc2(const Device& device, const TextureDesc& textureDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) {
-    D3D12_RESOURCE_DESC desc = {};
-    GetResourceDesc(&desc, textureDesc);
-
-    ((const DeviceD3D12&)device).GetMemoryDesc(memoryLocation, desc, memoryDesc);
+    ((const DeviceD3D12&)device).GetMemoryDesc2(textureDesc, memoryLocation, memoryDesc);
 }
 
 static Result NRI_CALL GetQueue(Device& device, QueueType queueType, uint32_t queueIndex, Queue*& queue) {
@@ -122,7 +126,11 @@ static Result NRI_CALL CreateCommandAllocator(Queue& queue, CommandAllocator*& c
 }
 
 static Result NRI_CALL CreateCommandBuffer(CommandAllocator& commandAllocator, CommandBuffer*& commandBuffer) {
-    return ((CommandAllocatorD3D12&)commandAllocator).CreateCommandBuffer(commandBuffer);
+    return ((CommandAllocatorD3D12&)commandAllocator).CreateCommandBuffer(commandBuffer, false);
+}
+
+static Result NRI_CALL CreateSecondaryCommandBuffer(CommandAllocator& commandAllocator, CommandBuffer*& commandBuffer) {
+    return ((CommandAllocatorD3D12&)commandAllocator).CreateCommandBuffer(commandBuffer, true);
 }
 
 static Result NRI_CALL CreateFence(Device& device, uint64_t initialValue, Fence*& fence) {
@@ -238,9 +246,17 @@ static void NRI_CALL FreeMemory(Memory& memory) {
 }
 
 static Result NRI_CALL BeginCommandBuffer(CommandBuffer& commandBuffer, const DescriptorPool* descriptorPool) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats() = {};
+
     return ((CommandBufferD3D12&)commandBuffer).Begin(descriptorPool);
 }
 
+static Result NRI_CALL BeginSecondaryCommandBuffer(CommandBuffer& commandBuffer, const DescriptorPool* descriptorPool, const InheritanceDesc& inheritanceDesc) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats() = {};
+
+    return ((CommandBufferD3D12&)commandBuffer).BeginSecondary(descriptorPool, inheritanceDesc);
+}
+
 static void NRI_CALL CmdSetDescriptorPool(CommandBuffer& commandBuffer, const DescriptorPool& descriptorPool) {
     ((CommandBufferD3D12&)commandBuffer).SetDescriptorPool(descriptorPool);
 }
@@ -250,6 +266,7 @@ static void NRI_CALL CmdSetPipelineLayout(CommandBuffer& commandBuffer, const Pi
 }
 
 static void NRI_CALL CmdSetDescriptorSet(CommandBuffer& commandBuffer, uint32_t setIndex, const DescriptorSet& descriptorSet, const uint32_t* dynamicConstantBufferOffsets) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats().descriptorSetBindNum++;
     ((CommandBufferD3D12&)commandBuffer).SetDescriptorSet(setIndex, descriptorSet, dynamicConstantBufferOffsets);
 }
 
@@ -262,10 +279,12 @@ static void NRI_CALL CmdSetRootDescriptor(CommandBuffer& commandBuffer, uint32_t
 }
 
 static void NRI_CALL CmdSetPipeline(CommandBuffer& commandBuffer, const Pipeline& pipeline) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats().pipelineBindNum++;
     ((CommandBufferD3D12&)commandBuffer).SetPipeline(pipeline);
 }
 
 static void NRI_CALL CmdBarrier(CommandBuffer& commandBuffer, const BarrierGroupDesc& barrierGroupDesc) {
+    AccountBarriers(((CommandBufferD3D12&)commandBuffer).GetStats(), barrierGroupDesc);
     ((CommandBufferD3D12&)commandBuffer).Barrier(barrierGroupDesc);
 }
 
@@ -310,6 +329,7 @@ static void NRI_CALL CmdSetDepthBias(CommandBuffer& commandBuffer, const DepthBi
 }
 
 static void NRI_CALL CmdBeginRendering(CommandBuffer& commandBuffer, const AttachmentsDesc& attachmentsDesc) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats().renderPassNum++;
     ((CommandBufferD3D12&)commandBuffer).BeginRendering(attachmentsDesc);
 }
 
@@ -318,38 +338,50 @@ static void NRI_CALL CmdClearAttachments(CommandBuffer& commandBuffer, const Cle
 }
 
 static void NRI_CALL CmdDraw(CommandBuffer& commandBuffer, const DrawDesc& drawDesc) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats().drawNum++;
     ((CommandBufferD3D12&)commandBuffer).Draw(drawDesc);
 }
 
 static void NRI_CALL CmdDrawIndexed(CommandBuffer& commandBuffer, const DrawIndexedDesc& drawIndexedDesc) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats().drawIndexedNum++;
     ((CommandBufferD3D12&)commandBuffer).DrawIndexed(drawIndexedDesc);
 }
 
 static void NRI_CALL CmdDrawIndirect(CommandBuffer& commandBuffer, const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats().drawIndirectNum++;
     ((CommandBufferD3D12&)commandBuffer).DrawIndirect(buffer, offset, drawNum, stride, countBuffer, countBufferOffset);
 }
 
 static void NRI_CALL CmdDrawIndexedIndirect(CommandBuffer& commandBuffer, const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats().drawIndirectNum++;
     ((CommandBufferD3D12&)commandBuffer).DrawIndexedIndirect(buffer, offset, drawNum, stride, countBuffer, countBufferOffset);
 }
 
+static void NRI_CALL CmdExecuteCommandBuffers(CommandBuffer& commandBuffer, const CommandBuffer* const* commandBuffers, uint32_t commandBufferNum) {
+    ((CommandBufferD3D12&)commandBuffer).ExecuteCommandBuffers(commandBuffers, commandBufferNum);
+}
+
 static void NRI_CALL CmdEndRendering(CommandBuffer& commandBuffer) {
     ((CommandBufferD3D12&)commandBuffer).ResetAttachments();
 }
 
 static void NRI_CALL CmdDispatch(CommandBuffer& commandBuffer, const DispatchDesc& dispatchDesc) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats().dispatchNum++;
     ((CommandBufferD3D12&)commandBuffer).Dispatch(dispatchDesc);
 }
 
 static void NRI_CALL CmdDispatchIndirect(CommandBuffer& commandBuffer, const Buffer& buffer, uint64_t offset) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats().dispatchNum++;
     ((CommandBufferD3D12&)commandBuffer).DispatchIndirect(buffer, offset);
 }
 
 static void NRI_CALL CmdCopyBuffer(CommandBuffer& commandBuffer, Buffer& dstBuffer, uint64_t dstOffset, const Buffer& srcBuffer, uint64_t srcOffset, uint64_t size) {
+    AccountBufferCopy(((CommandBufferD3D12&)commandBuffer).GetStats(), ((BufferD3D12&)srcBuffer).GetDesc().size, srcOffset, size);
     ((CommandBufferD3D12&)commandBuffer).CopyBuffer(dstBuffer, dstOffset, srcBuffer, srcOffset, size);
 }
 
 static void NRI_CALL CmdCopyTexture(CommandBuffer& commandBuffer, Texture& dstTexture, const TextureRegionDesc* dstRegionDesc, const Texture& srcTexture, const TextureRegionDesc* srcRegionDesc) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats().copyNum++;
     ((CommandBufferD3D12&)commandBuffer).CopyTexture(dstTexture, dstRegionDesc, srcTexture, srcRegionDesc);
 }
 
@@ -358,10 +390,12 @@ static void NRI_CALL CmdResolveTexture(CommandBuffer& commandBuffer, Texture& ds
 }
 
 static void NRI_CALL CmdUploadBufferToTexture(CommandBuffer& commandBuffer, Texture& dstTexture, const TextureRegionDesc& dstRegionDesc, const Buffer& srcBuffer, const TextureDataLayoutDesc& srcDataLayoutDesc) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats().copyNum++;
     ((CommandBufferD3D12&)commandBuffer).UploadBufferToTexture(dstTexture, dstRegionDesc, srcBuffer, srcDataLayoutDesc);
 }
 
 static void NRI_CALL CmdReadbackTextureToBuffer(CommandBuffer& commandBuffer, Buffer& dstBuffer, const TextureDataLayoutDesc& dstDataLayoutDesc, const Texture& srcTexture, const TextureRegionDesc& srcRegionDesc) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats().copyNum++;
     ((CommandBufferD3D12&)commandBuffer).ReadbackTextureToBuffer(dstBuffer, dstDataLayoutDesc, srcTexture, srcRegionDesc);
 }
 
@@ -393,10 +427,17 @@ static void NRI_CALL CmdBeginAnnotation(CommandBuffer& commandBuffer, const char
 #if NRI_ENABLE_DEBUG_NAMES_AND_ANNOTATIONS
     ((CommandBufferD3D12&)commandBuffer).BeginAnnotation(name, bgra);
 #endif
+
+    ProfilerImpl* profiler = ((CommandBufferD3D12&)commandBuffer).GetDevice().GetAnnotationProfiler();
+    if (profiler)
+        profiler->BeginZone(commandBuffer, ((CommandBufferD3D12&)commandBuffer).GetProfilerZoneState(), name);
 }
 
 static void NRI_CALL CmdEndAnnotation(CommandBuffer& commandBuffer) {
-    MaybeUnused(commandBuffer);
+    ProfilerImpl* profiler = ((CommandBufferD3D12&)commandBuffer).GetDevice().GetAnnotationProfiler();
+    if (profiler)
+        profiler->EndZone(commandBuffer, ((CommandBufferD3D12&)commandBuffer).GetProfilerZoneState());
+
 #if NRI_ENABLE_DEBUG_NAMES_AND_ANNOTATIONS
     ((CommandBufferD3D12&)commandBuffer).EndAnnotation();
 #endif
@@ -438,17 +479,36 @@ static void NRI_CALL ResetQueries(QueryPool&, uint32_t, uint32_t) {
 }
 
 static void NRI_CALL QueueSubmit(Queue& queue, const QueueSubmitDesc& queueSubmitDesc) {
-    ((QueueD3D12&)queue).Submit(queueSubmitDesc);
+    ((QueueD3D12&)queue).Submit(&queueSubmitDesc, 1);
+}
+
+static void NRI_CALL QueueSubmitBatch(Queue& queue, const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum) {
+    ((QueueD3D12&)queue).Submit(queueSubmitDescs, queueSubmitDescNum);
 }
 
 static void NRI_CALL Wait(Fence& fence, uint64_t value) {
     ((FenceD3D12&)fence).Wait(value);
 }
 
+static Result NRI_CALL WaitMany(const Fence* const* fences, const uint64_t* values, uint32_t fenceNum, bool waitAll, uint64_t timeoutNs) {
+    if (!fenceNum)
+        return Result::SUCCESS;
+
+    return FenceD3D12::WaitMany(fences, values, fenceNum, waitAll, timeoutNs);
+}
+
 static uint64_t NRI_CALL GetFenceValue(Fence& fence) {
     return ((FenceD3D12&)fence).GetFenceValue();
 }
 
+static void NRI_CALL WaitWithPolicy(Fence& fence, uint64_t value, const FenceWaitDesc& fenceWaitDesc) {
+    ((FenceD3D12&)fence).Wait(value, fenceWaitDesc);
+}
+
+static void NRI_CALL GetFenceWaitStats(const Device& device, FenceWaitStats& fenceWaitStats) {
+    ((const DeviceD3D12&)device).GetFenceWaitStats().Get(fenceWaitStats);
+}
+
 static void NRI_CALL UpdateDescriptorRanges(DescriptorSet& descriptorSet, uint32_t baseRange, uint32_t rangeNum, const DescriptorRangeUpdateDesc* rangeUpdateDescs) {
     ((DescriptorSetD3D12&)descriptorSet).UpdateDescriptorRanges(baseRange, rangeNum, rangeUpdateDescs);
 }
@@ -481,6 +541,22 @@ static void NRI_CALL UnmapBuffer(Buffer& buffer) {
     ((BufferD3D12&)buffer).Unmap();
 }
 
+static void* NRI_CALL MapBufferWithMode(Buffer& buffer, uint64_t offset, uint64_t size, MapMode) {
+    return ((BufferD3D12&)buffer).Map(offset, size);
+}
+
+static Result NRI_CALL FlushBufferRanges(Device&, const BufferRange*, uint32_t) {
+    return Result::SUCCESS; // upload heaps are coherent
+}
+
+static Result NRI_CALL InvalidateBufferRanges(Device&, const BufferRange*, uint32_t) {
+    return Result::SUCCESS; // readback heaps are coherent
+}
+
+static void NRI_CALL GetMappedMemoryStats(const Device& device, MappedMemoryStats& mappedMemoryStats) {
+    ((const DeviceD3D12&)device).GetMappedMemoryStats().Get(mappedMemoryStats);
+}
+
 static void NRI_CALL SetDebugName(Object* object, const char* name) {
     MaybeUnused(object, name);
 #if NRI_ENABLE_DEBUG_NAMES_AND_ANNOTATIONS
@@ -544,6 +620,7 @@ Result DeviceD3D12::FillFunctionTable(CoreInterface& table) const {
     table.GetQueue = ::GetQueue;
     table.CreateCommandAllocator = ::CreateCommandAllocator;
     table.CreateCommandBuffer = ::CreateCommandBuffer;
+    table.CreateSecondaryCommandBuffer = ::CreateSecondaryCommandBuffer;
     table.CreateDescriptorPool = ::CreateDescriptorPool;
     table.CreateBuffer = ::CreateBuffer;
     table.CreateTexture = ::CreateTexture;
@@ -572,6 +649,7 @@ Result DeviceD3D12::FillFunctionTable(CoreInterface& table) const {
     table.BindTextureMemory = ::BindTextureMemory;
     table.FreeMemory = ::FreeMemory;
     table.BeginCommandBuffer = ::BeginCommandBuffer;
+    table.BeginSecondaryCommandBuffer = ::BeginSecondaryCommandBuffer;
     table.CmdSetDescriptorPool = ::CmdSetDescriptorPool;
     table.CmdSetDescriptorSet = ::CmdSetDescriptorSet;
     table.CmdSetPipelineLayout = ::CmdSetPipelineLayout;
@@ -595,6 +673,7 @@ Result DeviceD3D12::FillFunctionTable(CoreInterface& table) const {
     table.CmdDrawIndexed = ::CmdDrawIndexed;
     table.CmdDrawIndirect = ::CmdDrawIndirect;
     table.CmdDrawIndexedIndirect = ::CmdDrawIndexedIndirect;
+    table.CmdExecuteCommandBuffers = ::CmdExecuteCommandBuffers;
     table.CmdEndRendering = ::CmdEndRendering;
     table.CmdDispatch = ::CmdDispatch;
     table.CmdDispatchIndirect = ::CmdDispatchIndirect;
@@ -618,8 +697,12 @@ Result DeviceD3D12::FillFunctionTable(CoreInterface& table) const {
     table.QueueAnnotation = ::QueueAnnotation;
     table.ResetQueries = ::ResetQueries;
     table.QueueSubmit = ::QueueSubmit;
+    table.QueueSubmitBatch = ::QueueSubmitBatch;
     table.Wait = ::Wait;
+    table.WaitMany = ::WaitMany;
     table.GetFenceValue = ::GetFenceValue;
+    table.WaitWithPolicy = ::WaitWithPolicy;
+    table.GetFenceWaitStats = ::GetFenceWaitStats;
     table.UpdateDescriptorRanges = ::UpdateDescriptorRanges;
     table.UpdateDynamicConstantBuffers = ::UpdateDynamicConstantBuffers;
     table.CopyDescriptorSet = ::CopyDescriptorSet;
@@ -628,6 +711,10 @@ Result DeviceD3D12::FillFunctionTable(CoreInterface& table) const {
     table.ResetCommandAllocator = ::ResetCommandAllocator;
     table.MapBuffer = ::MapBuffer;
     table.UnmapBuffer = ::UnmapBuffer;
+    table.MapBufferWithMode = ::MapBufferWithMode;
+    table.FlushBufferRanges = ::FlushBufferRanges;
+    table.InvalidateBufferRanges = ::InvalidateBufferRanges;
+    table.GetMappedMemoryStats = ::GetMappedMemoryStats;
     table.SetDebugName = ::SetDebugName;
     table.GetDeviceNativeObject = ::GetDeviceNativeObject;
     table.GetQueueNativeObject = ::GetQueueNativeObject;
@@ -641,6 +728,106 @@ Result DeviceD3D12::FillFunctionTable(CoreInterface& table) const {
 
 #pragma endregion
 
+//============================================================================================================================================================================================
+#pragma region[  CommandBufferPool  ]
+
+static Result CreateCommandBufferPool(Device& device, const CommandBufferPoolDesc& commandBufferPoolDesc, CommandBufferPool*& commandBufferPool) {
+    DeviceD3D12& deviceD3D12 = (DeviceD3D12&)device;
+    CommandBufferPoolImpl* impl = Allocate<CommandBufferPoolImpl>(deviceD3D12.GetAllocationCallbacks(), device, deviceD3D12.GetCoreInterface());
+    Result result = impl->Create(commandBufferPoolDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceD3D12.GetAllocationCallbacks(), impl);
+        commandBufferPool = nullptr;
+    } else
+        commandBufferPool = (CommandBufferPool*)impl;
+
+    return result;
+}
+
+static void DestroyCommandBufferPool(CommandBufferPool& commandBufferPool) {
+    Destroy(((DeviceBase&)((CommandBufferPoolImpl&)commandBufferPool).GetDevice()).GetAllocationCallbacks(), (CommandBufferPoolImpl*)&commandBufferPool);
+}
+
+static void BeginCommandBufferPoolFrame(CommandBufferPool& commandBufferPool) {
+    ((CommandBufferPoolImpl&)commandBufferPool).BeginFrame();
+}
+
+static void EndCommandBufferPoolFrame(CommandBufferPool& commandBufferPool, Fence& fence, uint64_t value) {
+    ((CommandBufferPoolImpl&)commandBufferPool).EndFrame(fence, value);
+}
+
+static Result AcquireCommandBuffer(CommandBufferPool& commandBufferPool, uint32_t threadIndex, CommandBuffer*& commandBuffer) {
+    return ((CommandBufferPoolImpl&)commandBufferPool).AcquireCommandBuffer(threadIndex, commandBuffer);
+}
+
+static void GetCommandBufferPoolStats(const CommandBufferPool& commandBufferPool, CommandBufferPoolStats& commandBufferPoolStats) {
+    ((const CommandBufferPoolImpl&)commandBufferPool).GetStats(commandBufferPoolStats);
+}
+
+Result DeviceD3D12::FillFunctionTable(CommandBufferPoolInterface& table) const {
+    table.CreateCommandBufferPool = ::CreateCommandBufferPool;
+    table.DestroyCommandBufferPool = ::DestroyCommandBufferPool;
+    table.BeginCommandBufferPoolFrame = ::BeginCommandBufferPoolFrame;
+    table.EndCommandBufferPoolFrame = ::EndCommandBufferPoolFrame;
+    table.AcquireCommandBuffer = ::AcquireCommandBuffer;
+    table.GetCommandBufferPoolStats = ::GetCommandBufferPoolStats;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
+//============================================================================================================================================================================================
+#pragma region[  DeferredRelease  ]
+
+static Result CreateDeferredReleaseQueue(Device& device, const DeferredReleaseQueueDesc& deferredReleaseQueueDesc, DeferredReleaseQueue*& deferredReleaseQueue) {
+    DeviceD3D12& deviceD3D12 = (DeviceD3D12&)device;
+    DeferredReleaseQueueImpl* impl = Allocate<DeferredReleaseQueueImpl>(deviceD3D12.GetAllocationCallbacks(), device, deviceD3D12.GetCoreInterface());
+    Result result = impl->Create(deferredReleaseQueueDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceD3D12.GetAllocationCallbacks(), impl);
+        deferredReleaseQueue = nullptr;
+    } else
+        deferredReleaseQueue = (DeferredReleaseQueue*)impl;
+
+    return result;
+}
+
+static void DestroyDeferredReleaseQueue(DeferredReleaseQueue& deferredReleaseQueue) {
+    Destroy(((DeviceBase&)((DeferredReleaseQueueImpl&)deferredReleaseQueue).GetDevice()).GetAllocationCallbacks(), (DeferredReleaseQueueImpl*)&deferredReleaseQueue);
+}
+
+static void DeferRelease(DeferredReleaseQueue& deferredReleaseQueue, Fence& fence, uint64_t value, DeferredReleaseType type, Object* object) {
+    ((DeferredReleaseQueueImpl&)deferredReleaseQueue).DeferRelease(fence, value, type, object);
+}
+
+static void DeferCallback(DeferredReleaseQueue& deferredReleaseQueue, Fence& fence, uint64_t value, const DeferredReleaseCallback& callback) {
+    ((DeferredReleaseQueueImpl&)deferredReleaseQueue).DeferCallback(fence, value, callback);
+}
+
+static uint32_t DrainDeferredReleases(DeferredReleaseQueue& deferredReleaseQueue) {
+    return ((DeferredReleaseQueueImpl&)deferredReleaseQueue).Drain();
+}
+
+static void GetDeferredReleaseQueueStats(const DeferredReleaseQueue& deferredReleaseQueue, DeferredReleaseQueueStats& deferredReleaseQueueStats) {
+    ((const DeferredReleaseQueueImpl&)deferredReleaseQueue).GetStats(deferredReleaseQueueStats);
+}
+
+Result DeviceD3D12::FillFunctionTable(DeferredReleaseInterface& table) const {
+    table.CreateDeferredReleaseQueue = ::CreateDeferredReleaseQueue;
+    table.DestroyDeferredReleaseQueue = ::DestroyDeferredReleaseQueue;
+    table.DeferRelease = ::DeferRelease;
+    table.DeferCallback = ::DeferCallback;
+    table.DrainDeferredReleases = ::DrainDeferredReleases;
+    table.GetDeferredReleaseQueueStats = ::GetDeferredReleaseQueueStats;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
 //============================================================================================================================================================================================
 #pragma region[  Helper  ]
 
@@ -675,12 +862,61 @@ static Result NRI_CALL QueryVideoMemoryInfo(const Device& device, MemoryLocation
     return QueryVideoMemoryInfoDXGI(luid, memoryLocation, videoMemoryInfo);
 }
 
+static Result NRI_CALL SetBudgetMonitor(Device& device, const BudgetMonitorDesc& budgetMonitorDesc) {
+    return ((DeviceD3D12&)device).GetBudgetMonitor().Start(device, ::QueryVideoMemoryInfo, budgetMonitorDesc);
+}
+
+static Result NRI_CALL GetTrackedVideoMemoryInfo(const Device& device, MemoryLocation memoryLocation, VideoMemoryInfo& videoMemoryInfo) {
+    return ((DeviceD3D12&)device).GetBudgetMonitor().GetInfo(memoryLocation, videoMemoryInfo);
+}
+
+static void NRI_CALL GetObjectPoolStats(const Device& device, ObjectPoolType objectPoolType, ObjectPoolStats& objectPoolStats) {
+    ((DeviceD3D12&)device).GetObjectPool(objectPoolType).GetStats(objectPoolStats);
+}
+
+static Result NRI_CALL GetAllocationStats(const Device& device, AllocationCategory allocationCategory, AllocationStats& allocationStats) {
+    const AllocationTracker& allocationTracker = ((DeviceD3D12&)device).GetAllocationTracker();
+    if (!allocationTracker.IsEnabled()) {
+        allocationStats = {};
+        return Result::UNSUPPORTED;
+    }
+
+    allocationTracker.GetStats(allocationCategory, allocationStats);
+
+    return Result::SUCCESS;
+}
+
+static void NRI_CALL ResetAllocationStats(Device& device) {
+    ((DeviceD3D12&)device).GetAllocationTracker().ResetStats();
+}
+
+static void NRI_CALL GetMemoryDescCacheStats(const Device& device, MemoryDescCacheStats& memoryDescCacheStats) {
+    ((const DeviceD3D12&)device).GetMemoryDescCache().GetStats(memoryDescCacheStats);
+}
+
+static Result NRI_CALL GetDescriptorCacheStats(const Device&, DescriptorCacheStats& descriptorCacheStats) {
+    descriptorCacheStats = {};
+    return Result::UNSUPPORTED;
+}
+
+static void NRI_CALL GetCommandBufferStats(const CommandBuffer& commandBuffer, CommandBufferStats& commandBufferStats) {
+    commandBufferStats = ((CommandBufferD3D12&)commandBuffer).GetStats();
+}
+
 Result DeviceD3D12::FillFunctionTable(HelperInterface& table) const {
     table.CalculateAllocationNumber = ::CalculateAllocationNumber;
     table.AllocateAndBindMemory = ::AllocateAndBindMemory;
     table.UploadData = ::UploadData;
     table.WaitForIdle = ::WaitForIdle;
     table.QueryVideoMemoryInfo = ::QueryVideoMemoryInfo;
+    table.SetBudgetMonitor = ::SetBudgetMonitor;
+    table.GetTrackedVideoMemoryInfo = ::GetTrackedVideoMemoryInfo;
+    table.GetObjectPoolStats = ::GetObjectPoolStats;
+    table.GetAllocationStats = ::GetAllocationStats;
+    table.ResetAllocationStats = ::ResetAllocationStats;
+    table.GetMemoryDescCacheStats = ::GetMemoryDescCacheStats;
+    table.GetDescriptorCacheStats = ::GetDescriptorCacheStats;
+    table.GetCommandBufferStats = ::GetCommandBufferStats;
 
     return Result::SUCCESS;
 }
@@ -707,7 +943,7 @@ static Result GetLatencyReport(const SwapChain& swapChain, LatencyReport& latenc
 }
 
 static void NRI_CALL QueueSubmitTrackable(Queue& queue, const QueueSubmitDesc& workSubmissionDesc, const SwapChain&) {
-    ((QueueD3D12&)queue).Submit(workSubmissionDesc);
+    ((QueueD3D12&)queue).Submit(&workSubmissionDesc, 1, true);
 }
 
 Result DeviceD3D12::FillFunctionTable(LowLatencyInterface& table) const {
@@ -729,10 +965,12 @@ Result DeviceD3D12::FillFunctionTable(LowLatencyInterface& table) const {
 #pragma region[  MeshShader  ]
 
 static void NRI_CALL CmdDrawMeshTasks(CommandBuffer& commandBuffer, const DrawMeshTasksDesc& drawMeshTasksDesc) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats().drawMeshTasksNum++;
     ((CommandBufferD3D12&)commandBuffer).DrawMeshTasks(drawMeshTasksDesc);
 }
 
 static void NRI_CALL CmdDrawMeshTasksIndirect(CommandBuffer& commandBuffer, const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats().drawMeshTasksNum++;
     ((CommandBufferD3D12&)commandBuffer).DrawMeshTasksIndirect(buffer, offset, drawNum, stride, countBuffer, countBufferOffset);
 }
 
@@ -748,6 +986,66 @@ Result DeviceD3D12::FillFunctionTable(MeshShaderInterface& table) const {
 
 #pragma endregion
 
+//============================================================================================================================================================================================
+#pragma region[  Profiler  ]
+
+static Result CreateProfiler(Device& device, const ProfilerDesc& profilerDesc, Profiler*& profiler) {
+    DeviceD3D12& deviceD3D12 = (DeviceD3D12&)device;
+    ProfilerImpl* impl = Allocate<ProfilerImpl>(deviceD3D12.GetAllocationCallbacks(), device, deviceD3D12.GetCoreInterface());
+    Result result = impl->Create(profilerDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceD3D12.GetAllocationCallbacks(), impl);
+        profiler = nullptr;
+    } else
+        profiler = (Profiler*)impl;
+
+    return result;
+}
+
+static void DestroyProfiler(Profiler& profiler) {
+    Destroy(((DeviceBase&)((ProfilerImpl&)profiler).GetDevice()).GetAllocationCallbacks(), (ProfilerImpl*)&profiler);
+}
+
+static void BeginProfilerFrame(Profiler& profiler) {
+    ((ProfilerImpl&)profiler).BeginFrame();
+}
+
+static void EndProfilerFrame(Profiler& profiler, Fence& fence, uint64_t value) {
+    ((ProfilerImpl&)profiler).EndFrame(fence, value);
+}
+
+static void CmdBeginProfilerZone(Profiler& profiler, CommandBuffer& commandBuffer, const char* name) {
+    ((ProfilerImpl&)profiler).BeginZone(commandBuffer, ((CommandBufferD3D12&)commandBuffer).GetProfilerZoneState(), name);
+}
+
+static void CmdEndProfilerZone(Profiler& profiler, CommandBuffer& commandBuffer) {
+    ((ProfilerImpl&)profiler).EndZone(commandBuffer, ((CommandBufferD3D12&)commandBuffer).GetProfilerZoneState());
+}
+
+static void CmdResolveProfilerFrame(Profiler& profiler, CommandBuffer& commandBuffer) {
+    ((ProfilerImpl&)profiler).ResolveFrame(commandBuffer);
+}
+
+static void GetProfilerFrame(const Profiler& profiler, ProfilerFrame& profilerFrame) {
+    ((const ProfilerImpl&)profiler).GetFrame(profilerFrame);
+}
+
+Result DeviceD3D12::FillFunctionTable(ProfilerInterface& table) const {
+    table.CreateProfiler = ::CreateProfiler;
+    table.DestroyProfiler = ::DestroyProfiler;
+    table.BeginProfilerFrame = ::BeginProfilerFrame;
+    table.EndProfilerFrame = ::EndProfilerFrame;
+    table.CmdBeginProfilerZone = ::CmdBeginProfilerZone;
+    table.CmdEndProfilerZone = ::CmdEndProfilerZone;
+    table.CmdResolveProfilerFrame = ::CmdResolveProfilerFrame;
+    table.GetProfilerFrame = ::GetProfilerFrame;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
 //============================================================================================================================================================================================
 #pragma region[  RayTracing  ]
 
@@ -796,10 +1094,12 @@ static void NRI_CALL CmdWriteAccelerationStructureSize(CommandBuffer& commandBuf
 }
 
 static void NRI_CALL CmdDispatchRays(CommandBuffer& commandBuffer, const DispatchRaysDesc& dispatchRaysDesc) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats().dispatchRaysNum++;
     ((CommandBufferD3D12&)commandBuffer).DispatchRays(dispatchRaysDesc);
 }
 
 static void NRI_CALL CmdDispatchRaysIndirect(CommandBuffer& commandBuffer, const Buffer& buffer, uint64_t offset) {
+    ((CommandBufferD3D12&)commandBuffer).GetStats().dispatchRaysNum++;
     ((CommandBufferD3D12&)commandBuffer).DispatchRaysIndirect(buffer, offset);
 }
 
@@ -877,10 +1177,51 @@ static Result AllocateAccelerationStructure(Device& device, const AllocateAccele
     return ((DeviceD3D12&)device).CreateImplementation<AccelerationStructureD3D12>(accelerationStructure, accelerationStructureDesc);
 }
 
+static Result CreateAllocatorPool(Device& device, const AllocatorPoolDesc& allocatorPoolDesc, AllocatorPool*& allocatorPool) {
+    return ((DeviceD3D12&)device).CreateImplementation<AllocatorPoolD3D12>(allocatorPool, allocatorPoolDesc);
+}
+
+static void DestroyAllocatorPool(AllocatorPool& allocatorPool) {
+    Destroy((AllocatorPoolD3D12*)&allocatorPool);
+}
+
+static Result GetAllocatorStats(Device& device, MemoryLocation memoryLocation, AllocatorStats& allocatorStats) {
+    return ((DeviceD3D12&)device).GetAllocatorStats(memoryLocation, allocatorStats);
+}
+
+static void GetAllocatorPoolStats(const AllocatorPool& allocatorPool, AllocatorStats& allocatorStats) {
+    ((AllocatorPoolD3D12&)allocatorPool).GetStats(allocatorStats);
+}
+
+static Result BeginDefragmentation(Device& device, const DefragmentationDesc& defragmentationDesc, Defragmentation*& defragmentation) {
+    return ((DeviceD3D12&)device).CreateImplementation<DefragmentationD3D12>(defragmentation, defragmentationDesc);
+}
+
+static Result GetDefragmentationPass(Defragmentation& defragmentation, DefragmentationPass& defragmentationPass) {
+    return ((DefragmentationD3D12&)defragmentation).GetPass(defragmentationPass);
+}
+
+static Result EndDefragmentationPass(Defragmentation& defragmentation) {
+    return ((DefragmentationD3D12&)defragmentation).EndPass();
+}
+
+static void EndDefragmentation(Defragmentation& defragmentation, DefragmentationStats& defragmentationStats) {
+    ((DefragmentationD3D12&)defragmentation).End(defragmentationStats);
+    Destroy((DefragmentationD3D12*)&defragmentation);
+}
+
 Result DeviceD3D12::FillFunctionTable(ResourceAllocatorInterface& table) const {
     table.AllocateBuffer = ::AllocateBuffer;
     table.AllocateTexture = ::AllocateTexture;
     table.AllocateAccelerationStructure = ::AllocateAccelerationStructure;
+    table.CreateAllocatorPool = ::CreateAllocatorPool;
+    table.DestroyAllocatorPool = ::DestroyAllocatorPool;
+    table.GetAllocatorStats = ::GetAllocatorStats;
+    table.GetAllocatorPoolStats = ::GetAllocatorPoolStats;
+    table.BeginDefragmentation = ::BeginDefragmentation;
+    table.GetDefragmentationPass = ::GetDefragmentationPass;
+    table.EndDefragmentationPass = ::EndDefragmentationPass;
+    table.EndDefragmentation = ::EndDefragmentation;
 
     return Result::SUCCESS;
 }
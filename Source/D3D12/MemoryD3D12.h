@@ -9,8 +9,7 @@ struct MemoryD3D12 final : public DebugNameBase {
         : m_Device(device) {
     }
 
-    inline ~MemoryD3D12() {
-    }
+    ~MemoryD3D12();
 
     inline operator ID3D12Heap*() const {
         return m_Heap.GetInterface();
@@ -48,6 +47,7 @@ private:
     ComPtr<ID3D12Heap> m_Heap;
     D3D12_HEAP_DESC m_HeapDesc = {};
     float m_Priority = 0.0f;
+    bool m_IsTracked = false; // by the budget monitor
 };
 
 } // namespace nri
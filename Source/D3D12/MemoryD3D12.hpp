@@ -1,5 +1,10 @@
 // © 2021 NVIDIA Corporation
 
+MemoryD3D12::~MemoryD3D12() {
+    if (m_IsTracked)
+        m_Device.GetBudgetMonitor().Track(m_HeapDesc.Properties.Type == D3D12_HEAP_TYPE_DEFAULT, -(int64_t)m_HeapDesc.SizeInBytes);
+}
+
 Result MemoryD3D12::Create(const AllocateMemoryDesc& allocateMemoryDesc) {
     MemoryTypeInfo memoryTypeInfo = Unpack(allocateMemoryDesc.type);
 
@@ -23,6 +28,9 @@ Result MemoryD3D12::Create(const AllocateMemoryDesc& allocateMemoryDesc) {
             hr = m_Device->SetResidencyPriority(1, &obj, &residencyPriority);
             RETURN_ON_BAD_HRESULT(&m_Device, hr, "ID3D12Device1::SetResidencyPriority()");
         }
+
+        m_IsTracked = true;
+        m_Device.GetBudgetMonitor().Track(heapDesc.Properties.Type == D3D12_HEAP_TYPE_DEFAULT, (int64_t)heapDesc.SizeInBytes);
     }
 
     m_HeapDesc = heapDesc;
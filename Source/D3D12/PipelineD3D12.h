@@ -74,3 +74,5 @@ private:
 };
 
 } // namespace nri
+
+NRI_ALLOCATION_CATEGORY(nri::PipelineD3D12, PIPELINE);
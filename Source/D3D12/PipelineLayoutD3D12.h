@@ -83,4 +83,6 @@ private:
     bool m_DrawParametersEmulation = false;
 };
 
-} // namespace nri
\ No newline at end of file
+} // namespace nri
+
+NRI_ALLOCATION_CATEGORY(nri::PipelineLayoutD3D12, PIPELINE);
\ No newline at end of file
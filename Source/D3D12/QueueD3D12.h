@@ -5,6 +5,7 @@
 struct ID3D12Device;
 struct ID3D12CommandQueue;
 enum D3D12_COMMAND_LIST_TYPE;
+struct SubmissionThread;
 
 namespace nri {
 
@@ -13,8 +14,7 @@ struct QueueD3D12 final : public DebugNameBase {
         : m_Device(device) {
     }
 
-    inline ~QueueD3D12() {
-    }
+    ~QueueD3D12();
 
     inline operator ID3D12CommandQueue*() const {
         return m_Queue.GetInterface();
@@ -28,7 +28,7 @@ struct QueueD3D12 final : public DebugNameBase {
         return m_CommandListType;
     }
 
-    Result Create(QueueType queueType, float priority);
+    Result Create(QueueType queueType, float priority, bool enableSubmissionThread = false);
     Result Create(ID3D12CommandQueue* queue);
 
     //================================================================================================================
@@ -46,12 +46,18 @@ struct QueueD3D12 final : public DebugNameBase {
     void BeginAnnotation(const char* name, uint32_t bgra);
     void EndAnnotation();
     void Annotation(const char* name, uint32_t bgra);
-    void Submit(const QueueSubmitDesc& queueSubmitDesc);
+    void Submit(const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum, bool isTrackable = false);
+    void FlushSubmissions();
     Result UploadData(const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum);
     Result WaitForIdle();
 
+private:
+    void SubmitImmediately(const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum);
+    static void SubmitFromThread(void* queue, const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum);
+
 private:
     DeviceD3D12& m_Device;
+    SubmissionThread* m_SubmissionThread = nullptr;
     ComPtr<ID3D12CommandQueue> m_Queue;
     D3D12_COMMAND_LIST_TYPE m_CommandListType = D3D12_COMMAND_LIST_TYPE(-1);
 };
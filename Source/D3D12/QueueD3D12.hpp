@@ -1,6 +1,11 @@
 // © 2021 NVIDIA Corporation
 
-Result QueueD3D12::Create(QueueType queueType, float priority) {
+QueueD3D12::~QueueD3D12() {
+    if (m_SubmissionThread)
+        Destroy(m_Device.GetAllocationCallbacks(), m_SubmissionThread);
+}
+
+Result QueueD3D12::Create(QueueType queueType, float priority, bool enableSubmissionThread) {
     D3D12_COMMAND_QUEUE_DESC queueDesc = {};
     queueDesc.Priority = priority > 0.5f ? D3D12_COMMAND_QUEUE_PRIORITY_HIGH : D3D12_COMMAND_QUEUE_PRIORITY_NORMAL; // TODO: values in between? check D3D12_FEATURE_COMMAND_QUEUE_PRIORITY support?
     queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
@@ -12,6 +17,9 @@ Result QueueD3D12::Create(QueueType queueType, float priority) {
 
     m_CommandListType = queueDesc.Type;
 
+    if (enableSubmissionThread)
+        m_SubmissionThread = Allocate<SubmissionThread>(m_Device.GetAllocationCallbacks(), m_Device, SubmitFromThread, this);
+
     return Result::SUCCESS;
 }
 
@@ -27,6 +35,10 @@ Result QueueD3D12::Create(ID3D12CommandQueue* queue) {
     return Result::SUCCESS;
 }
 
+void QueueD3D12::SubmitFromThread(void* queue, const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum) {
+    ((QueueD3D12*)queue)->SubmitImmediately(queueSubmitDescs, queueSubmitDescNum);
+}
+
 NRI_INLINE void QueueD3D12::BeginAnnotation(const char* name, uint32_t bgra) {
     if (m_Device.HasPix())
         m_Device.GetPix().BeginEventOnQueue(m_Queue, bgra, name);
@@ -48,26 +60,65 @@ NRI_INLINE void QueueD3D12::Annotation(const char* name, uint32_t bgra) {
         PIXSetMarker(m_Queue, bgra, name);
 }
 
-NRI_INLINE void QueueD3D12::Submit(const QueueSubmitDesc& queueSubmitDesc) {
-    for (uint32_t i = 0; i < queueSubmitDesc.waitFenceNum; i++) {
-        const FenceSubmitDesc& fenceSubmitDesc = queueSubmitDesc.waitFences[i];
-        FenceD3D12* fence = (FenceD3D12*)fenceSubmitDesc.fence;
-        fence->QueueWait(*this, fenceSubmitDesc.value);
+NRI_INLINE void QueueD3D12::Submit(const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum, bool isTrackable) {
+    if (m_SubmissionThread) {
+        if (!isTrackable) {
+            m_SubmissionThread->Push(queueSubmitDescs, queueSubmitDescNum);
+            return;
+        }
+
+        // Trackable submits go directly to the driver, but can't overtake pending ones
+        m_SubmissionThread->Flush();
     }
 
-    if (queueSubmitDesc.commandBufferNum) {
-        Scratch<ID3D12CommandList*> commandLists = AllocateScratch(m_Device, ID3D12CommandList*, queueSubmitDesc.commandBufferNum);
-        for (uint32_t j = 0; j < queueSubmitDesc.commandBufferNum; j++)
-            commandLists[j] = *(CommandBufferD3D12*)queueSubmitDesc.commandBuffers[j];
+    SubmitImmediately(queueSubmitDescs, queueSubmitDescNum);
+}
 
-        m_Queue->ExecuteCommandLists(queueSubmitDesc.commandBufferNum, commandLists);
-    }
+NRI_INLINE void QueueD3D12::FlushSubmissions() {
+    if (m_SubmissionThread)
+        m_SubmissionThread->Flush();
+}
+
+void QueueD3D12::SubmitImmediately(const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum) {
+    uint32_t commandBufferNum = 0;
+    for (uint32_t i = 0; i < queueSubmitDescNum; i++)
+        commandBufferNum += queueSubmitDescs[i].commandBufferNum;
+
+    // Command lists of adjacent submits are merged into one "ExecuteCommandLists" call, unless separated by a fence operation
+    Scratch<ID3D12CommandList*> commandLists = AllocateScratch(m_Device, ID3D12CommandList*, commandBufferNum);
+    uint32_t commandListNum = 0;
+
+    for (uint32_t i = 0; i < queueSubmitDescNum; i++) {
+        const QueueSubmitDesc& queueSubmitDesc = queueSubmitDescs[i];
+
+        if (queueSubmitDesc.waitFenceNum && commandListNum) {
+            m_Queue->ExecuteCommandLists(commandListNum, commandLists);
+            commandListNum = 0;
+        }
 
-    for (uint32_t i = 0; i < queueSubmitDesc.signalFenceNum; i++) {
-        const FenceSubmitDesc& fenceSubmitDesc = queueSubmitDesc.signalFences[i];
-        FenceD3D12* fence = (FenceD3D12*)fenceSubmitDesc.fence;
-        fence->QueueSignal(*this, fenceSubmitDesc.value);
+        for (uint32_t j = 0; j < queueSubmitDesc.waitFenceNum; j++) {
+            const FenceSubmitDesc& fenceSubmitDesc = queueSubmitDesc.waitFences[j];
+            FenceD3D12* fence = (FenceD3D12*)fenceSubmitDesc.fence;
+            fence->QueueWait(*this, fenceSubmitDesc.value);
+        }
+
+        for (uint32_t j = 0; j < queueSubmitDesc.commandBufferNum; j++)
+            commandLists[commandListNum++] = *(CommandBufferD3D12*)queueSubmitDesc.commandBuffers[j];
+
+        if (queueSubmitDesc.signalFenceNum && commandListNum) {
+            m_Queue->ExecuteCommandLists(commandListNum, commandLists);
+            commandListNum = 0;
+        }
+
+        for (uint32_t j = 0; j < queueSubmitDesc.signalFenceNum; j++) {
+            const FenceSubmitDesc& fenceSubmitDesc = queueSubmitDesc.signalFences[j];
+            FenceD3D12* fence = (FenceD3D12*)fenceSubmitDesc.fence;
+            fence->QueueSignal(*this, fenceSubmitDesc.value);
+        }
     }
+
+    if (commandListNum)
+        m_Queue->ExecuteCommandLists(commandListNum, commandLists);
 }
 
 NRI_INLINE Result QueueD3D12::UploadData(const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum) {
@@ -77,5 +128,7 @@ NRI_INLINE Result QueueD3D12::UploadData(const TextureUploadDesc* textureUploadD
 }
 
 NRI_INLINE Result QueueD3D12::WaitForIdle() {
+    FlushSubmissions();
+
     return WaitIdle(m_Device.GetCoreInterface(), (Device&)m_Device, (Queue&)*this);
 }
@@ -63,6 +63,108 @@ Result DeviceD3D12::CreateVma() {
     return Result::SUCCESS;
 }
 
+static void ConvertStats(const D3D12MA::DetailedStatistics& in, AllocatorStats& out) {
+    out.blockSize += in.Stats.BlockBytes;
+    out.allocationSize += in.Stats.AllocationBytes;
+    out.blockNum += in.Stats.BlockCount;
+    out.allocationNum += in.Stats.AllocationCount;
+    out.unusedRangeNum += in.UnusedRangeCount;
+
+    if (in.Stats.AllocationCount) {
+        out.allocationSizeMin = out.allocationSizeMin ? std::min(out.allocationSizeMin, in.AllocationSizeMin) : in.AllocationSizeMin;
+        out.allocationSizeMax = std::max(out.allocationSizeMax, in.AllocationSizeMax);
+    }
+
+    if (in.UnusedRangeCount)
+        out.unusedRangeSizeMax = std::max(out.unusedRangeSizeMax, in.UnusedRangeSizeMax);
+}
+
+Result DeviceD3D12::GetAllocatorStats(MemoryLocation memoryLocation, AllocatorStats& allocatorStats) {
+    allocatorStats = {};
+
+    Result nriResult = CreateVma();
+    if (nriResult != Result::SUCCESS)
+        return nriResult;
+
+    bool isLocal = memoryLocation == MemoryLocation::DEVICE || memoryLocation == MemoryLocation::DEVICE_UPLOAD;
+
+    D3D12MA::Budget localBudget = {};
+    D3D12MA::Budget nonLocalBudget = {};
+    m_Vma->GetBudget(&localBudget, &nonLocalBudget);
+
+    const D3D12MA::Budget& budget = isLocal ? localBudget : nonLocalBudget;
+    allocatorStats.budgetSize = budget.BudgetBytes;
+    allocatorStats.usageSize = budget.UsageBytes;
+
+    D3D12MA::TotalStatistics totalStats = {};
+    m_Vma->CalculateStatistics(&totalStats);
+
+    ConvertStats(totalStats.MemorySegmentGroup[isLocal ? 0 : 1], allocatorStats);
+
+    return Result::SUCCESS;
+}
+
+AllocatorPoolD3D12::~AllocatorPoolD3D12() {
+    if (m_Pool)
+        m_Pool->Release();
+}
+
+Result AllocatorPoolD3D12::Create(const AllocatorPoolDesc& allocatorPoolDesc) {
+    Result nriResult = m_Device.CreateVma();
+    if (nriResult != Result::SUCCESS)
+        return nriResult;
+
+    const DeviceDesc& deviceDesc = m_Device.GetDesc();
+
+    MemoryLocation memoryLocation = allocatorPoolDesc.memoryLocation;
+    if (memoryLocation == MemoryLocation::DEVICE_UPLOAD && deviceDesc.deviceUploadHeapSize == 0)
+        memoryLocation = MemoryLocation::HOST_UPLOAD;
+
+    // Tier 1 heaps can't mix resource categories
+    D3D12_HEAP_FLAGS heapFlags = D3D12_HEAP_FLAG_NONE;
+    if (!deviceDesc.isMemoryTier2Supported) {
+        if (allocatorPoolDesc.bufferUsage != BufferUsageBits::NONE)
+            heapFlags = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+        else if (allocatorPoolDesc.textureUsage & (TextureUsageBits::COLOR_ATTACHMENT | TextureUsageBits::DEPTH_STENCIL_ATTACHMENT))
+            heapFlags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+        else
+            heapFlags = D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+    }
+
+    D3D12MA::POOL_DESC poolDesc = {};
+    poolDesc.HeapProperties.Type = GetHeapType(memoryLocation);
+    poolDesc.HeapFlags = heapFlags;
+    poolDesc.BlockSize = allocatorPoolDesc.blockSize;
+    poolDesc.MinBlockCount = allocatorPoolDesc.blockMinNum;
+    poolDesc.MaxBlockCount = allocatorPoolDesc.blockMaxNum;
+
+    if (allocatorPoolDesc.isLinear)
+        poolDesc.Flags = (D3D12MA::POOL_FLAGS)(poolDesc.Flags | D3D12MA::POOL_FLAG_ALGORITHM_LINEAR);
+
+    HRESULT hr = m_Device.GetVma()->CreatePool(&poolDesc, &m_Pool);
+    RETURN_ON_BAD_HRESULT(&m_Device, hr, "D3D12MA::CreatePool");
+
+    m_Desc = allocatorPoolDesc;
+
+    return Result::SUCCESS;
+}
+
+void AllocatorPoolD3D12::GetStats(AllocatorStats& allocatorStats) const {
+    D3D12MA::DetailedStatistics stats = {};
+    m_Pool->CalculateStatistics(&stats);
+
+    allocatorStats = {};
+    ConvertStats(stats, allocatorStats);
+}
+
+NRI_INLINE void AllocatorPoolD3D12::SetDebugName(const char* name) {
+    size_t nameLength = strlen(name) + 1;
+    Scratch<wchar_t> wname = AllocateScratch(m_Device, wchar_t, nameLength);
+    ConvertCharToWchar(name, wname, nameLength);
+
+    m_Pool->SetName(wname);
+}
+
 Result BufferD3D12::Create(const AllocateBufferDesc& bufferDesc) {
     Result nriResult = m_Device.CreateVma();
     if (nriResult != Result::SUCCESS)
@@ -71,6 +173,7 @@ Result BufferD3D12::Create(const AllocateBufferDesc& bufferDesc) {
     D3D12MA::ALLOCATION_DESC allocationDesc = {};
     allocationDesc.HeapType = GetHeapType(bufferDesc.memoryLocation);
     allocationDesc.Flags = (D3D12MA::ALLOCATION_FLAGS)(D3D12MA::ALLOCATION_FLAG_CAN_ALIAS | D3D12MA::ALLOCATION_FLAG_STRATEGY_MIN_MEMORY);
+    allocationDesc.CustomPool = bufferDesc.pool ? ((AllocatorPoolD3D12*)bufferDesc.pool)->GetPool() : nullptr;
 
 #ifdef NRI_ENABLE_AGILITY_SDK_SUPPORT
     if (m_Device.GetVersion() >= 10) {
@@ -126,6 +229,7 @@ Result TextureD3D12::Create(const AllocateTextureDesc& textureDesc) {
     D3D12MA::ALLOCATION_DESC allocationDesc = {};
     allocationDesc.HeapType = GetHeapType(textureDesc.memoryLocation);
     allocationDesc.Flags = (D3D12MA::ALLOCATION_FLAGS)(D3D12MA::ALLOCATION_FLAG_CAN_ALIAS | D3D12MA::ALLOCATION_FLAG_STRATEGY_MIN_MEMORY);
+    allocationDesc.CustomPool = textureDesc.pool ? ((AllocatorPoolD3D12*)textureDesc.pool)->GetPool() : nullptr;
 
 #ifdef NRI_ENABLE_AGILITY_SDK_SUPPORT
     if (m_Device.GetVersion() >= 10) {
@@ -179,8 +283,219 @@ Result AccelerationStructureD3D12::Create(const AllocateAccelerationStructureDes
     AllocateBufferDesc bufferDesc = {};
     bufferDesc.memoryLocation = accelerationStructureDesc.memoryLocation;
     bufferDesc.memoryPriority = accelerationStructureDesc.memoryPriority;
+    bufferDesc.pool = accelerationStructureDesc.pool;
     bufferDesc.desc.size = m_PrebuildInfo.ResultDataMaxSizeInBytes;
     bufferDesc.desc.usage = BufferUsageBits::ACCELERATION_STRUCTURE_STORAGE;
 
     return m_Device.CreateImplementation<BufferD3D12>((Buffer*&)m_Buffer, bufferDesc);
 }
+
+Result BufferD3D12::BindDefragmentationTarget(D3D12MA::Allocation* allocation) {
+    D3D12_RESOURCE_DESC desc = {};
+    GetResourceDesc(&desc, m_Desc);
+
+    D3D12_HEAP_DESC heapDesc = allocation->GetHeap()->GetDesc();
+
+    D3D12_RESOURCE_STATES initialState = D3D12_RESOURCE_STATE_COMMON;
+    if (heapDesc.Properties.Type == D3D12_HEAP_TYPE_UPLOAD)
+        initialState |= D3D12_RESOURCE_STATE_GENERIC_READ;
+    else if (heapDesc.Properties.Type == D3D12_HEAP_TYPE_READBACK)
+        initialState |= D3D12_RESOURCE_STATE_COPY_DEST;
+
+    HRESULT hr = m_Device->CreatePlacedResource(allocation->GetHeap(), allocation->GetOffset(), &desc, initialState, nullptr, IID_PPV_ARGS(&m_Buffer));
+    RETURN_ON_BAD_HRESULT(&m_Device, hr, "ID3D12Device::CreatePlacedResource()");
+
+    // D3D12MA swaps resources of "src" and "dst" allocations at the end of the pass
+    allocation->SetResource(m_Buffer);
+
+    return Result::SUCCESS;
+}
+
+void BufferD3D12::FinishDefragmentationMove() {
+    m_Buffer = (ID3D12ResourceBest*)m_VmaAllocation->GetResource();
+}
+
+Result TextureD3D12::BindDefragmentationTarget(D3D12MA::Allocation* allocation) {
+    D3D12_RESOURCE_DESC desc = {};
+    GetResourceDesc(&desc, m_Desc);
+
+    D3D12_CLEAR_VALUE clearValue = {GetDxgiFormat(m_Desc.format).typed};
+    bool isRenderableSurface = desc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL);
+
+    HRESULT hr = m_Device->CreatePlacedResource(allocation->GetHeap(), allocation->GetOffset(), &desc, D3D12_RESOURCE_STATE_COMMON, isRenderableSurface ? &clearValue : nullptr, IID_PPV_ARGS(&m_Texture));
+    RETURN_ON_BAD_HRESULT(&m_Device, hr, "ID3D12Device::CreatePlacedResource()");
+
+    allocation->SetResource(m_Texture);
+
+    return Result::SUCCESS;
+}
+
+void TextureD3D12::FinishDefragmentationMove() {
+    m_Texture = (ID3D12ResourceBest*)m_VmaAllocation->GetResource();
+}
+
+DefragmentationD3D12::~DefragmentationD3D12() {
+    if (m_Context) {
+        DefragmentationStats defragmentationStats = {};
+        End(defragmentationStats);
+    }
+}
+
+Result DefragmentationD3D12::Create(const DefragmentationDesc& defragmentationDesc) {
+    Result nriResult = m_Device.CreateVma();
+    if (nriResult != Result::SUCCESS)
+        return nriResult;
+
+    // Movable resources
+    for (uint32_t i = 0; i < defragmentationDesc.bufferNum; i++) {
+        BufferD3D12* bufferD3D12 = (BufferD3D12*)defragmentationDesc.buffers[i];
+        if (bufferD3D12->GetVmaAllocation())
+            m_Resources[bufferD3D12->GetVmaAllocation()].srcBuffer = defragmentationDesc.buffers[i];
+    }
+
+    for (uint32_t i = 0; i < defragmentationDesc.textureNum; i++) {
+        TextureD3D12* textureD3D12 = (TextureD3D12*)defragmentationDesc.textures[i];
+        if (textureD3D12->GetVmaAllocation())
+            m_Resources[textureD3D12->GetVmaAllocation()].srcTexture = defragmentationDesc.textures[i];
+    }
+
+    // Begin
+    D3D12MA::DEFRAGMENTATION_DESC desc = {};
+    desc.MaxBytesPerPass = defragmentationDesc.maxBytesPerPass;
+    desc.MaxAllocationsPerPass = defragmentationDesc.maxMovesPerPass;
+
+    if (defragmentationDesc.pool) {
+        HRESULT hr = ((AllocatorPoolD3D12*)defragmentationDesc.pool)->GetPool()->BeginDefragmentation(&desc, &m_Context);
+        RETURN_ON_BAD_HRESULT(&m_Device, hr, "D3D12MA::Pool::BeginDefragmentation");
+    } else
+        m_Device.GetVma()->BeginDefragmentation(&desc, &m_Context);
+
+    return Result::SUCCESS;
+}
+
+Result DefragmentationD3D12::GetPass(DefragmentationPass& defragmentationPass) {
+    defragmentationPass = {};
+
+    // Not ended pass is reported again
+    while (!m_VmaMoves) {
+        D3D12MA::DEFRAGMENTATION_PASS_MOVE_INFO passInfo = {};
+        HRESULT hr = m_Context->BeginPass(&passInfo);
+        if (hr == S_OK)
+            return Result::SUCCESS; // nothing to move
+        RETURN_ON_BAD_HRESULT(&m_Device, hr, "D3D12MA::DefragmentationContext::BeginPass");
+
+        m_VmaMoves = passInfo.pMoves;
+        m_VmaMoveNum = passInfo.MoveCount;
+
+        // Create temporary resources in the new locations
+        for (uint32_t i = 0; i < m_VmaMoveNum; i++) {
+            D3D12MA::DEFRAGMENTATION_MOVE& vmaMove = m_VmaMoves[i];
+
+            const auto it = m_Resources.find(vmaMove.pSrcAllocation);
+            if (it == m_Resources.end()) {
+                vmaMove.Operation = D3D12MA::DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+                continue;
+            }
+
+            DefragmentationMove move = it->second;
+
+            Result nriResult = Result::SUCCESS;
+            if (move.srcBuffer) {
+                nriResult = m_Device.CreateImplementation<BufferD3D12>(move.dstBuffer, ((BufferD3D12*)move.srcBuffer)->GetDesc());
+                if (nriResult == Result::SUCCESS) {
+                    nriResult = ((BufferD3D12*)move.dstBuffer)->BindDefragmentationTarget(vmaMove.pDstTmpAllocation);
+                    if (nriResult != Result::SUCCESS)
+                        Destroy((BufferD3D12*)move.dstBuffer);
+                }
+            } else {
+                nriResult = m_Device.CreateImplementation<TextureD3D12>(move.dstTexture, ((TextureD3D12*)move.srcTexture)->GetDesc());
+                if (nriResult == Result::SUCCESS) {
+                    nriResult = ((TextureD3D12*)move.dstTexture)->BindDefragmentationTarget(vmaMove.pDstTmpAllocation);
+                    if (nriResult != Result::SUCCESS)
+                        Destroy((TextureD3D12*)move.dstTexture);
+                }
+            }
+
+            if (nriResult == Result::SUCCESS)
+                m_Moves.push_back(move);
+            else
+                vmaMove.Operation = D3D12MA::DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+        }
+
+        // All moves are ignored, try the next pass
+        if (m_Moves.empty()) {
+            hr = m_Context->EndPass(&passInfo);
+
+            m_VmaMoves = nullptr;
+            m_VmaMoveNum = 0;
+
+            if (hr == S_OK)
+                return Result::SUCCESS; // complete
+        }
+    }
+
+    defragmentationPass.moves = m_Moves.data();
+    defragmentationPass.moveNum = (uint32_t)m_Moves.size();
+
+    return Result::SUCCESS;
+}
+
+Result DefragmentationD3D12::EndPass() {
+    if (!m_VmaMoves)
+        return Result::SUCCESS;
+
+    D3D12MA::DEFRAGMENTATION_PASS_MOVE_INFO passInfo = {m_VmaMoveNum, m_VmaMoves};
+    HRESULT hr = m_Context->EndPass(&passInfo);
+
+    // Rebind moved resources
+    for (const DefragmentationMove& move : m_Moves) {
+        if (move.srcBuffer) {
+            ((BufferD3D12*)move.srcBuffer)->FinishDefragmentationMove();
+            Destroy((BufferD3D12*)move.dstBuffer);
+        } else {
+            ((TextureD3D12*)move.srcTexture)->FinishDefragmentationMove();
+            Destroy((TextureD3D12*)move.dstTexture);
+        }
+    }
+
+    m_Moves.clear();
+    m_VmaMoves = nullptr;
+    m_VmaMoveNum = 0;
+
+    RETURN_ON_BAD_HRESULT(&m_Device, hr, "D3D12MA::DefragmentationContext::EndPass");
+
+    return Result::SUCCESS;
+}
+
+void DefragmentationD3D12::End(DefragmentationStats& defragmentationStats) {
+    // Cancel the unfinished pass
+    if (m_VmaMoves) {
+        for (uint32_t i = 0; i < m_VmaMoveNum; i++)
+            m_VmaMoves[i].Operation = D3D12MA::DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+
+        D3D12MA::DEFRAGMENTATION_PASS_MOVE_INFO passInfo = {m_VmaMoveNum, m_VmaMoves};
+        m_Context->EndPass(&passInfo);
+
+        for (const DefragmentationMove& move : m_Moves) {
+            if (move.dstBuffer)
+                Destroy((BufferD3D12*)move.dstBuffer);
+            else
+                Destroy((TextureD3D12*)move.dstTexture);
+        }
+
+        m_Moves.clear();
+        m_VmaMoves = nullptr;
+        m_VmaMoveNum = 0;
+    }
+
+    D3D12MA::DEFRAGMENTATION_STATS stats = {};
+    m_Context->GetStats(&stats);
+    m_Context->Release();
+    m_Context = nullptr;
+
+    defragmentationStats = {};
+    defragmentationStats.movedSize = stats.BytesMoved;
+    defragmentationStats.freedSize = stats.BytesFreed;
+    defragmentationStats.moveNum = stats.AllocationsMoved;
+    defragmentationStats.freedBlockNum = stats.HeapsFreed;
+}
@@ -145,6 +145,10 @@ struct PixExt {
 namespace D3D12MA {
     class Allocator;
     class Allocation;
+    class Pool;
+    class DefragmentationContext;
+    struct DEFRAGMENTATION_MOVE;
 }
 
+#include "MemoryDescCache.h"
 #include "DeviceD3D12.h"
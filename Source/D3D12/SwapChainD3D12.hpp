@@ -181,6 +181,8 @@ NRI_INLINE Result SwapChainD3D12::WaitForPresent() {
 }
 
 NRI_INLINE Result SwapChainD3D12::Present() {
+    ((QueueD3D12*)m_Desc.queue)->FlushSubmissions();
+
 #if NRI_ENABLE_D3D_EXTENSIONS
     if (m_Desc.allowLowLatency)
         SetLatencyMarker((LatencyMarker)PRESENT_START);
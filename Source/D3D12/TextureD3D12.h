@@ -26,6 +26,10 @@ struct TextureD3D12 final : public DebugNameBase {
         return m_Device;
     }
 
+    inline D3D12MA::Allocation* GetVmaAllocation() const {
+        return m_VmaAllocation.GetInterface();
+    }
+
     inline const TextureDesc& GetDesc() const {
         return m_Desc;
     }
@@ -57,6 +61,8 @@ struct TextureD3D12 final : public DebugNameBase {
     Result Create(const TextureD3D12Desc& textureDesc);
     Result Create(const AllocateTextureDesc& textureDesc);
     Result BindMemory(const MemoryD3D12* memory, uint64_t offset);
+    Result BindDefragmentationTarget(D3D12MA::Allocation* allocation);
+    void FinishDefragmentationMove();
 
     //================================================================================================================
     // DebugNameBase
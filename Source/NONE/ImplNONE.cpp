@@ -2,6 +2,10 @@
 
 #include "SharedExternal.h"
 
+#include "CommandBufferPool.h"
+#include "Profiler.h"
+#include "SubmissionThread.h"
+
 using namespace nri;
 
 template <typename T>
@@ -9,11 +13,65 @@ constexpr T* DummyObject() {
     return (T*)(size_t)(1);
 }
 
+struct DeviceNONE;
+
+// Also serves as a command allocator, since there is nothing to allocate from
+struct QueueNONE {
+    DeviceNONE& device;
+    SubmissionThread* submissionThread; // see "QueueFamilyDesc::enableSubmissionThread"
+};
+
+// Holds statistics (see "HelperInterface::GetCommandBufferStats") and open profiler zones
+struct CommandBufferNONE {
+    DeviceNONE& device;
+    CommandBufferStats stats;
+    ProfilerZoneState profilerZoneState;
+};
+
+// Resources keep their descs, since the validation layer relies on "GetBufferDesc" and "GetTextureDesc"
+struct BufferNONE {
+    DeviceNONE& device;
+    BufferDesc desc;
+};
+
+struct TextureNONE {
+    DeviceNONE& device;
+    TextureDesc desc;
+};
+
+struct SwapChainNONE {
+    TextureNONE texture;
+    Texture* textures[1];
+};
+
+// Simulated GPU completes work instantly, i.e. a fence gets signaled on submission (or by the submission thread)
+struct FenceNONE {
+    inline FenceNONE(DeviceNONE& device, uint64_t initialValue)
+        : device(device)
+        , value(initialValue) {
+    }
+
+    DeviceNONE& device;
+    std::atomic_uint64_t value;
+};
+
 struct DeviceNONE final : public DeviceBase {
-    inline DeviceNONE(const CallbackInterface& callbacks, const AllocationCallbacks& allocationCallbacks, const AdapterDesc* adapterDesc)
+    inline DeviceNONE(const CallbackInterface& callbacks, const AllocationCallbacks& allocationCallbacks)
         : DeviceBase(callbacks, allocationCallbacks) {
-        if (adapterDesc)
-            m_Desc.adapterDesc = *adapterDesc;
+    }
+
+    inline Result Create(const DeviceCreationDesc& desc) {
+        if (desc.adapterDesc)
+            m_Desc.adapterDesc = *desc.adapterDesc;
+
+        // A single queue per type is shared by all queue indices
+        for (uint32_t i = 0; i < desc.queueFamilyNum; i++) {
+            const QueueFamilyDesc& queueFamilyDesc = desc.queueFamilies[i];
+            QueueNONE& queue = m_Queues[(uint32_t)queueFamilyDesc.queueType];
+
+            if (queueFamilyDesc.enableSubmissionThread && !queue.submissionThread)
+                queue.submissionThread = Allocate<SubmissionThread>(GetAllocationCallbacks(), *this, SubmitFromThread, &queue);
+        }
 
         for (uint32_t i = 0; i < (uint32_t)QueueType::MAX_NUM; i++)
             m_Desc.adapterDesc.queueNum[i] = 4;
@@ -169,6 +227,7 @@ struct DeviceNONE final : public DeviceBase {
         m_Desc.isFlexibleMultiviewSupported = true;
         m_Desc.isLayerBasedMultiviewSupported = true;
         m_Desc.isViewportBasedMultiviewSupported = true;
+        m_Desc.isSecondaryCommandBufferSupported = true;
 
         m_Desc.isShaderNativeI16Supported = true;
         m_Desc.isShaderNativeF16Supported = true;
@@ -188,27 +247,51 @@ struct DeviceNONE final : public DeviceBase {
         m_Desc.isRayTracingSupported = true;
         m_Desc.isMeshShaderSupported = true;
         m_Desc.isLowLatencySupported = true;
+
+        return FillFunctionTable(m_CoreInterface);
+    }
+
+    inline FormatSupportBits GetFormatSupport(Format format) const {
+        return m_FormatSupportCache.Get(format, [](Format f) { return QueryFormatSupport(f); });
+    }
+
+    inline Queue* GetQueue(QueueType queueType) {
+        return (Queue*)&m_Queues[(uint32_t)queueType];
     }
 
     inline ~DeviceNONE() {
+        for (QueueNONE& queue : m_Queues) {
+            if (queue.submissionThread)
+                Destroy(GetAllocationCallbacks(), queue.submissionThread);
+        }
     }
 
+    static void SubmitFromThread(void* queue, const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum);
+    static FormatSupportBits QueryFormatSupport(Format format);
+
     //================================================================================================================
     // DeviceBase
     //================================================================================================================
 
+    inline const CoreInterface& GetCoreInterface() const {
+        return m_CoreInterface;
+    }
+
     inline const DeviceDesc& GetDesc() const override {
         return m_Desc;
     }
 
     inline void Destruct() override {
-        Destroy(GetAllocationCallbacks(), this);
+        Destroy(GetApplicationAllocationCallbacks(), this);
     }
 
     Result FillFunctionTable(CoreInterface& table) const override;
+    Result FillFunctionTable(CommandBufferPoolInterface& table) const override;
+    Result FillFunctionTable(DeferredReleaseInterface& table) const override;
     Result FillFunctionTable(HelperInterface& table) const override;
     Result FillFunctionTable(LowLatencyInterface& table) const override;
     Result FillFunctionTable(MeshShaderInterface& table) const override;
+    Result FillFunctionTable(ProfilerInterface& table) const override;
     Result FillFunctionTable(RayTracingInterface& table) const override;
     Result FillFunctionTable(StreamerInterface& table) const override;
     Result FillFunctionTable(SwapChainInterface& table) const override;
@@ -216,21 +299,43 @@ struct DeviceNONE final : public DeviceBase {
 
 private:
     DeviceDesc m_Desc = {};
+    CoreInterface m_CoreInterface = {}; // used by "ProfilerImpl" and "CommandBufferPoolImpl"
+    QueueNONE m_Queues[(uint32_t)QueueType::MAX_NUM] = {{*this}, {*this}, {*this}};
+    FormatSupportCache m_FormatSupportCache;
 };
 
+// Simulated driver query (cached like in other backends): a format supports everything its properties allow
+FormatSupportBits DeviceNONE::QueryFormatSupport(Format format) {
+    if (format == Format::UNKNOWN)
+        return FormatSupportBits::UNSUPPORTED;
+
+    const FormatProps& formatProps = GetFormatProps(format);
+    if (formatProps.isDepth || formatProps.isStencil)
+        return FormatSupportBits::TEXTURE | FormatSupportBits::DEPTH_STENCIL_ATTACHMENT;
+
+    if (formatProps.isCompressed)
+        return FormatSupportBits::TEXTURE;
+
+    return FormatSupportBits::TEXTURE | FormatSupportBits::STORAGE_TEXTURE | FormatSupportBits::COLOR_ATTACHMENT | FormatSupportBits::BLEND
+        | FormatSupportBits::STORAGE_TEXTURE_ATOMICS | FormatSupportBits::BUFFER | FormatSupportBits::STORAGE_BUFFER | FormatSupportBits::VERTEX_BUFFER
+        | FormatSupportBits::STORAGE_BUFFER_ATOMICS;
+}
+
 Result CreateDeviceNONE(const DeviceCreationDesc& desc, DeviceBase*& device) {
-    DeviceNONE* impl = Allocate<DeviceNONE>(desc.allocationCallbacks, desc.callbackInterface, desc.allocationCallbacks, desc.adapterDesc);
+    DeviceNONE* impl = Allocate<DeviceNONE>(desc.allocationCallbacks, desc.callbackInterface, desc.allocationCallbacks);
 
-    if (!impl) {
-        Destroy(desc.allocationCallbacks, impl);
-        device = nullptr;
+    if (desc.enableAllocationTracking)
+        impl->EnableAllocationTracking();
 
-        return Result::FAILURE;
-    }
+    Result result = impl->Create(desc);
 
-    device = (DeviceBase*)impl;
+    if (result != Result::SUCCESS) {
+        Destroy(desc.allocationCallbacks, impl);
+        device = nullptr;
+    } else
+        device = (DeviceBase*)impl;
 
-    return Result::SUCCESS;
+    return result;
 }
 
 //============================================================================================================================================================================================
@@ -240,20 +345,16 @@ static const DeviceDesc& NRI_CALL GetDeviceDesc(const Device& device) {
     return ((DeviceNONE&)device).GetDesc();
 }
 
-static const BufferDesc& NRI_CALL GetBufferDesc(const Buffer&) {
-    static const BufferDesc bufferDesc = {};
-
-    return bufferDesc;
+static const BufferDesc& NRI_CALL GetBufferDesc(const Buffer& buffer) {
+    return ((const BufferNONE&)buffer).desc;
 }
 
-static const TextureDesc& NRI_CALL GetTextureDesc(const Texture&) {
-    static const TextureDesc textureDesc = {};
-
-    return textureDesc;
+static const TextureDesc& NRI_CALL GetTextureDesc(const Texture& texture) {
+    return ((const TextureNONE&)texture).desc;
 }
 
-static FormatSupportBits NRI_CALL GetFormatSupport(const Device&, Format) {
-    return (FormatSupportBits)(-1);
+static FormatSupportBits NRI_CALL GetFormatSupport(const Device& device, Format format) {
+    return ((const DeviceNONE&)device).GetFormatSupport(format);
 }
 
 static uint32_t NRI_CALL GetQuerySize(const QueryPool&) {
@@ -276,26 +377,32 @@ static void NRI_CALL GetTextureMemoryDesc2(const Device&, const TextureDesc&, Me
     memoryDesc = {};
 }
 
-static Result NRI_CALL GetQueue(Device&, QueueType, uint32_t, Queue*& queue) {
-    queue = DummyObject<Queue>();
+static Result NRI_CALL GetQueue(Device& device, QueueType queueType, uint32_t, Queue*& queue) {
+    queue = ((DeviceNONE&)device).GetQueue(queueType);
 
     return Result::SUCCESS;
 }
 
-static Result NRI_CALL CreateCommandAllocator(Queue&, CommandAllocator*& commandAllocator) {
-    commandAllocator = DummyObject<CommandAllocator>();
+static Result NRI_CALL CreateCommandAllocator(Queue& queue, CommandAllocator*& commandAllocator) {
+    commandAllocator = (CommandAllocator*)&queue;
 
     return Result::SUCCESS;
 }
 
-static Result NRI_CALL CreateCommandBuffer(CommandAllocator&, CommandBuffer*& commandBuffer) {
-    commandBuffer = DummyObject<CommandBuffer>();
+static Result NRI_CALL CreateCommandBuffer(CommandAllocator& commandAllocator, CommandBuffer*& commandBuffer) {
+    DeviceNONE& device = ((QueueNONE&)commandAllocator).device;
+    commandBuffer = (CommandBuffer*)Allocate<CommandBufferNONE>(device.GetAllocationCallbacks(), CommandBufferNONE{device, {}});
 
     return Result::SUCCESS;
 }
 
-static Result NRI_CALL CreateFence(Device&, uint64_t, Fence*& fence) {
-    fence = DummyObject<Fence>();
+static Result NRI_CALL CreateSecondaryCommandBuffer(CommandAllocator& commandAllocator, CommandBuffer*& commandBuffer) {
+    return CreateCommandBuffer(commandAllocator, commandBuffer);
+}
+
+static Result NRI_CALL CreateFence(Device& device, uint64_t initialValue, Fence*& fence) {
+    DeviceNONE& deviceNONE = (DeviceNONE&)device;
+    fence = (Fence*)Allocate<FenceNONE>(deviceNONE.GetAllocationCallbacks(), deviceNONE, initialValue);
 
     return Result::SUCCESS;
 }
@@ -306,14 +413,16 @@ static Result NRI_CALL CreateDescriptorPool(Device&, const DescriptorPoolDesc&,
     return Result::SUCCESS;
 }
 
-static Result NRI_CALL CreateBuffer(Device&, const BufferDesc&, Buffer*& buffer) {
-    buffer = DummyObject<Buffer>();
+static Result NRI_CALL CreateBuffer(Device& device, const BufferDesc& bufferDesc, Buffer*& buffer) {
+    DeviceNONE& deviceNONE = (DeviceNONE&)device;
+    buffer = (Buffer*)Allocate<BufferNONE>(deviceNONE.GetAllocationCallbacks(), BufferNONE{deviceNONE, bufferDesc});
 
     return Result::SUCCESS;
 }
 
-static Result NRI_CALL CreateTexture(Device&, const TextureDesc&, Texture*& texture) {
-    texture = DummyObject<Texture>();
+static Result NRI_CALL CreateTexture(Device& device, const TextureDesc& textureDesc, Texture*& texture) {
+    DeviceNONE& deviceNONE = (DeviceNONE&)device;
+    texture = (Texture*)Allocate<TextureNONE>(deviceNONE.GetAllocationCallbacks(), TextureNONE{deviceNONE, FixTextureDesc(textureDesc)});
 
     return Result::SUCCESS;
 }
@@ -375,16 +484,21 @@ static Result NRI_CALL CreateTexture3DView(const Texture3DViewDesc&, Descriptor*
 static void NRI_CALL DestroyCommandAllocator(CommandAllocator&) {
 }
 
-static void NRI_CALL DestroyCommandBuffer(CommandBuffer&) {
+static void NRI_CALL DestroyCommandBuffer(CommandBuffer& commandBuffer) {
+    Destroy(((CommandBufferNONE&)commandBuffer).device.GetAllocationCallbacks(), (CommandBufferNONE*)&commandBuffer);
 }
 
 static void NRI_CALL DestroyDescriptorPool(DescriptorPool&) {
 }
 
-static void NRI_CALL DestroyBuffer(Buffer&) {
+static void NRI_CALL DestroyBuffer(Buffer& buffer) {
+    BufferNONE& bufferNONE = (BufferNONE&)buffer;
+    Destroy(bufferNONE.device.GetAllocationCallbacks(), &bufferNONE);
 }
 
-static void NRI_CALL DestroyTexture(Texture&) {
+static void NRI_CALL DestroyTexture(Texture& texture) {
+    TextureNONE& textureNONE = (TextureNONE&)texture;
+    Destroy(textureNONE.device.GetAllocationCallbacks(), &textureNONE);
 }
 
 static void NRI_CALL DestroyDescriptor(Descriptor&) {
@@ -399,7 +513,9 @@ static void NRI_CALL DestroyPipeline(Pipeline&) {
 static void NRI_CALL DestroyQueryPool(QueryPool&) {
 }
 
-static void NRI_CALL DestroyFence(Fence&) {
+static void NRI_CALL DestroyFence(Fence& fence) {
+    FenceNONE& fenceNONE = (FenceNONE&)fence;
+    Destroy(fenceNONE.device.GetAllocationCallbacks(), &fenceNONE);
 }
 
 static Result NRI_CALL AllocateMemory(Device&, const AllocateMemoryDesc&, Memory*& memory) {
@@ -419,7 +535,15 @@ static Result NRI_CALL BindTextureMemory(Device&, const TextureMemoryBindingDesc
 static void NRI_CALL FreeMemory(Memory&) {
 }
 
-static Result NRI_CALL BeginCommandBuffer(CommandBuffer&, const DescriptorPool*) {
+static Result NRI_CALL BeginCommandBuffer(CommandBuffer& commandBuffer, const DescriptorPool*) {
+    ((CommandBufferNONE&)commandBuffer).stats = {};
+
+    return Result::SUCCESS;
+}
+
+static Result NRI_CALL BeginSecondaryCommandBuffer(CommandBuffer& commandBuffer, const DescriptorPool*, const InheritanceDesc&) {
+    ((CommandBufferNONE&)commandBuffer).stats = {};
+
     return Result::SUCCESS;
 }
 
@@ -429,7 +553,8 @@ static void NRI_CALL CmdSetDescriptorPool(CommandBuffer&, const DescriptorPool&)
 static void NRI_CALL CmdSetPipelineLayout(CommandBuffer&, const PipelineLayout&) {
 }
 
-static void NRI_CALL CmdSetDescriptorSet(CommandBuffer&, uint32_t, const DescriptorSet&, const uint32_t*) {
+static void NRI_CALL CmdSetDescriptorSet(CommandBuffer& commandBuffer, uint32_t, const DescriptorSet&, const uint32_t*) {
+    ((CommandBufferNONE&)commandBuffer).stats.descriptorSetBindNum++;
 }
 
 static void NRI_CALL CmdSetRootConstants(CommandBuffer&, uint32_t, const void*, uint32_t) {
@@ -438,10 +563,12 @@ static void NRI_CALL CmdSetRootConstants(CommandBuffer&, uint32_t, const void*,
 static void NRI_CALL CmdSetRootDescriptor(CommandBuffer&, uint32_t, Descriptor&) {
 }
 
-static void NRI_CALL CmdSetPipeline(CommandBuffer&, const Pipeline&) {
+static void NRI_CALL CmdSetPipeline(CommandBuffer& commandBuffer, const Pipeline&) {
+    ((CommandBufferNONE&)commandBuffer).stats.pipelineBindNum++;
 }
 
-static void NRI_CALL CmdBarrier(CommandBuffer&, const BarrierGroupDesc&) {
+static void NRI_CALL CmdBarrier(CommandBuffer& commandBuffer, const BarrierGroupDesc& barrierGroupDesc) {
+    AccountBarriers(((CommandBufferNONE&)commandBuffer).stats, barrierGroupDesc);
 }
 
 static void NRI_CALL CmdSetIndexBuffer(CommandBuffer&, const Buffer&, uint64_t, IndexType) {
@@ -474,46 +601,60 @@ static void NRI_CALL CmdSetShadingRate(CommandBuffer&, const ShadingRateDesc&) {
 static void NRI_CALL CmdSetDepthBias(CommandBuffer&, const DepthBiasDesc&) {
 }
 
-static void NRI_CALL CmdBeginRendering(CommandBuffer&, const AttachmentsDesc&) {
+static void NRI_CALL CmdBeginRendering(CommandBuffer& commandBuffer, const AttachmentsDesc&) {
+    ((CommandBufferNONE&)commandBuffer).stats.renderPassNum++;
 }
 
 static void NRI_CALL CmdClearAttachments(CommandBuffer&, const ClearDesc*, uint32_t, const Rect*, uint32_t) {
 }
 
-static void NRI_CALL CmdDraw(CommandBuffer&, const DrawDesc&) {
+static void NRI_CALL CmdDraw(CommandBuffer& commandBuffer, const DrawDesc&) {
+    ((CommandBufferNONE&)commandBuffer).stats.drawNum++;
+}
+
+static void NRI_CALL CmdDrawIndexed(CommandBuffer& commandBuffer, const DrawIndexedDesc&) {
+    ((CommandBufferNONE&)commandBuffer).stats.drawIndexedNum++;
 }
 
-static void NRI_CALL CmdDrawIndexed(CommandBuffer&, const DrawIndexedDesc&) {
+static void NRI_CALL CmdDrawIndirect(CommandBuffer& commandBuffer, const Buffer&, uint64_t, uint32_t, uint32_t, const Buffer*, uint64_t) {
+    ((CommandBufferNONE&)commandBuffer).stats.drawIndirectNum++;
 }
 
-static void NRI_CALL CmdDrawIndirect(CommandBuffer&, const Buffer&, uint64_t, uint32_t, uint32_t, const Buffer*, uint64_t) {
+static void NRI_CALL CmdDrawIndexedIndirect(CommandBuffer& commandBuffer, const Buffer&, uint64_t, uint32_t, uint32_t, const Buffer*, uint64_t) {
+    ((CommandBufferNONE&)commandBuffer).stats.drawIndirectNum++;
 }
 
-static void NRI_CALL CmdDrawIndexedIndirect(CommandBuffer&, const Buffer&, uint64_t, uint32_t, uint32_t, const Buffer*, uint64_t) {
+static void NRI_CALL CmdExecuteCommandBuffers(CommandBuffer&, const CommandBuffer* const*, uint32_t) {
 }
 
 static void NRI_CALL CmdEndRendering(CommandBuffer&) {
 }
 
-static void NRI_CALL CmdDispatch(CommandBuffer&, const DispatchDesc&) {
+static void NRI_CALL CmdDispatch(CommandBuffer& commandBuffer, const DispatchDesc&) {
+    ((CommandBufferNONE&)commandBuffer).stats.dispatchNum++;
 }
 
-static void NRI_CALL CmdDispatchIndirect(CommandBuffer&, const Buffer&, uint64_t) {
+static void NRI_CALL CmdDispatchIndirect(CommandBuffer& commandBuffer, const Buffer&, uint64_t) {
+    ((CommandBufferNONE&)commandBuffer).stats.dispatchNum++;
 }
 
-static void NRI_CALL CmdCopyBuffer(CommandBuffer&, Buffer&, uint64_t, const Buffer&, uint64_t, uint64_t) {
+static void NRI_CALL CmdCopyBuffer(CommandBuffer& commandBuffer, Buffer&, uint64_t, const Buffer& srcBuffer, uint64_t srcOffset, uint64_t size) {
+    AccountBufferCopy(((CommandBufferNONE&)commandBuffer).stats, ((const BufferNONE&)srcBuffer).desc.size, srcOffset, size);
 }
 
-static void NRI_CALL CmdCopyTexture(CommandBuffer&, Texture&, const TextureRegionDesc*, const Texture&, const TextureRegionDesc*) {
+static void NRI_CALL CmdCopyTexture(CommandBuffer& commandBuffer, Texture&, const TextureRegionDesc*, const Texture&, const TextureRegionDesc*) {
+    ((CommandBufferNONE&)commandBuffer).stats.copyNum++;
 }
 
 static void NRI_CALL CmdResolveTexture(CommandBuffer&, Texture&, const TextureRegionDesc*, const Texture&, const TextureRegionDesc*) {
 }
 
-static void NRI_CALL CmdUploadBufferToTexture(CommandBuffer&, Texture&, const TextureRegionDesc&, const Buffer&, const TextureDataLayoutDesc&) {
+static void NRI_CALL CmdUploadBufferToTexture(CommandBuffer& commandBuffer, Texture&, const TextureRegionDesc&, const Buffer&, const TextureDataLayoutDesc&) {
+    ((CommandBufferNONE&)commandBuffer).stats.copyNum++;
 }
 
-static void NRI_CALL CmdReadbackTextureToBuffer(CommandBuffer&, Buffer&, const TextureDataLayoutDesc&, const Texture&, const TextureRegionDesc&) {
+static void NRI_CALL CmdReadbackTextureToBuffer(CommandBuffer& commandBuffer, Buffer&, const TextureDataLayoutDesc&, const Texture&, const TextureRegionDesc&) {
+    ((CommandBufferNONE&)commandBuffer).stats.copyNum++;
 }
 
 static void NRI_CALL CmdClearStorageBuffer(CommandBuffer&, const ClearStorageBufferDesc&) {
@@ -534,10 +675,16 @@ static void NRI_CALL CmdEndQuery(CommandBuffer&, QueryPool&, uint32_t) {
 static void NRI_CALL CmdCopyQueries(CommandBuffer&, const QueryPool&, uint32_t, uint32_t, Buffer&, uint64_t) {
 }
 
-static void NRI_CALL CmdBeginAnnotation(CommandBuffer&, const char*, uint32_t) {
+static void NRI_CALL CmdBeginAnnotation(CommandBuffer& commandBuffer, const char* name, uint32_t) {
+    ProfilerImpl* profiler = ((CommandBufferNONE&)commandBuffer).device.GetAnnotationProfiler();
+    if (profiler)
+        profiler->BeginZone(commandBuffer, ((CommandBufferNONE&)commandBuffer).profilerZoneState, name);
 }
 
-static void NRI_CALL CmdEndAnnotation(CommandBuffer&) {
+static void NRI_CALL CmdEndAnnotation(CommandBuffer& commandBuffer) {
+    ProfilerImpl* profiler = ((CommandBufferNONE&)commandBuffer).device.GetAnnotationProfiler();
+    if (profiler)
+        profiler->EndZone(commandBuffer, ((CommandBufferNONE&)commandBuffer).profilerZoneState);
 }
 
 static void NRI_CALL CmdAnnotation(CommandBuffer&, const char*, uint32_t) {
@@ -559,14 +706,85 @@ static void NRI_CALL QueueAnnotation(Queue&, const char*, uint32_t) {
 static void NRI_CALL ResetQueries(QueryPool&, uint32_t, uint32_t) {
 }
 
-static void NRI_CALL QueueSubmit(Queue&, const QueueSubmitDesc&) {
+// Like "ID3D12CommandQueue::Signal", a fence gets the signaled value, i.e. the submission order is observable
+void DeviceNONE::SubmitFromThread(void*, const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum) {
+    for (uint32_t i = 0; i < queueSubmitDescNum; i++) {
+        const QueueSubmitDesc& queueSubmitDesc = queueSubmitDescs[i];
+
+        for (uint32_t j = 0; j < queueSubmitDesc.signalFenceNum; j++) {
+            const FenceSubmitDesc& fenceSubmitDesc = queueSubmitDesc.signalFences[j];
+            ((FenceNONE*)fenceSubmitDesc.fence)->value.store(fenceSubmitDesc.value, std::memory_order_release);
+        }
+    }
 }
 
-static void NRI_CALL Wait(Fence&, uint64_t) {
+static void NRI_CALL QueueSubmitBatch(Queue& queue, const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum) {
+    QueueNONE& queueNONE = (QueueNONE&)queue;
+
+    if (queueNONE.submissionThread)
+        queueNONE.submissionThread->Push(queueSubmitDescs, queueSubmitDescNum);
+    else
+        DeviceNONE::SubmitFromThread(&queueNONE, queueSubmitDescs, queueSubmitDescNum);
 }
 
-static uint64_t NRI_CALL GetFenceValue(Fence&) {
-    return 0;
+static void NRI_CALL QueueSubmit(Queue& queue, const QueueSubmitDesc& queueSubmitDesc) {
+    QueueSubmitBatch(queue, &queueSubmitDesc, 1);
+}
+
+static void NRI_CALL WaitWithPolicy(Fence& fence, uint64_t value, const FenceWaitDesc& fenceWaitDesc) {
+    FenceNONE& fenceNONE = (FenceNONE&)fence;
+
+    // There is no OS object to block on, "block" yields until another thread (or the submission thread) signals the fence.
+    // Like OS waits in other backends, it gives up after "TIMEOUT_FENCE", since the value may never be signaled
+    auto isCompleted = [&]() {
+        return fenceNONE.value.load(std::memory_order_acquire) >= value;
+    };
+
+    WaitForFence(fenceWaitDesc, fenceNONE.device.GetFenceWaitStats(), isCompleted, [&]() {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(TIMEOUT_FENCE);
+
+        while (!isCompleted()) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                REPORT_ERROR(&fenceNONE.device, "the fence hasn't reached value %llu in %u ms", (unsigned long long)value, TIMEOUT_FENCE);
+                return;
+            }
+
+            std::this_thread::yield();
+        }
+    });
+}
+
+static void NRI_CALL Wait(Fence& fence, uint64_t value) {
+    WaitWithPolicy(fence, value, ((FenceNONE&)fence).device.GetFenceWaitDesc());
+}
+
+static Result NRI_CALL WaitMany(const Fence* const* fences, const uint64_t* values, uint32_t fenceNum, bool waitAll, uint64_t timeoutNs) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(std::min<uint64_t>(timeoutNs, INT64_MAX / 2));
+
+    while (true) {
+        uint32_t completedNum = 0;
+        for (uint32_t i = 0; i < fenceNum; i++) {
+            const FenceNONE& fenceNONE = *(const FenceNONE*)fences[i];
+            if (fenceNONE.value.load(std::memory_order_acquire) >= values[i])
+                completedNum++;
+        }
+
+        if (waitAll ? completedNum == fenceNum : completedNum != 0)
+            return Result::SUCCESS;
+
+        if (timeoutNs != UINT64_MAX && std::chrono::steady_clock::now() >= deadline)
+            return Result::TIMEOUT;
+
+        std::this_thread::yield();
+    }
+}
+
+static uint64_t NRI_CALL GetFenceValue(Fence& fence) {
+    return ((FenceNONE&)fence).value.load(std::memory_order_acquire);
+}
+
+static void NRI_CALL GetFenceWaitStats(const Device& device, FenceWaitStats& fenceWaitStats) {
+    ((DeviceNONE&)device).GetFenceWaitStats().Get(fenceWaitStats);
 }
 
 static void NRI_CALL UpdateDescriptorRanges(DescriptorSet&, uint32_t, uint32_t, const DescriptorRangeUpdateDesc*) {
@@ -595,6 +813,29 @@ static void* NRI_CALL MapBuffer(Buffer&, uint64_t, uint64_t) {
 static void NRI_CALL UnmapBuffer(Buffer&) {
 }
 
+static void* NRI_CALL MapBufferWithMode(Buffer&, uint64_t, uint64_t, MapMode) {
+    return nullptr;
+}
+
+// Memory is treated as non host coherent to make the number of driver calls measurable
+static Result NRI_CALL FlushBufferRanges(Device& device, const BufferRange*, uint32_t bufferRangeNum) {
+    if (bufferRangeNum)
+        ((DeviceNONE&)device).GetMappedMemoryStats().AddFlush(bufferRangeNum);
+
+    return Result::SUCCESS;
+}
+
+static Result NRI_CALL InvalidateBufferRanges(Device& device, const BufferRange*, uint32_t bufferRangeNum) {
+    if (bufferRangeNum)
+        ((DeviceNONE&)device).GetMappedMemoryStats().AddInvalidate(bufferRangeNum);
+
+    return Result::SUCCESS;
+}
+
+static void NRI_CALL GetMappedMemoryStats(const Device& device, MappedMemoryStats& mappedMemoryStats) {
+    ((const DeviceNONE&)device).GetMappedMemoryStats().Get(mappedMemoryStats);
+}
+
 static void NRI_CALL SetDebugName(Object*, const char*) {
 }
 
@@ -635,6 +876,7 @@ Result DeviceNONE::FillFunctionTable(CoreInterface& table) const {
     table.GetQueue = ::GetQueue;
     table.CreateCommandAllocator = ::CreateCommandAllocator;
     table.CreateCommandBuffer = ::CreateCommandBuffer;
+    table.CreateSecondaryCommandBuffer = ::CreateSecondaryCommandBuffer;
     table.CreateDescriptorPool = ::CreateDescriptorPool;
     table.CreateBuffer = ::CreateBuffer;
     table.CreateTexture = ::CreateTexture;
@@ -663,6 +905,7 @@ Result DeviceNONE::FillFunctionTable(CoreInterface& table) const {
     table.BindTextureMemory = ::BindTextureMemory;
     table.FreeMemory = ::FreeMemory;
     table.BeginCommandBuffer = ::BeginCommandBuffer;
+    table.BeginSecondaryCommandBuffer = ::BeginSecondaryCommandBuffer;
     table.CmdSetDescriptorPool = ::CmdSetDescriptorPool;
     table.CmdSetDescriptorSet = ::CmdSetDescriptorSet;
     table.CmdSetPipelineLayout = ::CmdSetPipelineLayout;
@@ -686,6 +929,7 @@ Result DeviceNONE::FillFunctionTable(CoreInterface& table) const {
     table.CmdDrawIndexed = ::CmdDrawIndexed;
     table.CmdDrawIndirect = ::CmdDrawIndirect;
     table.CmdDrawIndexedIndirect = ::CmdDrawIndexedIndirect;
+    table.CmdExecuteCommandBuffers = ::CmdExecuteCommandBuffers;
     table.CmdEndRendering = ::CmdEndRendering;
     table.CmdDispatch = ::CmdDispatch;
     table.CmdDispatchIndirect = ::CmdDispatchIndirect;
@@ -709,8 +953,12 @@ Result DeviceNONE::FillFunctionTable(CoreInterface& table) const {
     table.QueueAnnotation = ::QueueAnnotation;
     table.ResetQueries = ::ResetQueries;
     table.QueueSubmit = ::QueueSubmit;
+    table.QueueSubmitBatch = ::QueueSubmitBatch;
     table.Wait = ::Wait;
+    table.WaitMany = ::WaitMany;
     table.GetFenceValue = ::GetFenceValue;
+    table.WaitWithPolicy = ::WaitWithPolicy;
+    table.GetFenceWaitStats = ::GetFenceWaitStats;
     table.UpdateDescriptorRanges = ::UpdateDescriptorRanges;
     table.UpdateDynamicConstantBuffers = ::UpdateDynamicConstantBuffers;
     table.CopyDescriptorSet = ::CopyDescriptorSet;
@@ -719,6 +967,10 @@ Result DeviceNONE::FillFunctionTable(CoreInterface& table) const {
     table.ResetCommandAllocator = ::ResetCommandAllocator;
     table.MapBuffer = ::MapBuffer;
     table.UnmapBuffer = ::UnmapBuffer;
+    table.MapBufferWithMode = ::MapBufferWithMode;
+    table.FlushBufferRanges = ::FlushBufferRanges;
+    table.InvalidateBufferRanges = ::InvalidateBufferRanges;
+    table.GetMappedMemoryStats = ::GetMappedMemoryStats;
     table.SetDebugName = ::SetDebugName;
     table.GetDeviceNativeObject = ::GetDeviceNativeObject;
     table.GetQueueNativeObject = ::GetQueueNativeObject;
@@ -732,6 +984,97 @@ Result DeviceNONE::FillFunctionTable(CoreInterface& table) const {
 
 #pragma endregion
 
+//============================================================================================================================================================================================
+#pragma region[  CommandBufferPool  ]
+
+static Result CreateCommandBufferPool(Device& device, const CommandBufferPoolDesc& commandBufferPoolDesc, CommandBufferPool*& commandBufferPool) {
+    DeviceNONE& deviceNONE = (DeviceNONE&)device;
+    CommandBufferPoolImpl* impl = Allocate<CommandBufferPoolImpl>(deviceNONE.GetAllocationCallbacks(), device, deviceNONE.GetCoreInterface());
+    Result result = impl->Create(commandBufferPoolDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceNONE.GetAllocationCallbacks(), impl);
+        commandBufferPool = nullptr;
+    } else
+        commandBufferPool = (CommandBufferPool*)impl;
+
+    return result;
+}
+
+static void DestroyCommandBufferPool(CommandBufferPool& commandBufferPool) {
+    Destroy(((DeviceBase&)((CommandBufferPoolImpl&)commandBufferPool).GetDevice()).GetAllocationCallbacks(), (CommandBufferPoolImpl*)&commandBufferPool);
+}
+
+static void BeginCommandBufferPoolFrame(CommandBufferPool& commandBufferPool) {
+    ((CommandBufferPoolImpl&)commandBufferPool).BeginFrame();
+}
+
+static void EndCommandBufferPoolFrame(CommandBufferPool& commandBufferPool, Fence& fence, uint64_t value) {
+    ((CommandBufferPoolImpl&)commandBufferPool).EndFrame(fence, value);
+}
+
+static Result AcquireCommandBuffer(CommandBufferPool& commandBufferPool, uint32_t threadIndex, CommandBuffer*& commandBuffer) {
+    return ((CommandBufferPoolImpl&)commandBufferPool).AcquireCommandBuffer(threadIndex, commandBuffer);
+}
+
+static void GetCommandBufferPoolStats(const CommandBufferPool& commandBufferPool, CommandBufferPoolStats& commandBufferPoolStats) {
+    ((const CommandBufferPoolImpl&)commandBufferPool).GetStats(commandBufferPoolStats);
+}
+
+Result DeviceNONE::FillFunctionTable(CommandBufferPoolInterface& table) const {
+    table.CreateCommandBufferPool = ::CreateCommandBufferPool;
+    table.DestroyCommandBufferPool = ::DestroyCommandBufferPool;
+    table.BeginCommandBufferPoolFrame = ::BeginCommandBufferPoolFrame;
+    table.EndCommandBufferPoolFrame = ::EndCommandBufferPoolFrame;
+    table.AcquireCommandBuffer = ::AcquireCommandBuffer;
+    table.GetCommandBufferPoolStats = ::GetCommandBufferPoolStats;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
+//============================================================================================================================================================================================
+#pragma region[  DeferredRelease  ]
+
+static Result CreateDeferredReleaseQueue(Device&, const DeferredReleaseQueueDesc&, DeferredReleaseQueue*& deferredReleaseQueue) {
+    deferredReleaseQueue = DummyObject<DeferredReleaseQueue>();
+
+    return Result::SUCCESS;
+}
+
+static void DestroyDeferredReleaseQueue(DeferredReleaseQueue&) {
+}
+
+static void DeferRelease(DeferredReleaseQueue&, Fence&, uint64_t, DeferredReleaseType, Object*) {
+}
+
+static void DeferCallback(DeferredReleaseQueue&, Fence&, uint64_t, const DeferredReleaseCallback& callback) {
+    if (callback.Callback)
+        callback.Callback(callback.userArg);
+}
+
+static uint32_t DrainDeferredReleases(DeferredReleaseQueue&) {
+    return 0;
+}
+
+static void GetDeferredReleaseQueueStats(const DeferredReleaseQueue&, DeferredReleaseQueueStats& deferredReleaseQueueStats) {
+    deferredReleaseQueueStats = {};
+}
+
+Result DeviceNONE::FillFunctionTable(DeferredReleaseInterface& table) const {
+    table.CreateDeferredReleaseQueue = ::CreateDeferredReleaseQueue;
+    table.DestroyDeferredReleaseQueue = ::DestroyDeferredReleaseQueue;
+    table.DeferRelease = ::DeferRelease;
+    table.DeferCallback = ::DeferCallback;
+    table.DrainDeferredReleases = ::DrainDeferredReleases;
+    table.GetDeferredReleaseQueueStats = ::GetDeferredReleaseQueueStats;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
 //============================================================================================================================================================================================
 #pragma region[  Helper  ]
 
@@ -747,7 +1090,11 @@ static Result NRI_CALL UploadData(Queue&, const TextureUploadDesc*, uint32_t, co
     return Result::SUCCESS;
 }
 
-static Result NRI_CALL WaitForIdle(Queue&) {
+static Result NRI_CALL WaitForIdle(Queue& queue) {
+    QueueNONE& queueNONE = (QueueNONE&)queue;
+    if (queueNONE.submissionThread)
+        queueNONE.submissionThread->Flush();
+
     return Result::SUCCESS;
 }
 
@@ -757,12 +1104,61 @@ static Result NRI_CALL QueryVideoMemoryInfo(const Device&, MemoryLocation, Video
     return Result::SUCCESS;
 }
 
+static Result NRI_CALL SetBudgetMonitor(Device& device, const BudgetMonitorDesc& budgetMonitorDesc) {
+    return ((DeviceNONE&)device).GetBudgetMonitor().Start(device, ::QueryVideoMemoryInfo, budgetMonitorDesc);
+}
+
+static Result NRI_CALL GetTrackedVideoMemoryInfo(const Device& device, MemoryLocation memoryLocation, VideoMemoryInfo& videoMemoryInfo) {
+    return ((DeviceNONE&)device).GetBudgetMonitor().GetInfo(memoryLocation, videoMemoryInfo);
+}
+
+static void NRI_CALL GetObjectPoolStats(const Device&, ObjectPoolType, ObjectPoolStats& objectPoolStats) {
+    objectPoolStats = {};
+}
+
+static Result NRI_CALL GetAllocationStats(const Device& device, AllocationCategory allocationCategory, AllocationStats& allocationStats) {
+    const AllocationTracker& allocationTracker = ((DeviceNONE&)device).GetAllocationTracker();
+    if (!allocationTracker.IsEnabled()) {
+        allocationStats = {};
+        return Result::UNSUPPORTED;
+    }
+
+    allocationTracker.GetStats(allocationCategory, allocationStats);
+
+    return Result::SUCCESS;
+}
+
+static void NRI_CALL ResetAllocationStats(Device& device) {
+    ((DeviceNONE&)device).GetAllocationTracker().ResetStats();
+}
+
+static void NRI_CALL GetMemoryDescCacheStats(const Device&, MemoryDescCacheStats& memoryDescCacheStats) {
+    memoryDescCacheStats = {};
+}
+
+static Result NRI_CALL GetDescriptorCacheStats(const Device&, DescriptorCacheStats& descriptorCacheStats) {
+    descriptorCacheStats = {};
+    return Result::UNSUPPORTED;
+}
+
+static void NRI_CALL GetCommandBufferStats(const CommandBuffer& commandBuffer, CommandBufferStats& commandBufferStats) {
+    commandBufferStats = ((const CommandBufferNONE&)commandBuffer).stats;
+}
+
 Result DeviceNONE::FillFunctionTable(HelperInterface& table) const {
     table.CalculateAllocationNumber = ::CalculateAllocationNumber;
     table.AllocateAndBindMemory = ::AllocateAndBindMemory;
     table.UploadData = ::UploadData;
     table.WaitForIdle = ::WaitForIdle;
     table.QueryVideoMemoryInfo = ::QueryVideoMemoryInfo;
+    table.SetBudgetMonitor = ::SetBudgetMonitor;
+    table.GetTrackedVideoMemoryInfo = ::GetTrackedVideoMemoryInfo;
+    table.GetObjectPoolStats = ::GetObjectPoolStats;
+    table.GetAllocationStats = ::GetAllocationStats;
+    table.ResetAllocationStats = ::ResetAllocationStats;
+    table.GetMemoryDescCacheStats = ::GetMemoryDescCacheStats;
+    table.GetDescriptorCacheStats = ::GetDescriptorCacheStats;
+    table.GetCommandBufferStats = ::GetCommandBufferStats;
 
     return Result::SUCCESS;
 }
@@ -788,7 +1184,8 @@ static Result GetLatencyReport(const SwapChain&, LatencyReport&) {
     return Result::SUCCESS;
 }
 
-static void NRI_CALL QueueSubmitTrackable(Queue&, const QueueSubmitDesc&, const SwapChain&) {
+static void NRI_CALL QueueSubmitTrackable(Queue& queue, const QueueSubmitDesc& queueSubmitDesc, const SwapChain&) {
+    QueueSubmit(queue, queueSubmitDesc);
 }
 
 Result DeviceNONE::FillFunctionTable(LowLatencyInterface& table) const {
@@ -806,10 +1203,12 @@ Result DeviceNONE::FillFunctionTable(LowLatencyInterface& table) const {
 //============================================================================================================================================================================================
 #pragma region[  MeshShader  ]
 
-static void NRI_CALL CmdDrawMeshTasks(CommandBuffer&, const DrawMeshTasksDesc&) {
+static void NRI_CALL CmdDrawMeshTasks(CommandBuffer& commandBuffer, const DrawMeshTasksDesc&) {
+    ((CommandBufferNONE&)commandBuffer).stats.drawMeshTasksNum++;
 }
 
-static void NRI_CALL CmdDrawMeshTasksIndirect(CommandBuffer&, const Buffer&, uint64_t, uint32_t, uint32_t, const Buffer*, uint64_t) {
+static void NRI_CALL CmdDrawMeshTasksIndirect(CommandBuffer& commandBuffer, const Buffer&, uint64_t, uint32_t, uint32_t, const Buffer*, uint64_t) {
+    ((CommandBufferNONE&)commandBuffer).stats.drawMeshTasksNum++;
 }
 
 Result DeviceNONE::FillFunctionTable(MeshShaderInterface& table) const {
@@ -821,6 +1220,67 @@ Result DeviceNONE::FillFunctionTable(MeshShaderInterface& table) const {
 
 #pragma endregion
 
+//============================================================================================================================================================================================
+#pragma region[  Profiler  ]
+
+// Timestamps come from a simulated clock
+static Result CreateProfiler(Device& device, const ProfilerDesc& profilerDesc, Profiler*& profiler) {
+    DeviceNONE& deviceNONE = (DeviceNONE&)device;
+    ProfilerImpl* impl = Allocate<ProfilerImpl>(deviceNONE.GetAllocationCallbacks(), device, deviceNONE.GetCoreInterface());
+    Result result = impl->Create(profilerDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceNONE.GetAllocationCallbacks(), impl);
+        profiler = nullptr;
+    } else
+        profiler = (Profiler*)impl;
+
+    return result;
+}
+
+static void DestroyProfiler(Profiler& profiler) {
+    Destroy(((DeviceBase&)((ProfilerImpl&)profiler).GetDevice()).GetAllocationCallbacks(), (ProfilerImpl*)&profiler);
+}
+
+static void BeginProfilerFrame(Profiler& profiler) {
+    ((ProfilerImpl&)profiler).BeginFrame();
+}
+
+static void EndProfilerFrame(Profiler& profiler, Fence& fence, uint64_t value) {
+    ((ProfilerImpl&)profiler).EndFrame(fence, value);
+}
+
+static void CmdBeginProfilerZone(Profiler& profiler, CommandBuffer& commandBuffer, const char* name) {
+    ((ProfilerImpl&)profiler).BeginZone(commandBuffer, ((CommandBufferNONE&)commandBuffer).profilerZoneState, name);
+}
+
+static void CmdEndProfilerZone(Profiler& profiler, CommandBuffer& commandBuffer) {
+    ((ProfilerImpl&)profiler).EndZone(commandBuffer, ((CommandBufferNONE&)commandBuffer).profilerZoneState);
+}
+
+static void CmdResolveProfilerFrame(Profiler& profiler, CommandBuffer& commandBuffer) {
+    ((ProfilerImpl&)profiler).ResolveFrame(commandBuffer);
+}
+
+static void GetProfilerFrame(const Profiler& profiler, ProfilerFrame& profilerFrame) {
+    ((const ProfilerImpl&)profiler).GetFrame(profilerFrame);
+}
+
+Result DeviceNONE::FillFunctionTable(ProfilerInterface& table) const {
+    table.CreateProfiler = ::CreateProfiler;
+    table.DestroyProfiler = ::DestroyProfiler;
+    table.BeginProfilerFrame = ::BeginProfilerFrame;
+    table.EndProfilerFrame = ::EndProfilerFrame;
+    table.CmdBeginProfilerZone = ::CmdBeginProfilerZone;
+    table.CmdEndProfilerZone = ::CmdEndProfilerZone;
+    table.CmdResolveProfilerFrame = ::CmdResolveProfilerFrame;
+    table.GetProfilerFrame = ::GetProfilerFrame;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
 //============================================================================================================================================================================================
 #pragma region[  RayTracing  ]
 
@@ -883,10 +1343,12 @@ static void NRI_CALL CmdUpdateTopLevelAccelerationStructure(CommandBuffer&, uint
 static void NRI_CALL CmdUpdateBottomLevelAccelerationStructure(CommandBuffer&, uint32_t, const GeometryObject*, AccelerationStructureBuildBits, AccelerationStructure&, const AccelerationStructure&, Buffer&, uint64_t) {
 }
 
-static void NRI_CALL CmdDispatchRays(CommandBuffer&, const DispatchRaysDesc&) {
+static void NRI_CALL CmdDispatchRays(CommandBuffer& commandBuffer, const DispatchRaysDesc&) {
+    ((CommandBufferNONE&)commandBuffer).stats.dispatchRaysNum++;
 }
 
-static void NRI_CALL CmdDispatchRaysIndirect(CommandBuffer&, const Buffer&, uint64_t) {
+static void NRI_CALL CmdDispatchRaysIndirect(CommandBuffer& commandBuffer, const Buffer&, uint64_t) {
+    ((CommandBufferNONE&)commandBuffer).stats.dispatchRaysNum++;
 }
 
 static void NRI_CALL CmdCopyAccelerationStructure(CommandBuffer&, AccelerationStructure&, const AccelerationStructure&, CopyMode) {
@@ -929,28 +1391,71 @@ Result DeviceNONE::FillFunctionTable(RayTracingInterface& table) const {
 //============================================================================================================================================================================================
 #pragma region[  ResourceAllocator  ]
 
-static Result AllocateBuffer(Device&, const AllocateBufferDesc&, Buffer*& buffer) {
-    buffer = DummyObject<Buffer>();
+static Result AllocateBuffer(Device& device, const AllocateBufferDesc& bufferDesc, Buffer*& buffer) {
+    return ::CreateBuffer(device, bufferDesc.desc, buffer);
+}
+
+static Result AllocateTexture(Device& device, const AllocateTextureDesc& textureDesc, Texture*& texture) {
+    return ::CreateTexture(device, textureDesc.desc, texture);
+}
+
+static Result AllocateAccelerationStructure(Device&, const AllocateAccelerationStructureDesc&, AccelerationStructure*& accelerationStructure) {
+    accelerationStructure = DummyObject<AccelerationStructure>();
 
     return Result::SUCCESS;
 }
 
-static Result AllocateTexture(Device&, const AllocateTextureDesc&, Texture*& texture) {
-    texture = DummyObject<Texture>();
+static Result CreateAllocatorPool(Device&, const AllocatorPoolDesc&, AllocatorPool*& allocatorPool) {
+    allocatorPool = DummyObject<AllocatorPool>();
 
     return Result::SUCCESS;
 }
 
-static Result AllocateAccelerationStructure(Device&, const AllocateAccelerationStructureDesc&, AccelerationStructure*& accelerationStructure) {
-    accelerationStructure = DummyObject<AccelerationStructure>();
+static void DestroyAllocatorPool(AllocatorPool&) {
+}
+
+static Result GetAllocatorStats(Device&, MemoryLocation, AllocatorStats& allocatorStats) {
+    allocatorStats = {};
+
+    return Result::SUCCESS;
+}
+
+static void GetAllocatorPoolStats(const AllocatorPool&, AllocatorStats& allocatorStats) {
+    allocatorStats = {};
+}
+
+static Result BeginDefragmentation(Device&, const DefragmentationDesc&, Defragmentation*& defragmentation) {
+    defragmentation = DummyObject<Defragmentation>();
 
     return Result::SUCCESS;
 }
 
+static Result GetDefragmentationPass(Defragmentation&, DefragmentationPass& defragmentationPass) {
+    defragmentationPass = {};
+
+    return Result::SUCCESS;
+}
+
+static Result EndDefragmentationPass(Defragmentation&) {
+    return Result::SUCCESS;
+}
+
+static void EndDefragmentation(Defragmentation&, DefragmentationStats& defragmentationStats) {
+    defragmentationStats = {};
+}
+
 Result DeviceNONE::FillFunctionTable(ResourceAllocatorInterface& table) const {
     table.AllocateBuffer = ::AllocateBuffer;
     table.AllocateTexture = ::AllocateTexture;
     table.AllocateAccelerationStructure = ::AllocateAccelerationStructure;
+    table.CreateAllocatorPool = ::CreateAllocatorPool;
+    table.DestroyAllocatorPool = ::DestroyAllocatorPool;
+    table.GetAllocatorStats = ::GetAllocatorStats;
+    table.GetAllocatorPoolStats = ::GetAllocatorPoolStats;
+    table.BeginDefragmentation = ::BeginDefragmentation;
+    table.GetDefragmentationPass = ::GetDefragmentationPass;
+    table.EndDefragmentationPass = ::EndDefragmentationPass;
+    table.EndDefragmentation = ::EndDefragmentation;
 
     return Result::SUCCESS;
 }
@@ -1015,20 +1520,33 @@ Result DeviceNONE::FillFunctionTable(StreamerInterface& table) const {
 //============================================================================================================================================================================================
 #pragma region[  SwapChain  ]
 
-static Result NRI_CALL CreateSwapChain(Device&, const SwapChainDesc&, SwapChain*& swapChain) {
-    swapChain = DummyObject<SwapChain>();
+static Result NRI_CALL CreateSwapChain(Device& device, const SwapChainDesc& swapChainDesc, SwapChain*& swapChain) {
+    DeviceNONE& deviceNONE = (DeviceNONE&)device;
+
+    TextureDesc textureDesc = {};
+    textureDesc.type = TextureType::TEXTURE_2D;
+    textureDesc.usage = TextureUsageBits::COLOR_ATTACHMENT;
+    textureDesc.format = Format::RGBA8_UNORM;
+    textureDesc.width = swapChainDesc.width;
+    textureDesc.height = swapChainDesc.height;
+
+    SwapChainNONE* impl = Allocate<SwapChainNONE>(deviceNONE.GetAllocationCallbacks(), SwapChainNONE{{deviceNONE, FixTextureDesc(textureDesc)}, {}});
+    impl->textures[0] = (Texture*)&impl->texture;
+
+    swapChain = (SwapChain*)impl;
 
     return Result::SUCCESS;
 }
 
-static void NRI_CALL DestroySwapChain(SwapChain&) {
+static void NRI_CALL DestroySwapChain(SwapChain& swapChain) {
+    SwapChainNONE& swapChainNONE = (SwapChainNONE&)swapChain;
+    Destroy(swapChainNONE.texture.device.GetAllocationCallbacks(), &swapChainNONE);
 }
 
-static Texture* const* NRI_CALL GetSwapChainTextures(const SwapChain&, uint32_t& textureNum) {
-    static void* textures[1] = {};
+static Texture* const* NRI_CALL GetSwapChainTextures(const SwapChain& swapChain, uint32_t& textureNum) {
     textureNum = 1;
 
-    return (Texture**)textures;
+    return ((const SwapChainNONE&)swapChain).textures;
 }
 
 static uint32_t NRI_CALL AcquireNextSwapChainTexture(SwapChain&) {
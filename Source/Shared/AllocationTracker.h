@@ -0,0 +1,75 @@
+#pragma once
+
+#include <unordered_map>
+
+// The category of allocations made by the current thread
+inline nri::AllocationCategory& GetAllocationCategory() {
+    static thread_local nri::AllocationCategory allocationCategory = nri::AllocationCategory::OTHER;
+    return allocationCategory;
+}
+
+// "OTHER" doesn't override the outer category, i.e. a buffer created by the streamer stays in "STREAMER"
+struct AllocationCategoryScope {
+    inline AllocationCategoryScope(nri::AllocationCategory allocationCategory)
+        : m_Previous(GetAllocationCategory()) {
+        if (allocationCategory != nri::AllocationCategory::OTHER)
+            GetAllocationCategory() = allocationCategory;
+    }
+
+    inline ~AllocationCategoryScope() {
+        GetAllocationCategory() = m_Previous;
+    }
+
+private:
+    nri::AllocationCategory m_Previous;
+};
+
+// Specialize to account allocations made during construction, creation and destruction of "T" to a category
+template <typename T>
+struct AllocationCategoryTraits {
+    static constexpr nri::AllocationCategory category = nri::AllocationCategory::OTHER;
+};
+
+#define NRI_ALLOCATION_CATEGORY(T, allocationCategory) \
+    template <> \
+    struct AllocationCategoryTraits<T> { \
+        static constexpr nri::AllocationCategory category = nri::AllocationCategory::allocationCategory; \
+    }
+
+// Sits between NRI and the application allocator. Frees of blocks allocated before tracking has been enabled are
+// not found in the map and just get forwarded. The map itself uses the CRT heap to not track itself
+struct AllocationTracker {
+    // "forcedCategory != MAX_NUM" puts all allocations into one category (validation)
+    void Enable(const AllocationCallbacks& allocationCallbacks, nri::AllocationCategory forcedCategory);
+    void GetStats(nri::AllocationCategory allocationCategory, nri::AllocationStats& allocationStats) const;
+    void ResetStats();
+
+    inline bool IsEnabled() const {
+        return m_AllocationCallbacks.Allocate != nullptr;
+    }
+
+    inline const AllocationCallbacks& GetAllocationCallbacks() const {
+        return m_AllocationCallbacks;
+    }
+
+private:
+    static void* TrackedAllocate(void* userArg, size_t size, size_t alignment);
+    static void* TrackedReallocate(void* userArg, void* memory, size_t size, size_t alignment);
+    static void TrackedFree(void* userArg, void* memory);
+
+    void Add(void* memory, size_t size);
+    void Remove(void* memory);
+
+private:
+    struct Block {
+        uint64_t size;
+        nri::AllocationCategory category;
+    };
+
+    AllocationCallbacks m_AllocationCallbacks = {}; // tracked (the application's ones are in "m_Underlying")
+    AllocationCallbacks m_Underlying = {};
+    std::unordered_map<void*, Block> m_Blocks;
+    std::array<nri::AllocationStats, (size_t)nri::AllocationCategory::MAX_NUM> m_Stats = {};
+    nri::AllocationCategory m_ForcedCategory = nri::AllocationCategory::MAX_NUM;
+    mutable Lock m_Lock{"AllocationTracker"};
+};
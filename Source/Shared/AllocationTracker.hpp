@@ -0,0 +1,87 @@
+void AllocationTracker::Enable(const AllocationCallbacks& allocationCallbacks, AllocationCategory forcedCategory) {
+    m_Underlying = allocationCallbacks;
+    m_ForcedCategory = forcedCategory;
+
+    m_AllocationCallbacks.Allocate = TrackedAllocate;
+    m_AllocationCallbacks.Reallocate = TrackedReallocate;
+    m_AllocationCallbacks.Free = TrackedFree;
+    m_AllocationCallbacks.userArg = this;
+}
+
+void AllocationTracker::GetStats(AllocationCategory allocationCategory, AllocationStats& allocationStats) const {
+    ExclusiveScope lock(m_Lock);
+
+    allocationStats = m_Stats[(size_t)allocationCategory];
+}
+
+void AllocationTracker::ResetStats() {
+    ExclusiveScope lock(m_Lock);
+
+    for (AllocationStats& stats : m_Stats) {
+        stats.peakSize = stats.liveSize;
+        stats.allocationSize = 0;
+        stats.allocationNum = 0;
+    }
+}
+
+void* AllocationTracker::TrackedAllocate(void* userArg, size_t size, size_t alignment) {
+    AllocationTracker& tracker = *(AllocationTracker*)userArg;
+
+    void* memory = tracker.m_Underlying.Allocate(tracker.m_Underlying.userArg, size, alignment);
+    if (memory)
+        tracker.Add(memory, size);
+
+    return memory;
+}
+
+void* AllocationTracker::TrackedReallocate(void* userArg, void* memory, size_t size, size_t alignment) {
+    AllocationTracker& tracker = *(AllocationTracker*)userArg;
+
+    void* newMemory = tracker.m_Underlying.Reallocate(tracker.m_Underlying.userArg, memory, size, alignment);
+    if (newMemory) {
+        if (memory)
+            tracker.Remove(memory);
+
+        tracker.Add(newMemory, size);
+    }
+
+    return newMemory;
+}
+
+void AllocationTracker::TrackedFree(void* userArg, void* memory) {
+    AllocationTracker& tracker = *(AllocationTracker*)userArg;
+
+    if (memory)
+        tracker.Remove(memory);
+
+    tracker.m_Underlying.Free(tracker.m_Underlying.userArg, memory);
+}
+
+void AllocationTracker::Add(void* memory, size_t size) {
+    AllocationCategory category = m_ForcedCategory != AllocationCategory::MAX_NUM ? m_ForcedCategory : GetAllocationCategory();
+
+    ExclusiveScope lock(m_Lock);
+
+    m_Blocks[memory] = {size, category};
+
+    AllocationStats& stats = m_Stats[(size_t)category];
+    stats.liveSize += size;
+    stats.peakSize = std::max(stats.peakSize, stats.liveSize);
+    stats.allocationSize += size;
+    stats.liveNum++;
+    stats.allocationNum++;
+}
+
+void AllocationTracker::Remove(void* memory) {
+    ExclusiveScope lock(m_Lock);
+
+    auto it = m_Blocks.find(memory);
+    if (it == m_Blocks.end())
+        return;
+
+    AllocationStats& stats = m_Stats[(size_t)it->second.category];
+    stats.liveSize -= it->second.size;
+    stats.liveNum--;
+
+    m_Blocks.erase(it);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+
+constexpr float BUDGET_MONITOR_HIGH_WATERMARK = 0.9f;
+constexpr float BUDGET_MONITOR_LOW_WATERMARK = 0.8f;
+constexpr uint32_t BUDGET_MONITOR_RECONCILE_INTERVAL_MS = 100;
+
+typedef nri::Result(NRI_CALL* QueryVideoMemoryInfoFunc)(const nri::Device& device, nri::MemoryLocation memoryLocation, nri::VideoMemoryInfo& videoMemoryInfo);
+
+// Tracks NRI-side allocations per segment ("local" and "non-local", since budgets are per heap) between periodic
+// reconciliations with the OS-provided numbers. Watermark crossings are reported with hysteresis
+struct BudgetMonitor {
+    inline ~BudgetMonitor() {
+        Stop();
+    }
+
+    nri::Result Start(const nri::Device& device, QueryVideoMemoryInfoFunc queryVideoMemoryInfo, const nri::BudgetMonitorDesc& budgetMonitorDesc);
+    void Stop(); // must be called before the device gets destroyed
+    void Track(bool isLocal, int64_t size);
+    nri::Result GetInfo(nri::MemoryLocation memoryLocation, nri::VideoMemoryInfo& videoMemoryInfo) const;
+
+private:
+    struct Segment {
+        std::atomic_uint64_t budgetSize{0};
+        std::atomic_int64_t usageSize{0}; // reconciled usage + tracked deltas
+        bool isAboveHighWatermark = false;  // guarded by "m_Lock"
+    };
+
+    void Reconcile();
+    void Evaluate(uint32_t segmentIndex);
+    void ThreadMain();
+
+private:
+    std::array<Segment, 2> m_Segments; // local, non-local
+    nri::BudgetMonitorDesc m_Desc = {};
+    const nri::Device* m_Device = nullptr;
+    QueryVideoMemoryInfoFunc m_QueryVideoMemoryInfo = nullptr;
+    Lock m_Lock{"BudgetMonitor"}; // guards "m_Desc" and watermark states
+    std::thread m_Thread;
+    std::mutex m_Mutex;
+    std::condition_variable m_WakeUp;
+    std::atomic_bool m_IsRunning{false};
+    bool m_IsExitRequested = false;
+};
@@ -0,0 +1,146 @@
+static inline MemoryLocation GetSegmentMemoryLocation(uint32_t segmentIndex) {
+    return segmentIndex == 0 ? MemoryLocation::DEVICE : MemoryLocation::HOST_UPLOAD;
+}
+
+Result BudgetMonitor::Start(const Device& device, QueryVideoMemoryInfoFunc queryVideoMemoryInfo, const BudgetMonitorDesc& budgetMonitorDesc) {
+    Stop();
+
+    if (!budgetMonitorDesc.BudgetCallback)
+        return Result::SUCCESS;
+
+    VideoMemoryInfo videoMemoryInfo = {};
+    Result result = queryVideoMemoryInfo(device, MemoryLocation::DEVICE, videoMemoryInfo);
+    if (result != Result::SUCCESS)
+        return result;
+
+    {
+        ExclusiveScope lock(m_Lock);
+
+        m_Desc = budgetMonitorDesc;
+        if (m_Desc.highWatermark == 0.0f)
+            m_Desc.highWatermark = BUDGET_MONITOR_HIGH_WATERMARK;
+        if (m_Desc.lowWatermark == 0.0f)
+            m_Desc.lowWatermark = std::min(BUDGET_MONITOR_LOW_WATERMARK, m_Desc.highWatermark);
+        if (m_Desc.reconcileIntervalMs == 0)
+            m_Desc.reconcileIntervalMs = BUDGET_MONITOR_RECONCILE_INTERVAL_MS;
+
+        for (Segment& segment : m_Segments)
+            segment.isAboveHighWatermark = false;
+    }
+
+    m_Device = &device;
+    m_QueryVideoMemoryInfo = queryVideoMemoryInfo;
+    m_IsExitRequested = false;
+
+    Reconcile();
+
+    m_IsRunning.store(true, std::memory_order_release);
+    m_Thread = std::thread(&BudgetMonitor::ThreadMain, this);
+
+    return Result::SUCCESS;
+}
+
+void BudgetMonitor::Stop() {
+    m_IsRunning.store(false, std::memory_order_relaxed);
+
+    if (m_Thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_IsExitRequested = true;
+        }
+        m_WakeUp.notify_one();
+
+        m_Thread.join();
+    }
+}
+
+void BudgetMonitor::Track(bool isLocal, int64_t size) {
+    if (!m_IsRunning.load(std::memory_order_acquire))
+        return;
+
+    uint32_t segmentIndex = isLocal ? 0 : 1;
+    m_Segments[segmentIndex].usageSize.fetch_add(size, std::memory_order_relaxed);
+
+    Evaluate(segmentIndex);
+}
+
+Result BudgetMonitor::GetInfo(MemoryLocation memoryLocation, VideoMemoryInfo& videoMemoryInfo) const {
+    videoMemoryInfo = {};
+
+    if (!m_IsRunning.load(std::memory_order_acquire))
+        return Result::UNSUPPORTED;
+
+    bool isLocal = memoryLocation == MemoryLocation::DEVICE || memoryLocation == MemoryLocation::DEVICE_UPLOAD;
+    const Segment& segment = m_Segments[isLocal ? 0 : 1];
+
+    videoMemoryInfo.budgetSize = segment.budgetSize.load(std::memory_order_relaxed);
+    videoMemoryInfo.usageSize = (uint64_t)std::max(segment.usageSize.load(std::memory_order_relaxed), (int64_t)0);
+
+    return Result::SUCCESS;
+}
+
+void BudgetMonitor::Reconcile() {
+    for (uint32_t i = 0; i < (uint32_t)m_Segments.size(); i++) {
+        Segment& segment = m_Segments[i];
+        int64_t trackedUsageSize = segment.usageSize.load(std::memory_order_relaxed);
+
+        VideoMemoryInfo videoMemoryInfo = {};
+        if (m_QueryVideoMemoryInfo(*m_Device, GetSegmentMemoryLocation(i), videoMemoryInfo) != Result::SUCCESS)
+            continue;
+
+        // Tracked deltas are already accounted by the OS. The correction is applied as a delta, since a plain store
+        // would lose deltas tracked by other threads during the query
+        segment.budgetSize.store(videoMemoryInfo.budgetSize, std::memory_order_relaxed);
+        segment.usageSize.fetch_add((int64_t)videoMemoryInfo.usageSize - trackedUsageSize, std::memory_order_relaxed);
+
+        Evaluate(i);
+    }
+}
+
+void BudgetMonitor::Evaluate(uint32_t segmentIndex) {
+    Segment& segment = m_Segments[segmentIndex];
+
+    VideoMemoryInfo videoMemoryInfo = {};
+    videoMemoryInfo.budgetSize = segment.budgetSize.load(std::memory_order_relaxed);
+    videoMemoryInfo.usageSize = (uint64_t)std::max(segment.usageSize.load(std::memory_order_relaxed), (int64_t)0);
+
+    if (!videoMemoryInfo.budgetSize)
+        return;
+
+    BudgetEvent budgetEvent = BudgetEvent::MAX_NUM;
+    BudgetMonitorDesc desc = {};
+    {
+        ExclusiveScope lock(m_Lock);
+
+        double usage = (double)videoMemoryInfo.usageSize;
+        double budget = (double)videoMemoryInfo.budgetSize;
+
+        if (!segment.isAboveHighWatermark && usage >= budget * m_Desc.highWatermark) {
+            segment.isAboveHighWatermark = true;
+            budgetEvent = BudgetEvent::HIGH_WATERMARK_CROSSED;
+        } else if (segment.isAboveHighWatermark && usage <= budget * m_Desc.lowWatermark) {
+            segment.isAboveHighWatermark = false;
+            budgetEvent = BudgetEvent::LOW_WATERMARK_CROSSED;
+        }
+
+        desc = m_Desc;
+    }
+
+    // Outside of the lock, to not serialize allocating threads behind the user callback
+    if (budgetEvent != BudgetEvent::MAX_NUM && desc.BudgetCallback)
+        desc.BudgetCallback(budgetEvent, GetSegmentMemoryLocation(segmentIndex), videoMemoryInfo, desc.userArg);
+}
+
+void BudgetMonitor::ThreadMain() {
+    auto period = std::chrono::milliseconds(m_Desc.reconcileIntervalMs);
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            if (m_WakeUp.wait_for(lock, period, [&] { return m_IsExitRequested; }))
+                break;
+        }
+
+        Reconcile();
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+// Owned by a single recording thread, aligned to avoid false sharing between threads
+struct alignas(LOCK_CACHELINE_SIZE) CommandAllocatorSlot {
+    Vector<nri::CommandBuffer*> commandBuffers;
+    nri::CommandAllocator* commandAllocator;
+    uint32_t acquiredNum;
+};
+
+struct FrameFence {
+    nri::Fence* fence;
+    uint64_t value;
+};
+
+struct CommandBufferPoolImpl : public nri::DebugNameBase {
+    inline CommandBufferPoolImpl(nri::Device& device, const nri::CoreInterface& NRI)
+        : m_Device(device)
+        , m_NRI(NRI)
+        , m_Slots(((nri::DeviceBase&)device).GetStdAllocator())
+        , m_FrameFences(((nri::DeviceBase&)device).GetStdAllocator()) {
+    }
+
+    inline nri::Device& GetDevice() {
+        return m_Device;
+    }
+
+    ~CommandBufferPoolImpl();
+
+    nri::Result Create(const nri::CommandBufferPoolDesc& desc);
+    void BeginFrame();
+    void EndFrame(nri::Fence& fence, uint64_t value);
+    nri::Result AcquireCommandBuffer(uint32_t threadIndex, nri::CommandBuffer*& commandBuffer);
+    void GetStats(nri::CommandBufferPoolStats& stats) const;
+
+    //================================================================================================================
+    // DebugNameBase
+    //================================================================================================================
+
+    void SetDebugName(const char* name) DEBUG_NAME_OVERRIDE {
+        for (CommandAllocatorSlot& slot : m_Slots)
+            m_NRI.SetDebugName(slot.commandAllocator, name);
+    }
+
+private:
+    inline CommandAllocatorSlot* GetFrameSlots(uint32_t frameIndex) {
+        return &m_Slots[frameIndex * m_Desc.threadNum];
+    }
+
+    inline const CommandAllocatorSlot* GetFrameSlots(uint32_t frameIndex) const {
+        return &m_Slots[frameIndex * m_Desc.threadNum];
+    }
+
+private:
+    nri::Device& m_Device;
+    const nri::CoreInterface& m_NRI;
+    nri::CommandBufferPoolDesc m_Desc = {};
+    Vector<CommandAllocatorSlot> m_Slots; // frameInFlightNum * threadNum
+    Vector<FrameFence> m_FrameFences;     // frameInFlightNum
+    uint32_t m_FrameIndex = 0;
+};
+
+NRI_ALLOCATION_CATEGORY(CommandBufferPoolImpl, COMMAND_BUFFER);
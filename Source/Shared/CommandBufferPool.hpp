@@ -0,0 +1,113 @@
+CommandBufferPoolImpl::~CommandBufferPoolImpl() {
+    for (const FrameFence& frameFence : m_FrameFences) {
+        if (frameFence.fence)
+            m_NRI.Wait(*frameFence.fence, frameFence.value);
+    }
+
+    for (CommandAllocatorSlot& slot : m_Slots) {
+        for (CommandBuffer* commandBuffer : slot.commandBuffers)
+            m_NRI.DestroyCommandBuffer(*commandBuffer);
+
+        if (slot.commandAllocator)
+            m_NRI.DestroyCommandAllocator(*slot.commandAllocator);
+    }
+}
+
+Result CommandBufferPoolImpl::Create(const CommandBufferPoolDesc& desc) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::COMMAND_BUFFER);
+
+    if (!desc.queue || !desc.threadNum || !desc.frameInFlightNum)
+        return Result::INVALID_ARGUMENT;
+
+    m_Desc = desc;
+
+    // Allocators are created upfront to avoid synchronization in "AcquireCommandBuffer"
+    uint32_t slotNum = desc.frameInFlightNum * desc.threadNum;
+    m_Slots.reserve(slotNum);
+
+    for (uint32_t i = 0; i < slotNum; i++) {
+        m_Slots.push_back({Vector<CommandBuffer*>(m_Slots.get_allocator()), nullptr, 0});
+
+        Result result = m_NRI.CreateCommandAllocator(*desc.queue, m_Slots.back().commandAllocator);
+        if (result != Result::SUCCESS)
+            return result;
+    }
+
+    m_FrameFences.resize(desc.frameInFlightNum, {nullptr, 0});
+
+    // The first "BeginFrame" switches to the frame 0
+    m_FrameIndex = desc.frameInFlightNum - 1;
+
+    return Result::SUCCESS;
+}
+
+void CommandBufferPoolImpl::BeginFrame() {
+    m_FrameIndex = (m_FrameIndex + 1) % m_Desc.frameInFlightNum;
+
+    // Wait for the GPU
+    FrameFence& frameFence = m_FrameFences[m_FrameIndex];
+    if (frameFence.fence) {
+        if (m_NRI.GetFenceValue(*frameFence.fence) < frameFence.value)
+            m_NRI.Wait(*frameFence.fence, frameFence.value);
+
+        frameFence.fence = nullptr;
+    }
+
+    // Recycle
+    CommandAllocatorSlot* slots = GetFrameSlots(m_FrameIndex);
+    for (uint32_t i = 0; i < m_Desc.threadNum; i++) {
+        CommandAllocatorSlot& slot = slots[i];
+        if (slot.acquiredNum) {
+            m_NRI.ResetCommandAllocator(*slot.commandAllocator);
+            slot.acquiredNum = 0;
+        }
+    }
+}
+
+void CommandBufferPoolImpl::EndFrame(Fence& fence, uint64_t value) {
+    FrameFence& frameFence = m_FrameFences[m_FrameIndex];
+    frameFence.fence = &fence;
+    frameFence.value = value;
+}
+
+Result CommandBufferPoolImpl::AcquireCommandBuffer(uint32_t threadIndex, CommandBuffer*& commandBuffer) {
+    if (threadIndex >= m_Desc.threadNum)
+        return Result::INVALID_ARGUMENT;
+
+    CommandAllocatorSlot& slot = GetFrameSlots(m_FrameIndex)[threadIndex];
+
+    // Warm-up
+    if (slot.acquiredNum == slot.commandBuffers.size()) {
+        CommandBuffer* newCommandBuffer = nullptr;
+        Result result = m_NRI.CreateCommandBuffer(*slot.commandAllocator, newCommandBuffer);
+        if (result != Result::SUCCESS)
+            return result;
+
+        slot.commandBuffers.push_back(newCommandBuffer);
+    }
+
+    commandBuffer = slot.commandBuffers[slot.acquiredNum++];
+
+    return Result::SUCCESS;
+}
+
+void CommandBufferPoolImpl::GetStats(CommandBufferPoolStats& stats) const {
+    stats = {};
+    stats.commandAllocatorNum = (uint32_t)m_Slots.size();
+
+    for (uint32_t frameIndex = 0; frameIndex < m_Desc.frameInFlightNum; frameIndex++) {
+        const FrameFence& frameFence = m_FrameFences[frameIndex];
+        bool isInFlight = frameFence.fence && m_NRI.GetFenceValue(*frameFence.fence) < frameFence.value;
+
+        const CommandAllocatorSlot* slots = GetFrameSlots(frameIndex);
+        for (uint32_t i = 0; i < m_Desc.threadNum; i++) {
+            const CommandAllocatorSlot& slot = slots[i];
+            stats.commandBufferNum += (uint32_t)slot.commandBuffers.size();
+
+            if (frameIndex == m_FrameIndex)
+                stats.commandBufferAcquiredNum += slot.acquiredNum;
+            else if (isInFlight)
+                stats.commandBufferInFlightNum += slot.acquiredNum;
+        }
+    }
+}
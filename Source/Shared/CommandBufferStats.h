@@ -0,0 +1,24 @@
+#pragma once
+
+// Tracks open profiler zones of a command buffer without locking (see "ProfilerImpl::BeginZone"). Only the innermost zone
+// is stored, outer zones are reachable via "ProfilerZoneRecord::parentIndex". The state gets dropped on a frame or profiler change
+struct ProfilerZoneState {
+    const ProfilerImpl* profiler = nullptr;
+    uint64_t frameIndex = 0;
+    uint32_t zoneIndex = uint32_t(-1); // "PROFILER_NO_ZONE"
+    uint32_t droppedZoneNum = 0;       // nested zones, which didn't fit into "zoneMaxNum"
+};
+
+// "CommandBufferStats" get updated by "Cmd*" functions of all implementations and reset in "BeginCommandBuffer"
+inline void AccountBarriers(nri::CommandBufferStats& commandBufferStats, const nri::BarrierGroupDesc& barrierGroupDesc) {
+    commandBufferStats.barrierGroupNum++;
+    commandBufferStats.barrierNum += barrierGroupDesc.globalNum + barrierGroupDesc.bufferNum + barrierGroupDesc.textureNum;
+}
+
+inline void AccountBufferCopy(nri::CommandBufferStats& commandBufferStats, uint64_t srcBufferSize, uint64_t srcOffset, uint64_t size) {
+    commandBufferStats.copyNum++;
+    if (size == nri::WHOLE_SIZE)
+        size = srcBufferSize > srcOffset ? srcBufferSize - srcOffset : 0;
+
+    commandBufferStats.copyBytes += size;
+}
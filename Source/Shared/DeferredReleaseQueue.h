@@ -0,0 +1,53 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+
+struct DeferredRelease {
+    nri::Fence* fence;
+    uint64_t value;
+    void* object; // or "userArg" if "callback" is set
+    void (*callback)(void* userArg);
+    nri::DeferredReleaseType type;
+};
+
+struct DeferredReleaseQueueImpl : public nri::DebugNameBase {
+    inline DeferredReleaseQueueImpl(nri::Device& device, const nri::CoreInterface& NRI)
+        : m_Device(device)
+        , m_NRI(NRI)
+        , m_Pending(((nri::DeviceBase&)device).GetStdAllocator())
+        , m_Ready(((nri::DeviceBase&)device).GetStdAllocator()) {
+    }
+
+    inline nri::Device& GetDevice() {
+        return m_Device;
+    }
+
+    ~DeferredReleaseQueueImpl();
+
+    nri::Result Create(const nri::DeferredReleaseQueueDesc& desc);
+    void DeferRelease(nri::Fence& fence, uint64_t value, nri::DeferredReleaseType type, void* object);
+    void DeferCallback(nri::Fence& fence, uint64_t value, const nri::DeferredReleaseCallback& callback);
+    uint32_t Drain();
+    void GetStats(nri::DeferredReleaseQueueStats& stats) const;
+
+private:
+    void Push(const DeferredRelease& deferredRelease);
+    void Release(const DeferredRelease& deferredRelease) const;
+    void ThreadMain();
+
+private:
+    nri::Device& m_Device;
+    const nri::CoreInterface& m_NRI;
+    nri::DeferredReleaseQueueDesc m_Desc = {};
+    Vector<DeferredRelease> m_Pending;               // in order of queueing
+    Vector<DeferredRelease> m_Ready;                 // reused by "Drain"
+    mutable Lock m_Lock{"DeferredReleaseQueue"};     // guards "m_Pending" and stats
+    Lock m_DrainLock{"DeferredReleaseQueue::Drain"}; // guards "m_Ready"
+    std::thread m_Thread;
+    std::mutex m_Mutex;
+    std::condition_variable m_WakeUp;
+    uint64_t m_ReleasedNum = 0;
+    uint32_t m_PendingMaxNum = 0;
+    bool m_IsExitRequested = false;
+};
@@ -0,0 +1,144 @@
+DeferredReleaseQueueImpl::~DeferredReleaseQueueImpl() {
+    if (m_Thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_IsExitRequested = true;
+        }
+        m_WakeUp.notify_one();
+
+        m_Thread.join();
+    }
+
+    // Everything must be released
+    for (const DeferredRelease& deferredRelease : m_Pending) {
+        if (m_NRI.GetFenceValue(*deferredRelease.fence) < deferredRelease.value)
+            m_NRI.Wait(*deferredRelease.fence, deferredRelease.value);
+
+        Release(deferredRelease);
+    }
+}
+
+Result DeferredReleaseQueueImpl::Create(const DeferredReleaseQueueDesc& desc) {
+    m_Desc = desc;
+
+    if (desc.enableBackgroundThread)
+        m_Thread = std::thread(&DeferredReleaseQueueImpl::ThreadMain, this);
+
+    return Result::SUCCESS;
+}
+
+void DeferredReleaseQueueImpl::DeferRelease(Fence& fence, uint64_t value, DeferredReleaseType type, void* object) {
+    if (!object)
+        return;
+
+    Push({&fence, value, object, nullptr, type});
+}
+
+void DeferredReleaseQueueImpl::DeferCallback(Fence& fence, uint64_t value, const DeferredReleaseCallback& callback) {
+    if (!callback.Callback)
+        return;
+
+    Push({&fence, value, callback.userArg, callback.Callback, DeferredReleaseType::MAX_NUM});
+}
+
+uint32_t DeferredReleaseQueueImpl::Drain() {
+    ExclusiveScope drainLock(m_DrainLock);
+
+    { // Move ready releases out of the pending list, preserving the order
+        ExclusiveScope lock(m_Lock);
+
+        size_t budget = m_Desc.releaseBudget ? m_Desc.releaseBudget : m_Pending.size();
+        const Fence* fence = nullptr;
+        uint64_t completedValue = 0;
+        size_t n = 0;
+
+        for (const DeferredRelease& deferredRelease : m_Pending) {
+            if (m_Ready.size() < budget) {
+                // Neighbors usually share a fence
+                if (deferredRelease.fence != fence) {
+                    fence = deferredRelease.fence;
+                    completedValue = m_NRI.GetFenceValue(*deferredRelease.fence);
+                }
+
+                if (deferredRelease.value <= completedValue) {
+                    m_Ready.push_back(deferredRelease);
+                    continue;
+                }
+            }
+
+            m_Pending[n++] = deferredRelease;
+        }
+
+        m_Pending.resize(n);
+        m_ReleasedNum += m_Ready.size();
+    }
+
+    // Release outside of the lock to not block "DeferRelease" callers
+    for (const DeferredRelease& deferredRelease : m_Ready)
+        Release(deferredRelease);
+
+    uint32_t releasedNum = (uint32_t)m_Ready.size();
+    m_Ready.clear();
+
+    return releasedNum;
+}
+
+void DeferredReleaseQueueImpl::GetStats(DeferredReleaseQueueStats& stats) const {
+    ExclusiveScope lock(m_Lock);
+
+    stats = {};
+    stats.pendingNum = (uint32_t)m_Pending.size();
+    stats.pendingMaxNum = m_PendingMaxNum;
+    stats.releasedNum = m_ReleasedNum;
+}
+
+void DeferredReleaseQueueImpl::Push(const DeferredRelease& deferredRelease) {
+    ExclusiveScope lock(m_Lock);
+
+    m_Pending.push_back(deferredRelease);
+    m_PendingMaxNum = std::max(m_PendingMaxNum, (uint32_t)m_Pending.size());
+}
+
+void DeferredReleaseQueueImpl::Release(const DeferredRelease& deferredRelease) const {
+    if (deferredRelease.callback) {
+        deferredRelease.callback(deferredRelease.object);
+        return;
+    }
+
+    switch (deferredRelease.type) {
+        case DeferredReleaseType::BUFFER:
+            m_NRI.DestroyBuffer(*(Buffer*)deferredRelease.object);
+            break;
+        case DeferredReleaseType::TEXTURE:
+            m_NRI.DestroyTexture(*(Texture*)deferredRelease.object);
+            break;
+        case DeferredReleaseType::DESCRIPTOR:
+            m_NRI.DestroyDescriptor(*(Descriptor*)deferredRelease.object);
+            break;
+        case DeferredReleaseType::PIPELINE:
+            m_NRI.DestroyPipeline(*(Pipeline*)deferredRelease.object);
+            break;
+        case DeferredReleaseType::QUERY_POOL:
+            m_NRI.DestroyQueryPool(*(QueryPool*)deferredRelease.object);
+            break;
+        case DeferredReleaseType::MEMORY:
+            m_NRI.FreeMemory(*(Memory*)deferredRelease.object);
+            break;
+        default:
+            break;
+    }
+}
+
+void DeferredReleaseQueueImpl::ThreadMain() {
+    auto period = std::chrono::milliseconds(m_Desc.backgroundThreadPeriodMs ? m_Desc.backgroundThreadPeriodMs : 1);
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            if (m_WakeUp.wait_for(lock, period, [&] { return m_IsExitRequested; }))
+                break;
+        }
+
+        Drain();
+    }
+}
@@ -2,6 +2,8 @@
 
 #pragma once
 
+struct ProfilerImpl;
+
 namespace nri {
 
 /*
@@ -39,16 +41,48 @@ struct DebugNameBaseVal {
     }
 };
 
+struct MappedMemoryStatsImpl {
+    std::atomic_uint64_t flushNum{0};
+    std::atomic_uint64_t flushRangeNum{0};
+    std::atomic_uint64_t invalidateNum{0};
+    std::atomic_uint64_t invalidateRangeNum{0};
+
+    inline void Get(MappedMemoryStats& stats) const {
+        stats.flushNum = flushNum.load(std::memory_order_relaxed);
+        stats.flushRangeNum = flushRangeNum.load(std::memory_order_relaxed);
+        stats.invalidateNum = invalidateNum.load(std::memory_order_relaxed);
+        stats.invalidateRangeNum = invalidateRangeNum.load(std::memory_order_relaxed);
+    }
+
+    inline void AddFlush(uint32_t rangeNum) {
+        flushNum.fetch_add(1, std::memory_order_relaxed);
+        flushRangeNum.fetch_add(rangeNum, std::memory_order_relaxed);
+    }
+
+    inline void AddInvalidate(uint32_t rangeNum) {
+        invalidateNum.fetch_add(1, std::memory_order_relaxed);
+        invalidateRangeNum.fetch_add(rangeNum, std::memory_order_relaxed);
+    }
+};
+
 struct DeviceBase : public DebugNameBaseVal {
     inline DeviceBase(const CallbackInterface& callbacks, const AllocationCallbacks& allocationCallbacks, uint64_t signature = 0)
         : m_CallbackInterface(callbacks)
         , m_AllocationCallbacks(allocationCallbacks)
+        , m_ApplicationAllocationCallbacks(allocationCallbacks)
         , m_StdAllocator(m_AllocationCallbacks)
 #ifndef NDEBUG
         , m_Signature(signature)
 #endif
     {
         MaybeUnused(signature);
+
+        for (ObjectPool& objectPool : m_ObjectPools)
+            objectPool.Init(m_AllocationCallbacks);
+    }
+
+    inline const CallbackInterface& GetCallbackInterface() const {
+        return m_CallbackInterface;
     }
 
     inline StdAllocator<uint8_t>& GetStdAllocator() {
@@ -59,6 +93,65 @@ struct DeviceBase : public DebugNameBaseVal {
         return m_AllocationCallbacks;
     }
 
+    // The device itself is allocated with these ones (it's a copy, since the device gets destroyed before "Free")
+    inline AllocationCallbacks GetApplicationAllocationCallbacks() const {
+        return m_ApplicationAllocationCallbacks;
+    }
+
+    // Must be called right after construction, everything allocated via "GetAllocationCallbacks" gets tracked after that
+    inline void EnableAllocationTracking(AllocationCategory forcedCategory = AllocationCategory::MAX_NUM) {
+        m_AllocationTracker.Enable(m_ApplicationAllocationCallbacks, forcedCategory);
+        m_AllocationCallbacks = m_AllocationTracker.GetAllocationCallbacks();
+    }
+
+    inline AllocationTracker& GetAllocationTracker() const {
+        return m_AllocationTracker;
+    }
+
+    inline ObjectPool& GetObjectPool(ObjectPoolType objectPoolType) const {
+        return m_ObjectPools[(size_t)objectPoolType];
+    }
+
+    inline const FenceWaitDesc& GetFenceWaitDesc() const {
+        return m_FenceWaitDesc;
+    }
+
+    inline void SetFenceWaitDesc(const FenceWaitDesc& fenceWaitDesc) {
+        m_FenceWaitDesc = fenceWaitDesc;
+    }
+
+    inline FenceWaitStatsImpl& GetFenceWaitStats() const {
+        return m_FenceWaitStats;
+    }
+
+    inline MappedMemoryStatsImpl& GetMappedMemoryStats() const {
+        return m_MappedMemoryStats;
+    }
+
+    inline BudgetMonitor& GetBudgetMonitor() const {
+        return m_BudgetMonitor;
+    }
+
+    // A profiler capturing "CmdBeginAnnotation/CmdEndAnnotation" ranges (if any)
+    inline ProfilerImpl* GetAnnotationProfiler() const {
+        return m_AnnotationProfiler;
+    }
+
+    inline void SetAnnotationProfiler(ProfilerImpl* profiler) {
+        m_AnnotationProfiler = profiler;
+    }
+
+    // Function tables returned by "nriGetInterface" get wrapped by the instrumentation
+    inline bool IsInstrumented() const {
+        return m_IsInstrumented;
+    }
+
+    inline void SetInstrumented(bool isInstrumented) {
+        m_IsInstrumented = isInstrumented;
+    }
+
+    Result FillFunctionTable(InstrumentationInterface& table) const;
+
     void ReportMessage(Message messageType, const char* file, uint32_t line, const char* format, ...) const;
 
     virtual ~DeviceBase() {
@@ -71,6 +164,14 @@ struct DeviceBase : public DebugNameBaseVal {
         return Result::UNSUPPORTED;
     }
 
+    virtual Result FillFunctionTable(CommandBufferPoolInterface&) const {
+        return Result::UNSUPPORTED;
+    }
+
+    virtual Result FillFunctionTable(DeferredReleaseInterface&) const {
+        return Result::UNSUPPORTED;
+    }
+
     virtual Result FillFunctionTable(HelperInterface&) const {
         return Result::UNSUPPORTED;
     }
@@ -83,6 +184,10 @@ struct DeviceBase : public DebugNameBaseVal {
         return Result::UNSUPPORTED;
     }
 
+    virtual Result FillFunctionTable(ProfilerInterface&) const {
+        return Result::UNSUPPORTED;
+    }
+
     virtual Result FillFunctionTable(RayTracingInterface&) const {
         return Result::UNSUPPORTED;
     }
@@ -117,7 +222,16 @@ protected:
 #endif
     CallbackInterface m_CallbackInterface = {};
     AllocationCallbacks m_AllocationCallbacks = {};
+    AllocationCallbacks m_ApplicationAllocationCallbacks = {};
     StdAllocator<uint8_t> m_StdAllocator;
+    FenceWaitDesc m_FenceWaitDesc = {};
+    mutable FenceWaitStatsImpl m_FenceWaitStats;
+    mutable MappedMemoryStatsImpl m_MappedMemoryStats;
+    mutable BudgetMonitor m_BudgetMonitor; // stopped in "nriDestroyDevice", since the thread calls into the derived device
+    ProfilerImpl* m_AnnotationProfiler = nullptr;
+    bool m_IsInstrumented = false;
+    mutable AllocationTracker m_AllocationTracker; // must outlive everything allocated via "m_AllocationCallbacks"
+    mutable std::array<ObjectPool, (size_t)ObjectPoolType::MAX_NUM> m_ObjectPools;
 };
 
 } // namespace nri
@@ -0,0 +1,81 @@
+#pragma once
+
+constexpr uint32_t FENCE_WAIT_BACKOFF_MAX = 64; // "_mm_pause" iterations, "yield" is used after that
+
+struct FenceWaitStatsImpl {
+    std::atomic_uint64_t waitNum{0};
+    std::atomic_uint64_t completedNum{0};
+    std::atomic_uint64_t spinNum{0};
+    std::atomic_uint64_t blockNum{0};
+    std::atomic_uint64_t spinTimeUs{0};
+    std::atomic_uint64_t blockTimeUs{0};
+    std::atomic_uint64_t blockTimeMaxUs{0};
+
+    inline void Get(nri::FenceWaitStats& stats) const {
+        stats.waitNum = waitNum.load(std::memory_order_relaxed);
+        stats.completedNum = completedNum.load(std::memory_order_relaxed);
+        stats.spinNum = spinNum.load(std::memory_order_relaxed);
+        stats.blockNum = blockNum.load(std::memory_order_relaxed);
+        stats.spinTimeUs = spinTimeUs.load(std::memory_order_relaxed);
+        stats.blockTimeUs = blockTimeUs.load(std::memory_order_relaxed);
+        stats.blockTimeMaxUs = blockTimeMaxUs.load(std::memory_order_relaxed);
+    }
+};
+
+// "isCompleted" polls the fence value, "block" is the OS wait
+template <typename IsCompleted, typename Block>
+inline void WaitForFence(const nri::FenceWaitDesc& fenceWaitDesc, FenceWaitStatsImpl& stats, IsCompleted isCompleted, Block block) {
+    using namespace std::chrono;
+
+    stats.waitNum.fetch_add(1, std::memory_order_relaxed);
+
+    if (isCompleted()) {
+        stats.completedNum.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto start = steady_clock::now();
+
+    // Spin
+    if (fenceWaitDesc.policy != nri::FenceWaitPolicy::BLOCK && fenceWaitDesc.spinTimeUs) {
+        auto deadline = start + microseconds(fenceWaitDesc.spinTimeUs);
+        uint32_t backoff = 1;
+
+        while (true) {
+            if (isCompleted()) {
+                stats.spinNum.fetch_add(1, std::memory_order_relaxed);
+                stats.spinTimeUs.fetch_add(duration_cast<microseconds>(steady_clock::now() - start).count(), std::memory_order_relaxed);
+                return;
+            }
+
+            if (steady_clock::now() >= deadline)
+                break;
+
+            if (fenceWaitDesc.policy == nri::FenceWaitPolicy::HYBRID) {
+                if (backoff > FENCE_WAIT_BACKOFF_MAX)
+                    std::this_thread::yield();
+                else {
+                    for (uint32_t i = 0; i < backoff; i++)
+                        _mm_pause();
+
+                    backoff <<= 1;
+                }
+            } else
+                _mm_pause();
+        }
+    }
+
+    // Block
+    auto blockStart = steady_clock::now();
+    block();
+    auto end = steady_clock::now();
+
+    uint64_t blockTimeUs = duration_cast<microseconds>(end - blockStart).count();
+    uint64_t blockTimeMaxUs = stats.blockTimeMaxUs.load(std::memory_order_relaxed);
+    while (blockTimeUs > blockTimeMaxUs && !stats.blockTimeMaxUs.compare_exchange_weak(blockTimeMaxUs, blockTimeUs, std::memory_order_relaxed))
+        ;
+
+    stats.blockNum.fetch_add(1, std::memory_order_relaxed);
+    stats.spinTimeUs.fetch_add(duration_cast<microseconds>(blockStart - start).count(), std::memory_order_relaxed);
+    stats.blockTimeUs.fetch_add(blockTimeUs, std::memory_order_relaxed);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+// Dense "Format"-indexed cache of "GetFormatSupport" results. Entries are filled lazily on the first query and
+// published atomically (concurrent first queries may both hit the driver, but they produce the same value)
+struct FormatSupportCache {
+    static constexpr uint32_t CACHED = 1u << 31;
+
+    template <typename Query>
+    inline nri::FormatSupportBits Get(nri::Format format, Query query) const {
+        if (format >= nri::Format::MAX_NUM)
+            return nri::FormatSupportBits::UNSUPPORTED;
+
+        std::atomic_uint32_t& entry = m_Entries[(size_t)format];
+
+        uint32_t value = entry.load(std::memory_order_acquire);
+        if (!(value & CACHED)) {
+            value = (uint32_t)query(format) | CACHED;
+            entry.store(value, std::memory_order_release);
+        }
+
+        return (nri::FormatSupportBits)(value & ~CACHED);
+    }
+
+private:
+    mutable std::array<std::atomic_uint32_t, (size_t)nri::Format::MAX_NUM> m_Entries = {};
+};
@@ -0,0 +1,395 @@
+#pragma once
+
+#include "Tracer.h"
+
+// Function tables returned by "nriGetInterface" get patched to point to "InstrumentedCall<Function>::Call<Index>", which
+// times the original function. Wrappers are shared by all devices, i.e. the first instrumented device defines "originals"
+
+constexpr uint32_t INSTRUMENTATION_SUB_BUCKET_BITS = 2;
+constexpr uint32_t INSTRUMENTATION_SUB_BUCKET_NUM = 1 << INSTRUMENTATION_SUB_BUCKET_BITS;
+constexpr uint32_t INSTRUMENTATION_BUCKET_NUM = 128; // log-linear, up to ~8 s
+
+#define NRI_INSTRUMENTED_CORE(X) \
+    X(CoreInterface, GetDeviceDesc) \
+    X(CoreInterface, GetBufferDesc) \
+    X(CoreInterface, GetTextureDesc) \
+    X(CoreInterface, GetFormatSupport) \
+    X(CoreInterface, GetQuerySize) \
+    X(CoreInterface, GetBufferMemoryDesc) \
+    X(CoreInterface, GetTextureMemoryDesc) \
+    X(CoreInterface, GetBufferMemoryDesc2) \
+    X(CoreInterface, GetTextureMemoryDesc2) \
+    X(CoreInterface, GetQueue) \
+    X(CoreInterface, CreateCommandAllocator) \
+    X(CoreInterface, CreateCommandBuffer) \
+    X(CoreInterface, CreateSecondaryCommandBuffer) \
+    X(CoreInterface, CreateFence) \
+    X(CoreInterface, CreateDescriptorPool) \
+    X(CoreInterface, CreateBuffer) \
+    X(CoreInterface, CreateTexture) \
+    X(CoreInterface, CreatePipelineLayout) \
+    X(CoreInterface, CreateGraphicsPipeline) \
+    X(CoreInterface, CreateComputePipeline) \
+    X(CoreInterface, CreateQueryPool) \
+    X(CoreInterface, CreateSampler) \
+    X(CoreInterface, CreateBufferView) \
+    X(CoreInterface, CreateTexture1DView) \
+    X(CoreInterface, CreateTexture2DView) \
+    X(CoreInterface, CreateTexture3DView) \
+    X(CoreInterface, DestroyCommandAllocator) \
+    X(CoreInterface, DestroyCommandBuffer) \
+    X(CoreInterface, DestroyDescriptorPool) \
+    X(CoreInterface, DestroyBuffer) \
+    X(CoreInterface, DestroyTexture) \
+    X(CoreInterface, DestroyDescriptor) \
+    X(CoreInterface, DestroyPipelineLayout) \
+    X(CoreInterface, DestroyPipeline) \
+    X(CoreInterface, DestroyQueryPool) \
+    X(CoreInterface, DestroyFence) \
+    X(CoreInterface, AllocateMemory) \
+    X(CoreInterface, BindBufferMemory) \
+    X(CoreInterface, BindTextureMemory) \
+    X(CoreInterface, FreeMemory) \
+    X(CoreInterface, AllocateDescriptorSets) \
+    X(CoreInterface, ResetDescriptorPool) \
+    X(CoreInterface, UpdateDescriptorRanges) \
+    X(CoreInterface, UpdateDynamicConstantBuffers) \
+    X(CoreInterface, CopyDescriptorSet) \
+    X(CoreInterface, BeginCommandBuffer) \
+    X(CoreInterface, BeginSecondaryCommandBuffer) \
+    X(CoreInterface, CmdSetDescriptorPool) \
+    X(CoreInterface, CmdSetPipelineLayout) \
+    X(CoreInterface, CmdSetPipeline) \
+    X(CoreInterface, CmdSetDescriptorSet) \
+    X(CoreInterface, CmdSetRootConstants) \
+    X(CoreInterface, CmdSetRootDescriptor) \
+    X(CoreInterface, CmdBarrier) \
+    X(CoreInterface, CmdSetIndexBuffer) \
+    X(CoreInterface, CmdSetVertexBuffers) \
+    X(CoreInterface, CmdSetViewports) \
+    X(CoreInterface, CmdSetScissors) \
+    X(CoreInterface, CmdSetStencilReference) \
+    X(CoreInterface, CmdSetDepthBounds) \
+    X(CoreInterface, CmdSetBlendConstants) \
+    X(CoreInterface, CmdSetSampleLocations) \
+    X(CoreInterface, CmdSetShadingRate) \
+    X(CoreInterface, CmdSetDepthBias) \
+    X(CoreInterface, CmdBeginRendering) \
+    X(CoreInterface, CmdClearAttachments) \
+    X(CoreInterface, CmdDraw) \
+    X(CoreInterface, CmdDrawIndexed) \
+    X(CoreInterface, CmdDrawIndirect) \
+    X(CoreInterface, CmdDrawIndexedIndirect) \
+    X(CoreInterface, CmdExecuteCommandBuffers) \
+    X(CoreInterface, CmdEndRendering) \
+    X(CoreInterface, CmdDispatch) \
+    X(CoreInterface, CmdDispatchIndirect) \
+    X(CoreInterface, CmdCopyBuffer) \
+    X(CoreInterface, CmdCopyTexture) \
+    X(CoreInterface, CmdResolveTexture) \
+    X(CoreInterface, CmdUploadBufferToTexture) \
+    X(CoreInterface, CmdReadbackTextureToBuffer) \
+    X(CoreInterface, CmdClearStorageBuffer) \
+    X(CoreInterface, CmdClearStorageTexture) \
+    X(CoreInterface, CmdResetQueries) \
+    X(CoreInterface, CmdBeginQuery) \
+    X(CoreInterface, CmdEndQuery) \
+    X(CoreInterface, CmdCopyQueries) \
+    X(CoreInterface, CmdBeginAnnotation) \
+    X(CoreInterface, CmdEndAnnotation) \
+    X(CoreInterface, CmdAnnotation) \
+    X(CoreInterface, EndCommandBuffer) \
+    X(CoreInterface, QueueBeginAnnotation) \
+    X(CoreInterface, QueueEndAnnotation) \
+    X(CoreInterface, QueueAnnotation) \
+    X(CoreInterface, ResetQueries) \
+    X(CoreInterface, QueueSubmit) \
+    X(CoreInterface, QueueSubmitBatch) \
+    X(CoreInterface, Wait) \
+    X(CoreInterface, WaitMany) \
+    X(CoreInterface, GetFenceValue) \
+    X(CoreInterface, WaitWithPolicy) \
+    X(CoreInterface, GetFenceWaitStats) \
+    X(CoreInterface, ResetCommandAllocator) \
+    X(CoreInterface, MapBuffer) \
+    X(CoreInterface, UnmapBuffer) \
+    X(CoreInterface, MapBufferWithMode) \
+    X(CoreInterface, FlushBufferRanges) \
+    X(CoreInterface, InvalidateBufferRanges) \
+    X(CoreInterface, GetMappedMemoryStats) \
+    X(CoreInterface, SetDebugName) \
+    X(CoreInterface, GetDeviceNativeObject) \
+    X(CoreInterface, GetQueueNativeObject) \
+    X(CoreInterface, GetCommandBufferNativeObject) \
+    X(CoreInterface, GetBufferNativeObject) \
+    X(CoreInterface, GetTextureNativeObject) \
+    X(CoreInterface, GetDescriptorNativeObject)
+
+#define NRI_INSTRUMENTED_COMMAND_BUFFER_POOL(X) \
+    X(CommandBufferPoolInterface, CreateCommandBufferPool) \
+    X(CommandBufferPoolInterface, DestroyCommandBufferPool) \
+    X(CommandBufferPoolInterface, BeginCommandBufferPoolFrame) \
+    X(CommandBufferPoolInterface, EndCommandBufferPoolFrame) \
+    X(CommandBufferPoolInterface, AcquireCommandBuffer) \
+    X(CommandBufferPoolInterface, GetCommandBufferPoolStats)
+
+#define NRI_INSTRUMENTED_DEFERRED_RELEASE(X) \
+    X(DeferredReleaseInterface, CreateDeferredReleaseQueue) \
+    X(DeferredReleaseInterface, DestroyDeferredReleaseQueue) \
+    X(DeferredReleaseInterface, DeferRelease) \
+    X(DeferredReleaseInterface, DeferCallback) \
+    X(DeferredReleaseInterface, DrainDeferredReleases) \
+    X(DeferredReleaseInterface, GetDeferredReleaseQueueStats)
+
+#define NRI_INSTRUMENTED_HELPER(X) \
+    X(HelperInterface, CalculateAllocationNumber) \
+    X(HelperInterface, AllocateAndBindMemory) \
+    X(HelperInterface, UploadData) \
+    X(HelperInterface, WaitForIdle) \
+    X(HelperInterface, QueryVideoMemoryInfo) \
+    X(HelperInterface, SetBudgetMonitor) \
+    X(HelperInterface, GetTrackedVideoMemoryInfo) \
+    X(HelperInterface, GetObjectPoolStats) \
+    X(HelperInterface, GetAllocationStats) \
+    X(HelperInterface, ResetAllocationStats) \
+    X(HelperInterface, GetMemoryDescCacheStats) \
+    X(HelperInterface, GetDescriptorCacheStats) \
+    X(HelperInterface, GetCommandBufferStats)
+
+#define NRI_INSTRUMENTED_LOW_LATENCY(X) \
+    X(LowLatencyInterface, SetLatencySleepMode) \
+    X(LowLatencyInterface, SetLatencyMarker) \
+    X(LowLatencyInterface, LatencySleep) \
+    X(LowLatencyInterface, GetLatencyReport) \
+    X(LowLatencyInterface, QueueSubmitTrackable)
+
+#define NRI_INSTRUMENTED_MESH_SHADER(X) \
+    X(MeshShaderInterface, CmdDrawMeshTasks) \
+    X(MeshShaderInterface, CmdDrawMeshTasksIndirect)
+
+#define NRI_INSTRUMENTED_PROFILER(X) \
+    X(ProfilerInterface, CreateProfiler) \
+    X(ProfilerInterface, DestroyProfiler) \
+    X(ProfilerInterface, BeginProfilerFrame) \
+    X(ProfilerInterface, EndProfilerFrame) \
+    X(ProfilerInterface, CmdBeginProfilerZone) \
+    X(ProfilerInterface, CmdEndProfilerZone) \
+    X(ProfilerInterface, CmdResolveProfilerFrame) \
+    X(ProfilerInterface, GetProfilerFrame)
+
+#define NRI_INSTRUMENTED_RAY_TRACING(X) \
+    X(RayTracingInterface, GetAccelerationStructureMemoryDesc2) \
+    X(RayTracingInterface, GetAccelerationStructureMemoryDesc) \
+    X(RayTracingInterface, GetAccelerationStructureUpdateScratchBufferSize) \
+    X(RayTracingInterface, GetAccelerationStructureBuildScratchBufferSize) \
+    X(RayTracingInterface, GetAccelerationStructureHandle) \
+    X(RayTracingInterface, CreateRayTracingPipeline) \
+    X(RayTracingInterface, CreateAccelerationStructure) \
+    X(RayTracingInterface, CreateAccelerationStructureDescriptor) \
+    X(RayTracingInterface, DestroyAccelerationStructure) \
+    X(RayTracingInterface, BindAccelerationStructureMemory) \
+    X(RayTracingInterface, WriteShaderGroupIdentifiers) \
+    X(RayTracingInterface, CmdBuildTopLevelAccelerationStructure) \
+    X(RayTracingInterface, CmdBuildBottomLevelAccelerationStructure) \
+    X(RayTracingInterface, CmdUpdateTopLevelAccelerationStructure) \
+    X(RayTracingInterface, CmdUpdateBottomLevelAccelerationStructure) \
+    X(RayTracingInterface, CmdDispatchRays) \
+    X(RayTracingInterface, CmdDispatchRaysIndirect) \
+    X(RayTracingInterface, CmdCopyAccelerationStructure) \
+    X(RayTracingInterface, CmdWriteAccelerationStructureSize) \
+    X(RayTracingInterface, GetAccelerationStructureNativeObject)
+
+#define NRI_INSTRUMENTED_RESOURCE_ALLOCATOR(X) \
+    X(ResourceAllocatorInterface, AllocateBuffer) \
+    X(ResourceAllocatorInterface, AllocateTexture) \
+    X(ResourceAllocatorInterface, AllocateAccelerationStructure) \
+    X(ResourceAllocatorInterface, CreateAllocatorPool) \
+    X(ResourceAllocatorInterface, DestroyAllocatorPool) \
+    X(ResourceAllocatorInterface, GetAllocatorStats) \
+    X(ResourceAllocatorInterface, GetAllocatorPoolStats) \
+    X(ResourceAllocatorInterface, BeginDefragmentation) \
+    X(ResourceAllocatorInterface, GetDefragmentationPass) \
+    X(ResourceAllocatorInterface, EndDefragmentationPass) \
+    X(ResourceAllocatorInterface, EndDefragmentation)
+
+#define NRI_INSTRUMENTED_STREAMER(X) \
+    X(StreamerInterface, CreateStreamer) \
+    X(StreamerInterface, DestroyStreamer) \
+    X(StreamerInterface, GetStreamerConstantBuffer) \
+    X(StreamerInterface, GetStreamerDynamicBuffer) \
+    X(StreamerInterface, AddStreamerBufferUpdateRequest) \
+    X(StreamerInterface, AddStreamerTextureUpdateRequest) \
+    X(StreamerInterface, UpdateStreamerConstantBuffer) \
+    X(StreamerInterface, CopyStreamerUpdateRequests) \
+    X(StreamerInterface, CmdUploadStreamerUpdateRequests)
+
+#define NRI_INSTRUMENTED_SWAP_CHAIN(X) \
+    X(SwapChainInterface, CreateSwapChain) \
+    X(SwapChainInterface, DestroySwapChain) \
+    X(SwapChainInterface, GetSwapChainTextures) \
+    X(SwapChainInterface, AcquireNextSwapChainTexture) \
+    X(SwapChainInterface, WaitForPresent) \
+    X(SwapChainInterface, QueuePresent) \
+    X(SwapChainInterface, GetDisplayDesc)
+
+#define NRI_INSTRUMENTED_FUNCTIONS(X) \
+    NRI_INSTRUMENTED_CORE(X) \
+    NRI_INSTRUMENTED_COMMAND_BUFFER_POOL(X) \
+    NRI_INSTRUMENTED_DEFERRED_RELEASE(X) \
+    NRI_INSTRUMENTED_HELPER(X) \
+    NRI_INSTRUMENTED_LOW_LATENCY(X) \
+    NRI_INSTRUMENTED_MESH_SHADER(X) \
+    NRI_INSTRUMENTED_PROFILER(X) \
+    NRI_INSTRUMENTED_RAY_TRACING(X) \
+    NRI_INSTRUMENTED_RESOURCE_ALLOCATOR(X) \
+    NRI_INSTRUMENTED_STREAMER(X) \
+    NRI_INSTRUMENTED_SWAP_CHAIN(X)
+
+#define NRI_INSTRUMENTATION_INDEX(interfaceName, functionName) INSTRUMENTED_##interfaceName##_##functionName,
+
+enum InstrumentedFunction : uint32_t {
+    NRI_INSTRUMENTED_FUNCTIONS(NRI_INSTRUMENTATION_INDEX)
+
+    INSTRUMENTED_FUNCTION_NUM
+};
+
+#undef NRI_INSTRUMENTATION_INDEX
+
+typedef void(NRI_CALL* InstrumentationOriginal)();
+
+struct InstrumentationSlot {
+    std::array<std::atomic_uint32_t, INSTRUMENTATION_BUCKET_NUM> histogram; // the sum is the number of calls
+    std::atomic_uint64_t totalNs;
+    std::atomic_uint64_t maxNs;
+    InstrumentationOriginal original;
+    const char* interfaceName;
+    const char* functionName;
+};
+
+// Process-wide statistics, exposed via "InstrumentationInterface"
+struct Instrumentation {
+    static Instrumentation& Get();
+
+    inline InstrumentationSlot& GetSlot(uint32_t index) {
+        return m_Slots[index];
+    }
+
+    inline Lock& GetLock() {
+        return m_Lock;
+    }
+
+    static inline uint64_t GetTimestamp() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static inline uint32_t GetBucketIndex(uint64_t ns) {
+        if (ns < INSTRUMENTATION_SUB_BUCKET_NUM)
+            return (uint32_t)ns;
+
+        uint32_t exponent = 63;
+        while (!(ns >> exponent))
+            exponent--;
+
+        uint32_t bucketIndex = (exponent - INSTRUMENTATION_SUB_BUCKET_BITS + 1) * INSTRUMENTATION_SUB_BUCKET_NUM;
+        bucketIndex += (uint32_t)(ns >> (exponent - INSTRUMENTATION_SUB_BUCKET_BITS)) & (INSTRUMENTATION_SUB_BUCKET_NUM - 1);
+
+        return std::min(bucketIndex, INSTRUMENTATION_BUCKET_NUM - 1);
+    }
+
+    inline void Add(InstrumentationSlot& slot, uint64_t ns) {
+        slot.histogram[GetBucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+        slot.totalNs.fetch_add(ns, std::memory_order_relaxed);
+
+        uint64_t maxNs = slot.maxNs.load(std::memory_order_relaxed);
+        while (ns > maxNs && !slot.maxNs.compare_exchange_weak(maxNs, ns, std::memory_order_relaxed))
+            ;
+    }
+
+    // Expects "GetLock()" to be held. A function differing from the already hooked one (another backend) is left as is
+    template <uint32_t Index, typename Function>
+    void Hook(Function& function, const char* interfaceName, const char* functionName);
+
+    void GetStats(nri::InstrumentationStats* stats, uint32_t& statNum) const;
+    void ResetStats();
+
+private:
+    std::array<InstrumentationSlot, INSTRUMENTED_FUNCTION_NUM> m_Slots = {};
+    Lock m_Lock{"Instrumentation"};
+};
+
+template <typename Function>
+struct InstrumentedCall;
+
+template <typename R, typename... Args>
+struct InstrumentedCall<R(NRI_CALL*)(Args...)> {
+    template <uint32_t Index>
+    static R NRI_CALL Call(Args... args) {
+        InstrumentationSlot& slot = Instrumentation::Get().GetSlot(Index);
+
+        TraceScope traceScope(slot.functionName);
+        InstrumentationScope instrumentationScope(slot);
+
+        // The validation layer reports barrier issues per call site
+        if constexpr (Index == INSTRUMENTED_CoreInterface_CmdBarrier) {
+            ForwardedCallSiteScope forwardedCallSiteScope(NRI_CALL_SITE);
+            return ((R(NRI_CALL*)(Args...))slot.original)(args...);
+        } else
+            return ((R(NRI_CALL*)(Args...))slot.original)(args...);
+    }
+
+private:
+    struct InstrumentationScope {
+        inline InstrumentationScope(InstrumentationSlot& slot)
+            : m_Slot(slot)
+            , m_Begin(Instrumentation::GetTimestamp()) {
+        }
+
+        inline ~InstrumentationScope() {
+            Instrumentation::Get().Add(m_Slot, Instrumentation::GetTimestamp() - m_Begin);
+        }
+
+    private:
+        InstrumentationSlot& m_Slot;
+        uint64_t m_Begin;
+    };
+};
+
+template <uint32_t Index, typename Function>
+void Instrumentation::Hook(Function& function, const char* interfaceName, const char* functionName) {
+    InstrumentationSlot& slot = m_Slots[Index];
+
+    InstrumentationOriginal original = (InstrumentationOriginal)function;
+    if (!slot.original) {
+        slot.original = original;
+        slot.interfaceName = interfaceName;
+        slot.functionName = functionName;
+    } else if (slot.original != original)
+        return;
+
+    function = &InstrumentedCall<Function>::template Call<Index>;
+}
+
+#define NRI_INSTRUMENTATION_HOOK(interfaceName, functionName) \
+    instrumentation.Hook<INSTRUMENTED_##interfaceName##_##functionName>(table.functionName, #interfaceName, #functionName);
+
+#define NRI_INSTRUMENT_FUNCTION_TABLE(interfaceName, list) \
+    inline void InstrumentFunctionTable(nri::interfaceName& table) { \
+        Instrumentation& instrumentation = Instrumentation::Get(); \
+        ExclusiveScope lock(instrumentation.GetLock()); \
+        list(NRI_INSTRUMENTATION_HOOK) \
+    }
+
+NRI_INSTRUMENT_FUNCTION_TABLE(CoreInterface, NRI_INSTRUMENTED_CORE)
+NRI_INSTRUMENT_FUNCTION_TABLE(CommandBufferPoolInterface, NRI_INSTRUMENTED_COMMAND_BUFFER_POOL)
+NRI_INSTRUMENT_FUNCTION_TABLE(DeferredReleaseInterface, NRI_INSTRUMENTED_DEFERRED_RELEASE)
+NRI_INSTRUMENT_FUNCTION_TABLE(HelperInterface, NRI_INSTRUMENTED_HELPER)
+NRI_INSTRUMENT_FUNCTION_TABLE(LowLatencyInterface, NRI_INSTRUMENTED_LOW_LATENCY)
+NRI_INSTRUMENT_FUNCTION_TABLE(MeshShaderInterface, NRI_INSTRUMENTED_MESH_SHADER)
+NRI_INSTRUMENT_FUNCTION_TABLE(ProfilerInterface, NRI_INSTRUMENTED_PROFILER)
+NRI_INSTRUMENT_FUNCTION_TABLE(RayTracingInterface, NRI_INSTRUMENTED_RAY_TRACING)
+NRI_INSTRUMENT_FUNCTION_TABLE(ResourceAllocatorInterface, NRI_INSTRUMENTED_RESOURCE_ALLOCATOR)
+NRI_INSTRUMENT_FUNCTION_TABLE(StreamerInterface, NRI_INSTRUMENTED_STREAMER)
+NRI_INSTRUMENT_FUNCTION_TABLE(SwapChainInterface, NRI_INSTRUMENTED_SWAP_CHAIN)
+
+#undef NRI_INSTRUMENT_FUNCTION_TABLE
+#undef NRI_INSTRUMENTATION_HOOK
@@ -0,0 +1,87 @@
+static inline uint64_t GetBucketValue(uint32_t bucketIndex) {
+    if (bucketIndex < INSTRUMENTATION_SUB_BUCKET_NUM)
+        return bucketIndex;
+
+    uint32_t shift = bucketIndex / INSTRUMENTATION_SUB_BUCKET_NUM - 1;
+    uint64_t lower = (uint64_t)(INSTRUMENTATION_SUB_BUCKET_NUM + bucketIndex % INSTRUMENTATION_SUB_BUCKET_NUM) << shift;
+
+    return lower + ((1ull << shift) >> 1); // the middle of the bucket
+}
+
+Instrumentation& Instrumentation::Get() {
+    static Instrumentation instrumentation;
+
+    return instrumentation;
+}
+
+void Instrumentation::GetStats(InstrumentationStats* stats, uint32_t& statNum) const {
+    uint32_t statIndex = 0;
+    for (const InstrumentationSlot& slot : m_Slots) {
+        std::array<uint32_t, INSTRUMENTATION_BUCKET_NUM> histogram;
+        uint64_t callNum = 0;
+        for (uint32_t i = 0; i < INSTRUMENTATION_BUCKET_NUM; i++) {
+            histogram[i] = slot.histogram[i].load(std::memory_order_relaxed);
+            callNum += histogram[i];
+        }
+
+        if (!callNum)
+            continue;
+
+        if (stats) {
+            if (statIndex == statNum)
+                break;
+
+            InstrumentationStats& stat = stats[statIndex];
+            stat = {};
+            stat.interfaceName = slot.interfaceName;
+            stat.functionName = slot.functionName;
+            stat.callNum = callNum;
+            stat.totalNs = slot.totalNs.load(std::memory_order_relaxed);
+            stat.maxNs = slot.maxNs.load(std::memory_order_relaxed);
+
+            // Percentiles
+            uint64_t* percentiles[] = {&stat.medianNs, &stat.p95Ns, &stat.p99Ns};
+            const uint64_t ranks[] = {(callNum * 50 + 99) / 100, (callNum * 95 + 99) / 100, (callNum * 99 + 99) / 100};
+
+            uint64_t cumulative = 0;
+            uint32_t percentileIndex = 0;
+            for (uint32_t i = 0; i < INSTRUMENTATION_BUCKET_NUM && percentileIndex < GetCountOf(ranks); i++) {
+                cumulative += histogram[i];
+                while (percentileIndex < GetCountOf(ranks) && cumulative >= ranks[percentileIndex])
+                    *percentiles[percentileIndex++] = std::min(GetBucketValue(i), stat.maxNs);
+            }
+        }
+
+        statIndex++;
+    }
+
+    statNum = statIndex;
+}
+
+void Instrumentation::ResetStats() {
+    for (InstrumentationSlot& slot : m_Slots) {
+        for (std::atomic_uint32_t& bucket : slot.histogram)
+            bucket.store(0, std::memory_order_relaxed);
+
+        slot.totalNs.store(0, std::memory_order_relaxed);
+        slot.maxNs.store(0, std::memory_order_relaxed);
+    }
+}
+
+static void NRI_CALL GetInstrumentationStats(const Device&, InstrumentationStats* stats, uint32_t& statNum) {
+    Instrumentation::Get().GetStats(stats, statNum);
+}
+
+static void NRI_CALL ResetInstrumentationStats(Device&) {
+    Instrumentation::Get().ResetStats();
+}
+
+Result DeviceBase::FillFunctionTable(InstrumentationInterface& table) const {
+    if (!m_IsInstrumented)
+        return Result::UNSUPPORTED;
+
+    table.GetInstrumentationStats = ::GetInstrumentationStats;
+    table.ResetInstrumentationStats = ::ResetInstrumentationStats;
+
+    return Result::SUCCESS;
+}
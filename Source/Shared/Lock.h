@@ -1,6 +1,18 @@
 #pragma once
 
+#if NRI_ENABLE_LOCK_STATS
+#    include <cstdio>
+#    include <mutex>
+#endif
+
+#if defined(__linux__)
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
 constexpr size_t LOCK_CACHELINE_SIZE = 64;
+constexpr uint32_t LOCK_BACKOFF_MAX = 256; // "_mm_pause" iterations, the thread gets parked after that
 
 // Found in sse2neon
 #if (defined(__arm__) || defined(__aarch64__) || defined(_M_ARM64) || defined(_M_ARM))
@@ -15,23 +27,195 @@ inline void _mm_pause() {
 #    include <xmmintrin.h>
 #endif
 
-// Very lightweight exclusive lock
+// Parking: sleep while "*address == value"
+inline void LockPark(std::atomic_uint32_t& atomic, uint32_t value) {
+    static_assert(sizeof(std::atomic_uint32_t) == sizeof(uint32_t), "Unexpected");
+
+#if defined(_WIN32)
+    WaitOnAddress(&atomic, &value, sizeof(value), INFINITE);
+#elif defined(__linux__)
+    syscall(SYS_futex, (uint32_t*)&atomic, FUTEX_WAIT_PRIVATE, value, nullptr, nullptr, 0);
+#else
+    MaybeUnused(atomic, value);
+    std::this_thread::yield();
+#endif
+}
+
+inline void LockUnpark(std::atomic_uint32_t& atomic) {
+#if defined(_WIN32)
+    WakeByAddressSingle(&atomic);
+#elif defined(__linux__)
+    syscall(SYS_futex, (uint32_t*)&atomic, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+    MaybeUnused(atomic);
+#endif
+}
+
+struct LockStats {
+    uint64_t acquireNum;
+    uint64_t contendedNum;
+    uint64_t spinNum;
+    uint64_t parkNum;
+};
+
+#if NRI_ENABLE_LOCK_STATS
+
+constexpr uint32_t LOCK_STATS_NAME_MAX_NUM = 64;
+
+// Destroyed locks accumulate their counters here (per name), since most of them die with their device
+struct LockStatsRegistry {
+    std::mutex mutex;
+    const char* names[LOCK_STATS_NAME_MAX_NUM] = {};
+    LockStats stats[LOCK_STATS_NAME_MAX_NUM] = {};
+    uint32_t nameNum = 0;
+};
+
+inline LockStatsRegistry& GetLockStatsRegistry() {
+    static LockStatsRegistry registry;
+
+    return registry;
+}
+
+inline void AccumulateLockStats(const char* name, const LockStats& lockStats) {
+    LockStatsRegistry& registry = GetLockStatsRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+
+    uint32_t i = 0;
+    while (i < registry.nameNum && strcmp(registry.names[i], name))
+        i++;
+
+    if (i == registry.nameNum) {
+        if (registry.nameNum == LOCK_STATS_NAME_MAX_NUM)
+            return;
+
+        registry.names[registry.nameNum++] = name;
+    }
+
+    LockStats& dst = registry.stats[i];
+    dst.acquireNum += lockStats.acquireNum;
+    dst.contendedNum += lockStats.contendedNum;
+    dst.spinNum += lockStats.spinNum;
+    dst.parkNum += lockStats.parkNum;
+}
+
+// Reports (as "INFO") and resets the accumulated counters of contended locks
+inline void ReportLockStats(const nri::CallbackInterface& callbacks) {
+    LockStatsRegistry& registry = GetLockStatsRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+
+    for (uint32_t i = 0; i < registry.nameNum; i++) {
+        const LockStats& lockStats = registry.stats[i];
+        if (lockStats.contendedNum && callbacks.MessageCallback) {
+            char buf[256];
+            snprintf(buf, sizeof(buf), "NRI lock '%s': acquires = %llu, contended = %llu, spins = %llu, parks = %llu", registry.names[i],
+                (unsigned long long)lockStats.acquireNum, (unsigned long long)lockStats.contendedNum, (unsigned long long)lockStats.spinNum, (unsigned long long)lockStats.parkNum);
+
+            callbacks.MessageCallback(nri::Message::INFO, __FILE__, __LINE__, buf, callbacks.userArg);
+        }
+    }
+
+    registry.nameNum = 0;
+}
+
+#endif
+
+// Lightweight exclusive lock: spins with exponential backoff, then parks the thread (futex) to not burn the core
+// while the owner is descheduled. "NRI_ENABLE_LOCK_STATS" adds contention counters, accumulated on destruction
+// and reported via the message callback when a device gets destroyed
 struct alignas(LOCK_CACHELINE_SIZE) Lock {
-    inline Lock() {
-        m_Atomic.store(0, std::memory_order_relaxed);
+    enum : uint32_t {
+        UNLOCKED,
+        LOCKED,
+        LOCKED_WITH_WAITERS,
+    };
+
+    explicit inline Lock(const char* name = "Lock") {
+        m_Atomic.store(UNLOCKED, std::memory_order_relaxed);
+
+#if NRI_ENABLE_LOCK_STATS
+        m_Name = name;
+#else
+        MaybeUnused(name);
+#endif
+    }
+
+#if NRI_ENABLE_LOCK_STATS
+    inline ~Lock() {
+        LockStats lockStats = {};
+        GetStats(lockStats);
+
+        if (lockStats.contendedNum)
+            AccumulateLockStats(m_Name, lockStats);
+    }
+#endif
+
+    // All zeros without "NRI_ENABLE_LOCK_STATS"
+    inline void GetStats(LockStats& lockStats) const {
+#if NRI_ENABLE_LOCK_STATS
+        lockStats.acquireNum = m_AcquireNum.load(std::memory_order_relaxed);
+        lockStats.contendedNum = m_ContendedNum.load(std::memory_order_relaxed);
+        lockStats.spinNum = m_SpinNum.load(std::memory_order_relaxed);
+        lockStats.parkNum = m_ParkNum.load(std::memory_order_relaxed);
+#else
+        lockStats = {};
+#endif
     }
 
     inline void Acquire() {
-        while (m_Atomic.exchange(1, std::memory_order_acquire))
-            _mm_pause();
+#if NRI_ENABLE_LOCK_STATS
+        m_AcquireNum.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+        uint32_t expected = UNLOCKED;
+        if (!m_Atomic.compare_exchange_strong(expected, LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+            AcquireContended();
     }
 
     inline void Release() {
-        m_Atomic.store(0, std::memory_order_release);
+        if (m_Atomic.exchange(UNLOCKED, std::memory_order_release) == LOCKED_WITH_WAITERS)
+            LockUnpark(m_Atomic);
+    }
+
+private:
+    inline void AcquireContended() {
+#if NRI_ENABLE_LOCK_STATS
+        m_ContendedNum.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+        // Spin
+        for (uint32_t backoff = 1; backoff <= LOCK_BACKOFF_MAX; backoff <<= 1) {
+            for (uint32_t i = 0; i < backoff; i++)
+                _mm_pause();
+
+#if NRI_ENABLE_LOCK_STATS
+            m_SpinNum.fetch_add(backoff, std::memory_order_relaxed);
+#endif
+
+            uint32_t expected = UNLOCKED;
+            if (m_Atomic.load(std::memory_order_relaxed) == UNLOCKED && m_Atomic.compare_exchange_weak(expected, LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+                return;
+        }
+
+        // Park (the lock is taken as "LOCKED_WITH_WAITERS", since other threads may still be parked)
+        while (m_Atomic.exchange(LOCKED_WITH_WAITERS, std::memory_order_acquire) != UNLOCKED) {
+#if NRI_ENABLE_LOCK_STATS
+            m_ParkNum.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+            LockPark(m_Atomic, LOCKED_WITH_WAITERS);
+        }
     }
 
 private:
     std::atomic_uint32_t m_Atomic;
+
+#if NRI_ENABLE_LOCK_STATS
+    const char* m_Name = nullptr;
+    std::atomic_uint64_t m_AcquireNum{0};
+    std::atomic_uint64_t m_ContendedNum{0};
+    std::atomic_uint64_t m_SpinNum{0};
+    std::atomic_uint64_t m_ParkNum{0};
+#endif
 };
 
 struct ExclusiveScope {
@@ -0,0 +1,87 @@
+#pragma once
+
+constexpr uint32_t MEMORY_DESC_CACHE_MAX_NUM = 4096; // the cache gets flushed on overflow
+
+// Memoized "GetBufferMemoryDesc2" and "GetTextureMemoryDesc2". Keys are normalized descs, compared entirely
+// (not only hashes), since a collision would return wrong memory requirements
+struct MemoryDescCache {
+    inline MemoryDescCache(StdAllocator<uint8_t>& stdAllocator)
+        : m_Entries(stdAllocator) {
+    }
+
+    template <typename Query>
+    inline void Get(const nri::BufferDesc& bufferDesc, nri::MemoryLocation memoryLocation, nri::MemoryDesc& memoryDesc, Query query) {
+        Key key;
+        memset(&key, 0, sizeof(key)); // padding bytes are hashed too
+        key.size = bufferDesc.size;
+        key.structureStride = bufferDesc.structureStride;
+        key.usage = (uint32_t)bufferDesc.usage;
+        key.memoryLocation = memoryLocation;
+        key.isTexture = false;
+
+        if (!Find(key, memoryDesc)) {
+            query(bufferDesc, memoryLocation, memoryDesc);
+            Add(key, memoryDesc);
+        }
+    }
+
+    template <typename Query>
+    inline void Get(const nri::TextureDesc& textureDesc, nri::MemoryLocation memoryLocation, nri::MemoryDesc& memoryDesc, Query query) {
+        nri::TextureDesc desc = FixTextureDesc(textureDesc);
+
+        Key key;
+        memset(&key, 0, sizeof(key)); // padding bytes are hashed too
+        key.usage = (uint32_t)desc.usage;
+        key.format = desc.format;
+        key.type = desc.type;
+        key.width = desc.width;
+        key.height = desc.height;
+        key.depth = desc.depth;
+        key.layerNum = desc.layerNum;
+        key.mipNum = desc.mipNum;
+        key.sampleNum = desc.sampleNum;
+        key.memoryLocation = memoryLocation;
+        key.isTexture = true;
+
+        if (!Find(key, memoryDesc)) {
+            query(desc, memoryLocation, memoryDesc);
+            Add(key, memoryDesc);
+        }
+    }
+
+    void GetStats(nri::MemoryDescCacheStats& memoryDescCacheStats) const;
+
+private:
+    struct Key {
+        uint64_t size;
+        uint32_t structureStride;
+        uint32_t usage;
+        nri::Format format;
+        nri::TextureType type;
+        nri::Dim_t width;
+        nri::Dim_t height;
+        nri::Dim_t depth;
+        nri::Dim_t layerNum;
+        nri::Mip_t mipNum;
+        nri::Sample_t sampleNum;
+        nri::MemoryLocation memoryLocation;
+        bool isTexture;
+    };
+
+    static_assert(std::is_trivially_copyable<Key>::value, "Unexpected");
+
+    struct Entry {
+        Key key;
+        nri::MemoryDesc memoryDesc;
+    };
+
+    bool Find(const Key& key, nri::MemoryDesc& memoryDesc);
+    void Add(const Key& key, const nri::MemoryDesc& memoryDesc);
+
+private:
+    UnorderedMap<uint64_t, Entry> m_Entries;
+    uint64_t m_HitNum = 0;
+    uint64_t m_MissNum = 0;
+    uint32_t m_FlushNum = 0;
+    mutable Lock m_Lock{"MemoryDescCache"};
+};
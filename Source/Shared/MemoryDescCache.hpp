@@ -0,0 +1,40 @@
+bool MemoryDescCache::Find(const Key& key, MemoryDesc& memoryDesc) {
+    uint64_t hash = HashBytes(&key, sizeof(key));
+
+    ExclusiveScope lock(m_Lock);
+
+    auto it = m_Entries.find(hash);
+    if (it != m_Entries.end() && !memcmp(&it->second.key, &key, sizeof(key))) {
+        memoryDesc = it->second.memoryDesc;
+        m_HitNum++;
+
+        return true;
+    }
+
+    m_MissNum++;
+
+    return false;
+}
+
+void MemoryDescCache::Add(const Key& key, const MemoryDesc& memoryDesc) {
+    uint64_t hash = HashBytes(&key, sizeof(key));
+
+    ExclusiveScope lock(m_Lock);
+
+    if (m_Entries.size() >= MEMORY_DESC_CACHE_MAX_NUM) {
+        m_Entries.clear();
+        m_FlushNum++;
+    }
+
+    m_Entries[hash] = {key, memoryDesc};
+}
+
+void MemoryDescCache::GetStats(MemoryDescCacheStats& memoryDescCacheStats) const {
+    ExclusiveScope lock(m_Lock);
+
+    memoryDescCacheStats = {};
+    memoryDescCacheStats.hitNum = m_HitNum;
+    memoryDescCacheStats.missNum = m_MissNum;
+    memoryDescCacheStats.entryNum = (uint32_t)m_Entries.size();
+    memoryDescCacheStats.flushNum = m_FlushNum;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+constexpr size_t OBJECT_POOL_PAGE_SIZE = 64 * 1024;
+
+// Slab allocator for objects of the same type: blocks are carved from pages and recycled via a free list.
+// The block size is set by the first allocation, bigger objects (if any) fall back to "AllocationCallbacks"
+struct ObjectPool {
+    inline void Init(const AllocationCallbacks& allocationCallbacks) {
+        m_AllocationCallbacks = &allocationCallbacks;
+    }
+
+    ~ObjectPool();
+
+    void* Allocate(size_t size, size_t alignment);
+    void Free(void* memory, size_t size, size_t alignment);
+    void GetStats(nri::ObjectPoolStats& stats) const;
+
+private:
+    inline bool IsPooled(size_t size, size_t alignment) const {
+        return size <= m_BlockSize && alignment <= m_BlockAlignment;
+    }
+
+private:
+    const AllocationCallbacks* m_AllocationCallbacks = nullptr;
+    void* m_Pages = nullptr;    // intrusive list, a page starts with a pointer to the next page
+    void* m_FreeList = nullptr; // intrusive list, a free block starts with a pointer to the next free block
+    uint8_t* m_PageCursor = nullptr;
+    uint8_t* m_PageEnd = nullptr;
+    size_t m_BlockSize = 0;
+    size_t m_BlockAlignment = 0;
+    mutable Lock m_Lock{"ObjectPool"};
+    uint64_t m_AllocationNum = 0;
+    uint32_t m_LiveNum = 0;
+    uint32_t m_PeakNum = 0;
+    uint32_t m_CapacityNum = 0;
+    uint32_t m_PageNum = 0;
+};
+
+// Specialize to put objects of type "T" into a device-owned "ObjectPool"
+template <typename T>
+struct ObjectPoolTraits {
+    static constexpr nri::ObjectPoolType type = nri::ObjectPoolType::MAX_NUM;
+};
+
+#define NRI_OBJECT_POOL(T, poolType) \
+    template <> \
+    struct ObjectPoolTraits<T> { \
+        static constexpr nri::ObjectPoolType type = nri::ObjectPoolType::poolType; \
+    }
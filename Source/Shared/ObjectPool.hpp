@@ -0,0 +1,82 @@
+ObjectPool::~ObjectPool() {
+    while (m_Pages) {
+        void* next = *(void**)m_Pages;
+        m_AllocationCallbacks->Free(m_AllocationCallbacks->userArg, m_Pages);
+        m_Pages = next;
+    }
+}
+
+void* ObjectPool::Allocate(size_t size, size_t alignment) {
+    {
+        ExclusiveScope lock(m_Lock);
+
+        // The first allocation defines the block
+        if (!m_BlockSize) {
+            m_BlockAlignment = std::max(alignment, alignof(void*));
+            m_BlockSize = Align(std::max(size, sizeof(void*)), m_BlockAlignment);
+        }
+
+        if (IsPooled(size, alignment)) {
+            void* block = m_FreeList;
+            if (block)
+                m_FreeList = *(void**)block;
+            else {
+                // New page
+                if (m_PageCursor + m_BlockSize > m_PageEnd) {
+                    size_t pageAlignment = std::max(m_BlockAlignment, LOCK_CACHELINE_SIZE);
+                    size_t pageSize = std::max(OBJECT_POOL_PAGE_SIZE, Align(sizeof(void*), m_BlockAlignment) + m_BlockSize);
+
+                    uint8_t* page = (uint8_t*)m_AllocationCallbacks->Allocate(m_AllocationCallbacks->userArg, pageSize, pageAlignment);
+                    if (!page)
+                        return nullptr;
+
+                    *(void**)page = m_Pages;
+                    m_Pages = page;
+                    m_PageCursor = page + Align(sizeof(void*), m_BlockAlignment);
+                    m_PageEnd = page + pageSize;
+                    m_PageNum++;
+                    m_CapacityNum += uint32_t((m_PageEnd - m_PageCursor) / m_BlockSize);
+                }
+
+                block = m_PageCursor;
+                m_PageCursor += m_BlockSize;
+            }
+
+            m_AllocationNum++;
+            m_LiveNum++;
+            m_PeakNum = std::max(m_PeakNum, m_LiveNum);
+
+            return block;
+        }
+    }
+
+    return m_AllocationCallbacks->Allocate(m_AllocationCallbacks->userArg, size, alignment);
+}
+
+void ObjectPool::Free(void* memory, size_t size, size_t alignment) {
+    {
+        ExclusiveScope lock(m_Lock);
+
+        if (IsPooled(size, alignment)) {
+            *(void**)memory = m_FreeList;
+            m_FreeList = memory;
+            m_LiveNum--;
+
+            return;
+        }
+    }
+
+    m_AllocationCallbacks->Free(m_AllocationCallbacks->userArg, memory);
+}
+
+void ObjectPool::GetStats(ObjectPoolStats& stats) const {
+    ExclusiveScope lock(m_Lock);
+
+    stats = {};
+    stats.allocationNum = m_AllocationNum;
+    stats.liveNum = m_LiveNum;
+    stats.peakNum = m_PeakNum;
+    stats.capacityNum = m_CapacityNum;
+    stats.pageNum = m_PageNum;
+    stats.objectSize = (uint32_t)m_BlockSize;
+}
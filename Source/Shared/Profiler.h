@@ -0,0 +1,91 @@
+#pragma once
+
+constexpr uint64_t PROFILER_SIMULATED_TIMESTAMP_STEP = 1000; // ns
+constexpr uint32_t PROFILER_NO_ZONE = uint32_t(-1);
+constexpr uint32_t PROFILER_ZONE_NAME_AVERAGE_SIZE = 64; // bytes, including the terminating zero
+
+struct ProfilerZoneRecord {
+    uint32_t nameOffset; // in "ProfilerFrameSlot::names"
+    uint32_t parentIndex;
+    uint32_t depth;
+    bool isClosed;
+};
+
+// Zone "i" uses queries "2 * i" (begin) and "2 * i + 1" (end) in the frame's range of the query pool
+// "zones" and "names" are preallocated, since zones get recorded concurrently. Counters are snapshotted in "BeginFrame"
+struct ProfilerFrameSlot {
+    Vector<ProfilerZoneRecord> zones; // zoneMaxNum
+    Vector<char> names;               // zoneMaxNum * PROFILER_ZONE_NAME_AVERAGE_SIZE, "names[0]" is an empty name for overflows
+    nri::Fence* fence;
+    uint64_t value;
+    uint64_t frameIndex;
+    uint32_t zoneNum;
+    uint32_t nameSize;
+    uint32_t droppedZoneNum;
+    bool isResolveRecorded;
+};
+
+struct ProfilerImpl : public nri::DebugNameBase {
+    inline ProfilerImpl(nri::Device& device, const nri::CoreInterface& NRI)
+        : m_Device(device)
+        , m_NRI(NRI)
+        , m_Slots(((nri::DeviceBase&)device).GetStdAllocator())
+        , m_Zones(((nri::DeviceBase&)device).GetStdAllocator())
+        , m_Names(((nri::DeviceBase&)device).GetStdAllocator())
+        , m_SimulatedTimestamps(((nri::DeviceBase&)device).GetStdAllocator()) {
+    }
+
+    inline nri::Device& GetDevice() {
+        return m_Device;
+    }
+
+    ~ProfilerImpl();
+
+    nri::Result Create(const nri::ProfilerDesc& desc);
+    void BeginFrame();
+    void EndFrame(nri::Fence& fence, uint64_t value);
+    void BeginZone(nri::CommandBuffer& commandBuffer, ProfilerZoneState& zoneState, const char* name);
+    void EndZone(nri::CommandBuffer& commandBuffer, ProfilerZoneState& zoneState);
+    void ResolveFrame(nri::CommandBuffer& commandBuffer);
+    void GetFrame(nri::ProfilerFrame& profilerFrame) const;
+
+    //================================================================================================================
+    // DebugNameBase
+    //================================================================================================================
+
+    void SetDebugName(const char* name) DEBUG_NAME_OVERRIDE {
+        m_NRI.SetDebugName(m_QueryPool, name);
+        m_NRI.SetDebugName(m_ReadbackBuffer, name);
+        m_NRI.SetDebugName(m_ReadbackMemory, name);
+    }
+
+private:
+    void WriteTimestamp(nri::CommandBuffer& commandBuffer, uint32_t queryIndex);
+    void Resolve(const ProfilerFrameSlot& slot, uint32_t queryOffset);
+
+private:
+    nri::Device& m_Device;
+    const nri::CoreInterface& m_NRI;
+    nri::ProfilerDesc m_Desc = {};
+    Vector<ProfilerFrameSlot> m_Slots;           // frameInFlightNum
+    Vector<nri::ProfilerZone> m_Zones;           // the latest resolved frame
+    Vector<char> m_Names;                        // names of "m_Zones"
+    Vector<uint64_t> m_SimulatedTimestamps;      // NONE only, replaces the query pool
+    nri::QueryPool* m_QueryPool = nullptr;       // frameInFlightNum * zoneMaxNum * 2
+    nri::Buffer* m_ReadbackBuffer = nullptr;     // mirrors "m_QueryPool"
+    nri::Memory* m_ReadbackMemory = nullptr;
+    Lock m_Lock{"Profiler"};                     // serializes frame-level calls, zones don't take it
+    std::atomic_uint32_t m_ZoneNum{0};           // the current frame, can exceed "zoneMaxNum"
+    std::atomic_uint32_t m_NameSize{1};          // the current frame
+    std::atomic_uint32_t m_DroppedZoneNum{0};    // the current frame
+    std::atomic_uint64_t m_SimulatedTime{0};
+    uint64_t m_FrameIndex = 0;
+    uint64_t m_ResolvedFrameIndex = 0;
+    double m_NsPerTick = 1.0;
+    uint32_t m_SlotIndex = 0;
+    uint32_t m_QuerySize = 0;
+    uint32_t m_ResolvedDroppedZoneNum = 0;
+    bool m_IsSimulated = false;
+};
+
+NRI_ALLOCATION_CATEGORY(ProfilerImpl, OTHER);
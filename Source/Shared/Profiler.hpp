@@ -0,0 +1,291 @@
+ProfilerImpl::~ProfilerImpl() {
+    DeviceBase& deviceBase = (DeviceBase&)m_Device;
+    if (deviceBase.GetAnnotationProfiler() == this)
+        deviceBase.SetAnnotationProfiler(nullptr);
+
+    for (const ProfilerFrameSlot& slot : m_Slots) {
+        if (slot.fence)
+            m_NRI.Wait(*slot.fence, slot.value);
+    }
+
+    if (m_QueryPool)
+        m_NRI.DestroyQueryPool(*m_QueryPool);
+
+    if (m_ReadbackBuffer)
+        m_NRI.DestroyBuffer(*m_ReadbackBuffer);
+
+    if (m_ReadbackMemory)
+        m_NRI.FreeMemory(*m_ReadbackMemory);
+}
+
+Result ProfilerImpl::Create(const ProfilerDesc& desc) {
+    if (!desc.frameInFlightNum || !desc.zoneMaxNum || desc.queueType >= QueueType::MAX_NUM)
+        return Result::INVALID_ARGUMENT;
+
+    DeviceBase& deviceBase = (DeviceBase&)m_Device;
+    if (desc.captureAnnotations && deviceBase.GetAnnotationProfiler())
+        return Result::INVALID_ARGUMENT;
+
+    m_Desc = desc;
+
+    const DeviceDesc& deviceDesc = m_NRI.GetDeviceDesc(m_Device);
+    uint32_t queryNum = desc.frameInFlightNum * desc.zoneMaxNum * 2;
+
+    // NONE: a simulated clock instead of queries
+    m_IsSimulated = deviceDesc.graphicsAPI == GraphicsAPI::NONE;
+    if (m_IsSimulated)
+        m_SimulatedTimestamps.resize(queryNum, 0);
+    else {
+        if (!deviceDesc.timestampFrequencyHz)
+            return Result::UNSUPPORTED;
+
+        m_NsPerTick = 1000000000.0 / (double)deviceDesc.timestampFrequencyHz;
+
+        // Create query pool
+        QueryPoolDesc queryPoolDesc = {};
+        queryPoolDesc.queryType = desc.queueType == QueueType::COPY ? QueryType::TIMESTAMP_COPY_QUEUE : QueryType::TIMESTAMP;
+        queryPoolDesc.capacity = queryNum;
+
+        Result result = m_NRI.CreateQueryPool(m_Device, queryPoolDesc, m_QueryPool);
+        if (result != Result::SUCCESS)
+            return result;
+
+        m_QuerySize = m_NRI.GetQuerySize(*m_QueryPool);
+
+        // Create readback buffer
+        BufferDesc bufferDesc = {};
+        bufferDesc.size = (uint64_t)queryNum * m_QuerySize;
+
+        result = m_NRI.CreateBuffer(m_Device, bufferDesc, m_ReadbackBuffer);
+        if (result != Result::SUCCESS)
+            return result;
+
+        // Allocate memory
+        MemoryDesc memoryDesc = {};
+        m_NRI.GetBufferMemoryDesc(*m_ReadbackBuffer, MemoryLocation::HOST_READBACK, memoryDesc);
+
+        AllocateMemoryDesc allocateMemoryDesc = {};
+        allocateMemoryDesc.type = memoryDesc.type;
+        allocateMemoryDesc.size = memoryDesc.size;
+
+        result = m_NRI.AllocateMemory(m_Device, allocateMemoryDesc, m_ReadbackMemory);
+        if (result != Result::SUCCESS)
+            return result;
+
+        // Bind to memory
+        BufferMemoryBindingDesc memoryBindingDesc = {};
+        memoryBindingDesc.buffer = m_ReadbackBuffer;
+        memoryBindingDesc.memory = m_ReadbackMemory;
+
+        result = m_NRI.BindBufferMemory(m_Device, &memoryBindingDesc, 1);
+        if (result != Result::SUCCESS)
+            return result;
+
+        m_NRI.ResetQueries(*m_QueryPool, 0, queryNum);
+    }
+
+    m_Slots.reserve(desc.frameInFlightNum);
+    for (uint32_t i = 0; i < desc.frameInFlightNum; i++) {
+        m_Slots.push_back({Vector<ProfilerZoneRecord>(m_Slots.get_allocator()), Vector<char>(m_Slots.get_allocator()), nullptr, 0, 0, 0, 0, 0, false});
+
+        ProfilerFrameSlot& slot = m_Slots.back();
+        slot.zones.resize(desc.zoneMaxNum);
+        slot.names.resize((size_t)desc.zoneMaxNum * PROFILER_ZONE_NAME_AVERAGE_SIZE, 0);
+    }
+
+    // The first "BeginFrame" switches to the frame 0
+    m_SlotIndex = desc.frameInFlightNum - 1;
+
+    if (desc.captureAnnotations)
+        deviceBase.SetAnnotationProfiler(this);
+
+    return Result::SUCCESS;
+}
+
+void ProfilerImpl::BeginFrame() {
+    ExclusiveScope lock(m_Lock);
+
+    // Finish the current frame (zones can't span frames, see "ProfilerZoneState")
+    ProfilerFrameSlot& prevSlot = m_Slots[m_SlotIndex];
+    prevSlot.zoneNum = std::min(m_ZoneNum.exchange(0, std::memory_order_relaxed), m_Desc.zoneMaxNum);
+    prevSlot.nameSize = std::min(m_NameSize.exchange(1, std::memory_order_relaxed), (uint32_t)prevSlot.names.size());
+    prevSlot.droppedZoneNum = m_DroppedZoneNum.exchange(0, std::memory_order_relaxed);
+
+    m_SlotIndex = (m_SlotIndex + 1) % m_Desc.frameInFlightNum;
+    ProfilerFrameSlot& slot = m_Slots[m_SlotIndex];
+    uint32_t queryOffset = m_SlotIndex * m_Desc.zoneMaxNum * 2;
+
+    // Wait for the GPU and resolve
+    if (slot.fence) {
+        if (m_NRI.GetFenceValue(*slot.fence) < slot.value)
+            m_NRI.Wait(*slot.fence, slot.value);
+
+        if (slot.isResolveRecorded)
+            Resolve(slot, queryOffset);
+
+        slot.fence = nullptr;
+    }
+
+    // Recycle
+    if (m_QueryPool && slot.zoneNum)
+        m_NRI.ResetQueries(*m_QueryPool, queryOffset, slot.zoneNum * 2);
+
+    slot.frameIndex = m_FrameIndex++;
+    slot.zoneNum = 0;
+    slot.nameSize = 0;
+    slot.droppedZoneNum = 0;
+    slot.isResolveRecorded = false;
+}
+
+void ProfilerImpl::EndFrame(Fence& fence, uint64_t value) {
+    ExclusiveScope lock(m_Lock);
+
+    ProfilerFrameSlot& slot = m_Slots[m_SlotIndex];
+    slot.fence = &fence;
+    slot.value = value;
+}
+
+// Zones don't lock: indices and names are allocated atomically, and the nesting lives in the command buffer. Recording must not overlap
+// with "BeginFrame", which is the case anyway, since a frame can't be switched while its command buffers are being recorded
+void ProfilerImpl::BeginZone(CommandBuffer& commandBuffer, ProfilerZoneState& zoneState, const char* name) {
+    if (zoneState.profiler != this || zoneState.frameIndex != m_FrameIndex) {
+        zoneState = {};
+        zoneState.profiler = this;
+        zoneState.frameIndex = m_FrameIndex;
+    }
+
+    // Dropped zones are always the innermost ones, since "m_ZoneNum" only grows within a frame
+    uint32_t zoneIndex = m_ZoneNum.fetch_add(1, std::memory_order_relaxed);
+    if (zoneIndex >= m_Desc.zoneMaxNum) {
+        m_DroppedZoneNum.fetch_add(1, std::memory_order_relaxed);
+        zoneState.droppedZoneNum++;
+
+        return;
+    }
+
+    ProfilerFrameSlot& slot = m_Slots[m_SlotIndex];
+
+    if (!name)
+        name = "";
+
+    uint32_t nameSize = (uint32_t)strlen(name) + 1;
+    uint64_t nameOffset = m_NameSize.fetch_add(nameSize, std::memory_order_relaxed);
+    if (nameOffset + nameSize <= slot.names.size())
+        memcpy(&slot.names[nameOffset], name, nameSize);
+    else
+        nameOffset = 0;
+
+    // Parent is the innermost open zone of the same command buffer
+    uint32_t parentIndex = zoneState.zoneIndex;
+
+    ProfilerZoneRecord& zone = slot.zones[zoneIndex];
+    zone.nameOffset = (uint32_t)nameOffset;
+    zone.parentIndex = parentIndex;
+    zone.depth = parentIndex == PROFILER_NO_ZONE ? 0 : slot.zones[parentIndex].depth + 1;
+    zone.isClosed = false;
+
+    zoneState.zoneIndex = zoneIndex;
+
+    WriteTimestamp(commandBuffer, m_SlotIndex * m_Desc.zoneMaxNum * 2 + zoneIndex * 2);
+}
+
+void ProfilerImpl::EndZone(CommandBuffer& commandBuffer, ProfilerZoneState& zoneState) {
+    if (zoneState.profiler != this || zoneState.frameIndex != m_FrameIndex)
+        return;
+
+    if (zoneState.droppedZoneNum) {
+        zoneState.droppedZoneNum--;
+        return;
+    }
+
+    if (zoneState.zoneIndex == PROFILER_NO_ZONE)
+        return;
+
+    ProfilerFrameSlot& slot = m_Slots[m_SlotIndex];
+    ProfilerZoneRecord& zone = slot.zones[zoneState.zoneIndex];
+    zone.isClosed = true;
+
+    WriteTimestamp(commandBuffer, m_SlotIndex * m_Desc.zoneMaxNum * 2 + zoneState.zoneIndex * 2 + 1);
+
+    zoneState.zoneIndex = zone.parentIndex;
+}
+
+void ProfilerImpl::ResolveFrame(CommandBuffer& commandBuffer) {
+    ExclusiveScope lock(m_Lock);
+
+    ProfilerFrameSlot& slot = m_Slots[m_SlotIndex];
+    slot.isResolveRecorded = true;
+
+    uint32_t zoneNum = std::min(m_ZoneNum.load(std::memory_order_relaxed), m_Desc.zoneMaxNum);
+    if (m_QueryPool && zoneNum) {
+        uint32_t queryOffset = m_SlotIndex * m_Desc.zoneMaxNum * 2;
+        m_NRI.CmdCopyQueries(commandBuffer, *m_QueryPool, queryOffset, zoneNum * 2, *m_ReadbackBuffer, (uint64_t)queryOffset * m_QuerySize);
+    }
+}
+
+void ProfilerImpl::GetFrame(ProfilerFrame& profilerFrame) const {
+    profilerFrame = {};
+    profilerFrame.zones = m_Zones.data();
+    profilerFrame.zoneNum = (uint32_t)m_Zones.size();
+    profilerFrame.droppedZoneNum = m_ResolvedDroppedZoneNum;
+    profilerFrame.frameIndex = m_ResolvedFrameIndex;
+}
+
+void ProfilerImpl::WriteTimestamp(CommandBuffer& commandBuffer, uint32_t queryIndex) {
+    if (m_IsSimulated)
+        m_SimulatedTimestamps[queryIndex] = m_SimulatedTime.fetch_add(PROFILER_SIMULATED_TIMESTAMP_STEP, std::memory_order_relaxed) + PROFILER_SIMULATED_TIMESTAMP_STEP;
+    else
+        m_NRI.CmdEndQuery(commandBuffer, *m_QueryPool, queryIndex);
+}
+
+void ProfilerImpl::Resolve(const ProfilerFrameSlot& slot, uint32_t queryOffset) {
+    m_Zones.clear();
+    m_Names.clear();
+    m_ResolvedFrameIndex = slot.frameIndex;
+    m_ResolvedDroppedZoneNum = slot.droppedZoneNum;
+
+    uint32_t queryNum = slot.zoneNum * 2;
+    if (!queryNum)
+        return;
+
+    // Timestamps
+    const uint8_t* timestamps = nullptr;
+    uint32_t stride = sizeof(uint64_t);
+
+    if (m_IsSimulated)
+        timestamps = (const uint8_t*)&m_SimulatedTimestamps[queryOffset];
+    else {
+        BufferRange bufferRange = {m_ReadbackBuffer, (uint64_t)queryOffset * m_QuerySize, (uint64_t)queryNum * m_QuerySize};
+        m_NRI.InvalidateBufferRanges(m_Device, &bufferRange, 1);
+
+        timestamps = (const uint8_t*)m_NRI.MapBufferWithMode(*m_ReadbackBuffer, bufferRange.offset, bufferRange.size, MapMode::EXPLICIT_FLUSH);
+        stride = m_QuerySize;
+
+        if (!timestamps)
+            return;
+    }
+
+    uint64_t base = uint64_t(-1);
+    for (uint32_t i = 0; i < slot.zoneNum; i++)
+        base = std::min(base, *(const uint64_t*)(timestamps + (i * 2) * stride));
+
+    m_Names.insert(m_Names.end(), slot.names.begin(), slot.names.begin() + slot.nameSize);
+
+    for (uint32_t i = 0; i < slot.zoneNum; i++) {
+        const ProfilerZoneRecord& zoneRecord = slot.zones[i];
+        uint64_t begin = *(const uint64_t*)(timestamps + (i * 2) * stride);
+        uint64_t end = *(const uint64_t*)(timestamps + (i * 2 + 1) * stride);
+
+        ProfilerZone zone = {};
+        zone.name = m_Names.data() + zoneRecord.nameOffset;
+        zone.beginNs = (uint64_t)((double)(begin - base) * m_NsPerTick);
+        zone.durationNs = zoneRecord.isClosed && end > begin ? (uint64_t)((double)(end - begin) * m_NsPerTick) : 0;
+        zone.parentIndex = zoneRecord.parentIndex;
+        zone.depth = zoneRecord.depth;
+
+        m_Zones.push_back(zone);
+    }
+
+    if (!m_IsSimulated)
+        m_NRI.UnmapBuffer(*m_ReadbackBuffer);
+}
@@ -7,17 +7,34 @@
 
 #include "SharedExternal.h"
 
+#include "CommandBufferPool.h"
+#include "DeferredReleaseQueue.h"
 #include "HelperDataUpload.h"
 #include "HelperDeviceMemoryAllocator.h"
 #include "HelperWaitIdle.h"
+#include "Instrumentation.h"
+#include "MemoryDescCache.h"
+#include "Profiler.h"
 #include "Streamer.h"
+#include "SubmissionThread.h"
+#include "Tracer.h"
 
 using namespace nri;
 
+#include "AllocationTracker.hpp"
+#include "BudgetMonitor.hpp"
+#include "CommandBufferPool.hpp"
+#include "DeferredReleaseQueue.hpp"
 #include "HelperDataUpload.hpp"
 #include "HelperDeviceMemoryAllocator.hpp"
 #include "HelperWaitIdle.hpp"
+#include "Instrumentation.hpp"
+#include "MemoryDescCache.hpp"
+#include "ObjectPool.hpp"
+#include "Profiler.hpp"
 #include "Streamer.hpp"
+#include "SubmissionThread.hpp"
+#include "Tracer.hpp"
 
 #include "SharedExternal.hpp"
 #include "SharedLibrary.hpp"
@@ -5,8 +5,10 @@
 #include <array>
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstring>
 #include <map>
+#include <thread>
 
 #ifdef _WIN32
 #    include <dxgi1_6.h>
@@ -18,10 +20,14 @@ typedef uint32_t DXGI_FORMAT;
 
 #include "NRI.h"
 
+#include "Extensions/NRICommandBufferPool.h"
+#include "Extensions/NRIDeferredRelease.h"
 #include "Extensions/NRIDeviceCreation.h"
 #include "Extensions/NRIHelper.h"
+#include "Extensions/NRIInstrumentation.h"
 #include "Extensions/NRILowLatency.h"
 #include "Extensions/NRIMeshShader.h"
+#include "Extensions/NRIProfiler.h"
 #include "Extensions/NRIRayTracing.h"
 #include "Extensions/NRIResourceAllocator.h"
 #include "Extensions/NRIStreamer.h"
@@ -32,18 +38,52 @@ typedef uint32_t DXGI_FORMAT;
 
 #include "NRICompatibility.hlsli"
 
-#include "Lock.h"
-
 template <typename... Args>
 constexpr void MaybeUnused([[maybe_unused]] const Args&... args) {
 }
 
+// Must be used in the entry point called by the application
+#if defined(_MSC_VER)
+#    include <intrin.h>
+#    define NRI_CALL_SITE _ReturnAddress()
+#else
+#    define NRI_CALL_SITE __builtin_return_address(0)
+#endif
+
+// Set by entry points wrapping other entry points (see "InstrumentedCall"), since "NRI_CALL_SITE" of a wrapped function is the wrapper
+inline const void*& GetForwardedCallSite() {
+    static thread_local const void* callSite = nullptr;
+    return callSite;
+}
+
+struct ForwardedCallSiteScope {
+    inline ForwardedCallSiteScope(const void* callSite)
+        : m_Previous(GetForwardedCallSite()) {
+        GetForwardedCallSite() = callSite;
+    }
+
+    inline ~ForwardedCallSiteScope() {
+        GetForwardedCallSite() = m_Previous;
+    }
+
+private:
+    const void* m_Previous;
+};
+
+#include "Lock.h"
+#include "FenceWait.h"
+#include "BudgetMonitor.h"
+#include "FormatSupportCache.h"
+
 // Allocator
 typedef nri::AllocationCallbacks AllocationCallbacks;
 #include "StdAllocator.h"
+#include "ObjectPool.h"
+#include "AllocationTracker.h"
 
 // Base classes
 #include "DeviceBase.h"
+#include "CommandBufferStats.h"
 
 // Consts
 constexpr uint32_t NRI_NODE_MASK = 0x1;    // mGPU is not planned
@@ -80,6 +120,10 @@ constexpr void Construct(T* objects, size_t number, Args&&... args) {
 
 template <typename T, typename... Args>
 inline T* Allocate(const AllocationCallbacks& allocationCallbacks, Args&&... args) {
+    static_assert(ObjectPoolTraits<T>::type == nri::ObjectPoolType::MAX_NUM, "Pooled objects must be created with 'AllocateObject'");
+
+    AllocationCategoryScope allocationCategoryScope(AllocationCategoryTraits<T>::category);
+
     T* object = (T*)allocationCallbacks.Allocate(allocationCallbacks.userArg, sizeof(T), alignof(T));
     if (object)
         new (object) T(std::forward<Args>(args)...);
@@ -87,8 +131,31 @@ inline T* Allocate(const AllocationCallbacks& allocationCallbacks, Args&&... arg
     return object;
 }
 
+// Objects with "ObjectPoolTraits" must be created with "AllocateObject" and destroyed with "DestroyObject" or "Destroy(object)"
+template <typename T, typename... Args>
+inline T* AllocateObject(nri::DeviceBase& device, Args&&... args) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategoryTraits<T>::category);
+
+    T* object = nullptr;
+    if constexpr (ObjectPoolTraits<T>::type != nri::ObjectPoolType::MAX_NUM)
+        object = (T*)device.GetObjectPool(ObjectPoolTraits<T>::type).Allocate(sizeof(T), alignof(T));
+    else {
+        const auto& allocationCallbacks = device.GetAllocationCallbacks();
+        object = (T*)allocationCallbacks.Allocate(allocationCallbacks.userArg, sizeof(T), alignof(T));
+    }
+
+    if (object)
+        new (object) T(std::forward<Args>(args)...);
+
+    return object;
+}
+
 template <typename T>
 inline void Destroy(const AllocationCallbacks& allocationCallbacks, T* object) {
+    static_assert(ObjectPoolTraits<T>::type == nri::ObjectPoolType::MAX_NUM, "Pooled objects must be destroyed with 'Destroy(object)'");
+
+    AllocationCategoryScope allocationCategoryScope(AllocationCategoryTraits<T>::category);
+
     if (object) {
         object->~T();
         allocationCallbacks.Free(allocationCallbacks.userArg, object);
@@ -96,19 +163,35 @@ inline void Destroy(const AllocationCallbacks& allocationCallbacks, T* object) {
 }
 
 template <typename T>
-inline void Destroy(T* object) {
+inline void DestroyObject(nri::DeviceBase& device, T* object) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategoryTraits<T>::category);
+
     if (object) {
         object->~T();
 
-        const auto& allocationCallbacks = ((nri::DeviceBase&)object->GetDevice()).GetAllocationCallbacks();
-        allocationCallbacks.Free(allocationCallbacks.userArg, object);
+        if constexpr (ObjectPoolTraits<T>::type != nri::ObjectPoolType::MAX_NUM)
+            device.GetObjectPool(ObjectPoolTraits<T>::type).Free(object, sizeof(T), alignof(T));
+        else {
+            const auto& allocationCallbacks = device.GetAllocationCallbacks();
+            allocationCallbacks.Free(allocationCallbacks.userArg, object);
+        }
     }
 }
 
+template <typename T>
+inline void Destroy(T* object) {
+    if (object)
+        DestroyObject((nri::DeviceBase&)object->GetDevice(), object);
+}
+
 constexpr uint64_t MsToUs(uint32_t x) {
     return x * 1000000ull;
 }
 
+constexpr uint32_t NsToMs(uint64_t x) { // rounded up, "UINT64_MAX" maps to "INFINITE" (Windows)
+    return x == UINT64_MAX ? UINT32_MAX : (uint32_t)std::min<uint64_t>((x + 999999) / 1000000, UINT32_MAX - 1);
+}
+
 constexpr void ReturnVoid() {
 }
 
@@ -202,6 +285,16 @@ inline bool IsDepthBiasEnabled(const nri::DepthBiasDesc& depthBiasDesc) {
     return depthBiasDesc.constant != 0.0f || depthBiasDesc.slope != 0.0f;
 }
 
+// FNV-1a, keys must be zero-initialized to not hash padding garbage
+inline uint64_t HashBytes(const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint64_t hash = 14695981039346656037ull;
+    while (size--)
+        hash = (hash ^ (*bytes++)) * 1099511628211ull;
+
+    return hash;
+}
+
 inline nri::TextureDesc FixTextureDesc(const nri::TextureDesc& textureDesc) {
     nri::TextureDesc desc = textureDesc;
     desc.height = std::max(desc.height, (nri::Dim_t)1);
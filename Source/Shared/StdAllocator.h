@@ -165,19 +165,81 @@ using String = std::basic_string<char, std::char_traits<char>, StdAllocator<char
 //================================================================================================================
 
 constexpr size_t MAX_STACK_ALLOC_SIZE = 32 * 1024;
+constexpr size_t SCRATCH_ARENA_SIZE = 256 * 1024;
+
+// Per-thread bump allocator backing big scratch allocations (if the default allocator is used). Scratches are
+// scoped, i.e. released in reverse order, so freeing is just rewinding. The arena grows only when empty
+struct ScratchArena {
+    inline ~ScratchArena() {
+        free(m_Memory);
+    }
+
+    inline void* Allocate(size_t size, size_t alignment, size_t& offset) {
+        size_t requiredSize = size + alignment - 1;
+        if (!m_Offset && requiredSize > m_Size) {
+            free(m_Memory);
+
+            m_Size = requiredSize > SCRATCH_ARENA_SIZE ? requiredSize : SCRATCH_ARENA_SIZE;
+            m_Memory = (uint8_t*)malloc(m_Size);
+            if (!m_Memory) {
+                m_Size = 0;
+                return nullptr;
+            }
+        }
+
+        uintptr_t begin = (uintptr_t)m_Memory;
+        uintptr_t aligned = (begin + m_Offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        if (aligned + size > begin + m_Size)
+            return nullptr;
+
+        offset = m_Offset;
+        m_Offset = aligned + size - begin;
+
+        return (void*)aligned;
+    }
+
+    inline void Rewind(size_t offset) {
+        assert(offset <= m_Offset);
+        m_Offset = offset;
+    }
+
+private:
+    uint8_t* m_Memory = nullptr;
+    size_t m_Size = 0;
+    size_t m_Offset = 0;
+};
+
+inline ScratchArena& GetScratchArena() {
+    static thread_local ScratchArena scratchArena;
+    return scratchArena;
+}
 
 template <typename T>
 class Scratch {
 public:
+    // "mem = nullptr" means "too big for the stack"
     Scratch(const AllocationCallbacks& allocator, T* mem, size_t num)
         : m_Allocator(allocator)
         , m_Mem(mem)
         , m_Num(num) {
-        m_IsHeap = (num * sizeof(T) + alignof(T)) > MAX_STACK_ALLOC_SIZE;
+        if ((num * sizeof(T) + alignof(T)) > MAX_STACK_ALLOC_SIZE) {
+            // The arena is not used with custom allocators to keep all memory visible to the application
+            if (allocator.Allocate == AlignedMalloc) {
+                m_Mem = (T*)GetScratchArena().Allocate(num * sizeof(T), alignof(T), m_ArenaOffset);
+                m_IsArena = m_Mem != nullptr;
+            }
+
+            if (!m_IsArena) {
+                m_Mem = (T*)allocator.Allocate(allocator.userArg, num * sizeof(T), alignof(T));
+                m_IsHeap = true;
+            }
+        }
     }
 
     ~Scratch() {
-        if (m_IsHeap)
+        if (m_IsArena)
+            GetScratchArena().Rewind(m_ArenaOffset);
+        else if (m_IsHeap)
             m_Allocator.Free(m_Allocator.userArg, m_Mem);
     }
 
@@ -194,12 +256,14 @@ private:
     const AllocationCallbacks& m_Allocator;
     T* m_Mem = nullptr;
     size_t m_Num = 0;
+    size_t m_ArenaOffset = 0;
     bool m_IsHeap = false;
+    bool m_IsArena = false;
 };
 
 #define AllocateScratch(device, T, elementNum) \
     {(device).GetAllocationCallbacks(), \
         ((elementNum) * sizeof(T) + alignof(T)) > MAX_STACK_ALLOC_SIZE \
-            ? (T*)(device).GetAllocationCallbacks().Allocate((device).GetAllocationCallbacks().userArg, (elementNum) * sizeof(T), alignof(T)) \
+            ? nullptr \
             : (T*)Align((elementNum) ? (T*)alloca(((elementNum) * sizeof(T) + alignof(T))) : nullptr, alignof(T)), \
         (elementNum)}
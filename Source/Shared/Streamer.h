@@ -77,4 +77,6 @@ private:
     uint64_t m_DynamicDataOffsetBase = 0;
     uint64_t m_DynamicBufferSize = 0;
     uint32_t m_FrameIndex = 0;
-};
\ No newline at end of file
+};
+
+NRI_ALLOCATION_CATEGORY(StreamerImpl, STREAMER);
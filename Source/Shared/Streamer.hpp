@@ -14,6 +14,8 @@ StreamerImpl::~StreamerImpl() {
 }
 
 Result StreamerImpl::Create(const StreamerDesc& desc) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::STREAMER);
+
     if (desc.constantBufferSize) {
         // Create constant buffer
         BufferDesc bufferDesc = {};
@@ -73,6 +75,8 @@ uint32_t StreamerImpl::UpdateStreamerConstantBuffer(const void* data, uint32_t d
 }
 
 uint64_t StreamerImpl::AddStreamerBufferUpdateRequest(const BufferUpdateRequestDesc& bufferUpdateRequestDesc) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::STREAMER);
+
     uint64_t alignedSize = Align(bufferUpdateRequestDesc.dataSize, 16);
 
     uint64_t offset = m_DynamicDataOffsetBase + m_DynamicDataOffset;
@@ -83,6 +87,8 @@ uint64_t StreamerImpl::AddStreamerBufferUpdateRequest(const BufferUpdateRequestD
 }
 
 uint64_t StreamerImpl::AddStreamerTextureUpdateRequest(const TextureUpdateRequestDesc& textureUpdateRequestDesc) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::STREAMER);
+
     const DeviceDesc& deviceDesc = m_NRI.GetDeviceDesc(m_Device);
     const TextureDesc& textureDesc = m_NRI.GetTextureDesc(*textureUpdateRequestDesc.dstTexture);
 
@@ -104,6 +110,8 @@ uint64_t StreamerImpl::AddStreamerTextureUpdateRequest(const TextureUpdateReques
 }
 
 Result StreamerImpl::CopyStreamerUpdateRequests() {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::STREAMER);
+
     if (!m_DynamicDataOffset)
         return Result::SUCCESS;
 
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <mutex>
+
+constexpr uint32_t SUBMISSION_PACKET_NUM = 64; // power of 2
+
+typedef void (*SubmitCallback)(void* queue, const nri::QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum);
+
+// A deep copy of "QueueSubmitBatch" input, memory is reused after the warm-up
+struct SubmissionPacket {
+    Vector<nri::QueueSubmitDesc> queueSubmitDescs;
+    Vector<nri::FenceSubmitDesc> fences;
+    Vector<nri::CommandBuffer*> commandBuffers;
+};
+
+// Submits are pushed into a bounded lock-free MPSC ring (a sequence number per packet), which is consumed by an NRI-owned
+// thread in the claim order. Producers never block in the driver or on each other. They only wait if the ring is full.
+// "Flush" must precede any queue operation, which is not routed through the thread (present, wait for idle...)
+struct SubmissionThread {
+    SubmissionThread(nri::DeviceBase& device, SubmitCallback submitCallback, void* queue);
+    ~SubmissionThread();
+
+    void Push(const nri::QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum); // thread safe
+    void Flush();                                                                        // waits for all pushed submits to reach the driver
+
+private:
+    void ThreadMain();
+
+private:
+    Vector<SubmissionPacket> m_Packets;
+    SubmitCallback m_SubmitCallback = nullptr;
+    void* m_Queue = nullptr;
+    std::thread m_Thread;
+    std::mutex m_Mutex;
+    std::condition_variable m_WakeUp;
+    std::condition_variable m_Done;
+    std::array<std::atomic_uint32_t, SUBMISSION_PACKET_NUM> m_Sequences; // "index" - free, "index + 1" - published
+    alignas(LOCK_CACHELINE_SIZE) std::atomic_uint32_t m_Head{0}; // claimed by producers
+    alignas(LOCK_CACHELINE_SIZE) std::atomic_uint32_t m_Tail{0}; // written by the thread
+    std::atomic_uint32_t m_FlushWaiterNum{0};
+    std::atomic_bool m_IsSleeping{false};
+    bool m_IsExitRequested = false;
+};
@@ -0,0 +1,131 @@
+SubmissionThread::SubmissionThread(DeviceBase& device, SubmitCallback submitCallback, void* queue)
+    : m_Packets(device.GetStdAllocator())
+    , m_SubmitCallback(submitCallback)
+    , m_Queue(queue) {
+    m_Packets.reserve(SUBMISSION_PACKET_NUM);
+    for (uint32_t i = 0; i < SUBMISSION_PACKET_NUM; i++) {
+        m_Packets.push_back({Vector<QueueSubmitDesc>(device.GetStdAllocator()), Vector<FenceSubmitDesc>(device.GetStdAllocator()), Vector<CommandBuffer*>(device.GetStdAllocator())});
+        m_Sequences[i].store(i, std::memory_order_relaxed);
+    }
+
+    m_Thread = std::thread(&SubmissionThread::ThreadMain, this);
+}
+
+SubmissionThread::~SubmissionThread() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_IsExitRequested = true;
+    }
+    m_WakeUp.notify_one();
+
+    // Pending submits are processed before exit
+    m_Thread.join();
+}
+
+void SubmissionThread::Push(const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum) {
+    // Claim a free packet (the thread releases a packet by advancing its sequence by "SUBMISSION_PACKET_NUM")
+    uint32_t head = m_Head.load(std::memory_order_relaxed);
+    while (true) {
+        uint32_t sequence = m_Sequences[head & (SUBMISSION_PACKET_NUM - 1)].load(std::memory_order_acquire);
+        int32_t diff = (int32_t)(sequence - head);
+
+        if (diff == 0) {
+            if (m_Head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed))
+                break;
+        } else {
+            if (diff < 0)
+                std::this_thread::yield(); // the ring is full
+
+            head = m_Head.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Deep copy
+    std::atomic_uint32_t& sequence = m_Sequences[head & (SUBMISSION_PACKET_NUM - 1)];
+    SubmissionPacket& packet = m_Packets[head & (SUBMISSION_PACKET_NUM - 1)];
+
+    uint32_t fenceNum = 0;
+    uint32_t commandBufferNum = 0;
+    for (uint32_t i = 0; i < queueSubmitDescNum; i++) {
+        fenceNum += queueSubmitDescs[i].waitFenceNum + queueSubmitDescs[i].signalFenceNum;
+        commandBufferNum += queueSubmitDescs[i].commandBufferNum;
+    }
+
+    packet.queueSubmitDescs.resize(queueSubmitDescNum);
+    packet.fences.resize(fenceNum);
+    packet.commandBuffers.resize(commandBufferNum);
+
+    FenceSubmitDesc* fences = packet.fences.data();
+    CommandBuffer** commandBuffers = packet.commandBuffers.data();
+
+    for (uint32_t i = 0; i < queueSubmitDescNum; i++) {
+        const QueueSubmitDesc& in = queueSubmitDescs[i];
+        QueueSubmitDesc& out = packet.queueSubmitDescs[i];
+        out = in;
+
+        out.waitFences = fences;
+        for (uint32_t j = 0; j < in.waitFenceNum; j++)
+            *fences++ = in.waitFences[j];
+
+        out.commandBuffers = commandBuffers;
+        for (uint32_t j = 0; j < in.commandBufferNum; j++)
+            *commandBuffers++ = (CommandBuffer*)in.commandBuffers[j];
+
+        out.signalFences = fences;
+        for (uint32_t j = 0; j < in.signalFenceNum; j++)
+            *fences++ = in.signalFences[j];
+    }
+
+    // Publish and wake up the thread if needed (seq_cst pairs with the thread going to sleep)
+    sequence.store(head + 1, std::memory_order_seq_cst);
+
+    if (m_IsSleeping.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        m_WakeUp.notify_one();
+    }
+}
+
+void SubmissionThread::Flush() {
+    uint32_t head = m_Head.load(std::memory_order_acquire);
+    if (m_Tail.load(std::memory_order_acquire) == head)
+        return;
+
+    m_FlushWaiterNum.fetch_add(1, std::memory_order_seq_cst);
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Done.wait(lock, [&] { return (int32_t)(m_Tail.load(std::memory_order_seq_cst) - head) >= 0; });
+    }
+    m_FlushWaiterNum.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void SubmissionThread::ThreadMain() {
+    uint32_t tail = m_Tail.load(std::memory_order_relaxed);
+
+    while (true) {
+        // Packets are consumed in the claim order, i.e. a claimed, but not yet published packet blocks the next ones
+        std::atomic_uint32_t& sequence = m_Sequences[tail & (SUBMISSION_PACKET_NUM - 1)];
+        if (sequence.load(std::memory_order_acquire) != tail + 1) {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+
+            m_IsSleeping.store(true, std::memory_order_seq_cst);
+            m_WakeUp.wait(lock, [&] { return m_IsExitRequested || sequence.load(std::memory_order_seq_cst) == tail + 1; });
+            m_IsSleeping.store(false, std::memory_order_relaxed);
+
+            if (sequence.load(std::memory_order_acquire) != tail + 1)
+                break; // exit requested and nothing to submit
+
+            continue;
+        }
+
+        const SubmissionPacket& packet = m_Packets[tail & (SUBMISSION_PACKET_NUM - 1)];
+        m_SubmitCallback(m_Queue, packet.queueSubmitDescs.data(), (uint32_t)packet.queueSubmitDescs.size());
+
+        sequence.store(tail + SUBMISSION_PACKET_NUM, std::memory_order_release);
+        m_Tail.store(++tail, std::memory_order_seq_cst);
+
+        if (m_FlushWaiterNum.load(std::memory_order_seq_cst)) {
+            std::lock_guard<std::mutex> guard(m_Mutex);
+            m_Done.notify_all();
+        }
+    }
+}
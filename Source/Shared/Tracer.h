@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdio>
+
+constexpr uint32_t TRACE_EVENT_MAX_NUM_DEFAULT = 65536; // per thread
+constexpr size_t TRACE_NAME_MAX_LENGTH = 55;            // including the terminator, longer names get truncated
+
+enum class TraceEventType : uint8_t {
+    BEGIN,
+    END,
+    INSTANT
+};
+
+struct TraceEvent {
+    uint64_t timestamp; // ns, "steady_clock"
+    char name[TRACE_NAME_MAX_LENGTH];
+    TraceEventType type;
+};
+
+static_assert(sizeof(TraceEvent) == 64, "A cache line per event is expected");
+
+// Single producer: only the owner thread writes events and publishes them by bumping "writeIndex". Rings are created on
+// the first event of a thread in a capture and outlive the thread (orphaned), since events are needed for writing
+struct TraceRing {
+    inline TraceRing(const AllocationCallbacks& allocationCallbacks)
+        : events(allocationCallbacks) {
+    }
+
+    Vector<TraceEvent> events;
+    std::atomic_uint64_t writeIndex = 0; // monotonic, the oldest events get overwritten
+    std::atomic_bool isWriting = false;  // the owner is recording an event, "EndCapture" waits for it
+    uint64_t generation = 0;             // the capture the ring belongs to
+    uint32_t threadIndex = 0;            // "tid" in JSON
+    char threadName[TRACE_NAME_MAX_LENGTH] = {};
+    bool isOrphaned = false;
+};
+
+// Process-wide CPU event tracer, exposed via "nriBeginTraceCapture", "nriEndTraceCapture" and "nriWriteTraceCapture".
+// An inactive tracer costs a relaxed load per event
+struct Tracer {
+    static Tracer& Get();
+
+    Tracer();
+    ~Tracer();
+
+    inline bool IsActive() const {
+        return m_IsActive.load(std::memory_order_relaxed);
+    }
+
+    inline bool IsCapturingApiCalls() const {
+        return m_IsCapturingApiCalls.load(std::memory_order_relaxed);
+    }
+
+    inline void Record(TraceEventType type, const char* name) {
+        if (IsActive())
+            RecordSlow(type, name);
+    }
+
+    void BeginCapture(uint32_t eventMaxNumPerThread, bool captureApiCalls);
+    void EndCapture();
+    nri::Result WriteCapture(const char* path);
+    void SetThreadName(const char* name);
+    void OrphanRing(TraceRing* ring);
+
+private:
+    void RecordSlow(TraceEventType type, const char* name);
+    TraceRing* AcquireRing();
+
+private:
+    AllocationCallbacks m_AllocationCallbacks = {}; // the default allocator, since the tracer is not bound to a device
+    Vector<TraceRing*> m_Rings;
+    std::atomic_uint64_t m_CaptureBegin = 0; // ns, "steady_clock"
+    std::atomic_uint64_t m_Generation = 0;
+    std::atomic_bool m_IsActive = false;
+    std::atomic_bool m_IsCapturingApiCalls = false;
+    uint32_t m_EventMaxNum = TRACE_EVENT_MAX_NUM_DEFAULT;
+    uint32_t m_ThreadNum = 0;
+    Lock m_Lock{"Tracer"}; // guards "m_Rings", i.e. ring creation, orphaning, fencing writers out and writing
+};
+
+// Records an exported function or an interface function call as a range, if "captureApiCalls" is enabled
+struct TraceScope {
+    inline TraceScope(const char* name) {
+        Tracer& tracer = Tracer::Get();
+        m_IsRecorded = tracer.IsCapturingApiCalls();
+        if (m_IsRecorded)
+            tracer.Record(TraceEventType::BEGIN, name);
+    }
+
+    inline ~TraceScope() {
+        if (m_IsRecorded)
+            Tracer::Get().Record(TraceEventType::END, nullptr);
+    }
+
+private:
+    bool m_IsRecorded;
+};
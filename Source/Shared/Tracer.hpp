@@ -0,0 +1,227 @@
+// Owner side: returns the ring to the tracer on thread exit
+struct TraceThreadSlot {
+    ~TraceThreadSlot() {
+        if (ring)
+            Tracer::Get().OrphanRing(ring);
+    }
+
+    TraceRing* ring = nullptr;
+    char threadName[TRACE_NAME_MAX_LENGTH] = {};
+};
+
+static thread_local TraceThreadSlot g_TraceThreadSlot;
+
+static inline uint64_t GetTraceTimestamp() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void CopyTraceName(char* dst, const char* src) {
+    size_t i = 0;
+    if (src) {
+        for (; i < TRACE_NAME_MAX_LENGTH - 1 && src[i]; i++)
+            dst[i] = src[i];
+    }
+
+    dst[i] = '\0';
+}
+
+static void WriteTraceString(FILE* file, const char* s) {
+    fputc('"', file);
+
+    for (; *s; s++) {
+        char c = *s;
+        if (c == '"' || c == '\\')
+            fprintf(file, "\\%c", c);
+        else if ((uint8_t)c < 0x20)
+            fprintf(file, "\\u%04x", (uint8_t)c);
+        else
+            fputc(c, file);
+    }
+
+    fputc('"', file);
+}
+
+Tracer& Tracer::Get() {
+    static Tracer tracer;
+
+    return tracer;
+}
+
+Tracer::Tracer()
+    : m_Rings(StdAllocator<TraceRing*>(m_AllocationCallbacks)) {
+    CheckAndSetDefaultAllocator(m_AllocationCallbacks);
+}
+
+Tracer::~Tracer() {
+    for (TraceRing* ring : m_Rings)
+        Destroy(m_AllocationCallbacks, ring);
+}
+
+void Tracer::BeginCapture(uint32_t eventMaxNumPerThread, bool captureApiCalls) {
+    ExclusiveScope lock(m_Lock);
+
+    // Rings of the previous capture get reset by their owners on the next event, orphaned rings are not needed anymore
+    for (size_t i = 0; i < m_Rings.size();) {
+        TraceRing* ring = m_Rings[i];
+        if (ring->isOrphaned) {
+            Destroy(m_AllocationCallbacks, ring);
+
+            m_Rings[i] = m_Rings.back();
+            m_Rings.pop_back();
+        } else
+            i++;
+    }
+
+    m_EventMaxNum = eventMaxNumPerThread ? eventMaxNumPerThread : TRACE_EVENT_MAX_NUM_DEFAULT;
+    m_ThreadNum = 0;
+    m_CaptureBegin.store(GetTraceTimestamp(), std::memory_order_relaxed);
+    m_Generation.fetch_add(1, std::memory_order_release);
+
+    m_IsCapturingApiCalls.store(captureApiCalls, std::memory_order_relaxed);
+    m_IsActive.store(true, std::memory_order_release);
+}
+
+// Fences writers out: a writer either sees the capture inactive or gets waited for (see "RecordSlow")
+void Tracer::EndCapture() {
+    m_IsCapturingApiCalls.store(false, std::memory_order_relaxed);
+    m_IsActive.store(false, std::memory_order_seq_cst);
+
+    ExclusiveScope lock(m_Lock);
+
+    for (const TraceRing* ring : m_Rings) {
+        while (ring->isWriting.load(std::memory_order_seq_cst))
+            std::this_thread::yield();
+    }
+}
+
+void Tracer::SetThreadName(const char* name) {
+    TraceThreadSlot& slot = g_TraceThreadSlot;
+    CopyTraceName(slot.threadName, name);
+
+    if (slot.ring) {
+        ExclusiveScope lock(m_Lock);
+        CopyTraceName(slot.ring->threadName, name);
+    }
+}
+
+void Tracer::OrphanRing(TraceRing* ring) {
+    ExclusiveScope lock(m_Lock);
+    ring->isOrphaned = true;
+}
+
+TraceRing* Tracer::AcquireRing() {
+    TraceThreadSlot& slot = g_TraceThreadSlot;
+    uint64_t generation = m_Generation.load(std::memory_order_acquire);
+
+    TraceRing* ring = slot.ring;
+    if (ring && ring->generation == generation)
+        return ring;
+
+    // Slow path: once per thread per capture
+    ExclusiveScope lock(m_Lock);
+
+    if (!ring) {
+        ring = Allocate<TraceRing>(m_AllocationCallbacks, m_AllocationCallbacks);
+        m_Rings.push_back(ring);
+
+        slot.ring = ring;
+    }
+
+    ring->events.resize(m_EventMaxNum);
+    ring->writeIndex.store(0, std::memory_order_relaxed);
+    ring->generation = generation;
+    ring->threadIndex = m_ThreadNum++;
+    CopyTraceName(ring->threadName, slot.threadName);
+
+    return ring;
+}
+
+void Tracer::RecordSlow(TraceEventType type, const char* name) {
+    TraceRing* ring = AcquireRing();
+
+    // Pairs with "EndCapture": publish the write, then re-check the state
+    ring->isWriting.store(true, std::memory_order_seq_cst);
+    if (!m_IsActive.load(std::memory_order_seq_cst)) {
+        ring->isWriting.store(false, std::memory_order_release);
+        return;
+    }
+
+    uint64_t writeIndex = ring->writeIndex.load(std::memory_order_relaxed);
+
+    TraceEvent& event = ring->events[writeIndex % ring->events.size()];
+    event.timestamp = GetTraceTimestamp() - m_CaptureBegin.load(std::memory_order_relaxed);
+    event.type = type;
+    CopyTraceName(event.name, name);
+
+    ring->writeIndex.store(writeIndex + 1, std::memory_order_release);
+    ring->isWriting.store(false, std::memory_order_release);
+}
+
+// Rings are read without synchronization with the owners, which is fine only after "EndCapture"
+Result Tracer::WriteCapture(const char* path) {
+    ExclusiveScope lock(m_Lock);
+
+    if (IsActive())
+        return Result::INVALID_ARGUMENT;
+
+    FILE* file = fopen(path, "wb");
+    if (!file)
+        return Result::FAILURE;
+
+    uint64_t generation = m_Generation.load(std::memory_order_acquire);
+    uint64_t droppedEventNum = 0;
+    bool isFirst = true;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+    for (const TraceRing* ring : m_Rings) {
+        if (ring->generation != generation)
+            continue;
+
+        // Thread name
+        if (ring->threadName[0]) {
+            fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", isFirst ? "" : ",", ring->threadIndex);
+            WriteTraceString(file, ring->threadName);
+            fprintf(file, "}}");
+
+            isFirst = false;
+        }
+
+        // Events, oldest first
+        uint64_t writeIndex = ring->writeIndex.load(std::memory_order_acquire);
+        uint64_t eventNum = ring->events.size();
+        uint64_t readIndex = writeIndex > eventNum ? writeIndex - eventNum : 0;
+        droppedEventNum += readIndex;
+
+        uint32_t depth = 0;
+        for (; readIndex < writeIndex; readIndex++) {
+            const TraceEvent& event = ring->events[readIndex % eventNum];
+
+            // "END"s of overwritten "BEGIN"s can't be matched
+            const char* phase = "i";
+            if (event.type == TraceEventType::BEGIN) {
+                phase = "B";
+                depth++;
+            } else if (event.type == TraceEventType::END) {
+                if (!depth)
+                    continue;
+
+                phase = "E";
+                depth--;
+            }
+
+            fprintf(file, "%s\n{\"name\":", isFirst ? "" : ",");
+            WriteTraceString(file, event.name);
+            fprintf(file, ",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":1,\"tid\":%u%s}", phase, event.timestamp / 1000.0, ring->threadIndex, event.type == TraceEventType::INSTANT ? ",\"s\":\"t\"" : "");
+
+            isFirst = false;
+        }
+    }
+
+    fprintf(file, "\n],\"otherData\":{\"droppedEventNum\":%llu}}\n", (unsigned long long)droppedEventNum);
+
+    bool isWritten = !ferror(file);
+    fclose(file);
+
+    return isWritten ? Result::SUCCESS : Result::FAILURE;
+}
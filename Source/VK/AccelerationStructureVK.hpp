@@ -82,7 +82,7 @@ NRI_INLINE void AccelerationStructureVK::SetDebugName(const char* name) {
 }
 
 NRI_INLINE Result AccelerationStructureVK::CreateDescriptor(Descriptor*& descriptor) const {
-    DescriptorVK* descriptorImpl = Allocate<DescriptorVK>(m_Device.GetAllocationCallbacks(), m_Device);
+    DescriptorVK* descriptorImpl = AllocateObject<DescriptorVK>(m_Device, m_Device);
 
     Result result = descriptorImpl->Create(m_Handle);
 
@@ -91,7 +91,7 @@ NRI_INLINE Result AccelerationStructureVK::CreateDescriptor(Descriptor*& descrip
         return Result::SUCCESS;
     }
 
-    Destroy(m_Device.GetAllocationCallbacks(), descriptorImpl);
+    Destroy(descriptorImpl);
 
     return Result::SUCCESS;
 }
@@ -0,0 +1,41 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+struct AllocatorPoolVK final : public DebugNameBase {
+    inline AllocatorPoolVK(DeviceVK& device)
+        : m_Device(device) {
+    }
+
+    inline VmaPool_T* GetHandle() const {
+        return m_Handle;
+    }
+
+    inline DeviceVK& GetDevice() const {
+        return m_Device;
+    }
+
+    inline const AllocatorPoolDesc& GetDesc() const {
+        return m_Desc;
+    }
+
+    ~AllocatorPoolVK();
+
+    Result Create(const AllocatorPoolDesc& allocatorPoolDesc);
+    void GetStats(AllocatorStats& allocatorStats) const;
+
+    //================================================================================================================
+    // DebugNameBase
+    //================================================================================================================
+
+    void SetDebugName(const char* name) DEBUG_NAME_OVERRIDE;
+
+private:
+    DeviceVK& m_Device;
+    VmaPool_T* m_Handle = nullptr;
+    AllocatorPoolDesc m_Desc = {};
+};
+
+} // namespace nri
@@ -27,6 +27,10 @@ struct BufferVK final : public DebugNameBase {
         return m_Desc;
     }
 
+    inline VmaAllocation_T* GetVmaAllocation() const {
+        return m_VmaAllocation;
+    }
+
     ~BufferVK();
 
     Result Create(const BufferDesc& bufferDesc);
@@ -34,7 +38,10 @@ struct BufferVK final : public DebugNameBase {
     Result Create(const AllocateBufferDesc& bufferDesc);
     void FinishMemoryBinding(MemoryVK& memory, uint64_t memoryOffset);
     void DestroyVma();
+    Result BindDefragmentationTarget(VmaAllocation_T* allocation);
+    void FinishDefragmentationMove(BufferVK& target);
     void GetMemoryDesc(MemoryLocation memoryLocation, MemoryDesc& memoryDesc) const;
+    bool GetMappedMemoryRange(uint64_t offset, uint64_t size, VkMappedMemoryRange& memoryRange) const; // "false" if flushes are not needed
 
     //================================================================================================================
     // DebugNameBase
@@ -46,20 +53,25 @@ struct BufferVK final : public DebugNameBase {
     // NRI
     //================================================================================================================
 
-    void* Map(uint64_t offset, uint64_t size);
+    void* Map(uint64_t offset, uint64_t size, MapMode mapMode);
     void Unmap();
 
+private:
+    void FinishVmaBinding();
+
 private:
     DeviceVK& m_Device;
     VkBuffer m_Handle = VK_NULL_HANDLE;
     VkDeviceAddress m_DeviceAddress = 0;
     uint8_t* m_MappedMemory = nullptr;
     VkDeviceMemory m_NonCoherentDeviceMemory = VK_NULL_HANDLE;
+    uint64_t m_NonCoherentDeviceMemorySize = 0; // 0 if unknown (wrapped objects)
     uint64_t m_MappedMemoryOffset = 0;
     uint64_t m_MappedMemoryRangeSize = 0;
     uint64_t m_MappedMemoryRangeOffset = 0;
     BufferDesc m_Desc = {};
     VmaAllocation_T* m_VmaAllocation = nullptr;
+    MapMode m_MapMode = MapMode::FLUSH_ON_UNMAP;
     bool m_OwnsNativeObjects = true;
 };
 
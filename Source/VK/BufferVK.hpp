@@ -49,8 +49,10 @@ void BufferVK::FinishMemoryBinding(MemoryVK& memory, uint64_t memoryOffset) {
         m_MappedMemory = memory.GetMappedMemory();
         m_MappedMemoryOffset = memoryOffset;
 
-        if (!m_Device.IsHostCoherentMemory(memoryTypeInfo.index))
+        if (!m_Device.IsHostCoherentMemory(memoryTypeInfo.index)) {
             m_NonCoherentDeviceMemory = memory.GetHandle();
+            m_NonCoherentDeviceMemorySize = memory.GetSize();
+        }
     }
 
     // Device address
@@ -91,7 +93,30 @@ NRI_INLINE void BufferVK::SetDebugName(const char* name) {
     m_Device.SetDebugNameToTrivialObject(VK_OBJECT_TYPE_BUFFER, (uint64_t)m_Handle, name);
 }
 
-NRI_INLINE void* BufferVK::Map(uint64_t offset, uint64_t size) {
+NRI_INLINE bool BufferVK::GetMappedMemoryRange(uint64_t offset, uint64_t size, VkMappedMemoryRange& memoryRange) const {
+    if (!m_NonCoherentDeviceMemory)
+        return false;
+
+    if (size == WHOLE_SIZE)
+        size = m_Desc.size - offset;
+
+    // "offset" and "size" must be multiples of "nonCoherentAtomSize", unless the range ends at the end of the memory
+    uint64_t atomSize = m_Device.GetNonCoherentAtomSize();
+    uint64_t begin = m_MappedMemoryOffset + offset;
+    uint64_t end = begin + size;
+
+    begin -= begin % atomSize;
+    end = Align(end, atomSize);
+
+    memoryRange = {VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE};
+    memoryRange.memory = m_NonCoherentDeviceMemory;
+    memoryRange.offset = begin;
+    memoryRange.size = (m_NonCoherentDeviceMemorySize && end < m_NonCoherentDeviceMemorySize) ? end - begin : VK_WHOLE_SIZE;
+
+    return true;
+}
+
+NRI_INLINE void* BufferVK::Map(uint64_t offset, uint64_t size, MapMode mapMode) {
     CHECK(m_MappedMemory, "The buffer does not support memory mapping");
 
     if (size == WHOLE_SIZE)
@@ -99,6 +124,7 @@ NRI_INLINE void* BufferVK::Map(uint64_t offset, uint64_t size) {
 
     m_MappedMemoryRangeSize = size;
     m_MappedMemoryRangeOffset = offset;
+    m_MapMode = mapMode;
 
     offset += m_MappedMemoryOffset;
 
@@ -106,14 +132,12 @@ NRI_INLINE void* BufferVK::Map(uint64_t offset, uint64_t size) {
 }
 
 NRI_INLINE void BufferVK::Unmap() {
-    if (m_NonCoherentDeviceMemory) {
-        VkMappedMemoryRange memoryRange = {VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE};
-        memoryRange.memory = m_NonCoherentDeviceMemory;
-        memoryRange.offset = m_MappedMemoryOffset + m_MappedMemoryRangeOffset;
-        memoryRange.size = m_MappedMemoryRangeSize;
-
+    VkMappedMemoryRange memoryRange = {};
+    if (m_MapMode == MapMode::FLUSH_ON_UNMAP && GetMappedMemoryRange(m_MappedMemoryRangeOffset, m_MappedMemoryRangeSize, memoryRange)) {
         const auto& vk = m_Device.GetDispatchTable();
         VkResult result = vk.FlushMappedMemoryRanges(m_Device, 1, &memoryRange);
         RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, ReturnVoid(), "vkFlushMappedMemoryRanges returned %d", (int32_t)result);
+
+        m_Device.GetMappedMemoryStats().AddFlush(1);
     }
 }
@@ -32,7 +32,7 @@ struct CommandAllocatorVK final : public DebugNameBase {
     // NRI
     //================================================================================================================
 
-    Result CreateCommandBuffer(CommandBuffer*& commandBuffer);
+    Result CreateCommandBuffer(CommandBuffer*& commandBuffer, bool isSecondary);
     void Reset();
 
 private:
@@ -43,3 +43,5 @@ private:
 };
 
 } // namespace nri
+
+NRI_ALLOCATION_CATEGORY(nri::CommandAllocatorVK, COMMAND_BUFFER);
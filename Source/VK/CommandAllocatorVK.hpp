@@ -36,8 +36,9 @@ NRI_INLINE void CommandAllocatorVK::SetDebugName(const char* name) {
     m_Device.SetDebugNameToTrivialObject(VK_OBJECT_TYPE_COMMAND_POOL, (uint64_t)m_Handle, name);
 }
 
-NRI_INLINE Result CommandAllocatorVK::CreateCommandBuffer(CommandBuffer*& commandBuffer) {
-    const VkCommandBufferAllocateInfo info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, nullptr, m_Handle, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1};
+NRI_INLINE Result CommandAllocatorVK::CreateCommandBuffer(CommandBuffer*& commandBuffer, bool isSecondary) {
+    VkCommandBufferLevel level = isSecondary ? VK_COMMAND_BUFFER_LEVEL_SECONDARY : VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    const VkCommandBufferAllocateInfo info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, nullptr, m_Handle, level, 1};
 
     VkCommandBuffer commandBufferHandle = VK_NULL_HANDLE;
 
@@ -45,7 +46,7 @@ NRI_INLINE Result CommandAllocatorVK::CreateCommandBuffer(CommandBuffer*& comman
     VkResult result = vk.AllocateCommandBuffers(m_Device, &info, &commandBufferHandle);
     RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vkAllocateCommandBuffers returned %d", (int32_t)result);
 
-    CommandBufferVK* commandBufferImpl = Allocate<CommandBufferVK>(m_Device.GetAllocationCallbacks(), m_Device);
+    CommandBufferVK* commandBufferImpl = AllocateObject<CommandBufferVK>(m_Device, m_Device);
     commandBufferImpl->Create(m_Handle, commandBufferHandle, m_Type);
 
     commandBuffer = (CommandBuffer*)commandBufferImpl;
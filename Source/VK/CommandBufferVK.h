@@ -21,6 +21,14 @@ struct CommandBufferVK final : public DebugNameBase {
         return m_Device;
     }
 
+    inline CommandBufferStats& GetStats() {
+        return m_Stats;
+    }
+
+    inline ProfilerZoneState& GetProfilerZoneState() {
+        return m_ProfilerZoneState;
+    }
+
     ~CommandBufferVK();
 
     void Create(VkCommandPool commandPool, VkCommandBuffer commandBuffer, QueueType type);
@@ -37,6 +45,7 @@ struct CommandBufferVK final : public DebugNameBase {
     //================================================================================================================
 
     Result Begin(const DescriptorPool* descriptorPool);
+    Result BeginSecondary(const DescriptorPool* descriptorPool, const InheritanceDesc& inheritanceDesc);
     Result End();
     void SetPipeline(const Pipeline& pipeline);
     void SetPipelineLayout(const PipelineLayout& pipelineLayout);
@@ -62,6 +71,7 @@ struct CommandBufferVK final : public DebugNameBase {
     void DrawIndexed(const DrawIndexedDesc& drawIndexedDesc);
     void DrawIndirect(const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset);
     void DrawIndexedIndirect(const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset);
+    void ExecuteCommandBuffers(const CommandBuffer* const* commandBuffers, uint32_t commandBufferNum);
     void Dispatch(const DispatchDesc& dispatchDesc);
     void DispatchIndirect(const Buffer& buffer, uint64_t offset);
     void BeginQuery(QueryPool& queryPool, uint32_t offset);
@@ -96,6 +106,8 @@ private:
     const DescriptorVK* m_DepthStencil = nullptr;
     VkCommandBuffer m_Handle = VK_NULL_HANDLE;
     VkCommandPool m_CommandPool = VK_NULL_HANDLE;
+    CommandBufferStats m_Stats = {};
+    ProfilerZoneState m_ProfilerZoneState;
     QueueType m_Type = (QueueType)0;
     uint32_t m_ViewMask = 0;
     Dim_t m_RenderLayerNum = 0;
@@ -104,3 +116,6 @@ private:
 };
 
 } // namespace nri
+
+NRI_OBJECT_POOL(nri::CommandBufferVK, COMMAND_BUFFER);
+NRI_ALLOCATION_CATEGORY(nri::CommandBufferVK, COMMAND_BUFFER);
@@ -42,6 +42,43 @@ NRI_INLINE Result CommandBufferVK::Begin(const DescriptorPool*) {
     return Result::SUCCESS;
 }
 
+NRI_INLINE Result CommandBufferVK::BeginSecondary(const DescriptorPool*, const InheritanceDesc& inheritanceDesc) {
+    Scratch<VkFormat> colorFormats = AllocateScratch(m_Device, VkFormat, inheritanceDesc.colorNum);
+    for (uint32_t i = 0; i < inheritanceDesc.colorNum; i++)
+        colorFormats[i] = GetVkFormat(inheritanceDesc.colorFormats[i]);
+
+    VkFormat depthStencilFormat = GetVkFormat(inheritanceDesc.depthStencilFormat);
+
+    VkCommandBufferInheritanceRenderingInfo renderingInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO};
+    renderingInfo.viewMask = inheritanceDesc.viewMask;
+    renderingInfo.colorAttachmentCount = inheritanceDesc.colorNum;
+    renderingInfo.pColorAttachmentFormats = colorFormats;
+    renderingInfo.depthAttachmentFormat = depthStencilFormat;
+    renderingInfo.stencilAttachmentFormat = HasStencil(inheritanceDesc.depthStencilFormat) ? depthStencilFormat : VK_FORMAT_UNDEFINED;
+    renderingInfo.rasterizationSamples = (VkSampleCountFlagBits)(inheritanceDesc.sampleNum ? inheritanceDesc.sampleNum : 1);
+
+    VkCommandBufferInheritanceInfo inheritanceInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO};
+    inheritanceInfo.pNext = &renderingInfo;
+
+    VkCommandBufferBeginInfo info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    info.pInheritanceInfo = &inheritanceInfo;
+
+    const auto& vk = m_Device.GetDispatchTable();
+    VkResult result = vk.BeginCommandBuffer(m_Handle, &info);
+    RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vkBeginCommandBuffer returned %d", (int32_t)result);
+
+    m_CurrentPipelineLayout = nullptr;
+    m_CurrentPipeline = nullptr;
+    m_DepthStencil = nullptr;
+    m_ViewMask = inheritanceDesc.viewMask;
+    m_RenderLayerNum = 0; // the render area is unknown, i.e. "ClearAttachments" is not allowed
+    m_RenderWidth = 0;
+    m_RenderHeight = 0;
+
+    return Result::SUCCESS;
+}
+
 NRI_INLINE Result CommandBufferVK::End() {
     const auto& vk = m_Device.GetDispatchTable();
     VkResult result = vk.EndCommandBuffer(m_Handle);
@@ -147,7 +184,8 @@ NRI_INLINE void CommandBufferVK::SetDepthBias(const DepthBiasDesc& depthBiasDesc
 NRI_INLINE void CommandBufferVK::ClearAttachments(const ClearDesc* clearDescs, uint32_t clearDescNum, const Rect* rects, uint32_t rectNum) {
     static_assert(sizeof(VkClearValue) == sizeof(ClearValue), "Sizeof mismatch");
 
-    if (!clearDescNum)
+    // Not allowed in secondary command buffers (see "InheritanceDesc")
+    if (!clearDescNum || !m_RenderLayerNum)
         return;
 
     // Attachments
@@ -160,9 +198,9 @@ NRI_INLINE void CommandBufferVK::ClearAttachments(const ClearDesc* clearDescs, u
         VkImageAspectFlags aspectMask = 0;
         if (desc.planes & PlaneBits::COLOR)
             aspectMask |= VK_IMAGE_ASPECT_COLOR_BIT;
-        if ((desc.planes & PlaneBits::DEPTH) && m_DepthStencil->IsDepthWritable())
+        if ((desc.planes & PlaneBits::DEPTH) && m_DepthStencil && m_DepthStencil->IsDepthWritable())
             aspectMask |= VK_IMAGE_ASPECT_DEPTH_BIT;
-        if ((desc.planes & PlaneBits::STENCIL) && m_DepthStencil->IsStencilWritable())
+        if ((desc.planes & PlaneBits::STENCIL) && m_DepthStencil && m_DepthStencil->IsStencilWritable())
             aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
 
         if (aspectMask) {
@@ -297,7 +335,7 @@ NRI_INLINE void CommandBufferVK::BeginRendering(const AttachmentsDesc& attachmen
         m_RenderLayerNum = 1;
 
     VkRenderingInfo renderingInfo = {VK_STRUCTURE_TYPE_RENDERING_INFO};
-    renderingInfo.flags = 0;
+    renderingInfo.flags = attachmentsDesc.secondaryCommandBuffers ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT : 0;
     renderingInfo.renderArea = {{0, 0}, {m_RenderWidth, m_RenderHeight}};
     renderingInfo.layerCount = m_RenderLayerNum;
     renderingInfo.viewMask = attachmentsDesc.viewMask;
@@ -470,6 +508,19 @@ NRI_INLINE void CommandBufferVK::DrawIndexedIndirect(const Buffer& buffer, uint6
         vk.CmdDrawIndexedIndirect(m_Handle, bufferVK.GetHandle(), offset, drawNum, stride);
 }
 
+NRI_INLINE void CommandBufferVK::ExecuteCommandBuffers(const CommandBuffer* const* commandBuffers, uint32_t commandBufferNum) {
+    Scratch<VkCommandBuffer> handles = AllocateScratch(m_Device, VkCommandBuffer, commandBufferNum);
+    for (uint32_t i = 0; i < commandBufferNum; i++)
+        handles[i] = *(CommandBufferVK*)commandBuffers[i];
+
+    const auto& vk = m_Device.GetDispatchTable();
+    vk.CmdExecuteCommands(m_Handle, commandBufferNum, handles);
+
+    // State is not inherited back from secondary command buffers
+    m_CurrentPipelineLayout = nullptr;
+    m_CurrentPipeline = nullptr;
+}
+
 NRI_INLINE void CommandBufferVK::CopyBuffer(Buffer& dstBuffer, uint64_t dstOffset, const Buffer& srcBuffer, uint64_t srcOffset, uint64_t size) {
     const BufferVK& src = (const BufferVK&)srcBuffer;
     const BufferVK& dstBufferImpl = (const BufferVK&)dstBuffer;
@@ -0,0 +1,34 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+struct DefragmentationVK final : public DebugNameBase {
+    inline DefragmentationVK(DeviceVK& device)
+        : m_Device(device)
+        , m_Resources(device.GetStdAllocator())
+        , m_Moves(device.GetStdAllocator()) {
+    }
+
+    inline DeviceVK& GetDevice() const {
+        return m_Device;
+    }
+
+    ~DefragmentationVK();
+
+    Result Create(const DefragmentationDesc& defragmentationDesc);
+    Result GetPass(DefragmentationPass& defragmentationPass);
+    Result EndPass();
+    void End(DefragmentationStats& defragmentationStats);
+
+private:
+    DeviceVK& m_Device;
+    UnorderedMap<VmaAllocation_T*, DefragmentationMove> m_Resources; // only "src" is set
+    Vector<DefragmentationMove> m_Moves;                              // the current pass
+    VmaDefragmentationContext_T* m_Context = nullptr;
+    VmaDefragmentationMove* m_VmaMoves = nullptr; // owned by VMA, "nullptr" if there is no pass in progress
+    uint32_t m_VmaMoveNum = 0;
+};
+
+} // namespace nri
@@ -83,6 +83,19 @@ struct DescriptorVK final : public DebugNameBase {
         return m_BufferDesc;
     }
 
+    inline bool IsCached() const {
+        return m_IsCached;
+    }
+
+    inline uint64_t GetCacheHash() const {
+        return m_CacheHash;
+    }
+
+    inline void SetCacheHash(uint64_t hash) {
+        m_CacheHash = hash;
+        m_IsCached = true;
+    }
+
     inline bool IsDepthWritable() const {
         return m_TextureDesc.layout != VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_STENCIL_ATTACHMENT_OPTIMAL && m_TextureDesc.layout != VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
     }
@@ -145,7 +158,12 @@ private:
         DescriptorBufDesc m_BufferDesc;
     };
 
+    uint64_t m_CacheHash = 0;
     DescriptorTypeVK m_Type = DescriptorTypeVK::NONE;
+    bool m_IsCached = false;
 };
 
-} // namespace nri
\ No newline at end of file
+} // namespace nri
+
+NRI_OBJECT_POOL(nri::DescriptorVK, DESCRIPTOR);
+NRI_ALLOCATION_CATEGORY(nri::DescriptorVK, DESCRIPTOR);
\ No newline at end of file
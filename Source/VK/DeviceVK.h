@@ -5,6 +5,7 @@
 namespace nri {
 
 struct QueueVK;
+struct DescriptorVK;
 
 struct IsSupported {
     uint32_t descriptorIndexing : 1;
@@ -26,6 +27,27 @@ struct IsSupported {
 
 static_assert(sizeof(IsSupported) == sizeof(uint32_t), "4 bytes expected");
 
+// "enableDescriptorCache": a normalized creation desc, zero-initialized and compared entirely
+struct DescriptorKeyVK {
+    union {
+        BufferViewDesc bufferView;
+        Texture1DViewDesc texture1DView;
+        Texture2DViewDesc texture2DView;
+        Texture3DViewDesc texture3DView;
+        SamplerDesc sampler;
+    };
+
+    uint32_t descIndex; // distinguishes union members, "DESCRIPTOR_KEY_EVICTED" never matches
+};
+
+constexpr uint32_t DESCRIPTOR_KEY_EVICTED = uint32_t(-1);
+
+struct DescriptorCacheEntryVK {
+    DescriptorKeyVK key;
+    DescriptorVK* descriptor;
+    uint32_t refNum;
+};
+
 struct DeviceVK final : public DeviceBase {
     inline operator VkDevice() const {
         return m_Device;
@@ -59,17 +81,35 @@ struct DeviceVK final : public DeviceBase {
         return (m_MemoryProps.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
     }
 
+    inline bool IsDeviceLocalHeap(MemoryTypeIndex memoryTypeIndex) const {
+        uint32_t heapIndex = m_MemoryProps.memoryTypes[memoryTypeIndex].heapIndex;
+        return (m_MemoryProps.memoryHeaps[heapIndex].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+    }
+
+    inline const MemoryDescCache& GetMemoryDescCache() const {
+        return m_MemoryDescCache;
+    }
+
     inline VmaAllocator_T* GetVma() const {
         return m_Vma;
     }
 
+    inline uint64_t GetNonCoherentAtomSize() const {
+        return m_NonCoherentAtomSize;
+    }
+
+    template <typename Desc>
+    Result CreateDescriptor(Descriptor*& descriptor, const Desc& desc);
+
     template <typename Implementation, typename Interface, typename... Args>
     inline Result CreateImplementation(Interface*& entity, const Args&... args) {
-        Implementation* impl = Allocate<Implementation>(GetAllocationCallbacks(), *this);
+        AllocationCategoryScope allocationCategoryScope(AllocationCategoryTraits<Implementation>::category);
+
+        Implementation* impl = AllocateObject<Implementation>(*this, *this);
         Result result = impl->Create(args...);
 
         if (result != Result::SUCCESS) {
-            Destroy(GetAllocationCallbacks(), impl);
+            DestroyObject(*this, impl);
             entity = nullptr;
         } else
             entity = (Interface*)impl;
@@ -92,6 +132,7 @@ struct DeviceVK final : public DeviceBase {
     void SetDebugNameToTrivialObject(VkObjectType objectType, uint64_t handle, const char* name);
     Result CreateVma();
     void DestroyVma();
+    Result GetAllocatorStats(MemoryLocation memoryLocation, AllocatorStats& allocatorStats);
 
     //================================================================================================================
     // DebugNameBase
@@ -109,9 +150,12 @@ struct DeviceVK final : public DeviceBase {
 
     void Destruct() override;
     Result FillFunctionTable(CoreInterface& table) const override;
+    Result FillFunctionTable(CommandBufferPoolInterface& table) const override;
+    Result FillFunctionTable(DeferredReleaseInterface& table) const override;
     Result FillFunctionTable(HelperInterface& table) const override;
     Result FillFunctionTable(LowLatencyInterface& table) const override;
     Result FillFunctionTable(MeshShaderInterface& table) const override;
+    Result FillFunctionTable(ProfilerInterface& table) const override;
     Result FillFunctionTable(RayTracingInterface& table) const override;
     Result FillFunctionTable(StreamerInterface& table) const override;
     Result FillFunctionTable(SwapChainInterface& table) const override;
@@ -128,8 +172,17 @@ struct DeviceVK final : public DeviceBase {
     Result QueryVideoMemoryInfo(MemoryLocation memoryLocation, VideoMemoryInfo& videoMemoryInfo) const;
     Result BindAccelerationStructureMemory(const AccelerationStructureMemoryBindingDesc* memoryBindingDescs, uint32_t memoryBindingDescNum);
     FormatSupportBits GetFormatSupport(Format format) const;
+    void DestroyDescriptor(DescriptorVK& descriptor);
+    void EvictCachedDescriptors(const void* resource);
+    Result FlushBufferRanges(const BufferRange* bufferRanges, uint32_t bufferRangeNum);
+    Result InvalidateBufferRanges(const BufferRange* bufferRanges, uint32_t bufferRangeNum);
+    Result GetDescriptorCacheStats(DescriptorCacheStats& descriptorCacheStats) const;
 
 private:
+    FormatSupportBits QueryFormatSupport(Format format) const;
+    void QueryMemoryDesc2(const BufferDesc& bufferDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) const;
+    void QueryMemoryDesc2(const TextureDesc& textureDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) const;
+    uint32_t GatherMappedMemoryRanges(const BufferRange* bufferRanges, uint32_t bufferRangeNum, VkMappedMemoryRange* memoryRanges) const;
     void FilterInstanceLayers(Vector<const char*>& layers);
     void ProcessInstanceExtensions(Vector<const char*>& desiredInstanceExts);
     void ProcessDeviceExtensions(Vector<const char*>& desiredDeviceExts, bool disableRayTracing);
@@ -154,6 +207,9 @@ private:
     VkAllocationCallbacks m_AllocationCallbacks = {};
     VKBindingOffsets m_BindingOffsets = {};
     CoreInterface m_CoreInterface = {};
+    FormatSupportCache m_FormatSupportCache;
+    mutable MemoryDescCache m_MemoryDescCache;
+    UnorderedMap<uint64_t, DescriptorCacheEntryVK> m_DescriptorCache;
     DeviceDesc m_Desc = {};
     Library* m_Loader = nullptr;
     VkDevice m_Device = VK_NULL_HANDLE;
@@ -161,10 +217,15 @@ private:
     VkAllocationCallbacks* m_AllocationCallbackPtr = nullptr;
     VkDebugUtilsMessengerEXT m_Messenger = VK_NULL_HANDLE;
     VmaAllocator_T* m_Vma = nullptr;
+    uint64_t m_DescriptorRequestedNum = 0;
+    uint64_t m_DescriptorCreatedNum = 0;
+    uint64_t m_NonCoherentAtomSize = 1;
     uint32_t m_NumActiveFamilyIndices = 0;
     uint32_t m_MinorVersion = 0;
     bool m_OwnsNativeObjects = true;
-    Lock m_Lock;
+    bool m_IsDescriptorCacheEnabled = false;
+    Lock m_Lock{"DeviceVK"};
+    mutable Lock m_DescriptorCacheLock{"DeviceVK::DescriptorCache"}; // guards "m_DescriptorCache" and counters
 };
 
 } // namespace nri
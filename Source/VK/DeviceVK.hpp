@@ -295,7 +295,9 @@ void DeviceVK::ProcessDeviceExtensions(Vector<const char*>& desiredDeviceExts, b
 }
 
 DeviceVK::DeviceVK(const CallbackInterface& callbacks, const AllocationCallbacks& allocationCallbacks)
-    : DeviceBase(callbacks, allocationCallbacks) {
+    : DeviceBase(callbacks, allocationCallbacks)
+    , m_MemoryDescCache(GetStdAllocator())
+    , m_DescriptorCache(GetStdAllocator()) {
     m_AllocationCallbacks.pUserData = (void*)&GetAllocationCallbacks();
     m_AllocationCallbacks.pfnAllocation = vkAllocateHostMemory;
     m_AllocationCallbacks.pfnReallocation = vkReallocateHostMemory;
@@ -336,6 +338,7 @@ Result DeviceVK::Create(const DeviceCreationDesc& desc, const DeviceCreationVKDe
     bool isWrapper = descVK.vkDevice != nullptr;
     m_OwnsNativeObjects = !isWrapper;
     m_BindingOffsets = desc.vkBindingOffsets;
+    m_IsDescriptorCacheEnabled = desc.enableDescriptorCache;
 
     if (!isWrapper && !desc.disable3rdPartyAllocationCallbacks)
         m_AllocationCallbackPtr = &m_AllocationCallbacks;
@@ -787,7 +790,7 @@ Result DeviceVK::Create(const DeviceCreationDesc& desc, const DeviceCreationVKDe
                 m_VK.GetDeviceQueue2(m_Device, &queueInfo, &handle);
 
                 QueueVK* queue;
-                Result result = CreateImplementation<QueueVK>(queue, queueFamilyDesc.queueType, queueInfo.queueFamilyIndex, handle);
+                Result result = CreateImplementation<QueueVK>(queue, queueFamilyDesc.queueType, queueInfo.queueFamilyIndex, handle, queueFamilyDesc.enableSubmissionThread);
                 if (result == Result::SUCCESS)
                     queueFamily.push_back(queue);
             }
@@ -874,6 +877,8 @@ Result DeviceVK::Create(const DeviceCreationDesc& desc, const DeviceCreationVKDe
         // Fill desc
         const VkPhysicalDeviceLimits& limits = props.properties.limits;
 
+        m_NonCoherentAtomSize = std::max(limits.nonCoherentAtomSize, (VkDeviceSize)1);
+
         m_Desc.viewportMaxNum = limits.maxViewports;
         m_Desc.viewportBoundsRange[0] = int32_t(limits.viewportBoundsRange[0]);
         m_Desc.viewportBoundsRange[1] = int32_t(limits.viewportBoundsRange[1]);
@@ -1048,6 +1053,7 @@ Result DeviceVK::Create(const DeviceCreationDesc& desc, const DeviceCreationVKDe
         m_Desc.isLayerBasedMultiviewSupported = features11.multiview;
         m_Desc.isPresentFromComputeSupported = true;
         m_Desc.isWaitableSwapChainSupported = presentIdFeatures.presentId != 0 && presentWaitFeatures.presentWait != 0;;
+        m_Desc.isSecondaryCommandBufferSupported = true;
 
         m_Desc.isShaderNativeI16Supported = features.features.shaderInt16;
         m_Desc.isShaderNativeF16Supported = features12.shaderFloat16;
@@ -1135,6 +1141,18 @@ void DeviceVK::FillCreateInfo(const TextureDesc& textureDesc, VkImageCreateInfo&
 }
 
 void DeviceVK::GetMemoryDesc2(const BufferDesc& bufferDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) const {
+    m_MemoryDescCache.Get(bufferDesc, memoryLocation, memoryDesc, [this](const BufferDesc& desc, MemoryLocation location, MemoryDesc& result) {
+        QueryMemoryDesc2(desc, location, result);
+    });
+}
+
+void DeviceVK::GetMemoryDesc2(const TextureDesc& textureDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) const {
+    m_MemoryDescCache.Get(textureDesc, memoryLocation, memoryDesc, [this](const TextureDesc& desc, MemoryLocation location, MemoryDesc& result) {
+        QueryMemoryDesc2(desc, location, result);
+    });
+}
+
+void DeviceVK::QueryMemoryDesc2(const BufferDesc& bufferDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) const {
     VkBufferCreateInfo createInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
     FillCreateInfo(bufferDesc, createInfo);
 
@@ -1161,7 +1179,7 @@ void DeviceVK::GetMemoryDesc2(const BufferDesc& bufferDesc, MemoryLocation memor
     }
 }
 
-void DeviceVK::GetMemoryDesc2(const TextureDesc& textureDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) const {
+void DeviceVK::QueryMemoryDesc2(const TextureDesc& textureDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) const {
     VkImageCreateInfo createInfo = {VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
     FillCreateInfo(textureDesc, createInfo);
 
@@ -1669,6 +1687,7 @@ Result DeviceVK::ResolveDispatchTable(const Vector<const char*>& desiredDeviceEx
     GET_DEVICE_CORE_PROC(UnmapMemory);
     GET_DEVICE_CORE_PROC(FreeMemory);
     GET_DEVICE_CORE_PROC(FlushMappedMemoryRanges);
+    GET_DEVICE_CORE_PROC(InvalidateMappedMemoryRanges);
     GET_DEVICE_CORE_PROC(QueueWaitIdle);
     GET_DEVICE_CORE_PROC(QueueSubmit2);
     GET_DEVICE_CORE_PROC(GetSemaphoreCounterValue);
@@ -1707,6 +1726,7 @@ Result DeviceVK::ResolveDispatchTable(const Vector<const char*>& desiredDeviceEx
     GET_DEVICE_CORE_PROC(CmdDrawIndirect);
     GET_DEVICE_CORE_PROC(CmdDrawIndirectCount);
     GET_DEVICE_CORE_PROC(CmdDrawIndexedIndirect);
+    GET_DEVICE_CORE_PROC(CmdExecuteCommands);
     GET_DEVICE_CORE_PROC(CmdDrawIndexedIndirectCount);
     GET_DEVICE_CORE_PROC(CmdCopyBuffer2);
     GET_DEVICE_CORE_PROC(CmdCopyImage2);
@@ -1793,7 +1813,7 @@ Result DeviceVK::ResolveDispatchTable(const Vector<const char*>& desiredDeviceEx
 }
 
 void DeviceVK::Destruct() {
-    Destroy(GetAllocationCallbacks(), this);
+    Destroy(GetApplicationAllocationCallbacks(), this);
 }
 
 NRI_INLINE void DeviceVK::SetDebugName(const char* name) {
@@ -1923,6 +1943,10 @@ NRI_INLINE Result DeviceVK::BindAccelerationStructureMemory(const AccelerationSt
 }
 
 NRI_INLINE FormatSupportBits DeviceVK::GetFormatSupport(Format format) const {
+    return m_FormatSupportCache.Get(format, [this](Format f) { return QueryFormatSupport(f); });
+}
+
+NRI_INLINE FormatSupportBits DeviceVK::QueryFormatSupport(Format format) const {
     FormatSupportBits mask = FormatSupportBits::UNSUPPORTED;
 
     const VkFormat vkFormat = GetVkFormat(format);
@@ -1991,3 +2015,218 @@ NRI_INLINE Result DeviceVK::QueryVideoMemoryInfo(MemoryLocation memoryLocation,
 
     return Result::SUCCESS;
 }
+
+static inline void FillDescriptorKey(DescriptorKeyVK& key, const BufferViewDesc& desc) {
+    key.descIndex = 0;
+    key.bufferView.buffer = desc.buffer;
+    key.bufferView.viewType = desc.viewType;
+    key.bufferView.format = desc.format;
+    key.bufferView.offset = desc.offset;
+    key.bufferView.size = desc.size;
+}
+
+static inline void FillDescriptorKey(DescriptorKeyVK& key, const Texture1DViewDesc& desc) {
+    key.descIndex = 1;
+    key.texture1DView.texture = desc.texture;
+    key.texture1DView.viewType = desc.viewType;
+    key.texture1DView.format = desc.format;
+    key.texture1DView.mipOffset = desc.mipOffset;
+    key.texture1DView.mipNum = desc.mipNum;
+    key.texture1DView.layerOffset = desc.layerOffset;
+    key.texture1DView.layerNum = desc.layerNum;
+}
+
+static inline void FillDescriptorKey(DescriptorKeyVK& key, const Texture2DViewDesc& desc) {
+    key.descIndex = 2;
+    key.texture2DView.texture = desc.texture;
+    key.texture2DView.viewType = desc.viewType;
+    key.texture2DView.format = desc.format;
+    key.texture2DView.mipOffset = desc.mipOffset;
+    key.texture2DView.mipNum = desc.mipNum;
+    key.texture2DView.layerOffset = desc.layerOffset;
+    key.texture2DView.layerNum = desc.layerNum;
+}
+
+static inline void FillDescriptorKey(DescriptorKeyVK& key, const Texture3DViewDesc& desc) {
+    key.descIndex = 3;
+    key.texture3DView.texture = desc.texture;
+    key.texture3DView.viewType = desc.viewType;
+    key.texture3DView.format = desc.format;
+    key.texture3DView.mipOffset = desc.mipOffset;
+    key.texture3DView.mipNum = desc.mipNum;
+    key.texture3DView.sliceOffset = desc.sliceOffset;
+    key.texture3DView.sliceNum = desc.sliceNum;
+}
+
+static inline void FillDescriptorKey(DescriptorKeyVK& key, const SamplerDesc& desc) {
+    key.descIndex = 4;
+    key.sampler.filters.min = desc.filters.min;
+    key.sampler.filters.mag = desc.filters.mag;
+    key.sampler.filters.mip = desc.filters.mip;
+    key.sampler.filters.ext = desc.filters.ext;
+    key.sampler.anisotropy = desc.anisotropy;
+    key.sampler.mipBias = desc.mipBias;
+    key.sampler.mipMin = desc.mipMin;
+    key.sampler.mipMax = desc.mipMax;
+    key.sampler.addressModes.u = desc.addressModes.u;
+    key.sampler.addressModes.v = desc.addressModes.v;
+    key.sampler.addressModes.w = desc.addressModes.w;
+    key.sampler.compareFunc = desc.compareFunc;
+    key.sampler.isInteger = desc.isInteger;
+    memcpy(&key.sampler.borderColor, &desc.borderColor, sizeof(desc.borderColor));
+}
+
+template <typename Desc>
+Result DeviceVK::CreateDescriptor(Descriptor*& descriptor, const Desc& desc) {
+    if (!m_IsDescriptorCacheEnabled)
+        return CreateImplementation<DescriptorVK>(descriptor, desc);
+
+    DescriptorKeyVK key;
+    memset(&key, 0, sizeof(key));
+    FillDescriptorKey(key, desc);
+
+    uint64_t hash = HashBytes(&key, sizeof(key));
+
+    { // Hit
+        ExclusiveScope lock(m_DescriptorCacheLock);
+        m_DescriptorRequestedNum++;
+
+        auto it = m_DescriptorCache.find(hash);
+        if (it != m_DescriptorCache.end() && !memcmp(&it->second.key, &key, sizeof(key))) {
+            it->second.refNum++;
+            descriptor = (Descriptor*)it->second.descriptor;
+
+            return Result::SUCCESS;
+        }
+    }
+
+    // Miss (creation happens outside of the lock)
+    Result result = CreateImplementation<DescriptorVK>(descriptor, desc);
+    if (result != Result::SUCCESS)
+        return result;
+
+    DescriptorVK* created = (DescriptorVK*)descriptor;
+    {
+        ExclusiveScope lock(m_DescriptorCacheLock);
+        m_DescriptorCreatedNum++;
+
+        auto it = m_DescriptorCache.find(hash);
+        if (it == m_DescriptorCache.end()) {
+            m_DescriptorCache[hash] = {key, created, 1};
+            created->SetCacheHash(hash);
+
+            return Result::SUCCESS;
+        }
+
+        // Another thread has been faster
+        if (!memcmp(&it->second.key, &key, sizeof(key))) {
+            it->second.refNum++;
+            descriptor = (Descriptor*)it->second.descriptor;
+        }
+    }
+
+    // Either a duplicate or a hash collision (the descriptor stays uncached)
+    if (descriptor != (Descriptor*)created)
+        Destroy(created);
+
+    return Result::SUCCESS;
+}
+
+NRI_INLINE void DeviceVK::DestroyDescriptor(DescriptorVK& descriptor) {
+    if (descriptor.IsCached()) {
+        ExclusiveScope lock(m_DescriptorCacheLock);
+
+        auto it = m_DescriptorCache.find(descriptor.GetCacheHash());
+        CHECK(it != m_DescriptorCache.end() && it->second.descriptor == &descriptor, "Unexpected");
+
+        if (it != m_DescriptorCache.end()) {
+            if (--it->second.refNum)
+                return;
+
+            m_DescriptorCache.erase(it);
+        }
+    }
+
+    Destroy(&descriptor);
+}
+
+// Cached views of "resource" stop matching, i.e. new requests create new views. Evicted entries stay in the map until
+// released, since they are still referenced
+NRI_INLINE void DeviceVK::EvictCachedDescriptors(const void* resource) {
+    if (!m_IsDescriptorCacheEnabled)
+        return;
+
+    ExclusiveScope lock(m_DescriptorCacheLock);
+
+    for (auto& it : m_DescriptorCache) {
+        DescriptorKeyVK& key = it.second.key;
+
+        const void* viewResource = nullptr;
+        if (key.descIndex == 0)
+            viewResource = key.bufferView.buffer;
+        else if (key.descIndex == 1)
+            viewResource = key.texture1DView.texture;
+        else if (key.descIndex == 2)
+            viewResource = key.texture2DView.texture;
+        else if (key.descIndex == 3)
+            viewResource = key.texture3DView.texture;
+
+        if (viewResource == resource)
+            key.descIndex = DESCRIPTOR_KEY_EVICTED;
+    }
+}
+
+NRI_INLINE Result DeviceVK::GetDescriptorCacheStats(DescriptorCacheStats& descriptorCacheStats) const {
+    descriptorCacheStats = {};
+    if (!m_IsDescriptorCacheEnabled)
+        return Result::UNSUPPORTED;
+
+    ExclusiveScope lock(m_DescriptorCacheLock);
+
+    descriptorCacheStats.requestedNum = m_DescriptorRequestedNum;
+    descriptorCacheStats.createdNum = m_DescriptorCreatedNum;
+    descriptorCacheStats.uniqueNum = (uint32_t)m_DescriptorCache.size();
+
+    return Result::SUCCESS;
+}
+
+uint32_t DeviceVK::GatherMappedMemoryRanges(const BufferRange* bufferRanges, uint32_t bufferRangeNum, VkMappedMemoryRange* memoryRanges) const {
+    uint32_t memoryRangeNum = 0;
+    for (uint32_t i = 0; i < bufferRangeNum; i++) {
+        const BufferRange& bufferRange = bufferRanges[i];
+        const BufferVK& bufferImpl = *(const BufferVK*)bufferRange.buffer;
+
+        if (bufferImpl.GetMappedMemoryRange(bufferRange.offset, bufferRange.size, memoryRanges[memoryRangeNum]))
+            memoryRangeNum++;
+    }
+
+    return memoryRangeNum;
+}
+
+NRI_INLINE Result DeviceVK::FlushBufferRanges(const BufferRange* bufferRanges, uint32_t bufferRangeNum) {
+    Scratch<VkMappedMemoryRange> memoryRanges = AllocateScratch(*this, VkMappedMemoryRange, bufferRangeNum);
+    uint32_t memoryRangeNum = GatherMappedMemoryRanges(bufferRanges, bufferRangeNum, memoryRanges);
+    if (!memoryRangeNum)
+        return Result::SUCCESS;
+
+    VkResult result = m_VK.FlushMappedMemoryRanges(m_Device, memoryRangeNum, memoryRanges);
+    RETURN_ON_FAILURE(this, result == VK_SUCCESS, GetReturnCode(result), "vkFlushMappedMemoryRanges returned %d", (int32_t)result);
+
+    GetMappedMemoryStats().AddFlush(memoryRangeNum);
+
+    return Result::SUCCESS;
+}
+
+NRI_INLINE Result DeviceVK::InvalidateBufferRanges(const BufferRange* bufferRanges, uint32_t bufferRangeNum) {
+    Scratch<VkMappedMemoryRange> memoryRanges = AllocateScratch(*this, VkMappedMemoryRange, bufferRangeNum);
+    uint32_t memoryRangeNum = GatherMappedMemoryRanges(bufferRanges, bufferRangeNum, memoryRanges);
+    if (!memoryRangeNum)
+        return Result::SUCCESS;
+
+    VkResult result = m_VK.InvalidateMappedMemoryRanges(m_Device, memoryRangeNum, memoryRanges);
+    RETURN_ON_FAILURE(this, result == VK_SUCCESS, GetReturnCode(result), "vkInvalidateMappedMemoryRanges returned %d", (int32_t)result);
+
+    GetMappedMemoryStats().AddInvalidate(memoryRangeNum);
+
+    return Result::SUCCESS;
+}
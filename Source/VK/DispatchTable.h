@@ -95,6 +95,7 @@ struct DispatchTable {
     VULKAN_FUNCTION(UnmapMemory); // TODO: replace with 2 (VK_KHR_map_memory2 or VK 1.4)
     VULKAN_FUNCTION(FreeMemory);
     VULKAN_FUNCTION(FlushMappedMemoryRanges);
+    VULKAN_FUNCTION(InvalidateMappedMemoryRanges);
     VULKAN_FUNCTION(QueueWaitIdle);
     VULKAN_FUNCTION(QueueSubmit2);
     VULKAN_FUNCTION(GetSemaphoreCounterValue);
@@ -134,6 +135,7 @@ struct DispatchTable {
     VULKAN_FUNCTION(CmdDrawIndexed);
     VULKAN_FUNCTION(CmdDrawIndirect);
     VULKAN_FUNCTION(CmdDrawIndexedIndirect);
+    VULKAN_FUNCTION(CmdExecuteCommands);
     VULKAN_FUNCTION(CmdDrawIndirectCount);
     VULKAN_FUNCTION(CmdDrawIndexedIndirectCount);
     VULKAN_FUNCTION(CmdCopyBuffer2);
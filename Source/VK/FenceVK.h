@@ -33,6 +33,9 @@ struct FenceVK final : public DebugNameBase {
 
     uint64_t GetFenceValue() const;
     void Wait(uint64_t value);
+    void Wait(uint64_t value, const FenceWaitDesc& fenceWaitDesc);
+
+    static Result WaitMany(const Fence* const* fences, const uint64_t* values, uint32_t fenceNum, bool waitAll, uint64_t timeoutNs);
 
 private:
     DeviceVK& m_Device;
@@ -35,11 +35,40 @@ NRI_INLINE uint64_t FenceVK::GetFenceValue() const {
 }
 
 NRI_INLINE void FenceVK::Wait(uint64_t value) {
+    Wait(value, m_Device.GetFenceWaitDesc());
+}
+
+NRI_INLINE void FenceVK::Wait(uint64_t value, const FenceWaitDesc& fenceWaitDesc) {
+    WaitForFence(fenceWaitDesc, m_Device.GetFenceWaitStats(), [&] { return GetFenceValue() >= value; }, [&] {
+        VkSemaphoreWaitInfo semaphoreWaitInfo = {VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO};
+        semaphoreWaitInfo.semaphoreCount = 1;
+        semaphoreWaitInfo.pSemaphores = &m_Handle;
+        semaphoreWaitInfo.pValues = &value;
+
+        const auto& vk = m_Device.GetDispatchTable();
+        vk.WaitSemaphores((VkDevice)m_Device, &semaphoreWaitInfo, MsToUs(TIMEOUT_FENCE));
+    });
+}
+
+NRI_INLINE Result FenceVK::WaitMany(const Fence* const* fences, const uint64_t* values, uint32_t fenceNum, bool waitAll, uint64_t timeoutNs) {
+    DeviceVK& device = ((FenceVK*)fences[0])->m_Device;
+
+    Scratch<VkSemaphore> semaphores = AllocateScratch(device, VkSemaphore, fenceNum);
+    for (uint32_t i = 0; i < fenceNum; i++)
+        semaphores[i] = ((FenceVK*)fences[i])->m_Handle;
+
     VkSemaphoreWaitInfo semaphoreWaitInfo = {VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO};
-    semaphoreWaitInfo.semaphoreCount = 1;
-    semaphoreWaitInfo.pSemaphores = &m_Handle;
-    semaphoreWaitInfo.pValues = &value;
+    semaphoreWaitInfo.flags = waitAll ? 0 : VK_SEMAPHORE_WAIT_ANY_BIT;
+    semaphoreWaitInfo.semaphoreCount = fenceNum;
+    semaphoreWaitInfo.pSemaphores = semaphores;
+    semaphoreWaitInfo.pValues = values;
 
-    const auto& vk = m_Device.GetDispatchTable();
-    vk.WaitSemaphores((VkDevice)m_Device, &semaphoreWaitInfo, MsToUs(TIMEOUT_FENCE));
+    const auto& vk = device.GetDispatchTable();
+    VkResult result = vk.WaitSemaphores((VkDevice)device, &semaphoreWaitInfo, timeoutNs);
+    if (result == VK_TIMEOUT)
+        return Result::TIMEOUT;
+
+    RETURN_ON_FAILURE(&device, result == VK_SUCCESS, GetReturnCode(result), "vkWaitSemaphores returned %d", (int32_t)result);
+
+    return Result::SUCCESS;
 }
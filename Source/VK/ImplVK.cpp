@@ -3,9 +3,11 @@
 #include "SharedVK.h"
 
 #include "AccelerationStructureVK.h"
+#include "AllocatorPoolVK.h"
 #include "BufferVK.h"
 #include "CommandAllocatorVK.h"
 #include "CommandBufferVK.h"
+#include "DefragmentationVK.h"
 #include "ConversionVK.h"
 #include "DescriptorPoolVK.h"
 #include "DescriptorSetVK.h"
@@ -19,9 +21,13 @@
 #include "SwapChainVK.h"
 #include "TextureVK.h"
 
+#include "CommandBufferPool.h"
+#include "DeferredReleaseQueue.h"
 #include "HelperDataUpload.h"
 #include "HelperDeviceMemoryAllocator.h"
+#include "Profiler.h"
 #include "Streamer.h"
+#include "SubmissionThread.h"
 
 using namespace nri;
 
@@ -46,6 +52,10 @@ using namespace nri;
 
 Result CreateDeviceVK(const DeviceCreationDesc& desc, const DeviceCreationVKDesc& descVK, DeviceBase*& device) {
     DeviceVK* impl = Allocate<DeviceVK>(desc.allocationCallbacks, desc.callbackInterface, desc.allocationCallbacks);
+
+    if (desc.enableAllocationTracking)
+        impl->EnableAllocationTracking();
+
     Result result = impl->Create(desc, descVK);
 
     if (result != Result::SUCCESS) {
@@ -106,7 +116,11 @@ static Result NRI_CALL CreateCommandAllocator(Queue& queue, CommandAllocator*& c
 }
 
 static Result NRI_CALL CreateCommandBuffer(CommandAllocator& commandAllocator, CommandBuffer*& commandBuffer) {
-    return ((CommandAllocatorVK&)commandAllocator).CreateCommandBuffer(commandBuffer);
+    return ((CommandAllocatorVK&)commandAllocator).CreateCommandBuffer(commandBuffer, false);
+}
+
+static Result NRI_CALL CreateSecondaryCommandBuffer(CommandAllocator& commandAllocator, CommandBuffer*& commandBuffer) {
+    return ((CommandAllocatorVK&)commandAllocator).CreateCommandBuffer(commandBuffer, true);
 }
 
 static Result NRI_CALL CreateFence(Device& device, uint64_t initialValue, Fence*& fence) {
@@ -142,27 +156,27 @@ static Result NRI_CALL CreateQueryPool(Device& device, const QueryPoolDesc& quer
 }
 
 static Result NRI_CALL CreateSampler(Device& device, const SamplerDesc& samplerDesc, Descriptor*& sampler) {
-    return ((DeviceVK&)device).CreateImplementation<DescriptorVK>(sampler, samplerDesc);
+    return ((DeviceVK&)device).CreateDescriptor(sampler, samplerDesc);
 }
 
 static Result NRI_CALL CreateBufferView(const BufferViewDesc& bufferViewDesc, Descriptor*& bufferView) {
     DeviceVK& device = ((const BufferVK*)bufferViewDesc.buffer)->GetDevice();
-    return device.CreateImplementation<DescriptorVK>(bufferView, bufferViewDesc);
+    return device.CreateDescriptor(bufferView, bufferViewDesc);
 }
 
 static Result NRI_CALL CreateTexture1DView(const Texture1DViewDesc& textureViewDesc, Descriptor*& textureView) {
     DeviceVK& device = ((const TextureVK*)textureViewDesc.texture)->GetDevice();
-    return device.CreateImplementation<DescriptorVK>(textureView, textureViewDesc);
+    return device.CreateDescriptor(textureView, textureViewDesc);
 }
 
 static Result NRI_CALL CreateTexture2DView(const Texture2DViewDesc& textureViewDesc, Descriptor*& textureView) {
     DeviceVK& device = ((const TextureVK*)textureViewDesc.texture)->GetDevice();
-    return device.CreateImplementation<DescriptorVK>(textureView, textureViewDesc);
+    return device.CreateDescriptor(textureView, textureViewDesc);
 }
 
 static Result NRI_CALL CreateTexture3DView(const Texture3DViewDesc& textureViewDesc, Descriptor*& textureView) {
     DeviceVK& device = ((const TextureVK*)textureViewDesc.texture)->GetDevice();
-    return device.CreateImplementation<DescriptorVK>(textureView, textureViewDesc);
+    return device.CreateDescriptor(textureView, textureViewDesc);
 }
 
 static void NRI_CALL DestroyCommandAllocator(CommandAllocator& commandAllocator) {
@@ -186,7 +200,8 @@ static void NRI_CALL DestroyTexture(Texture& texture) {
 }
 
 static void NRI_CALL DestroyDescriptor(Descriptor& descriptor) {
-    Destroy((DescriptorVK*)&descriptor);
+    DescriptorVK& descriptorVK = (DescriptorVK&)descriptor;
+    descriptorVK.GetDevice().DestroyDescriptor(descriptorVK);
 }
 
 static void NRI_CALL DestroyPipelineLayout(PipelineLayout& pipelineLayout) {
@@ -222,9 +237,17 @@ static void NRI_CALL FreeMemory(Memory& memory) {
 }
 
 static Result NRI_CALL BeginCommandBuffer(CommandBuffer& commandBuffer, const DescriptorPool* descriptorPool) {
+    ((CommandBufferVK&)commandBuffer).GetStats() = {};
+
     return ((CommandBufferVK&)commandBuffer).Begin(descriptorPool);
 }
 
+static Result NRI_CALL BeginSecondaryCommandBuffer(CommandBuffer& commandBuffer, const DescriptorPool* descriptorPool, const InheritanceDesc& inheritanceDesc) {
+    ((CommandBufferVK&)commandBuffer).GetStats() = {};
+
+    return ((CommandBufferVK&)commandBuffer).BeginSecondary(descriptorPool, inheritanceDesc);
+}
+
 static void NRI_CALL CmdSetDescriptorPool(CommandBuffer& commandBuffer, const DescriptorPool& descriptorPool) {
     ((CommandBufferVK&)commandBuffer).SetDescriptorPool(descriptorPool);
 }
@@ -234,6 +257,7 @@ static void NRI_CALL CmdSetPipelineLayout(CommandBuffer& commandBuffer, const Pi
 }
 
 static void NRI_CALL CmdSetDescriptorSet(CommandBuffer& commandBuffer, uint32_t setIndex, const DescriptorSet& descriptorSet, const uint32_t* dynamicConstantBufferOffsets) {
+    ((CommandBufferVK&)commandBuffer).GetStats().descriptorSetBindNum++;
     ((CommandBufferVK&)commandBuffer).SetDescriptorSet(setIndex, descriptorSet, dynamicConstantBufferOffsets);
 }
 
@@ -246,10 +270,12 @@ static void NRI_CALL CmdSetRootDescriptor(CommandBuffer& commandBuffer, uint32_t
 }
 
 static void NRI_CALL CmdSetPipeline(CommandBuffer& commandBuffer, const Pipeline& pipeline) {
+    ((CommandBufferVK&)commandBuffer).GetStats().pipelineBindNum++;
     ((CommandBufferVK&)commandBuffer).SetPipeline(pipeline);
 }
 
 static void NRI_CALL CmdBarrier(CommandBuffer& commandBuffer, const BarrierGroupDesc& barrierGroupDesc) {
+    AccountBarriers(((CommandBufferVK&)commandBuffer).GetStats(), barrierGroupDesc);
     ((CommandBufferVK&)commandBuffer).Barrier(barrierGroupDesc);
 }
 
@@ -294,6 +320,7 @@ static void NRI_CALL CmdSetDepthBias(CommandBuffer& commandBuffer, const DepthBi
 }
 
 static void NRI_CALL CmdBeginRendering(CommandBuffer& commandBuffer, const AttachmentsDesc& attachmentsDesc) {
+    ((CommandBufferVK&)commandBuffer).GetStats().renderPassNum++;
     ((CommandBufferVK&)commandBuffer).BeginRendering(attachmentsDesc);
 }
 
@@ -302,38 +329,50 @@ static void NRI_CALL CmdClearAttachments(CommandBuffer& commandBuffer, const Cle
 }
 
 static void NRI_CALL CmdDraw(CommandBuffer& commandBuffer, const DrawDesc& drawDesc) {
+    ((CommandBufferVK&)commandBuffer).GetStats().drawNum++;
     ((CommandBufferVK&)commandBuffer).Draw(drawDesc);
 }
 
 static void NRI_CALL CmdDrawIndexed(CommandBuffer& commandBuffer, const DrawIndexedDesc& drawIndexedDesc) {
+    ((CommandBufferVK&)commandBuffer).GetStats().drawIndexedNum++;
     ((CommandBufferVK&)commandBuffer).DrawIndexed(drawIndexedDesc);
 }
 
 static void NRI_CALL CmdDrawIndirect(CommandBuffer& commandBuffer, const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset) {
+    ((CommandBufferVK&)commandBuffer).GetStats().drawIndirectNum++;
     ((CommandBufferVK&)commandBuffer).DrawIndirect(buffer, offset, drawNum, stride, countBuffer, countBufferOffset);
 }
 
 static void NRI_CALL CmdDrawIndexedIndirect(CommandBuffer& commandBuffer, const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset) {
+    ((CommandBufferVK&)commandBuffer).GetStats().drawIndirectNum++;
     ((CommandBufferVK&)commandBuffer).DrawIndexedIndirect(buffer, offset, drawNum, stride, countBuffer, countBufferOffset);
 }
 
+static void NRI_CALL CmdExecuteCommandBuffers(CommandBuffer& commandBuffer, const CommandBuffer* const* commandBuffers, uint32_t commandBufferNum) {
+    ((CommandBufferVK&)commandBuffer).ExecuteCommandBuffers(commandBuffers, commandBufferNum);
+}
+
 static void NRI_CALL CmdEndRendering(CommandBuffer& commandBuffer) {
     ((CommandBufferVK&)commandBuffer).EndRendering();
 }
 
 static void NRI_CALL CmdDispatch(CommandBuffer& commandBuffer, const DispatchDesc& dispatchDesc) {
+    ((CommandBufferVK&)commandBuffer).GetStats().dispatchNum++;
     ((CommandBufferVK&)commandBuffer).Dispatch(dispatchDesc);
 }
 
 static void NRI_CALL CmdDispatchIndirect(CommandBuffer& commandBuffer, const Buffer& buffer, uint64_t offset) {
+    ((CommandBufferVK&)commandBuffer).GetStats().dispatchNum++;
     ((CommandBufferVK&)commandBuffer).DispatchIndirect(buffer, offset);
 }
 
 static void NRI_CALL CmdCopyBuffer(CommandBuffer& commandBuffer, Buffer& dstBuffer, uint64_t dstOffset, const Buffer& srcBuffer, uint64_t srcOffset, uint64_t size) {
+    AccountBufferCopy(((CommandBufferVK&)commandBuffer).GetStats(), ((BufferVK&)srcBuffer).GetDesc().size, srcOffset, size);
     ((CommandBufferVK&)commandBuffer).CopyBuffer(dstBuffer, dstOffset, srcBuffer, srcOffset, size);
 }
 
 static void NRI_CALL CmdCopyTexture(CommandBuffer& commandBuffer, Texture& dstTexture, const TextureRegionDesc* dstRegionDesc, const Texture& srcTexture, const TextureRegionDesc* srcRegionDesc) {
+    ((CommandBufferVK&)commandBuffer).GetStats().copyNum++;
     ((CommandBufferVK&)commandBuffer).CopyTexture(dstTexture, dstRegionDesc, srcTexture, srcRegionDesc);
 }
 
@@ -342,10 +381,12 @@ static void NRI_CALL CmdResolveTexture(CommandBuffer& commandBuffer, Texture& ds
 }
 
 static void NRI_CALL CmdUploadBufferToTexture(CommandBuffer& commandBuffer, Texture& dstTexture, const TextureRegionDesc& dstRegionDesc, const Buffer& srcBuffer, const TextureDataLayoutDesc& srcDataLayoutDesc) {
+    ((CommandBufferVK&)commandBuffer).GetStats().copyNum++;
     ((CommandBufferVK&)commandBuffer).UploadBufferToTexture(dstTexture, dstRegionDesc, srcBuffer, srcDataLayoutDesc);
 }
 
 static void NRI_CALL CmdReadbackTextureToBuffer(CommandBuffer& commandBuffer, Buffer& dstBuffer, const TextureDataLayoutDesc& dstDataLayoutDesc, const Texture& srcTexture, const TextureRegionDesc& srcRegionDesc) {
+    ((CommandBufferVK&)commandBuffer).GetStats().copyNum++;
     ((CommandBufferVK&)commandBuffer).ReadbackTextureToBuffer(dstBuffer, dstDataLayoutDesc, srcTexture, srcRegionDesc);
 }
 
@@ -378,10 +419,17 @@ static void NRI_CALL CmdBeginAnnotation(CommandBuffer& commandBuffer, const char
 #if NRI_ENABLE_DEBUG_NAMES_AND_ANNOTATIONS
     ((CommandBufferVK&)commandBuffer).BeginAnnotation(name, bgra);
 #endif
+
+    ProfilerImpl* profiler = ((CommandBufferVK&)commandBuffer).GetDevice().GetAnnotationProfiler();
+    if (profiler)
+        profiler->BeginZone(commandBuffer, ((CommandBufferVK&)commandBuffer).GetProfilerZoneState(), name);
 }
 
 static void NRI_CALL CmdEndAnnotation(CommandBuffer& commandBuffer) {
-    MaybeUnused(commandBuffer);
+    ProfilerImpl* profiler = ((CommandBufferVK&)commandBuffer).GetDevice().GetAnnotationProfiler();
+    if (profiler)
+        profiler->EndZone(commandBuffer, ((CommandBufferVK&)commandBuffer).GetProfilerZoneState());
+
 #if NRI_ENABLE_DEBUG_NAMES_AND_ANNOTATIONS
     ((CommandBufferVK&)commandBuffer).EndAnnotation();
 #endif
@@ -424,17 +472,36 @@ static void NRI_CALL ResetQueries(QueryPool& queryPool, uint32_t offset, uint32_
 }
 
 static void NRI_CALL QueueSubmit(Queue& queue, const QueueSubmitDesc& workSubmissionDesc) {
-    ((QueueVK&)queue).Submit(workSubmissionDesc, nullptr);
+    ((QueueVK&)queue).Submit(&workSubmissionDesc, 1, nullptr);
+}
+
+static void NRI_CALL QueueSubmitBatch(Queue& queue, const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum) {
+    ((QueueVK&)queue).Submit(queueSubmitDescs, queueSubmitDescNum, nullptr);
 }
 
 static void NRI_CALL Wait(Fence& fence, uint64_t value) {
     ((FenceVK&)fence).Wait(value);
 }
 
+static Result NRI_CALL WaitMany(const Fence* const* fences, const uint64_t* values, uint32_t fenceNum, bool waitAll, uint64_t timeoutNs) {
+    if (!fenceNum)
+        return Result::SUCCESS;
+
+    return FenceVK::WaitMany(fences, values, fenceNum, waitAll, timeoutNs);
+}
+
 static uint64_t NRI_CALL GetFenceValue(Fence& fence) {
     return ((FenceVK&)fence).GetFenceValue();
 }
 
+static void NRI_CALL WaitWithPolicy(Fence& fence, uint64_t value, const FenceWaitDesc& fenceWaitDesc) {
+    ((FenceVK&)fence).Wait(value, fenceWaitDesc);
+}
+
+static void NRI_CALL GetFenceWaitStats(const Device& device, FenceWaitStats& fenceWaitStats) {
+    ((const DeviceVK&)device).GetFenceWaitStats().Get(fenceWaitStats);
+}
+
 static void NRI_CALL UpdateDescriptorRanges(DescriptorSet& descriptorSet, uint32_t baseRange, uint32_t rangeNum, const DescriptorRangeUpdateDesc* rangeUpdateDescs) {
     ((DescriptorSetVK&)descriptorSet).UpdateDescriptorRanges(baseRange, rangeNum, rangeUpdateDescs);
 }
@@ -460,13 +527,29 @@ static void NRI_CALL ResetCommandAllocator(CommandAllocator& commandAllocator) {
 }
 
 static void* NRI_CALL MapBuffer(Buffer& buffer, uint64_t offset, uint64_t size) {
-    return ((BufferVK&)buffer).Map(offset, size);
+    return ((BufferVK&)buffer).Map(offset, size, MapMode::FLUSH_ON_UNMAP);
 }
 
 static void NRI_CALL UnmapBuffer(Buffer& buffer) {
     ((BufferVK&)buffer).Unmap();
 }
 
+static void* NRI_CALL MapBufferWithMode(Buffer& buffer, uint64_t offset, uint64_t size, MapMode mapMode) {
+    return ((BufferVK&)buffer).Map(offset, size, mapMode);
+}
+
+static Result NRI_CALL FlushBufferRanges(Device& device, const BufferRange* bufferRanges, uint32_t bufferRangeNum) {
+    return ((DeviceVK&)device).FlushBufferRanges(bufferRanges, bufferRangeNum);
+}
+
+static Result NRI_CALL InvalidateBufferRanges(Device& device, const BufferRange* bufferRanges, uint32_t bufferRangeNum) {
+    return ((DeviceVK&)device).InvalidateBufferRanges(bufferRanges, bufferRangeNum);
+}
+
+static void NRI_CALL GetMappedMemoryStats(const Device& device, MappedMemoryStats& mappedMemoryStats) {
+    ((const DeviceVK&)device).GetMappedMemoryStats().Get(mappedMemoryStats);
+}
+
 static void NRI_CALL SetDebugName(Object* object, const char* name) {
     MaybeUnused(object, name);
 #if NRI_ENABLE_DEBUG_NAMES_AND_ANNOTATIONS
@@ -542,6 +625,7 @@ Result DeviceVK::FillFunctionTable(CoreInterface& table) const {
     table.GetQueue = ::GetQueue;
     table.CreateCommandAllocator = ::CreateCommandAllocator;
     table.CreateCommandBuffer = ::CreateCommandBuffer;
+    table.CreateSecondaryCommandBuffer = ::CreateSecondaryCommandBuffer;
     table.CreateDescriptorPool = ::CreateDescriptorPool;
     table.CreateBuffer = ::CreateBuffer;
     table.CreateTexture = ::CreateTexture;
@@ -570,6 +654,7 @@ Result DeviceVK::FillFunctionTable(CoreInterface& table) const {
     table.BindTextureMemory = ::BindTextureMemory;
     table.FreeMemory = ::FreeMemory;
     table.BeginCommandBuffer = ::BeginCommandBuffer;
+    table.BeginSecondaryCommandBuffer = ::BeginSecondaryCommandBuffer;
     table.CmdSetDescriptorPool = ::CmdSetDescriptorPool;
     table.CmdSetDescriptorSet = ::CmdSetDescriptorSet;
     table.CmdSetPipelineLayout = ::CmdSetPipelineLayout;
@@ -593,6 +678,7 @@ Result DeviceVK::FillFunctionTable(CoreInterface& table) const {
     table.CmdDrawIndexed = ::CmdDrawIndexed;
     table.CmdDrawIndirect = ::CmdDrawIndirect;
     table.CmdDrawIndexedIndirect = ::CmdDrawIndexedIndirect;
+    table.CmdExecuteCommandBuffers = ::CmdExecuteCommandBuffers;
     table.CmdEndRendering = ::CmdEndRendering;
     table.CmdDispatch = ::CmdDispatch;
     table.CmdDispatchIndirect = ::CmdDispatchIndirect;
@@ -616,8 +702,12 @@ Result DeviceVK::FillFunctionTable(CoreInterface& table) const {
     table.QueueAnnotation = ::QueueAnnotation;
     table.ResetQueries = ::ResetQueries;
     table.QueueSubmit = ::QueueSubmit;
+    table.QueueSubmitBatch = ::QueueSubmitBatch;
     table.Wait = ::Wait;
+    table.WaitMany = ::WaitMany;
     table.GetFenceValue = ::GetFenceValue;
+    table.WaitWithPolicy = ::WaitWithPolicy;
+    table.GetFenceWaitStats = ::GetFenceWaitStats;
     table.UpdateDescriptorRanges = ::UpdateDescriptorRanges;
     table.UpdateDynamicConstantBuffers = ::UpdateDynamicConstantBuffers;
     table.CopyDescriptorSet = ::CopyDescriptorSet;
@@ -626,6 +716,10 @@ Result DeviceVK::FillFunctionTable(CoreInterface& table) const {
     table.ResetCommandAllocator = ::ResetCommandAllocator;
     table.MapBuffer = ::MapBuffer;
     table.UnmapBuffer = ::UnmapBuffer;
+    table.MapBufferWithMode = ::MapBufferWithMode;
+    table.FlushBufferRanges = ::FlushBufferRanges;
+    table.InvalidateBufferRanges = ::InvalidateBufferRanges;
+    table.GetMappedMemoryStats = ::GetMappedMemoryStats;
     table.SetDebugName = ::SetDebugName;
     table.GetDeviceNativeObject = ::GetDeviceNativeObject;
     table.GetQueueNativeObject = ::GetQueueNativeObject;
@@ -639,6 +733,106 @@ Result DeviceVK::FillFunctionTable(CoreInterface& table) const {
 
 #pragma endregion
 
+//============================================================================================================================================================================================
+#pragma region[  CommandBufferPool  ]
+
+static Result CreateCommandBufferPool(Device& device, const CommandBufferPoolDesc& commandBufferPoolDesc, CommandBufferPool*& commandBufferPool) {
+    DeviceVK& deviceVK = (DeviceVK&)device;
+    CommandBufferPoolImpl* impl = Allocate<CommandBufferPoolImpl>(deviceVK.GetAllocationCallbacks(), device, deviceVK.GetCoreInterface());
+    Result result = impl->Create(commandBufferPoolDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceVK.GetAllocationCallbacks(), impl);
+        commandBufferPool = nullptr;
+    } else
+        commandBufferPool = (CommandBufferPool*)impl;
+
+    return result;
+}
+
+static void DestroyCommandBufferPool(CommandBufferPool& commandBufferPool) {
+    Destroy(((DeviceBase&)((CommandBufferPoolImpl&)commandBufferPool).GetDevice()).GetAllocationCallbacks(), (CommandBufferPoolImpl*)&commandBufferPool);
+}
+
+static void BeginCommandBufferPoolFrame(CommandBufferPool& commandBufferPool) {
+    ((CommandBufferPoolImpl&)commandBufferPool).BeginFrame();
+}
+
+static void EndCommandBufferPoolFrame(CommandBufferPool& commandBufferPool, Fence& fence, uint64_t value) {
+    ((CommandBufferPoolImpl&)commandBufferPool).EndFrame(fence, value);
+}
+
+static Result AcquireCommandBuffer(CommandBufferPool& commandBufferPool, uint32_t threadIndex, CommandBuffer*& commandBuffer) {
+    return ((CommandBufferPoolImpl&)commandBufferPool).AcquireCommandBuffer(threadIndex, commandBuffer);
+}
+
+static void GetCommandBufferPoolStats(const CommandBufferPool& commandBufferPool, CommandBufferPoolStats& commandBufferPoolStats) {
+    ((const CommandBufferPoolImpl&)commandBufferPool).GetStats(commandBufferPoolStats);
+}
+
+Result DeviceVK::FillFunctionTable(CommandBufferPoolInterface& table) const {
+    table.CreateCommandBufferPool = ::CreateCommandBufferPool;
+    table.DestroyCommandBufferPool = ::DestroyCommandBufferPool;
+    table.BeginCommandBufferPoolFrame = ::BeginCommandBufferPoolFrame;
+    table.EndCommandBufferPoolFrame = ::EndCommandBufferPoolFrame;
+    table.AcquireCommandBuffer = ::AcquireCommandBuffer;
+    table.GetCommandBufferPoolStats = ::GetCommandBufferPoolStats;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
+//============================================================================================================================================================================================
+#pragma region[  DeferredRelease  ]
+
+static Result CreateDeferredReleaseQueue(Device& device, const DeferredReleaseQueueDesc& deferredReleaseQueueDesc, DeferredReleaseQueue*& deferredReleaseQueue) {
+    DeviceVK& deviceVK = (DeviceVK&)device;
+    DeferredReleaseQueueImpl* impl = Allocate<DeferredReleaseQueueImpl>(deviceVK.GetAllocationCallbacks(), device, deviceVK.GetCoreInterface());
+    Result result = impl->Create(deferredReleaseQueueDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceVK.GetAllocationCallbacks(), impl);
+        deferredReleaseQueue = nullptr;
+    } else
+        deferredReleaseQueue = (DeferredReleaseQueue*)impl;
+
+    return result;
+}
+
+static void DestroyDeferredReleaseQueue(DeferredReleaseQueue& deferredReleaseQueue) {
+    Destroy(((DeviceBase&)((DeferredReleaseQueueImpl&)deferredReleaseQueue).GetDevice()).GetAllocationCallbacks(), (DeferredReleaseQueueImpl*)&deferredReleaseQueue);
+}
+
+static void DeferRelease(DeferredReleaseQueue& deferredReleaseQueue, Fence& fence, uint64_t value, DeferredReleaseType type, Object* object) {
+    ((DeferredReleaseQueueImpl&)deferredReleaseQueue).DeferRelease(fence, value, type, object);
+}
+
+static void DeferCallback(DeferredReleaseQueue& deferredReleaseQueue, Fence& fence, uint64_t value, const DeferredReleaseCallback& callback) {
+    ((DeferredReleaseQueueImpl&)deferredReleaseQueue).DeferCallback(fence, value, callback);
+}
+
+static uint32_t DrainDeferredReleases(DeferredReleaseQueue& deferredReleaseQueue) {
+    return ((DeferredReleaseQueueImpl&)deferredReleaseQueue).Drain();
+}
+
+static void GetDeferredReleaseQueueStats(const DeferredReleaseQueue& deferredReleaseQueue, DeferredReleaseQueueStats& deferredReleaseQueueStats) {
+    ((const DeferredReleaseQueueImpl&)deferredReleaseQueue).GetStats(deferredReleaseQueueStats);
+}
+
+Result DeviceVK::FillFunctionTable(DeferredReleaseInterface& table) const {
+    table.CreateDeferredReleaseQueue = ::CreateDeferredReleaseQueue;
+    table.DestroyDeferredReleaseQueue = ::DestroyDeferredReleaseQueue;
+    table.DeferRelease = ::DeferRelease;
+    table.DeferCallback = ::DeferCallback;
+    table.DrainDeferredReleases = ::DrainDeferredReleases;
+    table.GetDeferredReleaseQueueStats = ::GetDeferredReleaseQueueStats;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
 //============================================================================================================================================================================================
 #pragma region[  Helper  ]
 
@@ -671,12 +865,60 @@ static Result NRI_CALL QueryVideoMemoryInfo(const Device& device, MemoryLocation
     return ((DeviceVK&)device).QueryVideoMemoryInfo(memoryLocation, videoMemoryInfo);
 }
 
+static Result NRI_CALL SetBudgetMonitor(Device& device, const BudgetMonitorDesc& budgetMonitorDesc) {
+    return ((DeviceVK&)device).GetBudgetMonitor().Start(device, ::QueryVideoMemoryInfo, budgetMonitorDesc);
+}
+
+static Result NRI_CALL GetTrackedVideoMemoryInfo(const Device& device, MemoryLocation memoryLocation, VideoMemoryInfo& videoMemoryInfo) {
+    return ((DeviceVK&)device).GetBudgetMonitor().GetInfo(memoryLocation, videoMemoryInfo);
+}
+
+static void NRI_CALL GetObjectPoolStats(const Device& device, ObjectPoolType objectPoolType, ObjectPoolStats& objectPoolStats) {
+    ((DeviceVK&)device).GetObjectPool(objectPoolType).GetStats(objectPoolStats);
+}
+
+static Result NRI_CALL GetAllocationStats(const Device& device, AllocationCategory allocationCategory, AllocationStats& allocationStats) {
+    const AllocationTracker& allocationTracker = ((DeviceVK&)device).GetAllocationTracker();
+    if (!allocationTracker.IsEnabled()) {
+        allocationStats = {};
+        return Result::UNSUPPORTED;
+    }
+
+    allocationTracker.GetStats(allocationCategory, allocationStats);
+
+    return Result::SUCCESS;
+}
+
+static void NRI_CALL ResetAllocationStats(Device& device) {
+    ((DeviceVK&)device).GetAllocationTracker().ResetStats();
+}
+
+static void NRI_CALL GetMemoryDescCacheStats(const Device& device, MemoryDescCacheStats& memoryDescCacheStats) {
+    ((const DeviceVK&)device).GetMemoryDescCache().GetStats(memoryDescCacheStats);
+}
+
+static Result NRI_CALL GetDescriptorCacheStats(const Device& device, DescriptorCacheStats& descriptorCacheStats) {
+    return ((const DeviceVK&)device).GetDescriptorCacheStats(descriptorCacheStats);
+}
+
+static void NRI_CALL GetCommandBufferStats(const CommandBuffer& commandBuffer, CommandBufferStats& commandBufferStats) {
+    commandBufferStats = ((CommandBufferVK&)commandBuffer).GetStats();
+}
+
 Result DeviceVK::FillFunctionTable(HelperInterface& table) const {
     table.CalculateAllocationNumber = ::CalculateAllocationNumber;
     table.AllocateAndBindMemory = ::AllocateAndBindMemory;
     table.UploadData = ::UploadData;
     table.WaitForIdle = ::WaitForIdle;
     table.QueryVideoMemoryInfo = ::QueryVideoMemoryInfo;
+    table.SetBudgetMonitor = ::SetBudgetMonitor;
+    table.GetTrackedVideoMemoryInfo = ::GetTrackedVideoMemoryInfo;
+    table.GetObjectPoolStats = ::GetObjectPoolStats;
+    table.GetAllocationStats = ::GetAllocationStats;
+    table.ResetAllocationStats = ::ResetAllocationStats;
+    table.GetMemoryDescCacheStats = ::GetMemoryDescCacheStats;
+    table.GetDescriptorCacheStats = ::GetDescriptorCacheStats;
+    table.GetCommandBufferStats = ::GetCommandBufferStats;
 
     return Result::SUCCESS;
 }
@@ -687,7 +929,7 @@ Result DeviceVK::FillFunctionTable(HelperInterface& table) const {
 #pragma region[  Low latency  ]
 
 static void NRI_CALL QueueSubmitTrackable(Queue& queue, const QueueSubmitDesc& workSubmissionDesc, const SwapChain& swapChain) {
-    ((QueueVK&)queue).Submit(workSubmissionDesc, &swapChain);
+    ((QueueVK&)queue).Submit(&workSubmissionDesc, 1, &swapChain);
 }
 
 static Result SetLatencySleepMode(SwapChain& swapChain, const LatencySleepMode& latencySleepMode) {
@@ -725,10 +967,12 @@ Result DeviceVK::FillFunctionTable(LowLatencyInterface& table) const {
 #pragma region[  MeshShader  ]
 
 static void NRI_CALL CmdDrawMeshTasks(CommandBuffer& commandBuffer, const DrawMeshTasksDesc& drawMeshTasksDesc) {
+    ((CommandBufferVK&)commandBuffer).GetStats().drawMeshTasksNum++;
     ((CommandBufferVK&)commandBuffer).DrawMeshTasks(drawMeshTasksDesc);
 }
 
 static void NRI_CALL CmdDrawMeshTasksIndirect(CommandBuffer& commandBuffer, const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset) {
+    ((CommandBufferVK&)commandBuffer).GetStats().drawMeshTasksNum++;
     ((CommandBufferVK&)commandBuffer).DrawMeshTasksIndirect(buffer, offset, drawNum, stride, countBuffer, countBufferOffset);
 }
 
@@ -744,6 +988,66 @@ Result DeviceVK::FillFunctionTable(MeshShaderInterface& table) const {
 
 #pragma endregion
 
+//============================================================================================================================================================================================
+#pragma region[  Profiler  ]
+
+static Result CreateProfiler(Device& device, const ProfilerDesc& profilerDesc, Profiler*& profiler) {
+    DeviceVK& deviceVK = (DeviceVK&)device;
+    ProfilerImpl* impl = Allocate<ProfilerImpl>(deviceVK.GetAllocationCallbacks(), device, deviceVK.GetCoreInterface());
+    Result result = impl->Create(profilerDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceVK.GetAllocationCallbacks(), impl);
+        profiler = nullptr;
+    } else
+        profiler = (Profiler*)impl;
+
+    return result;
+}
+
+static void DestroyProfiler(Profiler& profiler) {
+    Destroy(((DeviceBase&)((ProfilerImpl&)profiler).GetDevice()).GetAllocationCallbacks(), (ProfilerImpl*)&profiler);
+}
+
+static void BeginProfilerFrame(Profiler& profiler) {
+    ((ProfilerImpl&)profiler).BeginFrame();
+}
+
+static void EndProfilerFrame(Profiler& profiler, Fence& fence, uint64_t value) {
+    ((ProfilerImpl&)profiler).EndFrame(fence, value);
+}
+
+static void CmdBeginProfilerZone(Profiler& profiler, CommandBuffer& commandBuffer, const char* name) {
+    ((ProfilerImpl&)profiler).BeginZone(commandBuffer, ((CommandBufferVK&)commandBuffer).GetProfilerZoneState(), name);
+}
+
+static void CmdEndProfilerZone(Profiler& profiler, CommandBuffer& commandBuffer) {
+    ((ProfilerImpl&)profiler).EndZone(commandBuffer, ((CommandBufferVK&)commandBuffer).GetProfilerZoneState());
+}
+
+static void CmdResolveProfilerFrame(Profiler& profiler, CommandBuffer& commandBuffer) {
+    ((ProfilerImpl&)profiler).ResolveFrame(commandBuffer);
+}
+
+static void GetProfilerFrame(const Profiler& profiler, ProfilerFrame& profilerFrame) {
+    ((const ProfilerImpl&)profiler).GetFrame(profilerFrame);
+}
+
+Result DeviceVK::FillFunctionTable(ProfilerInterface& table) const {
+    table.CreateProfiler = ::CreateProfiler;
+    table.DestroyProfiler = ::DestroyProfiler;
+    table.BeginProfilerFrame = ::BeginProfilerFrame;
+    table.EndProfilerFrame = ::EndProfilerFrame;
+    table.CmdBeginProfilerZone = ::CmdBeginProfilerZone;
+    table.CmdEndProfilerZone = ::CmdEndProfilerZone;
+    table.CmdResolveProfilerFrame = ::CmdResolveProfilerFrame;
+    table.GetProfilerFrame = ::GetProfilerFrame;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
 //============================================================================================================================================================================================
 #pragma region[  RayTracing  ]
 
@@ -793,10 +1097,12 @@ static void NRI_CALL CmdWriteAccelerationStructureSize(CommandBuffer& commandBuf
 }
 
 static void NRI_CALL CmdDispatchRays(CommandBuffer& commandBuffer, const DispatchRaysDesc& dispatchRaysDesc) {
+    ((CommandBufferVK&)commandBuffer).GetStats().dispatchRaysNum++;
     ((CommandBufferVK&)commandBuffer).DispatchRays(dispatchRaysDesc);
 }
 
 static void NRI_CALL CmdDispatchRaysIndirect(CommandBuffer& commandBuffer, const Buffer& buffer, uint64_t offset) {
+    ((CommandBufferVK&)commandBuffer).GetStats().dispatchRaysNum++;
     ((CommandBufferVK&)commandBuffer).DispatchRaysIndirect(buffer, offset);
 }
 
@@ -873,10 +1179,51 @@ static Result AllocateAccelerationStructure(Device& device, const AllocateAccele
     return ((DeviceVK&)device).CreateImplementation<AccelerationStructureVK>(accelerationStructure, accelerationStructureDesc);
 }
 
+static Result CreateAllocatorPool(Device& device, const AllocatorPoolDesc& allocatorPoolDesc, AllocatorPool*& allocatorPool) {
+    return ((DeviceVK&)device).CreateImplementation<AllocatorPoolVK>(allocatorPool, allocatorPoolDesc);
+}
+
+static void DestroyAllocatorPool(AllocatorPool& allocatorPool) {
+    Destroy((AllocatorPoolVK*)&allocatorPool);
+}
+
+static Result GetAllocatorStats(Device& device, MemoryLocation memoryLocation, AllocatorStats& allocatorStats) {
+    return ((DeviceVK&)device).GetAllocatorStats(memoryLocation, allocatorStats);
+}
+
+static void GetAllocatorPoolStats(const AllocatorPool& allocatorPool, AllocatorStats& allocatorStats) {
+    ((AllocatorPoolVK&)allocatorPool).GetStats(allocatorStats);
+}
+
+static Result BeginDefragmentation(Device& device, const DefragmentationDesc& defragmentationDesc, Defragmentation*& defragmentation) {
+    return ((DeviceVK&)device).CreateImplementation<DefragmentationVK>(defragmentation, defragmentationDesc);
+}
+
+static Result GetDefragmentationPass(Defragmentation& defragmentation, DefragmentationPass& defragmentationPass) {
+    return ((DefragmentationVK&)defragmentation).GetPass(defragmentationPass);
+}
+
+static Result EndDefragmentationPass(Defragmentation& defragmentation) {
+    return ((DefragmentationVK&)defragmentation).EndPass();
+}
+
+static void EndDefragmentation(Defragmentation& defragmentation, DefragmentationStats& defragmentationStats) {
+    ((DefragmentationVK&)defragmentation).End(defragmentationStats);
+    Destroy((DefragmentationVK*)&defragmentation);
+}
+
 Result DeviceVK::FillFunctionTable(ResourceAllocatorInterface& table) const {
     table.AllocateBuffer = ::AllocateBuffer;
     table.AllocateTexture = ::AllocateTexture;
     table.AllocateAccelerationStructure = ::AllocateAccelerationStructure;
+    table.CreateAllocatorPool = ::CreateAllocatorPool;
+    table.DestroyAllocatorPool = ::DestroyAllocatorPool;
+    table.GetAllocatorStats = ::GetAllocatorStats;
+    table.GetAllocatorPoolStats = ::GetAllocatorPoolStats;
+    table.BeginDefragmentation = ::BeginDefragmentation;
+    table.GetDefragmentationPass = ::GetDefragmentationPass;
+    table.EndDefragmentationPass = ::EndDefragmentationPass;
+    table.EndDefragmentation = ::EndDefragmentation;
 
     return Result::SUCCESS;
 }
@@ -30,6 +30,10 @@ struct MemoryVK final : public DebugNameBase {
         return m_MappedMemory;
     }
 
+    inline uint64_t GetSize() const {
+        return m_Size;
+    }
+
     ~MemoryVK();
 
     Result Create(const MemoryVKDesc& memoryDesc);
@@ -47,6 +51,7 @@ private:
     DeviceVK& m_Device;
     VkDeviceMemory m_Handle = VK_NULL_HANDLE;
     uint8_t* m_MappedMemory = nullptr;
+    uint64_t m_Size = 0; // tracked by the budget monitor
     MemoryType m_Type = std::numeric_limits<MemoryType>::max();
     float m_Priority = 0.0f;
     bool m_OwnsNativeObjects = true;
@@ -4,6 +4,9 @@ MemoryVK::~MemoryVK() {
     if (m_OwnsNativeObjects) {
         const auto& vk = m_Device.GetDispatchTable();
         vk.FreeMemory(m_Device, m_Handle, m_Device.GetVkAllocationCallbacks());
+
+        if (m_Size)
+            m_Device.GetBudgetMonitor().Track(m_Device.IsDeviceLocalHeap(Unpack(m_Type).index), -(int64_t)m_Size);
     }
 }
 
@@ -54,6 +57,9 @@ Result MemoryVK::Create(const AllocateMemoryDesc& allocateMemoryDesc) {
     VkResult result = vk.AllocateMemory(m_Device, &memoryInfo, m_Device.GetVkAllocationCallbacks(), &m_Handle);
     RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vkAllocateMemory returned %d", (int32_t)result);
 
+    m_Size = allocateMemoryDesc.size;
+    m_Device.GetBudgetMonitor().Track(m_Device.IsDeviceLocalHeap(memoryTypeInfo.index), (int64_t)m_Size);
+
     if (IsHostVisibleMemory(memoryTypeInfo.location)) {
         result = vk.MapMemory(m_Device, m_Handle, 0, allocateMemoryDesc.size, 0, (void**)&m_MappedMemory);
         RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vkMapMemory returned %d", (int32_t)result);
@@ -89,6 +95,9 @@ Result MemoryVK::CreateDedicated(const BufferVK& buffer) {
     VkResult result = vk.AllocateMemory(m_Device, &memoryInfo, m_Device.GetVkAllocationCallbacks(), &m_Handle);
     RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vkAllocateMemory returned %d", (int32_t)result);
 
+    m_Size = memoryDesc.size;
+    m_Device.GetBudgetMonitor().Track(m_Device.IsDeviceLocalHeap(memoryTypeInfo.index), (int64_t)m_Size);
+
     if (IsHostVisibleMemory(memoryTypeInfo.location)) {
         result = vk.MapMemory(m_Device, m_Handle, 0, memoryDesc.size, 0, (void**)&m_MappedMemory);
         RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vkMapMemory returned %d", (int32_t)result);
@@ -124,6 +133,9 @@ Result MemoryVK::CreateDedicated(const TextureVK& texture) {
     VkResult result = vk.AllocateMemory(m_Device, &memoryInfo, m_Device.GetVkAllocationCallbacks(), &m_Handle);
     RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vkAllocateMemory returned %d", (int32_t)result);
 
+    m_Size = memoryDesc.size;
+    m_Device.GetBudgetMonitor().Track(m_Device.IsDeviceLocalHeap(memoryTypeInfo.index), (int64_t)m_Size);
+
     if (IsHostVisibleMemory(memoryTypeInfo.location)) {
         result = vk.MapMemory(m_Device, m_Handle, 0, memoryDesc.size, 0, (void**)&m_MappedMemory);
         RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vkMapMemory returned %d", (int32_t)result);
@@ -73,4 +73,6 @@ private:
     Vector<VkDescriptorSetLayout> m_DescriptorSetLayouts;
 };
 
-} // namespace nri
\ No newline at end of file
+} // namespace nri
+
+NRI_ALLOCATION_CATEGORY(nri::PipelineLayoutVK, PIPELINE);
\ No newline at end of file
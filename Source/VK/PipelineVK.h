@@ -61,4 +61,6 @@ private:
     bool m_OwnsNativeObjects = true;
 };
 
-} // namespace nri
\ No newline at end of file
+} // namespace nri
+
+NRI_ALLOCATION_CATEGORY(nri::PipelineVK, PIPELINE);
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #pragma once
 
+struct SubmissionThread;
+
 namespace nri {
 
 struct QueueVK final : public DebugNameBase {
@@ -29,7 +31,9 @@ struct QueueVK final : public DebugNameBase {
         return m_Lock;
     }
 
-    Result Create(QueueType type, uint32_t familyIndex, VkQueue handle);
+    ~QueueVK();
+
+    Result Create(QueueType type, uint32_t familyIndex, VkQueue handle, bool enableSubmissionThread = false);
 
     //================================================================================================================
     // DebugNameBase
@@ -44,16 +48,22 @@ struct QueueVK final : public DebugNameBase {
     void BeginAnnotation(const char* name, uint32_t bgra);
     void EndAnnotation();
     void Annotation(const char* name, uint32_t bgra);
-    void Submit(const QueueSubmitDesc& queueSubmitDesc, const SwapChain* swapChain);
+    void Submit(const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum, const SwapChain* swapChain);
+    void FlushSubmissions();
     Result UploadData(const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum);
     Result WaitForIdle();
 
+private:
+    void SubmitImmediately(const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum, const SwapChain* swapChain);
+    static void SubmitFromThread(void* queue, const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum);
+
 private:
     DeviceVK& m_Device;
+    SubmissionThread* m_SubmissionThread = nullptr;
     VkQueue m_Handle = VK_NULL_HANDLE;
     uint32_t m_FamilyIndex = INVALID_FAMILY_INDEX;
     QueueType m_Type = QueueType(-1);
-    Lock m_Lock;
+    Lock m_Lock{"QueueVK"};
 };
 
 } // namespace nri
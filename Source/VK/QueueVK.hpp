@@ -1,13 +1,25 @@
 // © 2021 NVIDIA Corporation
 
-Result QueueVK::Create(QueueType type, uint32_t familyIndex, VkQueue handle) {
+QueueVK::~QueueVK() {
+    if (m_SubmissionThread)
+        Destroy(m_Device.GetAllocationCallbacks(), m_SubmissionThread);
+}
+
+Result QueueVK::Create(QueueType type, uint32_t familyIndex, VkQueue handle, bool enableSubmissionThread) {
     m_Type = type;
     m_FamilyIndex = familyIndex;
     m_Handle = handle;
 
+    if (enableSubmissionThread)
+        m_SubmissionThread = Allocate<SubmissionThread>(m_Device.GetAllocationCallbacks(), m_Device, SubmitFromThread, this);
+
     return Result::SUCCESS;
 }
 
+void QueueVK::SubmitFromThread(void* queue, const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum) {
+    ((QueueVK*)queue)->SubmitImmediately(queueSubmitDescs, queueSubmitDescNum, nullptr);
+}
+
 NRI_INLINE void QueueVK::SetDebugName(const char* name) {
     m_Device.SetDebugNameToTrivialObject(VK_OBJECT_TYPE_QUEUE, (uint64_t)m_Handle, name);
 }
@@ -44,50 +56,93 @@ NRI_INLINE void QueueVK::Annotation(const char* name, uint32_t bgra) {
         vk.QueueInsertDebugUtilsLabelEXT(m_Handle, &info);
 }
 
-NRI_INLINE void QueueVK::Submit(const QueueSubmitDesc& queueSubmitDesc, const SwapChain* swapChain) {
-    ExclusiveScope lock(m_Lock);
+NRI_INLINE void QueueVK::Submit(const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum, const SwapChain* swapChain) {
+    if (m_SubmissionThread) {
+        if (!swapChain) {
+            m_SubmissionThread->Push(queueSubmitDescs, queueSubmitDescNum);
+            return;
+        }
 
-    Scratch<VkSemaphoreSubmitInfo> waitSemaphores = AllocateScratch(m_Device, VkSemaphoreSubmitInfo, queueSubmitDesc.waitFenceNum);
-    for (uint32_t i = 0; i < queueSubmitDesc.waitFenceNum; i++) {
-        waitSemaphores[i] = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
-        waitSemaphores[i].semaphore = *(FenceVK*)queueSubmitDesc.waitFences[i].fence;
-        waitSemaphores[i].value = queueSubmitDesc.waitFences[i].value;
-        waitSemaphores[i].stageMask = GetPipelineStageFlags(queueSubmitDesc.waitFences[i].stages);
+        // Trackable submits go directly to the driver, but can't overtake pending ones
+        m_SubmissionThread->Flush();
     }
 
-    Scratch<VkCommandBufferSubmitInfo> commandBuffers = AllocateScratch(m_Device, VkCommandBufferSubmitInfo, queueSubmitDesc.commandBufferNum);
-    for (uint32_t i = 0; i < queueSubmitDesc.commandBufferNum; i++) {
-        commandBuffers[i] = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO};
-        commandBuffers[i].commandBuffer = *(CommandBufferVK*)queueSubmitDesc.commandBuffers[i];
-    }
+    SubmitImmediately(queueSubmitDescs, queueSubmitDescNum, swapChain);
+}
 
-    Scratch<VkSemaphoreSubmitInfo> signalSemaphores = AllocateScratch(m_Device, VkSemaphoreSubmitInfo, queueSubmitDesc.signalFenceNum);
-    for (uint32_t i = 0; i < queueSubmitDesc.signalFenceNum; i++) {
-        signalSemaphores[i] = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
-        signalSemaphores[i].semaphore = *(FenceVK*)queueSubmitDesc.signalFences[i].fence;
-        signalSemaphores[i].value = queueSubmitDesc.signalFences[i].value;
-        signalSemaphores[i].stageMask = GetPipelineStageFlags(queueSubmitDesc.signalFences[i].stages);
+void QueueVK::SubmitImmediately(const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum, const SwapChain* swapChain) {
+    // Gather sizes to fill all submits in one go
+    uint32_t waitFenceNum = 0;
+    uint32_t commandBufferNum = 0;
+    uint32_t signalFenceNum = 0;
+    for (uint32_t i = 0; i < queueSubmitDescNum; i++) {
+        waitFenceNum += queueSubmitDescs[i].waitFenceNum;
+        commandBufferNum += queueSubmitDescs[i].commandBufferNum;
+        signalFenceNum += queueSubmitDescs[i].signalFenceNum;
     }
 
-    VkSubmitInfo2 submitInfo = {VK_STRUCTURE_TYPE_SUBMIT_INFO_2};
-    submitInfo.waitSemaphoreInfoCount = queueSubmitDesc.waitFenceNum;
-    submitInfo.pWaitSemaphoreInfos = waitSemaphores;
-    submitInfo.commandBufferInfoCount = queueSubmitDesc.commandBufferNum;
-    submitInfo.pCommandBufferInfos = commandBuffers;
-    submitInfo.signalSemaphoreInfoCount = queueSubmitDesc.signalFenceNum;
-    submitInfo.pSignalSemaphoreInfos = signalSemaphores;
+    Scratch<VkSubmitInfo2> submitInfos = AllocateScratch(m_Device, VkSubmitInfo2, queueSubmitDescNum);
+    Scratch<VkSemaphoreSubmitInfo> semaphores = AllocateScratch(m_Device, VkSemaphoreSubmitInfo, waitFenceNum + signalFenceNum);
+    Scratch<VkCommandBufferSubmitInfo> commandBuffers = AllocateScratch(m_Device, VkCommandBufferSubmitInfo, commandBufferNum);
+
+    VkSemaphoreSubmitInfo* semaphore = semaphores;
+    VkCommandBufferSubmitInfo* commandBuffer = commandBuffers;
+
+    for (uint32_t i = 0; i < queueSubmitDescNum; i++) {
+        const QueueSubmitDesc& queueSubmitDesc = queueSubmitDescs[i];
+
+        VkSubmitInfo2& submitInfo = submitInfos[i];
+        submitInfo = {VK_STRUCTURE_TYPE_SUBMIT_INFO_2};
+        submitInfo.waitSemaphoreInfoCount = queueSubmitDesc.waitFenceNum;
+        submitInfo.pWaitSemaphoreInfos = semaphore;
+
+        for (uint32_t j = 0; j < queueSubmitDesc.waitFenceNum; j++) {
+            *semaphore = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
+            semaphore->semaphore = *(FenceVK*)queueSubmitDesc.waitFences[j].fence;
+            semaphore->value = queueSubmitDesc.waitFences[j].value;
+            semaphore->stageMask = GetPipelineStageFlags(queueSubmitDesc.waitFences[j].stages);
+            semaphore++;
+        }
+
+        submitInfo.commandBufferInfoCount = queueSubmitDesc.commandBufferNum;
+        submitInfo.pCommandBufferInfos = commandBuffer;
+
+        for (uint32_t j = 0; j < queueSubmitDesc.commandBufferNum; j++) {
+            *commandBuffer = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO};
+            commandBuffer->commandBuffer = *(CommandBufferVK*)queueSubmitDesc.commandBuffers[j];
+            commandBuffer++;
+        }
+
+        submitInfo.signalSemaphoreInfoCount = queueSubmitDesc.signalFenceNum;
+        submitInfo.pSignalSemaphoreInfos = semaphore;
+
+        for (uint32_t j = 0; j < queueSubmitDesc.signalFenceNum; j++) {
+            *semaphore = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
+            semaphore->semaphore = *(FenceVK*)queueSubmitDesc.signalFences[j].fence;
+            semaphore->value = queueSubmitDesc.signalFences[j].value;
+            semaphore->stageMask = GetPipelineStageFlags(queueSubmitDesc.signalFences[j].stages);
+            semaphore++;
+        }
+    }
 
     VkLatencySubmissionPresentIdNV presentId = {VK_STRUCTURE_TYPE_LATENCY_SUBMISSION_PRESENT_ID_NV};
-    if (swapChain && m_Device.m_IsSupported.presentId) {
+    if (swapChain && m_Device.m_IsSupported.presentId && queueSubmitDescNum) {
         presentId.presentID = ((const SwapChainVK*)swapChain)->GetPresentId();
-        submitInfo.pNext = &presentId;
+        submitInfos[queueSubmitDescNum - 1].pNext = &presentId;
     }
 
+    ExclusiveScope lock(m_Lock);
+
     const auto& vk = m_Device.GetDispatchTable();
-    VkResult result = vk.QueueSubmit2(m_Handle, 1, &submitInfo, VK_NULL_HANDLE);
+    VkResult result = vk.QueueSubmit2(m_Handle, queueSubmitDescNum, submitInfos, VK_NULL_HANDLE);
     RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, ReturnVoid(), "vkQueueSubmit returned %d", (int32_t)result);
 }
 
+NRI_INLINE void QueueVK::FlushSubmissions() {
+    if (m_SubmissionThread)
+        m_SubmissionThread->Flush();
+}
+
 NRI_INLINE Result QueueVK::UploadData(const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum) {
     HelperDataUpload helperDataUpload(m_Device.GetCoreInterface(), (Device&)m_Device, (Queue&)*this);
 
@@ -95,6 +150,8 @@ NRI_INLINE Result QueueVK::UploadData(const TextureUploadDesc* textureUploadDesc
 }
 
 NRI_INLINE Result QueueVK::WaitForIdle() {
+    FlushSubmissions();
+
     ExclusiveScope lock(m_Lock);
 
     const auto& vk = m_Device.GetDispatchTable();
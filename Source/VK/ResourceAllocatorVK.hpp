@@ -27,6 +27,15 @@
 #    pragma warning(pop)
 #endif
 
+static void VKAPI_PTR VmaAllocateDeviceMemoryCallback(VmaAllocator, uint32_t memoryType, VkDeviceMemory, VkDeviceSize size, void* userData) {
+    DeviceVK& device = *(DeviceVK*)userData;
+    device.GetBudgetMonitor().Track(device.IsDeviceLocalHeap(memoryType), (int64_t)size);
+}
+
+static void VKAPI_PTR VmaFreeDeviceMemoryCallback(VmaAllocator, uint32_t memoryType, VkDeviceMemory, VkDeviceSize size, void* userData) {
+    DeviceVK& device = *(DeviceVK*)userData;
+    device.GetBudgetMonitor().Track(device.IsDeviceLocalHeap(memoryType), -(int64_t)size);
+}
 
 Result DeviceVK::CreateVma() {
     if (m_Vma)
@@ -45,6 +54,14 @@ Result DeviceVK::CreateVma() {
     allocatorCreateInfo.pAllocationCallbacks = m_AllocationCallbackPtr;
     allocatorCreateInfo.preferredLargeHeapBlockSize = VMA_PREFERRED_BLOCK_SIZE;
 
+    // Feed VMA block allocations to the budget monitor
+    VmaDeviceMemoryCallbacks deviceMemoryCallbacks = {};
+    deviceMemoryCallbacks.pfnAllocate = VmaAllocateDeviceMemoryCallback;
+    deviceMemoryCallbacks.pfnFree = VmaFreeDeviceMemoryCallback;
+    deviceMemoryCallbacks.pUserData = this;
+
+    allocatorCreateInfo.pDeviceMemoryCallbacks = &deviceMemoryCallbacks;
+
     allocatorCreateInfo.flags = VMA_ALLOCATOR_CREATE_KHR_MAINTENANCE4_BIT;
     if (m_IsSupported.memoryBudget)
         allocatorCreateInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
@@ -61,6 +78,35 @@ Result DeviceVK::CreateVma() {
     return Result::SUCCESS;
 }
 
+static void FillAllocationCreateInfo(VmaAllocationCreateInfo& allocationCreateInfo, MemoryLocation memoryLocation, bool isBuffer) {
+    allocationCreateInfo.usage = IsHostMemory(memoryLocation) ? VMA_MEMORY_USAGE_AUTO_PREFER_HOST : VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+    if (isBuffer && IsHostVisibleMemory(memoryLocation)) {
+        allocationCreateInfo.flags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        if (memoryLocation == MemoryLocation::HOST_READBACK)
+            allocationCreateInfo.flags |= VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
+        else
+            allocationCreateInfo.flags |= VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+    }
+}
+
+static void ConvertStats(const VmaDetailedStatistics& in, AllocatorStats& out) {
+    out.blockSize += in.statistics.blockBytes;
+    out.allocationSize += in.statistics.allocationBytes;
+    out.blockNum += in.statistics.blockCount;
+    out.allocationNum += in.statistics.allocationCount;
+    out.unusedRangeNum += in.unusedRangeCount;
+
+    if (in.statistics.allocationCount) {
+        out.allocationSizeMin = out.allocationSizeMin ? std::min(out.allocationSizeMin, in.allocationSizeMin) : in.allocationSizeMin;
+        out.allocationSizeMax = std::max(out.allocationSizeMax, in.allocationSizeMax);
+    }
+
+    if (in.unusedRangeCount)
+        out.unusedRangeSizeMax = std::max(out.unusedRangeSizeMax, in.unusedRangeSizeMax);
+}
+
 Result BufferVK::Create(const AllocateBufferDesc& bufferDesc) {
     Result nriResult = m_Device.CreateVma();
     if (nriResult != Result::SUCCESS)
@@ -74,16 +120,8 @@ Result BufferVK::Create(const AllocateBufferDesc& bufferDesc) {
     VmaAllocationCreateInfo allocationCreateInfo = {};
     allocationCreateInfo.flags = VMA_ALLOCATION_CREATE_CAN_ALIAS_BIT | VMA_ALLOCATION_CREATE_STRATEGY_MIN_MEMORY_BIT;
     allocationCreateInfo.priority = bufferDesc.memoryPriority * 0.5f + 0.5f;
-    allocationCreateInfo.usage = IsHostMemory(bufferDesc.memoryLocation) ? VMA_MEMORY_USAGE_AUTO_PREFER_HOST : VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
-
-    if (IsHostVisibleMemory(bufferDesc.memoryLocation)) {
-        allocationCreateInfo.flags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
-
-        if (bufferDesc.memoryLocation == MemoryLocation::HOST_READBACK)
-            allocationCreateInfo.flags |= VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
-        else
-            allocationCreateInfo.flags |= VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
-    }
+    allocationCreateInfo.pool = bufferDesc.pool ? ((AllocatorPoolVK*)bufferDesc.pool)->GetHandle() : nullptr;
+    FillAllocationCreateInfo(allocationCreateInfo, bufferDesc.memoryLocation, true);
 
     const DeviceDesc& deviceDesc = m_Device.GetDesc();
     uint32_t alignment = 1;
@@ -96,21 +134,30 @@ Result BufferVK::Create(const AllocateBufferDesc& bufferDesc) {
     if (bufferDesc.desc.usage & BufferUsageBits::SCRATCH_BUFFER)
         alignment = std::max(alignment, deviceDesc.scratchBufferOffsetAlignment);
 
-    VmaAllocationInfo allocationInfo = {};
-    VkResult result = vmaCreateBufferWithAlignment(m_Device.GetVma(), &bufferCreateInfo, &allocationCreateInfo, alignment, &m_Handle, &m_VmaAllocation, &allocationInfo);
+    VkResult result = vmaCreateBufferWithAlignment(m_Device.GetVma(), &bufferCreateInfo, &allocationCreateInfo, alignment, &m_Handle, &m_VmaAllocation, nullptr);
     RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vmaCreateBufferWithAlignment returned %d", (int32_t)result);
 
-    // Mapped memory
-    if (IsHostVisibleMemory(bufferDesc.memoryLocation)) {
-        m_MappedMemory = (uint8_t*)allocationInfo.pMappedData - allocationInfo.offset;
-        m_MappedMemoryOffset = allocationInfo.offset;
+    FinishVmaBinding();
 
-        uint32_t memoryTypeIndex = 0;
-        result = vmaFindMemoryTypeIndexForBufferInfo(m_Device.GetVma(), &bufferCreateInfo, &allocationCreateInfo, &memoryTypeIndex);
-        RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vmaFindMemoryTypeIndexForBufferInfo returned %d", (int32_t)result);
+    m_Desc = bufferDesc.desc;
+
+    return Result::SUCCESS;
+}
+
+void BufferVK::FinishVmaBinding() {
+    VmaAllocationInfo2 allocationInfo2 = {};
+    vmaGetAllocationInfo2(m_Device.GetVma(), m_VmaAllocation, &allocationInfo2);
 
-        if (!m_Device.IsHostCoherentMemory((MemoryTypeIndex)memoryTypeIndex))
-            m_NonCoherentDeviceMemory = allocationInfo.deviceMemory;
+    const VmaAllocationInfo& allocationInfo = allocationInfo2.allocationInfo;
+
+    // Mapped memory (persistently mapped host visible memory)
+    if (allocationInfo.pMappedData) {
+        bool isCoherent = m_Device.IsHostCoherentMemory((MemoryTypeIndex)allocationInfo.memoryType);
+
+        m_MappedMemory = (uint8_t*)allocationInfo.pMappedData - allocationInfo.offset;
+        m_MappedMemoryOffset = allocationInfo.offset;
+        m_NonCoherentDeviceMemory = isCoherent ? VK_NULL_HANDLE : allocationInfo.deviceMemory;
+        m_NonCoherentDeviceMemorySize = isCoherent ? 0 : allocationInfo2.blockSize;
     }
 
     // Device address
@@ -121,10 +168,6 @@ Result BufferVK::Create(const AllocateBufferDesc& bufferDesc) {
         const auto& vk = m_Device.GetDispatchTable();
         m_DeviceAddress = vk.GetBufferDeviceAddress(m_Device, &bufferDeviceAddressInfo);
     }
-
-    m_Desc = bufferDesc.desc;
-
-    return Result::SUCCESS;
 }
 
 Result TextureVK::Create(const AllocateTextureDesc& textureDesc) {
@@ -140,7 +183,8 @@ Result TextureVK::Create(const AllocateTextureDesc& textureDesc) {
     VmaAllocationCreateInfo allocationCreateInfo = {};
     allocationCreateInfo.flags = VMA_ALLOCATION_CREATE_CAN_ALIAS_BIT | VMA_ALLOCATION_CREATE_STRATEGY_MIN_MEMORY_BIT;
     allocationCreateInfo.priority = textureDesc.memoryPriority * 0.5f + 0.5f;
-    allocationCreateInfo.usage = IsHostMemory(textureDesc.memoryLocation) ? VMA_MEMORY_USAGE_AUTO_PREFER_HOST : VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+    allocationCreateInfo.pool = textureDesc.pool ? ((AllocatorPoolVK*)textureDesc.pool)->GetHandle() : nullptr;
+    FillAllocationCreateInfo(allocationCreateInfo, textureDesc.memoryLocation, false);
 
     VkResult result = vmaCreateImage(m_Device.GetVma(), &imageCreateInfo, &allocationCreateInfo, &m_Handle, &m_VmaAllocation, nullptr);
     RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vmaCreateImage returned %d", (int32_t)result);
@@ -161,6 +205,7 @@ Result AccelerationStructureVK::Create(const AllocateAccelerationStructureDesc&
     AllocateBufferDesc bufferDesc = {};
     bufferDesc.memoryLocation = accelerationStructureDesc.memoryLocation;
     bufferDesc.memoryPriority = accelerationStructureDesc.memoryPriority;
+    bufferDesc.pool = accelerationStructureDesc.pool;
     bufferDesc.desc.size = sizesInfo.accelerationStructureSize;
     bufferDesc.desc.usage = BufferUsageBits::ACCELERATION_STRUCTURE_STORAGE;
 
@@ -179,6 +224,106 @@ Result AccelerationStructureVK::Create(const AllocateAccelerationStructureDesc&
     return result;
 }
 
+AllocatorPoolVK::~AllocatorPoolVK() {
+    if (m_Handle)
+        vmaDestroyPool(m_Device.GetVma(), m_Handle);
+}
+
+Result AllocatorPoolVK::Create(const AllocatorPoolDesc& allocatorPoolDesc) {
+    Result nriResult = m_Device.CreateVma();
+    if (nriResult != Result::SUCCESS)
+        return nriResult;
+
+    // Find a memory type, compatible with the expected resources
+    bool isBuffer = allocatorPoolDesc.bufferUsage != BufferUsageBits::NONE;
+
+    VmaAllocationCreateInfo allocationCreateInfo = {};
+    FillAllocationCreateInfo(allocationCreateInfo, allocatorPoolDesc.memoryLocation, isBuffer);
+
+    uint32_t memoryTypeIndex = 0;
+    if (isBuffer) {
+        BufferDesc bufferDesc = {};
+        bufferDesc.size = 64 * 1024;
+        bufferDesc.usage = allocatorPoolDesc.bufferUsage;
+
+        VkBufferCreateInfo bufferCreateInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+        m_Device.FillCreateInfo(bufferDesc, bufferCreateInfo);
+
+        VkResult result = vmaFindMemoryTypeIndexForBufferInfo(m_Device.GetVma(), &bufferCreateInfo, &allocationCreateInfo, &memoryTypeIndex);
+        RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vmaFindMemoryTypeIndexForBufferInfo returned %d", (int32_t)result);
+    } else {
+        TextureDesc textureDesc = {};
+        textureDesc.type = TextureType::TEXTURE_2D;
+        textureDesc.usage = allocatorPoolDesc.textureUsage;
+        textureDesc.format = (allocatorPoolDesc.textureUsage & TextureUsageBits::DEPTH_STENCIL_ATTACHMENT) ? Format::D32_SFLOAT : Format::RGBA8_UNORM;
+        textureDesc.width = 16;
+        textureDesc.height = 16;
+
+        VkImageCreateInfo imageCreateInfo = {VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+        m_Device.FillCreateInfo(FixTextureDesc(textureDesc), imageCreateInfo);
+
+        VkResult result = vmaFindMemoryTypeIndexForImageInfo(m_Device.GetVma(), &imageCreateInfo, &allocationCreateInfo, &memoryTypeIndex);
+        RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vmaFindMemoryTypeIndexForImageInfo returned %d", (int32_t)result);
+    }
+
+    // Create
+    VmaPoolCreateInfo poolCreateInfo = {};
+    poolCreateInfo.memoryTypeIndex = memoryTypeIndex;
+    poolCreateInfo.blockSize = allocatorPoolDesc.blockSize;
+    poolCreateInfo.minBlockCount = allocatorPoolDesc.blockMinNum;
+    poolCreateInfo.maxBlockCount = allocatorPoolDesc.blockMaxNum;
+
+    if (allocatorPoolDesc.isLinear)
+        poolCreateInfo.flags |= VMA_POOL_CREATE_LINEAR_ALGORITHM_BIT;
+
+    VkResult result = vmaCreatePool(m_Device.GetVma(), &poolCreateInfo, &m_Handle);
+    RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vmaCreatePool returned %d", (int32_t)result);
+
+    m_Desc = allocatorPoolDesc;
+
+    return Result::SUCCESS;
+}
+
+void AllocatorPoolVK::GetStats(AllocatorStats& allocatorStats) const {
+    VmaDetailedStatistics stats = {};
+    vmaCalculatePoolStatistics(m_Device.GetVma(), m_Handle, &stats);
+
+    allocatorStats = {};
+    ConvertStats(stats, allocatorStats);
+}
+
+NRI_INLINE void AllocatorPoolVK::SetDebugName(const char* name) {
+    vmaSetPoolName(m_Device.GetVma(), m_Handle, name);
+}
+
+Result DeviceVK::GetAllocatorStats(MemoryLocation memoryLocation, AllocatorStats& allocatorStats) {
+    allocatorStats = {};
+
+    Result nriResult = CreateVma();
+    if (nriResult != Result::SUCCESS)
+        return nriResult;
+
+    VmaTotalStatistics totalStats = {};
+    vmaCalculateStatistics(m_Vma, &totalStats);
+
+    std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets = {};
+    vmaGetHeapBudgets(m_Vma, budgets.data());
+
+    bool isLocal = memoryLocation == MemoryLocation::DEVICE || memoryLocation == MemoryLocation::DEVICE_UPLOAD;
+    for (uint32_t i = 0; i < m_MemoryProps.memoryHeapCount; i++) {
+        bool state = m_MemoryProps.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+        if (state != isLocal)
+            continue;
+
+        allocatorStats.budgetSize += budgets[i].budget;
+        allocatorStats.usageSize += budgets[i].usage;
+
+        ConvertStats(totalStats.memoryHeap[i], allocatorStats);
+    }
+
+    return Result::SUCCESS;
+}
+
 void DeviceVK::DestroyVma() {
     if (m_Vma)
         vmaDestroyAllocator(m_Vma);
@@ -193,3 +338,197 @@ void TextureVK::DestroyVma() {
     CHECK(m_VmaAllocation, "Not a VMA allocation");
     vmaDestroyImage(m_Device.GetVma(), m_Handle, m_VmaAllocation);
 }
+
+Result BufferVK::BindDefragmentationTarget(VmaAllocation_T* allocation) {
+    VkResult result = vmaBindBufferMemory(m_Device.GetVma(), allocation, m_Handle);
+    RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vmaBindBufferMemory returned %d", (int32_t)result);
+
+    return Result::SUCCESS;
+}
+
+void BufferVK::FinishDefragmentationMove(BufferVK& target) {
+    // Cached views reference the old native object
+    m_Device.EvictCachedDescriptors(this);
+
+    // The allocation already describes the new location, the old native object goes to "target" for destruction
+    std::swap(m_Handle, target.m_Handle);
+
+    FinishVmaBinding();
+}
+
+Result TextureVK::BindDefragmentationTarget(VmaAllocation_T* allocation) {
+    VkResult result = vmaBindImageMemory(m_Device.GetVma(), allocation, m_Handle);
+    RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vmaBindImageMemory returned %d", (int32_t)result);
+
+    return Result::SUCCESS;
+}
+
+void TextureVK::FinishDefragmentationMove(TextureVK& target) {
+    m_Device.EvictCachedDescriptors(this);
+
+    std::swap(m_Handle, target.m_Handle);
+}
+
+DefragmentationVK::~DefragmentationVK() {
+    if (m_Context) {
+        DefragmentationStats defragmentationStats = {};
+        End(defragmentationStats);
+    }
+}
+
+Result DefragmentationVK::Create(const DefragmentationDesc& defragmentationDesc) {
+    Result nriResult = m_Device.CreateVma();
+    if (nriResult != Result::SUCCESS)
+        return nriResult;
+
+    // Movable resources
+    for (uint32_t i = 0; i < defragmentationDesc.bufferNum; i++) {
+        BufferVK* bufferVK = (BufferVK*)defragmentationDesc.buffers[i];
+        if (bufferVK->GetVmaAllocation())
+            m_Resources[bufferVK->GetVmaAllocation()].srcBuffer = defragmentationDesc.buffers[i];
+    }
+
+    for (uint32_t i = 0; i < defragmentationDesc.textureNum; i++) {
+        TextureVK* textureVK = (TextureVK*)defragmentationDesc.textures[i];
+        if (textureVK->GetVmaAllocation())
+            m_Resources[textureVK->GetVmaAllocation()].srcTexture = defragmentationDesc.textures[i];
+    }
+
+    // Begin
+    VmaDefragmentationInfo defragmentationInfo = {};
+    defragmentationInfo.pool = defragmentationDesc.pool ? ((AllocatorPoolVK*)defragmentationDesc.pool)->GetHandle() : nullptr;
+    defragmentationInfo.maxBytesPerPass = defragmentationDesc.maxBytesPerPass;
+    defragmentationInfo.maxAllocationsPerPass = defragmentationDesc.maxMovesPerPass;
+
+    VkResult result = vmaBeginDefragmentation(m_Device.GetVma(), &defragmentationInfo, &m_Context);
+    RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vmaBeginDefragmentation returned %d", (int32_t)result);
+
+    return Result::SUCCESS;
+}
+
+Result DefragmentationVK::GetPass(DefragmentationPass& defragmentationPass) {
+    defragmentationPass = {};
+
+    // Not ended pass is reported again
+    while (!m_VmaMoves) {
+        VmaDefragmentationPassMoveInfo passInfo = {};
+        VkResult result = vmaBeginDefragmentationPass(m_Device.GetVma(), m_Context, &passInfo);
+        if (result == VK_SUCCESS)
+            return Result::SUCCESS; // nothing to move
+        RETURN_ON_FAILURE(&m_Device, result == VK_INCOMPLETE, GetReturnCode(result), "vmaBeginDefragmentationPass returned %d", (int32_t)result);
+
+        m_VmaMoves = passInfo.pMoves;
+        m_VmaMoveNum = passInfo.moveCount;
+
+        // Create temporary resources in the new locations
+        for (uint32_t i = 0; i < m_VmaMoveNum; i++) {
+            VmaDefragmentationMove& vmaMove = m_VmaMoves[i];
+
+            const auto it = m_Resources.find(vmaMove.srcAllocation);
+            if (it == m_Resources.end()) {
+                vmaMove.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+                continue;
+            }
+
+            DefragmentationMove move = it->second;
+
+            Result nriResult = Result::SUCCESS;
+            if (move.srcBuffer) {
+                nriResult = m_Device.CreateImplementation<BufferVK>(move.dstBuffer, ((BufferVK*)move.srcBuffer)->GetDesc());
+                if (nriResult == Result::SUCCESS) {
+                    nriResult = ((BufferVK*)move.dstBuffer)->BindDefragmentationTarget(vmaMove.dstTmpAllocation);
+                    if (nriResult != Result::SUCCESS)
+                        Destroy((BufferVK*)move.dstBuffer);
+                }
+            } else {
+                nriResult = m_Device.CreateImplementation<TextureVK>(move.dstTexture, ((TextureVK*)move.srcTexture)->GetDesc());
+                if (nriResult == Result::SUCCESS) {
+                    nriResult = ((TextureVK*)move.dstTexture)->BindDefragmentationTarget(vmaMove.dstTmpAllocation);
+                    if (nriResult != Result::SUCCESS)
+                        Destroy((TextureVK*)move.dstTexture);
+                }
+            }
+
+            if (nriResult == Result::SUCCESS)
+                m_Moves.push_back(move);
+            else
+                vmaMove.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+        }
+
+        // All moves are ignored, try the next pass
+        if (m_Moves.empty()) {
+            VmaDefragmentationPassMoveInfo endPassInfo = {m_VmaMoveNum, m_VmaMoves};
+            result = vmaEndDefragmentationPass(m_Device.GetVma(), m_Context, &endPassInfo);
+
+            m_VmaMoves = nullptr;
+            m_VmaMoveNum = 0;
+
+            if (result == VK_SUCCESS)
+                return Result::SUCCESS; // complete
+        }
+    }
+
+    defragmentationPass.moves = m_Moves.data();
+    defragmentationPass.moveNum = (uint32_t)m_Moves.size();
+
+    return Result::SUCCESS;
+}
+
+Result DefragmentationVK::EndPass() {
+    if (!m_VmaMoves)
+        return Result::SUCCESS;
+
+    VmaDefragmentationPassMoveInfo passInfo = {m_VmaMoveNum, m_VmaMoves};
+    VkResult result = vmaEndDefragmentationPass(m_Device.GetVma(), m_Context, &passInfo);
+
+    // Rebind moved resources
+    for (const DefragmentationMove& move : m_Moves) {
+        if (move.srcBuffer) {
+            ((BufferVK*)move.srcBuffer)->FinishDefragmentationMove(*(BufferVK*)move.dstBuffer);
+            Destroy((BufferVK*)move.dstBuffer);
+        } else {
+            ((TextureVK*)move.srcTexture)->FinishDefragmentationMove(*(TextureVK*)move.dstTexture);
+            Destroy((TextureVK*)move.dstTexture);
+        }
+    }
+
+    m_Moves.clear();
+    m_VmaMoves = nullptr;
+    m_VmaMoveNum = 0;
+
+    RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS || result == VK_INCOMPLETE, GetReturnCode(result), "vmaEndDefragmentationPass returned %d", (int32_t)result);
+
+    return Result::SUCCESS;
+}
+
+void DefragmentationVK::End(DefragmentationStats& defragmentationStats) {
+    // Cancel the unfinished pass
+    if (m_VmaMoves) {
+        for (uint32_t i = 0; i < m_VmaMoveNum; i++)
+            m_VmaMoves[i].operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+
+        VmaDefragmentationPassMoveInfo passInfo = {m_VmaMoveNum, m_VmaMoves};
+        vmaEndDefragmentationPass(m_Device.GetVma(), m_Context, &passInfo);
+
+        for (const DefragmentationMove& move : m_Moves) {
+            if (move.dstBuffer)
+                Destroy((BufferVK*)move.dstBuffer);
+            else
+                Destroy((TextureVK*)move.dstTexture);
+        }
+
+        m_Moves.clear();
+        m_VmaMoves = nullptr;
+        m_VmaMoveNum = 0;
+    }
+
+    VmaDefragmentationStats stats = {};
+    vmaEndDefragmentation(m_Device.GetVma(), m_Context, &stats);
+    m_Context = nullptr;
+
+    defragmentationStats = {};
+    defragmentationStats.movedSize = stats.bytesMoved;
+    defragmentationStats.freedSize = stats.bytesFreed;
+    defragmentationStats.moveNum = stats.allocationsMoved;
+    defragmentationStats.freedBlockNum = stats.deviceMemoryBlocksFreed;
+}
@@ -53,5 +53,9 @@ constexpr uint32_t INVALID_FAMILY_INDEX = uint32_t(-1);
 
 struct VmaAllocator_T;
 struct VmaAllocation_T;
+struct VmaPool_T;
+struct VmaDefragmentationContext_T;
+struct VmaDefragmentationMove;
 
+#include "MemoryDescCache.h"
 #include "DeviceVK.h"
@@ -364,6 +364,8 @@ NRI_INLINE Result SwapChainVK::WaitForPresent() {
 }
 
 NRI_INLINE Result SwapChainVK::Present() {
+    m_Queue->FlushSubmissions();
+
     ExclusiveScope lock(m_Queue->GetLock());
 
     if (m_TextureIndex == OUT_OF_DATE)
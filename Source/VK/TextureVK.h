@@ -25,6 +25,10 @@ struct TextureVK final : public DebugNameBase {
         return m_Desc;
     }
 
+    inline VmaAllocation_T* GetVmaAllocation() const {
+        return m_VmaAllocation;
+    }
+
     inline Dim_t GetSize(Dim_t dimensionIndex, Mip_t mip = 0) const {
         return GetDimension(GraphicsAPI::VK, m_Desc, dimensionIndex, mip);
     }
@@ -36,6 +40,8 @@ struct TextureVK final : public DebugNameBase {
     Result Create(const AllocateTextureDesc& textureDesc);
     VkImageAspectFlags GetImageAspectFlags() const;
     void DestroyVma();
+    Result BindDefragmentationTarget(VmaAllocation_T* allocation);
+    void FinishDefragmentationMove(TextureVK& target);
     void GetMemoryDesc(MemoryLocation memoryLocation, MemoryDesc& memoryDesc) const;
 
     //================================================================================================================
@@ -16,13 +16,13 @@ NRI_INLINE uint64_t AccelerationStructureVal::GetBuildScratchBufferSize() const
 }
 
 NRI_INLINE uint64_t AccelerationStructureVal::GetHandle() const {
-    RETURN_ON_FAILURE(&m_Device, IsBoundToMemory(), 0, "AccelerationStructure is not bound to memory");
+    RETURN_ON_FAILURE_IF(&m_Device, OBJECT_LIFETIME, IsBoundToMemory(), 0, "AccelerationStructure is not bound to memory");
 
     return GetRayTracingInterface().GetAccelerationStructureHandle(*GetImpl());
 }
 
 NRI_INLINE uint64_t AccelerationStructureVal::GetNativeObject() const {
-    RETURN_ON_FAILURE(&m_Device, IsBoundToMemory(), 0, "AccelerationStructure is not bound to memory");
+    RETURN_ON_FAILURE_IF(&m_Device, OBJECT_LIFETIME, IsBoundToMemory(), 0, "AccelerationStructure is not bound to memory");
 
     return GetRayTracingInterface().GetAccelerationStructureNativeObject(*GetImpl());
 }
@@ -32,7 +32,7 @@ NRI_INLINE Result AccelerationStructureVal::CreateDescriptor(Descriptor*& descri
     const Result result = GetRayTracingInterface().CreateAccelerationStructureDescriptor(*GetImpl(), descriptorImpl);
 
     if (result == Result::SUCCESS)
-        descriptor = (Descriptor*)Allocate<DescriptorVal>(m_Device.GetAllocationCallbacks(), m_Device, descriptorImpl, ResourceType::ACCELERATION_STRUCTURE);
+        descriptor = (Descriptor*)AllocateObject<DescriptorVal>(m_Device, m_Device, descriptorImpl, ResourceType::ACCELERATION_STRUCTURE);
 
     return result;
 }
@@ -0,0 +1,35 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+struct AllocatorPoolVal final : public ObjectVal {
+    inline AllocatorPoolVal(DeviceVal& device, AllocatorPool* allocatorPool, const AllocatorPoolDesc& allocatorPoolDesc)
+        : ObjectVal(device, allocatorPool)
+        , m_Desc(allocatorPoolDesc) {
+    }
+
+    inline AllocatorPool* GetImpl() const {
+        return (AllocatorPool*)m_Impl;
+    }
+
+    inline const AllocatorPoolDesc& GetDesc() const {
+        return m_Desc;
+    }
+
+    inline bool IsBufferPool() const {
+        return m_Desc.bufferUsage != BufferUsageBits::NONE;
+    }
+
+    //================================================================================================================
+    // NRI
+    //================================================================================================================
+
+    void GetStats(AllocatorStats& allocatorStats) const;
+
+private:
+    AllocatorPoolDesc m_Desc = {};
+};
+
+} // namespace nri
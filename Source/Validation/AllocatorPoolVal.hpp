@@ -0,0 +1,5 @@
+// © 2021 NVIDIA Corporation
+
+NRI_INLINE void AllocatorPoolVal::GetStats(AllocatorStats& allocatorStats) const {
+    GetResourceAllocatorInterface().GetAllocatorPoolStats(*GetImpl(), allocatorStats);
+}
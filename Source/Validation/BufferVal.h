@@ -31,6 +31,14 @@ struct BufferVal final : public ObjectVal {
         return m_IsBoundToMemory;
     }
 
+    inline bool IsMapped() const {
+        return m_IsMapped;
+    }
+
+    inline ResourceStateVal& GetState() {
+        return m_State;
+    }
+
     inline void SetBoundToMemory(MemoryVal* memory = nullptr) {
         m_Memory = memory;
         m_IsBoundToMemory = true;
@@ -40,12 +48,13 @@ struct BufferVal final : public ObjectVal {
     // NRI
     //================================================================================================================
 
-    void* Map(uint64_t offset, uint64_t size);
+    void* Map(uint64_t offset, uint64_t size, MapMode mapMode);
     void Unmap();
 
 private:
     BufferDesc m_Desc = {}; // (only for) .natvis
     MemoryVal* m_Memory = nullptr;
+    ResourceStateVal m_State = {}; // resolved at "QueueSubmit"
     bool m_IsBoundToMemory = false;
     bool m_IsMapped = false;
 };
@@ -5,17 +5,18 @@ BufferVal::~BufferVal() {
         m_Memory->UnbindBuffer(*this);
 }
 
-NRI_INLINE void* BufferVal::Map(uint64_t offset, uint64_t size) {
-    RETURN_ON_FAILURE(&m_Device, m_IsBoundToMemory, nullptr, "the buffer is not bound to memory");
-    RETURN_ON_FAILURE(&m_Device, !m_IsMapped, nullptr, "the buffer is already mapped (D3D11 doesn't support nested calls)");
+NRI_INLINE void* BufferVal::Map(uint64_t offset, uint64_t size, MapMode mapMode) {
+    RETURN_ON_FAILURE_IF(&m_Device, OBJECT_LIFETIME, m_IsBoundToMemory, nullptr, "the buffer is not bound to memory");
+    RETURN_ON_FAILURE_IF(&m_Device, OBJECT_LIFETIME, !m_IsMapped, nullptr, "the buffer is already mapped (D3D11 doesn't support nested calls)");
+    RETURN_ON_FAILURE_IF(&m_Device, OBJECT_LIFETIME, mapMode < MapMode::MAX_NUM, nullptr, "'mapMode' is invalid");
 
     m_IsMapped = true;
 
-    return GetCoreInterface().MapBuffer(*GetImpl(), offset, size);
+    return GetCoreInterface().MapBufferWithMode(*GetImpl(), offset, size, mapMode);
 }
 
 NRI_INLINE void BufferVal::Unmap() {
-    RETURN_ON_FAILURE(&m_Device, m_IsMapped, ReturnVoid(), "the buffer is not mapped");
+    RETURN_ON_FAILURE_IF(&m_Device, OBJECT_LIFETIME, m_IsMapped, ReturnVoid(), "the buffer is not mapped");
 
     m_IsMapped = false;
 
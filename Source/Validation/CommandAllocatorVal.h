@@ -18,6 +18,7 @@ struct CommandAllocatorVal final : public ObjectVal {
     //================================================================================================================
 
     Result CreateCommandBuffer(CommandBuffer*& commandBuffer);
+    Result CreateSecondaryCommandBuffer(CommandBuffer*& commandBuffer);
     void Reset();
 };
 
@@ -5,7 +5,19 @@ NRI_INLINE Result CommandAllocatorVal::CreateCommandBuffer(CommandBuffer*& comma
     const Result result = GetCoreInterface().CreateCommandBuffer(*GetImpl(), commandBufferImpl);
 
     if (result == Result::SUCCESS)
-        commandBuffer = (CommandBuffer*)Allocate<CommandBufferVal>(m_Device.GetAllocationCallbacks(), m_Device, commandBufferImpl, false);
+        commandBuffer = (CommandBuffer*)AllocateObject<CommandBufferVal>(m_Device, m_Device, commandBufferImpl, false);
+
+    return result;
+}
+
+NRI_INLINE Result CommandAllocatorVal::CreateSecondaryCommandBuffer(CommandBuffer*& commandBuffer) {
+    RETURN_ON_FAILURE(&m_Device, m_Device.GetDesc().isSecondaryCommandBufferSupported, Result::UNSUPPORTED, "'isSecondaryCommandBufferSupported' is false");
+
+    CommandBuffer* commandBufferImpl;
+    const Result result = GetCoreInterface().CreateSecondaryCommandBuffer(*GetImpl(), commandBufferImpl);
+
+    if (result == Result::SUCCESS)
+        commandBuffer = (CommandBuffer*)AllocateObject<CommandBufferVal>(m_Device, m_Device, commandBufferImpl, false, true);
 
     return result;
 }
@@ -4,21 +4,69 @@
 
 namespace nri {
 
+struct CommandLogVal;
 struct DescriptorVal;
 struct PipelineVal;
 struct PipelineLayoutVal;
 
+// Barrier tracking: transitions are applied to the tracked resource states at "QueueSubmit"
+struct BufferTransitionVal {
+    BufferBarrierDesc desc;
+    const void* callSite;
+};
+
+struct TextureTransitionVal {
+    TextureBarrierDesc desc;
+    const void* callSite;
+};
+
 struct CommandBufferVal final : public ObjectVal {
-    CommandBufferVal(DeviceVal& device, CommandBuffer* commandBuffer, bool isWrapped)
+    CommandBufferVal(DeviceVal& device, CommandBuffer* commandBuffer, bool isWrapped, bool isSecondary = false)
         : ObjectVal(device, commandBuffer)
+        , m_BufferTransitions(device.GetStdAllocator())
+        , m_TextureTransitions(device.GetStdAllocator())
+        , m_ValidationCategories(device.GetValidationCategories())
         , m_IsRecordingStarted(isWrapped)
-        , m_IsWrapped(isWrapped) {
+        , m_IsWrapped(isWrapped)
+        , m_IsSecondary(isSecondary) {
     }
 
+    ~CommandBufferVal();
+
     inline CommandBuffer* GetImpl() const {
         return (CommandBuffer*)m_Impl;
     }
 
+    // Hides "ObjectVal::IsValidationEnabled" to take sampling into account
+    inline bool IsValidationEnabled(ValidationBits validationCategory) const {
+        return (m_ValidationCategories & validationCategory) != 0;
+    }
+
+    inline bool IsSecondary() const {
+        return m_IsSecondary;
+    }
+
+    inline bool IsRecordingStarted() const {
+        return m_IsRecordingStarted;
+    }
+
+    // Async validation: the replayed copy, which validates the logged commands on the validation thread
+    inline bool IsReplay() const {
+        return m_Owner != nullptr;
+    }
+
+    inline bool IsValidationPending() const {
+        return m_IsValidationPending;
+    }
+
+    inline void SetValidationPending(bool isValidationPending) {
+        m_IsValidationPending = isValidationPending;
+    }
+
+    inline ProfilerZoneState& GetProfilerZoneState() {
+        return m_ProfilerZoneState;
+    }
+
     inline void* GetNativeObject() const {
         return GetCoreInterface().GetCommandBufferNativeObject(*GetImpl());
     }
@@ -31,11 +79,16 @@ struct CommandBufferVal final : public ObjectVal {
         m_DepthStencil = nullptr;
     }
 
+    void ReplayCommandLog();
+    void ResolveTransitions() const;
+    void ReportMessage(Message messageType, const char* file, uint32_t line, const char* format, ...) const;
+
     //================================================================================================================
     // NRI
     //================================================================================================================
 
     Result Begin(const DescriptorPool* descriptorPool);
+    Result BeginSecondary(const DescriptorPool* descriptorPool, const InheritanceDesc& inheritanceDesc);
     Result End();
     void SetViewports(const Viewport* viewports, uint32_t viewportNum);
     void SetScissors(const Rect* rects, uint32_t rectNum);
@@ -62,6 +115,7 @@ struct CommandBufferVal final : public ObjectVal {
     void DrawIndexed(const DrawIndexedDesc& drawIndexedDesc);
     void DrawIndirect(const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset);
     void DrawIndexedIndirect(const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset);
+    void ExecuteCommandBuffers(const CommandBuffer* const* commandBuffers, uint32_t commandBufferNum, const bool* isRecordingStarted = nullptr); // async validation: snapshotted states
     void CopyBuffer(Buffer& dstBuffer, uint64_t dstOffset, const Buffer& srcBuffer, uint64_t srcOffset, uint64_t size);
     void CopyTexture(Texture& dstTexture, const TextureRegionDesc* dstRegionDesc, const Texture& srcTexture, const TextureRegionDesc* srcRegionDesc);
     void ResolveTexture(Texture& dstTexture, const TextureRegionDesc* dstRegionDesc, const Texture& srcTexture, const TextureRegionDesc* srcRegionDesc);
@@ -69,7 +123,7 @@ struct CommandBufferVal final : public ObjectVal {
     void ReadbackTextureToBuffer(Buffer& dstBuffer, const TextureDataLayoutDesc& dstDataLayoutDesc, const Texture& srcTexture, const TextureRegionDesc& srcRegionDesc);
     void Dispatch(const DispatchDesc& dispatchDesc);
     void DispatchIndirect(const Buffer& buffer, uint64_t offset);
-    void Barrier(const BarrierGroupDesc& barrierGroupDesc);
+    void Barrier(const BarrierGroupDesc& barrierGroupDesc, const void* callSite);
     void BeginQuery(QueryPool& queryPool, uint32_t offset);
     void EndQuery(QueryPool& queryPool, uint32_t offset);
     void CopyQueries(const QueryPool& queryPool, uint32_t offset, uint32_t num, Buffer& dstBuffer, uint64_t dstOffset);
@@ -89,7 +143,9 @@ struct CommandBufferVal final : public ObjectVal {
     void DrawMeshTasksIndirect(const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset);
 
 private:
+    void BeginValidation();
     void ValidateReadonlyDepthStencil();
+    void TrackBarriers(const BarrierGroupDesc& barrierGroupDesc, const void* callSite);
 
     std::array<DescriptorVal*, 16> m_RenderTargets = {};
     DescriptorVal* m_DepthStencil = nullptr;
@@ -97,9 +153,24 @@ private:
     PipelineVal* m_Pipeline = nullptr;
     uint32_t m_RenderTargetNum = 0;
     int32_t m_AnnotationStack = 0;
+    CommandLogVal* m_CommandLog = nullptr;             // async validation: created on the first logged recording
+    CommandBufferVal* m_Replay = nullptr;              // async validation: the copy, which replays "m_CommandLog"
+    CommandBufferVal* m_Owner = nullptr;               // async validation: set for the copy only
+    const char* m_OwnerDebugName = nullptr;            // async validation: the owner's name at "EndCommandBuffer" (lives in the log)
+    Vector<BufferTransitionVal> m_BufferTransitions;   // in order of recording
+    Vector<TextureTransitionVal> m_TextureTransitions; // in order of recording
+    uint32_t m_CommandIndex = 0;                       // async validation: the replayed command
+    ValidationBits m_ValidationCategories;             // sampled at "Begin"
+    ProfilerZoneState m_ProfilerZoneState;
+    std::atomic_bool m_IsValidationPending{false};     // async validation: the log is queued or being replayed
+    bool m_IsLogging = false;
     bool m_IsRecordingStarted = false;
     bool m_IsWrapped = false;
     bool m_IsRenderPass = false;
+    bool m_IsSecondary = false;
+    bool m_IsSecondaryCommandBuffersPass = false;
 };
 
 } // namespace nri
+
+NRI_OBJECT_POOL(nri::CommandBufferVal, COMMAND_BUFFER);
@@ -1,41 +1,209 @@
 // © 2021 NVIDIA Corporation
 
+#include <cstdarg>
+
 void ConvertGeometryObjectsVal(GeometryObject* destObjects, const GeometryObject* sourceObjects, uint32_t objectNum);
 
-static bool ValidateBufferBarrierDesc(const DeviceVal& device, uint32_t i, const BufferBarrierDesc& bufferBarrierDesc) {
+static bool ValidateBufferBarrierDesc(const CommandBufferVal& commandBuffer, uint32_t i, const BufferBarrierDesc& bufferBarrierDesc) {
     const BufferVal& bufferVal = *(const BufferVal*)bufferBarrierDesc.buffer;
 
-    RETURN_ON_FAILURE(&device, bufferBarrierDesc.buffer != nullptr, false, "'bufferBarrierDesc.buffers[%u].buffer' is NULL", i);
-    RETURN_ON_FAILURE(&device, IsAccessMaskSupported(bufferVal.GetDesc().usage, bufferBarrierDesc.before.access), false,
+    RETURN_ON_FAILURE(&commandBuffer, bufferBarrierDesc.buffer != nullptr, false, "'bufferBarrierDesc.buffers[%u].buffer' is NULL", i);
+    RETURN_ON_FAILURE(&commandBuffer, IsAccessMaskSupported(bufferVal.GetDesc().usage, bufferBarrierDesc.before.access), false,
         "'bufferBarrierDesc.buffers[%u].before' is not supported by the usage mask of the buffer ('%s')", i, bufferVal.GetDebugName());
-    RETURN_ON_FAILURE(&device, IsAccessMaskSupported(bufferVal.GetDesc().usage, bufferBarrierDesc.after.access), false,
+    RETURN_ON_FAILURE(&commandBuffer, IsAccessMaskSupported(bufferVal.GetDesc().usage, bufferBarrierDesc.after.access), false,
         "'bufferBarrierDesc.buffers[%u].after' is not supported by the usage mask of the buffer ('%s')", i, bufferVal.GetDebugName());
 
     return true;
 }
 
-static bool ValidateTextureBarrierDesc(const DeviceVal& device, uint32_t i, const TextureBarrierDesc& textureBarrierDesc) {
+static bool ValidateTextureBarrierDesc(const CommandBufferVal& commandBuffer, uint32_t i, const TextureBarrierDesc& textureBarrierDesc) {
     const TextureVal& textureVal = *(const TextureVal*)textureBarrierDesc.texture;
 
-    RETURN_ON_FAILURE(&device, textureBarrierDesc.texture != nullptr, false, "'bufferBarrierDesc.textures[%u].texture' is NULL", i);
-    RETURN_ON_FAILURE(&device, IsAccessMaskSupported(textureVal.GetDesc().usage, textureBarrierDesc.before.access), false,
+    RETURN_ON_FAILURE(&commandBuffer, textureBarrierDesc.texture != nullptr, false, "'bufferBarrierDesc.textures[%u].texture' is NULL", i);
+    RETURN_ON_FAILURE(&commandBuffer, IsAccessMaskSupported(textureVal.GetDesc().usage, textureBarrierDesc.before.access), false,
         "'bufferBarrierDesc.textures[%u].before' is not supported by the usage mask of the texture ('%s')", i, textureVal.GetDebugName());
-    RETURN_ON_FAILURE(&device, IsAccessMaskSupported(textureVal.GetDesc().usage, textureBarrierDesc.after.access), false,
+    RETURN_ON_FAILURE(&commandBuffer, IsAccessMaskSupported(textureVal.GetDesc().usage, textureBarrierDesc.after.access), false,
         "'bufferBarrierDesc.textures[%u].after' is not supported by the usage mask of the texture ('%s')", i, textureVal.GetDebugName());
-    RETURN_ON_FAILURE(&device, IsTextureLayoutSupported(textureVal.GetDesc().usage, textureBarrierDesc.before.layout), false,
+    RETURN_ON_FAILURE(&commandBuffer, IsTextureLayoutSupported(textureVal.GetDesc().usage, textureBarrierDesc.before.layout), false,
         "'bufferBarrierDesc.textures[%u].prevLayout' is not supported by the usage mask of the texture ('%s')", i, textureVal.GetDebugName());
-    RETURN_ON_FAILURE(&device, IsTextureLayoutSupported(textureVal.GetDesc().usage, textureBarrierDesc.after.layout), false,
+    RETURN_ON_FAILURE(&commandBuffer, IsTextureLayoutSupported(textureVal.GetDesc().usage, textureBarrierDesc.after.layout), false,
         "'bufferBarrierDesc.textures[%u].nextLayout' is not supported by the usage mask of the texture ('%s')", i, textureVal.GetDebugName());
 
     return true;
 }
 
+// A barrier between the same read-only states is redundant, a barrier between overlapping read-only states can be merged with the previous one
+static BarrierIssue GetBarrierIssue(AccessBits before, AccessBits after) {
+    constexpr AccessBits writeAccess = AccessBits::SHADER_RESOURCE_STORAGE | AccessBits::COLOR_ATTACHMENT | AccessBits::DEPTH_STENCIL_ATTACHMENT_WRITE
+        | AccessBits::COPY_DESTINATION | AccessBits::RESOLVE_DESTINATION | AccessBits::ACCELERATION_STRUCTURE_WRITE;
+
+    if ((before & writeAccess) != 0 || (after & writeAccess) != 0)
+        return BarrierIssue::MAX_NUM;
+
+    if (before == after)
+        return BarrierIssue::REDUNDANT;
+
+    if ((before & after) != 0)
+        return BarrierIssue::MERGEABLE;
+
+    return BarrierIssue::MAX_NUM;
+}
+
+static const char* GetBarrierIssueName(BarrierIssue barrierIssue) {
+    return barrierIssue == BarrierIssue::REDUNDANT ? "redundant" : "mergeable";
+}
+
+CommandBufferVal::~CommandBufferVal() {
+    m_Device.WaitForAsyncValidation(*this);
+
+    if (m_CommandLog) {
+        Destroy(m_Device.GetAllocationCallbacks(), m_CommandLog);
+        Destroy(m_Replay);
+    }
+}
+
+void CommandBufferVal::ReplayCommandLog() {
+    m_CommandLog->Replay(*m_Replay, m_Replay->m_CommandIndex);
+}
+
+void CommandBufferVal::ResolveTransitions() const {
+    ExclusiveScope lockScope(m_Device.GetResourceStateLock());
+
+    // Transitions recorded without validation are unknown
+    if (!IsValidationEnabled(ValidationBits::BARRIERS)) {
+        m_Device.InvalidateResourceStates();
+        return;
+    }
+
+    uint32_t epoch = m_Device.GetResourceStateEpoch();
+
+    for (const BufferTransitionVal& transition : m_BufferTransitions) {
+        const BufferBarrierDesc& desc = transition.desc;
+        BufferVal& bufferVal = *(BufferVal*)desc.buffer;
+        ResourceStateVal& state = bufferVal.GetState();
+
+        bool isMismatch = state.epoch == epoch && desc.before.access != AccessBits::UNKNOWN && desc.before.access != state.access;
+        if (isMismatch && m_Device.CountBarrierIssue(BarrierIssue::STATE_MISMATCH, transition.callSite))
+            REPORT_WARNING(&m_Device, "'before' doesn't match the tracked state of the buffer ('%s', call site = %p)", bufferVal.GetDebugName(), transition.callSite);
+
+        state = {desc.after.access, Layout::UNKNOWN, epoch};
+    }
+
+    for (const TextureTransitionVal& transition : m_TextureTransitions) {
+        const TextureBarrierDesc& desc = transition.desc;
+        TextureVal& textureVal = *(TextureVal*)desc.texture;
+        const TextureDesc& textureDesc = textureVal.GetDesc();
+
+        uint32_t mipEnd = desc.mipNum == REMAINING_MIPS ? textureDesc.mipNum : std::min((uint32_t)desc.mipOffset + desc.mipNum, (uint32_t)textureDesc.mipNum);
+        uint32_t layerEnd = desc.layerNum == REMAINING_LAYERS ? textureDesc.layerNum : std::min((uint32_t)desc.layerOffset + desc.layerNum, (uint32_t)textureDesc.layerNum);
+        bool isMismatchReported = false;
+
+        for (uint32_t layer = desc.layerOffset; layer < layerEnd; layer++) {
+            for (uint32_t mip = desc.mipOffset; mip < mipEnd; mip++) {
+                ResourceStateVal& state = textureVal.GetState((Dim_t)layer, (Mip_t)mip);
+
+                bool isMismatch = state.epoch == epoch && desc.before.access != AccessBits::UNKNOWN
+                    && (desc.before.access != state.access || (desc.before.layout != Layout::UNKNOWN && desc.before.layout != state.layout));
+                if (isMismatch && !isMismatchReported) {
+                    isMismatchReported = true;
+
+                    if (m_Device.CountBarrierIssue(BarrierIssue::STATE_MISMATCH, transition.callSite))
+                        REPORT_WARNING(&m_Device, "'before' doesn't match the tracked state of the texture ('%s', mip = %u, layer = %u, call site = %p)", textureVal.GetDebugName(), mip, layer, transition.callSite);
+                }
+
+                state = {desc.after.access, desc.after.layout, epoch};
+            }
+        }
+    }
+}
+
+void CommandBufferVal::TrackBarriers(const BarrierGroupDesc& barrierGroupDesc, const void* callSite) {
+    // Async validation: transitions are resolved by the owner
+    CommandBufferVal& owner = IsReplay() ? *m_Owner : *this;
+
+    for (uint32_t i = 0; i < barrierGroupDesc.bufferNum; i++) {
+        const BufferBarrierDesc& bufferBarrierDesc = barrierGroupDesc.buffers[i];
+
+        BarrierIssue barrierIssue = GetBarrierIssue(bufferBarrierDesc.before.access, bufferBarrierDesc.after.access);
+        if (barrierIssue != BarrierIssue::MAX_NUM && m_Device.CountBarrierIssue(barrierIssue, callSite)) {
+            const BufferVal& bufferVal = *(const BufferVal*)bufferBarrierDesc.buffer;
+            REPORT_WARNING(this, "'barrierGroupDesc.buffers[%u]' is %s ('%s', call site = %p)", i, GetBarrierIssueName(barrierIssue), bufferVal.GetDebugName(), callSite);
+        }
+
+        owner.m_BufferTransitions.push_back({bufferBarrierDesc, callSite});
+    }
+
+    for (uint32_t i = 0; i < barrierGroupDesc.textureNum; i++) {
+        const TextureBarrierDesc& textureBarrierDesc = barrierGroupDesc.textures[i];
+
+        BarrierIssue barrierIssue = BarrierIssue::MAX_NUM;
+        if (textureBarrierDesc.before.layout == textureBarrierDesc.after.layout)
+            barrierIssue = GetBarrierIssue(textureBarrierDesc.before.access, textureBarrierDesc.after.access);
+
+        if (barrierIssue != BarrierIssue::MAX_NUM && m_Device.CountBarrierIssue(barrierIssue, callSite)) {
+            const TextureVal& textureVal = *(const TextureVal*)textureBarrierDesc.texture;
+            REPORT_WARNING(this, "'barrierGroupDesc.textures[%u]' is %s ('%s', call site = %p)", i, GetBarrierIssueName(barrierIssue), textureVal.GetDebugName(), callSite);
+        }
+
+        owner.m_TextureTransitions.push_back({textureBarrierDesc, callSite});
+    }
+}
+
+void CommandBufferVal::ReportMessage(Message messageType, const char* file, uint32_t line, const char* format, ...) const {
+    char message[MAX_MESSAGE_LENGTH];
+
+    va_list argptr;
+    va_start(argptr, format);
+    vsnprintf(message, sizeof(message), format, argptr);
+    va_end(argptr);
+
+    // Async validation: the command is identified by its index in the recording
+    if (IsReplay()) {
+        const char* name = m_OwnerDebugName;
+        m_Device.ReportMessage(messageType, file, line, "'%s', command #%u: %s", name ? name : "unnamed", m_CommandIndex, message);
+    } else
+        m_Device.ReportMessage(messageType, file, line, "%s", message);
+}
+
+NRI_INLINE void CommandBufferVal::BeginValidation() {
+    // The log can't be reused until the previous recording is validated
+    m_Device.WaitForAsyncValidation(*this);
+
+    m_BufferTransitions.clear();
+    m_TextureTransitions.clear();
+
+    ValidationBits validationCategories = m_Device.GetCommandBufferValidationCategories();
+    m_IsLogging = m_Device.IsAsyncValidationEnabled() && validationCategories != ValidationBits::NONE;
+
+    if (m_IsLogging) {
+        if (!m_CommandLog) {
+            m_CommandLog = Allocate<CommandLogVal>(m_Device.GetAllocationCallbacks(), m_Device);
+            m_Replay = AllocateObject<CommandBufferVal>(m_Device, m_Device, GetImpl(), false, m_IsSecondary);
+            m_Replay->m_Owner = this;
+        }
+
+        m_CommandLog->Reset();
+
+        // Checks are skipped while recording
+        m_Replay->m_ValidationCategories = validationCategories;
+        m_ValidationCategories = ValidationBits::NONE;
+    } else
+        m_ValidationCategories = validationCategories;
+}
+
 NRI_INLINE Result CommandBufferVal::Begin(const DescriptorPool* descriptorPool) {
-    RETURN_ON_FAILURE(&m_Device, !m_IsRecordingStarted, Result::FAILURE, "already in the recording state");
+    if (!IsReplay())
+        BeginValidation();
+
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.Begin(descriptorPool); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, !m_IsRecordingStarted, Result::FAILURE, "already in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondary, Result::FAILURE, "a secondary command buffer must be started with 'BeginSecondaryCommandBuffer'");
 
     DescriptorPool* descriptorPoolImpl = NRI_GET_IMPL(DescriptorPool, descriptorPool);
 
-    Result result = GetCoreInterface().BeginCommandBuffer(*GetImpl(), descriptorPoolImpl);
+    Result result = IsReplay() ? Result::SUCCESS : GetCoreInterface().BeginCommandBuffer(*GetImpl(), descriptorPoolImpl);
     if (result == Result::SUCCESS)
         m_IsRecordingStarted = true;
 
@@ -47,121 +215,244 @@ NRI_INLINE Result CommandBufferVal::Begin(const DescriptorPool* descriptorPool)
     return result;
 }
 
+NRI_INLINE Result CommandBufferVal::BeginSecondary(const DescriptorPool* descriptorPool, const InheritanceDesc& inheritanceDesc) {
+    if (!IsReplay())
+        BeginValidation();
+
+    if (m_IsLogging) {
+        InheritanceDesc inheritanceDescCopy = inheritanceDesc;
+        inheritanceDescCopy.colorFormats = m_CommandLog->Copy(inheritanceDesc.colorFormats, inheritanceDesc.colorNum);
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.BeginSecondary(descriptorPool, inheritanceDescCopy); });
+    }
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, !m_IsRecordingStarted, Result::FAILURE, "already in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, m_IsSecondary, Result::FAILURE, "not a secondary command buffer");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !inheritanceDesc.colorNum || inheritanceDesc.colorFormats, Result::INVALID_ARGUMENT, "'inheritanceDesc.colorFormats' is NULL");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, inheritanceDesc.colorNum <= m_RenderTargets.size(), Result::INVALID_ARGUMENT, "'inheritanceDesc.colorNum' is too big");
+
+    DescriptorPool* descriptorPoolImpl = NRI_GET_IMPL(DescriptorPool, descriptorPool);
+
+    Result result = IsReplay() ? Result::SUCCESS : GetCoreInterface().BeginSecondaryCommandBuffer(*GetImpl(), descriptorPoolImpl, inheritanceDesc);
+    if (result != Result::SUCCESS)
+        return result;
+
+    m_IsRecordingStarted = true;
+    m_IsRenderPass = true; // secondary command buffers are executed inside a rendering pass
+
+    m_Pipeline = nullptr;
+    m_PipelineLayout = nullptr;
+
+    ResetAttachments();
+
+    return result;
+}
+
 NRI_INLINE Result CommandBufferVal::End() {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, Result::FAILURE, "not in the recording state");
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.End(); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, Result::FAILURE, "not in the recording state");
+
+    if (IsValidationEnabled(ValidationBits::COMMANDS)) {
+        if (m_AnnotationStack > 0)
+            REPORT_ERROR(this, "'CmdBeginAnnotation' is called more times than 'CmdEndAnnotation'");
+        else if (m_AnnotationStack < 0)
+            REPORT_ERROR(this, "'CmdEndAnnotation' is called more times than 'CmdBeginAnnotation'");
+    }
 
-    if (m_AnnotationStack > 0)
-        REPORT_ERROR(&m_Device, "'CmdBeginAnnotation' is called more times than 'CmdEndAnnotation'");
-    else if (m_AnnotationStack < 0)
-        REPORT_ERROR(&m_Device, "'CmdEndAnnotation' is called more times than 'CmdBeginAnnotation'");
+    if (m_IsSecondary)
+        m_IsRenderPass = false;
 
-    Result result = GetCoreInterface().EndCommandBuffer(*GetImpl());
+    Result result = IsReplay() ? Result::SUCCESS : GetCoreInterface().EndCommandBuffer(*GetImpl());
     if (result == Result::SUCCESS)
         m_IsRecordingStarted = m_IsWrapped;
 
+    // Async validation: the log is complete, checks outside of the recording are synchronous
+    if (m_IsLogging) {
+        // The name can be changed on another thread while the log is replayed
+        const char* name = GetDebugName();
+        m_Replay->m_OwnerDebugName = name ? m_CommandLog->Copy(name, strlen(name) + 1) : nullptr;
+
+        m_IsLogging = false;
+        m_ValidationCategories = m_Replay->m_ValidationCategories;
+        m_Device.QueueAsyncValidation(*this);
+    }
+
     return result;
 }
 
 NRI_INLINE void CommandBufferVal::SetViewports(const Viewport* viewports, uint32_t viewportNum) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    if (m_IsLogging) {
+        const Viewport* viewportsCopy = m_CommandLog->Copy(viewports, viewportNum);
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.SetViewports(viewportsCopy, viewportNum); });
+    }
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
 
     if (!viewportNum)
         return;
 
-    RETURN_ON_FAILURE(&m_Device, viewports, ReturnVoid(), "'viewports' is NULL");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, viewports, ReturnVoid(), "'viewports' is NULL");
 
     const DeviceDesc& deviceDesc = m_Device.GetDesc();
     if (!deviceDesc.isViewportOriginBottomLeftSupported) {
         for (uint32_t i = 0; i < viewportNum; i++) {
-            RETURN_ON_FAILURE(&m_Device, !viewports[i].originBottomLeft, ReturnVoid(), "'isViewportOriginBottomLeftSupported' is false");
+            RETURN_ON_FAILURE_IF(this, COMMANDS, !viewports[i].originBottomLeft, ReturnVoid(), "'isViewportOriginBottomLeftSupported' is false");
         }
     }
 
+    if (IsReplay())
+        return;
+
     GetCoreInterface().CmdSetViewports(*GetImpl(), viewports, viewportNum);
 }
 
 NRI_INLINE void CommandBufferVal::SetScissors(const Rect* rects, uint32_t rectNum) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    if (m_IsLogging) {
+        const Rect* rectsCopy = m_CommandLog->Copy(rects, rectNum);
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.SetScissors(rectsCopy, rectNum); });
+    }
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
 
     if (!rectNum)
         return;
 
-    RETURN_ON_FAILURE(&m_Device, rects, ReturnVoid(), "'rects' is NULL");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, rects, ReturnVoid(), "'rects' is NULL");
+
+    if (IsReplay())
+        return;
 
     GetCoreInterface().CmdSetScissors(*GetImpl(), rects, rectNum);
 }
 
 NRI_INLINE void CommandBufferVal::SetDepthBounds(float boundsMin, float boundsMax) {
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.SetDepthBounds(boundsMin, boundsMax); });
+
     const DeviceDesc& deviceDesc = m_Device.GetDesc();
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, deviceDesc.isDepthBoundsTestSupported, ReturnVoid(), "'isDepthBoundsTestSupported' is false");
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, deviceDesc.isDepthBoundsTestSupported, ReturnVoid(), "'isDepthBoundsTestSupported' is false");
+
+    if (IsReplay())
+        return;
 
     GetCoreInterface().CmdSetDepthBounds(*GetImpl(), boundsMin, boundsMax);
 }
 
 NRI_INLINE void CommandBufferVal::SetStencilReference(uint8_t frontRef, uint8_t backRef) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.SetStencilReference(frontRef, backRef); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+
+    if (IsReplay())
+        return;
 
     GetCoreInterface().CmdSetStencilReference(*GetImpl(), frontRef, backRef);
 }
 
 NRI_INLINE void CommandBufferVal::SetSampleLocations(const SampleLocation* locations, Sample_t locationNum, Sample_t sampleNum) {
+    if (m_IsLogging) {
+        const SampleLocation* locationsCopy = m_CommandLog->Copy(locations, locationNum);
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.SetSampleLocations(locationsCopy, locationNum, sampleNum); });
+    }
+
     const DeviceDesc& deviceDesc = m_Device.GetDesc();
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, deviceDesc.sampleLocationsTier != 0, ReturnVoid(), "'sampleLocationsTier > 0' required");
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, deviceDesc.sampleLocationsTier != 0, ReturnVoid(), "'sampleLocationsTier > 0' required");
+
+    if (IsReplay())
+        return;
 
     GetCoreInterface().CmdSetSampleLocations(*GetImpl(), locations, locationNum, sampleNum);
 }
 
 NRI_INLINE void CommandBufferVal::SetBlendConstants(const Color32f& color) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.SetBlendConstants(color); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+
+    if (IsReplay())
+        return;
 
     GetCoreInterface().CmdSetBlendConstants(*GetImpl(), color);
 }
 
 NRI_INLINE void CommandBufferVal::SetShadingRate(const ShadingRateDesc& shadingRateDesc) {
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.SetShadingRate(shadingRateDesc); });
+
     const DeviceDesc& deviceDesc = m_Device.GetDesc();
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, deviceDesc.shadingRateTier, ReturnVoid(), "'shadingRateTier > 0' required");
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, deviceDesc.shadingRateTier, ReturnVoid(), "'shadingRateTier > 0' required");
+
+    if (IsReplay())
+        return;
 
     GetCoreInterface().CmdSetShadingRate(*GetImpl(), shadingRateDesc);
 }
 
 NRI_INLINE void CommandBufferVal::SetDepthBias(const DepthBiasDesc& depthBiasDesc) {
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.SetDepthBias(depthBiasDesc); });
+
     const DeviceDesc& deviceDesc = m_Device.GetDesc();
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, deviceDesc.isDynamicDepthBiasSupported, ReturnVoid(), "'isDynamicDepthBiasSupported' is false");
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, deviceDesc.isDynamicDepthBiasSupported, ReturnVoid(), "'isDynamicDepthBiasSupported' is false");
+
+    if (IsReplay())
+        return;
 
     GetCoreInterface().CmdSetDepthBias(*GetImpl(), depthBiasDesc);
 }
 
 NRI_INLINE void CommandBufferVal::ClearAttachments(const ClearDesc* clearDescs, uint32_t clearDescNum, const Rect* rects, uint32_t rectNum) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, m_IsRenderPass, ReturnVoid(), "must be called inside 'CmdBeginRendering/CmdEndRendering'");
+    if (m_IsLogging) {
+        const ClearDesc* clearDescsCopy = m_CommandLog->Copy(clearDescs, clearDescNum);
+        const Rect* rectsCopy = m_CommandLog->Copy(rects, rectNum);
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.ClearAttachments(clearDescsCopy, clearDescNum, rectsCopy, rectNum); });
+    }
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondary, ReturnVoid(), "can't be called in a secondary command buffer");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, m_IsRenderPass, ReturnVoid(), "must be called inside 'CmdBeginRendering/CmdEndRendering'");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondaryCommandBuffersPass, ReturnVoid(), "the pass contents must be recorded in secondary command buffers ('AttachmentsDesc::secondaryCommandBuffers = true')");
 
     const DeviceDesc& deviceDesc = m_Device.GetDesc();
     for (uint32_t i = 0; i < clearDescNum; i++) {
-        RETURN_ON_FAILURE(&m_Device, (clearDescs[i].planes & (PlaneBits::COLOR | PlaneBits::DEPTH | PlaneBits::STENCIL)) != 0, ReturnVoid(), "'[%u].planes' is not COLOR, DEPTH or STENCIL", i);
+        RETURN_ON_FAILURE_IF(this, COMMANDS, (clearDescs[i].planes & (PlaneBits::COLOR | PlaneBits::DEPTH | PlaneBits::STENCIL)) != 0, ReturnVoid(), "'[%u].planes' is not COLOR, DEPTH or STENCIL", i);
 
         if (clearDescs[i].planes & PlaneBits::COLOR) {
-            RETURN_ON_FAILURE(&m_Device, clearDescs[i].colorAttachmentIndex < deviceDesc.colorAttachmentMaxNum, ReturnVoid(), "'[%u].colorAttachmentIndex = %u' is out of bounds", i, clearDescs[i].colorAttachmentIndex);
-            RETURN_ON_FAILURE(&m_Device, m_RenderTargets[clearDescs[i].colorAttachmentIndex], ReturnVoid(), "'[%u].colorAttachmentIndex = %u' references a NULL COLOR attachment", i, clearDescs[i].colorAttachmentIndex);
+            RETURN_ON_FAILURE_IF(this, COMMANDS, clearDescs[i].colorAttachmentIndex < deviceDesc.colorAttachmentMaxNum, ReturnVoid(), "'[%u].colorAttachmentIndex = %u' is out of bounds", i, clearDescs[i].colorAttachmentIndex);
+            RETURN_ON_FAILURE_IF(this, COMMANDS, m_RenderTargets[clearDescs[i].colorAttachmentIndex], ReturnVoid(), "'[%u].colorAttachmentIndex = %u' references a NULL COLOR attachment", i, clearDescs[i].colorAttachmentIndex);
         }
 
         if (clearDescs[i].planes & (PlaneBits::DEPTH | PlaneBits::STENCIL))
-            RETURN_ON_FAILURE(&m_Device, m_DepthStencil, ReturnVoid(), "DEPTH_STENCIL attachment is NULL", i);
+            RETURN_ON_FAILURE_IF(this, COMMANDS, m_DepthStencil, ReturnVoid(), "DEPTH_STENCIL attachment is NULL", i);
 
         if (clearDescs[i].colorAttachmentIndex != 0)
-            RETURN_ON_FAILURE(&m_Device, (clearDescs[i].planes & PlaneBits::COLOR), ReturnVoid(), "'[%u].planes' is not COLOR, but `colorAttachmentIndex != 0`", i);
+            RETURN_ON_FAILURE_IF(this, COMMANDS, (clearDescs[i].planes & PlaneBits::COLOR), ReturnVoid(), "'[%u].planes' is not COLOR, but `colorAttachmentIndex != 0`", i);
     }
 
+    if (IsReplay())
+        return;
+
     GetCoreInterface().CmdClearAttachments(*GetImpl(), clearDescs, clearDescNum, rects, rectNum);
 }
 
 NRI_INLINE void CommandBufferVal::ClearStorageBuffer(const ClearStorageBufferDesc& clearDesc) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
-    RETURN_ON_FAILURE(&m_Device, clearDesc.storageBuffer, ReturnVoid(), "'.storageBuffer' is NULL");
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.ClearStorageBuffer(clearDesc); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondary, ReturnVoid(), "can't be called in a secondary command buffer");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, clearDesc.storageBuffer, ReturnVoid(), "'.storageBuffer' is NULL");
+
+    if (IsReplay())
+        return;
 
     auto clearDescImpl = clearDesc;
     clearDescImpl.storageBuffer = NRI_GET_IMPL(Descriptor, clearDesc.storageBuffer);
@@ -170,9 +461,16 @@ NRI_INLINE void CommandBufferVal::ClearStorageBuffer(const ClearStorageBufferDes
 }
 
 NRI_INLINE void CommandBufferVal::ClearStorageTexture(const ClearStorageTextureDesc& clearDesc) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
-    RETURN_ON_FAILURE(&m_Device, clearDesc.storageTexture, ReturnVoid(), "'.storageTexture' is NULL");
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.ClearStorageTexture(clearDesc); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondary, ReturnVoid(), "can't be called in a secondary command buffer");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, clearDesc.storageTexture, ReturnVoid(), "'.storageTexture' is NULL");
+
+    if (IsReplay())
+        return;
 
     auto clearDescImpl = clearDesc;
     clearDescImpl.storageTexture = NRI_GET_IMPL(Descriptor, clearDesc.storageTexture);
@@ -181,12 +479,18 @@ NRI_INLINE void CommandBufferVal::ClearStorageTexture(const ClearStorageTextureD
 }
 
 NRI_INLINE void CommandBufferVal::BeginRendering(const AttachmentsDesc& attachmentsDesc) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "'CmdBeginRendering' has been already called");
+    if (m_IsLogging) {
+        AttachmentsDesc attachmentsDescCopy = attachmentsDesc;
+        attachmentsDescCopy.colors = m_CommandLog->Copy(attachmentsDesc.colors, attachmentsDesc.colorNum);
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.BeginRendering(attachmentsDescCopy); });
+    }
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "'CmdBeginRendering' has been already called");
 
     const DeviceDesc& deviceDesc = m_Device.GetDesc();
     if (attachmentsDesc.shadingRate)
-        RETURN_ON_FAILURE(&m_Device, deviceDesc.shadingRateTier, ReturnVoid(), "'shadingRateTier >= 2' required");
+        RETURN_ON_FAILURE_IF(this, COMMANDS, deviceDesc.shadingRateTier, ReturnVoid(), "'shadingRateTier >= 2' required");
 
     Scratch<Descriptor*> colors = AllocateScratch(m_Device, Descriptor*, attachmentsDesc.colorNum);
     for (uint32_t i = 0; i < attachmentsDesc.colorNum; i++)
@@ -199,6 +503,7 @@ NRI_INLINE void CommandBufferVal::BeginRendering(const AttachmentsDesc& attachme
     attachmentsDescImpl.colorNum = attachmentsDesc.colorNum;
 
     m_IsRenderPass = true;
+    m_IsSecondaryCommandBuffersPass = attachmentsDesc.secondaryCommandBuffers;
     m_RenderTargetNum = attachmentsDesc.colors ? attachmentsDesc.colorNum : 0;
 
     size_t i = 0;
@@ -214,23 +519,44 @@ NRI_INLINE void CommandBufferVal::BeginRendering(const AttachmentsDesc& attachme
 
     ValidateReadonlyDepthStencil();
 
+    if (IsReplay())
+        return;
+
     GetCoreInterface().CmdBeginRendering(*GetImpl(), attachmentsDescImpl);
 }
 
 NRI_INLINE void CommandBufferVal::EndRendering() {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, m_IsRenderPass, ReturnVoid(), "'CmdBeginRendering' has not been called");
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.EndRendering(); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, m_IsRenderPass, ReturnVoid(), "'CmdBeginRendering' has not been called");
+
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondary, ReturnVoid(), "can't be called in a secondary command buffer");
 
     m_IsRenderPass = false;
+    m_IsSecondaryCommandBuffersPass = false;
 
     ResetAttachments();
 
+    if (IsReplay())
+        return;
+
     GetCoreInterface().CmdEndRendering(*GetImpl());
 }
 
 NRI_INLINE void CommandBufferVal::SetVertexBuffers(uint32_t baseSlot, uint32_t bufferNum, const Buffer* const* buffers, const uint64_t* offsets) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, m_Pipeline, ReturnVoid(), "'SetPipeline' has not been called");
+    if (m_IsLogging) {
+        const Buffer* const* buffersCopy = m_CommandLog->Copy(buffers, bufferNum);
+        const uint64_t* offsetsCopy = m_CommandLog->Copy(offsets, bufferNum);
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.SetVertexBuffers(baseSlot, bufferNum, buffersCopy, offsetsCopy); });
+    }
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, m_Pipeline, ReturnVoid(), "'SetPipeline' has not been called");
+
+    if (IsReplay())
+        return;
 
     Scratch<Buffer*> buffersImpl = AllocateScratch(m_Device, Buffer*, bufferNum);
     for (uint32_t i = 0; i < bufferNum; i++)
@@ -240,7 +566,13 @@ NRI_INLINE void CommandBufferVal::SetVertexBuffers(uint32_t baseSlot, uint32_t b
 }
 
 NRI_INLINE void CommandBufferVal::SetIndexBuffer(const Buffer& buffer, uint64_t offset, IndexType indexType) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &buffer](CommandBufferVal& replay) { replay.SetIndexBuffer(buffer, offset, indexType); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+
+    if (IsReplay())
+        return;
 
     Buffer* bufferImpl = NRI_GET_IMPL(Buffer, &buffer);
 
@@ -248,17 +580,26 @@ NRI_INLINE void CommandBufferVal::SetIndexBuffer(const Buffer& buffer, uint64_t
 }
 
 NRI_INLINE void CommandBufferVal::SetPipelineLayout(const PipelineLayout& pipelineLayout) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &pipelineLayout](CommandBufferVal& replay) { replay.SetPipelineLayout(pipelineLayout); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
 
     PipelineLayout* pipelineLayoutImpl = NRI_GET_IMPL(PipelineLayout, &pipelineLayout);
 
     m_PipelineLayout = (PipelineLayoutVal*)&pipelineLayout;
 
+    if (IsReplay())
+        return;
+
     GetCoreInterface().CmdSetPipelineLayout(*GetImpl(), *pipelineLayoutImpl);
 }
 
 NRI_INLINE void CommandBufferVal::SetPipeline(const Pipeline& pipeline) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &pipeline](CommandBufferVal& replay) { replay.SetPipeline(pipeline); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
 
     Pipeline* pipelineImpl = NRI_GET_IMPL(Pipeline, &pipeline);
 
@@ -266,11 +607,20 @@ NRI_INLINE void CommandBufferVal::SetPipeline(const Pipeline& pipeline) {
 
     ValidateReadonlyDepthStencil();
 
+    if (IsReplay())
+        return;
+
     GetCoreInterface().CmdSetPipeline(*GetImpl(), *pipelineImpl);
 }
 
 NRI_INLINE void CommandBufferVal::SetDescriptorPool(const DescriptorPool& descriptorPool) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &descriptorPool](CommandBufferVal& replay) { replay.SetDescriptorPool(descriptorPool); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+
+    if (IsReplay())
+        return;
 
     DescriptorPool* descriptorPoolImpl = NRI_GET_IMPL(DescriptorPool, &descriptorPool);
 
@@ -278,8 +628,14 @@ NRI_INLINE void CommandBufferVal::SetDescriptorPool(const DescriptorPool& descri
 }
 
 NRI_INLINE void CommandBufferVal::SetDescriptorSet(uint32_t setIndex, const DescriptorSet& descriptorSet, const uint32_t* dynamicConstantBufferOffsets) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, m_PipelineLayout, ReturnVoid(), "'SetPipelineLayout' has not been called");
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &descriptorSet](CommandBufferVal& replay) { replay.SetDescriptorSet(setIndex, descriptorSet, nullptr); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, DESCRIPTORS, m_PipelineLayout, ReturnVoid(), "'SetPipelineLayout' has not been called");
+
+    if (IsReplay())
+        return;
 
     DescriptorSet* descriptorSetImpl = NRI_GET_IMPL(DescriptorSet, &descriptorSet);
 
@@ -287,18 +643,30 @@ NRI_INLINE void CommandBufferVal::SetDescriptorSet(uint32_t setIndex, const Desc
 }
 
 NRI_INLINE void CommandBufferVal::SetRootConstants(uint32_t rootConstantIndex, const void* data, uint32_t size) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, m_PipelineLayout, ReturnVoid(), "'SetPipelineLayout' has not been called");
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.SetRootConstants(rootConstantIndex, nullptr, size); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, DESCRIPTORS, m_PipelineLayout, ReturnVoid(), "'SetPipelineLayout' has not been called");
+
+    if (IsReplay())
+        return;
 
     GetCoreInterface().CmdSetRootConstants(*GetImpl(), rootConstantIndex, data, size);
 }
 
 NRI_INLINE void CommandBufferVal::SetRootDescriptor(uint32_t rootDescriptorIndex, Descriptor& descriptor) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, m_PipelineLayout, ReturnVoid(), "'SetPipelineLayout' has not been called");
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &descriptor](CommandBufferVal& replay) { replay.SetRootDescriptor(rootDescriptorIndex, descriptor); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, DESCRIPTORS, m_PipelineLayout, ReturnVoid(), "'SetPipelineLayout' has not been called");
 
     const DescriptorVal& descriptorVal = (DescriptorVal&)descriptor;
-    RETURN_ON_FAILURE(&m_Device, descriptorVal.IsBufferView(), ReturnVoid(), "'descriptor' must be a buffer view");
+    RETURN_ON_FAILURE_IF(this, DESCRIPTORS, descriptorVal.IsBufferView(), ReturnVoid(), "'descriptor' must be a buffer view");
+
+    if (IsReplay())
+        return;
 
     Descriptor* descriptorImpl = NRI_GET_IMPL(Descriptor, &descriptor);
 
@@ -306,24 +674,45 @@ NRI_INLINE void CommandBufferVal::SetRootDescriptor(uint32_t rootDescriptorIndex
 }
 
 NRI_INLINE void CommandBufferVal::Draw(const DrawDesc& drawDesc) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, m_IsRenderPass, ReturnVoid(), "must be called inside 'CmdBeginRendering/CmdEndRendering'");
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.Draw(drawDesc); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, m_IsRenderPass, ReturnVoid(), "must be called inside 'CmdBeginRendering/CmdEndRendering'");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondaryCommandBuffersPass, ReturnVoid(), "the pass contents must be recorded in secondary command buffers ('AttachmentsDesc::secondaryCommandBuffers = true')");
+
+    if (IsReplay())
+        return;
 
     GetCoreInterface().CmdDraw(*GetImpl(), drawDesc);
 }
 
 NRI_INLINE void CommandBufferVal::DrawIndexed(const DrawIndexedDesc& drawIndexedDesc) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, m_IsRenderPass, ReturnVoid(), "must be called inside 'CmdBeginRendering/CmdEndRendering'");
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.DrawIndexed(drawIndexedDesc); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, m_IsRenderPass, ReturnVoid(), "must be called inside 'CmdBeginRendering/CmdEndRendering'");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondaryCommandBuffersPass, ReturnVoid(), "the pass contents must be recorded in secondary command buffers ('AttachmentsDesc::secondaryCommandBuffers = true')");
+
+    if (IsReplay())
+        return;
 
     GetCoreInterface().CmdDrawIndexed(*GetImpl(), drawIndexedDesc);
 }
 
 NRI_INLINE void CommandBufferVal::DrawIndirect(const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset) {
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &buffer](CommandBufferVal& replay) { replay.DrawIndirect(buffer, offset, drawNum, stride, countBuffer, countBufferOffset); });
+
     const DeviceDesc& deviceDesc = m_Device.GetDesc();
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, m_IsRenderPass, ReturnVoid(), "must be called inside 'CmdBeginRendering/CmdEndRendering'");
-    RETURN_ON_FAILURE(&m_Device, !countBuffer || deviceDesc.isDrawIndirectCountSupported, ReturnVoid(), "'countBuffer' is not supported");
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, m_IsRenderPass, ReturnVoid(), "must be called inside 'CmdBeginRendering/CmdEndRendering'");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondaryCommandBuffersPass, ReturnVoid(), "the pass contents must be recorded in secondary command buffers ('AttachmentsDesc::secondaryCommandBuffers = true')");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !countBuffer || deviceDesc.isDrawIndirectCountSupported, ReturnVoid(), "'countBuffer' is not supported");
+
+    if (IsReplay())
+        return;
 
     Buffer* bufferImpl = NRI_GET_IMPL(Buffer, &buffer);
     Buffer* countBufferImpl = NRI_GET_IMPL(Buffer, countBuffer);
@@ -332,10 +721,17 @@ NRI_INLINE void CommandBufferVal::DrawIndirect(const Buffer& buffer, uint64_t of
 }
 
 NRI_INLINE void CommandBufferVal::DrawIndexedIndirect(const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset) {
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &buffer](CommandBufferVal& replay) { replay.DrawIndexedIndirect(buffer, offset, drawNum, stride, countBuffer, countBufferOffset); });
+
     const DeviceDesc& deviceDesc = m_Device.GetDesc();
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, m_IsRenderPass, ReturnVoid(), "must be called inside 'CmdBeginRendering/CmdEndRendering'");
-    RETURN_ON_FAILURE(&m_Device, !countBuffer || deviceDesc.isDrawIndirectCountSupported, ReturnVoid(), "'countBuffer' is not supported");
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, m_IsRenderPass, ReturnVoid(), "must be called inside 'CmdBeginRendering/CmdEndRendering'");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondaryCommandBuffersPass, ReturnVoid(), "the pass contents must be recorded in secondary command buffers ('AttachmentsDesc::secondaryCommandBuffers = true')");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !countBuffer || deviceDesc.isDrawIndirectCountSupported, ReturnVoid(), "'countBuffer' is not supported");
+
+    if (IsReplay())
+        return;
 
     Buffer* bufferImpl = NRI_GET_IMPL(Buffer, &buffer);
     Buffer* countBufferImpl = NRI_GET_IMPL(Buffer, countBuffer);
@@ -343,17 +739,61 @@ NRI_INLINE void CommandBufferVal::DrawIndexedIndirect(const Buffer& buffer, uint
     GetCoreInterface().CmdDrawIndexedIndirect(*GetImpl(), *bufferImpl, offset, drawNum, stride, countBufferImpl, countBufferOffset);
 }
 
+NRI_INLINE void CommandBufferVal::ExecuteCommandBuffers(const CommandBuffer* const* commandBuffers, uint32_t commandBufferNum, const bool* isRecordingStarted) {
+    if (m_IsLogging) {
+        // Secondary command buffers can be re-recorded by the time the log gets replayed, i.e. their states are snapshotted
+        Scratch<bool> isRecordingStarted = AllocateScratch(m_Device, bool, commandBufferNum);
+        for (uint32_t i = 0; i < commandBufferNum; i++)
+            isRecordingStarted[i] = commandBuffers[i] && ((CommandBufferVal*)commandBuffers[i])->IsRecordingStarted();
+
+        const CommandBuffer* const* commandBuffersCopy = m_CommandLog->Copy(commandBuffers, commandBufferNum);
+        const bool* isRecordingStartedCopy = m_CommandLog->Copy((const bool*)isRecordingStarted, commandBufferNum);
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.ExecuteCommandBuffers(commandBuffersCopy, commandBufferNum, isRecordingStartedCopy); });
+    }
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondary, ReturnVoid(), "can't be called in a secondary command buffer");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, m_IsRenderPass, ReturnVoid(), "must be called inside 'CmdBeginRendering/CmdEndRendering'");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, m_IsSecondaryCommandBuffersPass, ReturnVoid(), "'AttachmentsDesc::secondaryCommandBuffers' must be true");
+
+    Scratch<CommandBuffer*> commandBuffersImpl = AllocateScratch(m_Device, CommandBuffer*, commandBufferNum);
+    for (uint32_t i = 0; i < commandBufferNum; i++) {
+        const CommandBufferVal* commandBufferVal = (CommandBufferVal*)commandBuffers[i];
+        RETURN_ON_FAILURE_IF(this, COMMANDS, commandBufferVal, ReturnVoid(), "'commandBuffers[%u]' is NULL", i);
+        RETURN_ON_FAILURE_IF(this, COMMANDS, commandBufferVal->IsSecondary(), ReturnVoid(), "'commandBuffers[%u]' is not a secondary command buffer", i);
+        bool isSecondaryRecordingStarted = isRecordingStarted ? isRecordingStarted[i] : commandBufferVal->IsRecordingStarted();
+        RETURN_ON_FAILURE_IF(this, COMMANDS, !isSecondaryRecordingStarted, ReturnVoid(), "'commandBuffers[%u]' is in the recording state", i);
+
+        commandBuffersImpl[i] = commandBufferVal->GetImpl();
+    }
+
+    m_Pipeline = nullptr;
+    m_PipelineLayout = nullptr;
+
+    if (IsReplay())
+        return;
+
+    GetCoreInterface().CmdExecuteCommandBuffers(*GetImpl(), commandBuffersImpl, commandBufferNum);
+}
+
 NRI_INLINE void CommandBufferVal::CopyBuffer(Buffer& dstBuffer, uint64_t dstOffset, const Buffer& srcBuffer, uint64_t srcOffset, uint64_t size) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &dstBuffer, &srcBuffer](CommandBufferVal& replay) { replay.CopyBuffer(dstBuffer, dstOffset, srcBuffer, srcOffset, size); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondary, ReturnVoid(), "can't be called in a secondary command buffer");
 
-    if (size == WHOLE_SIZE) {
+    if (size == WHOLE_SIZE && IsValidationEnabled(ValidationBits::COMMANDS)) {
         const BufferDesc& dstDesc = ((BufferVal&)dstBuffer).GetDesc();
         const BufferDesc& srcDesc = ((BufferVal&)srcBuffer).GetDesc();
 
         if (dstDesc.size != srcDesc.size)
-            REPORT_WARNING(&m_Device, "WHOLE_SIZE is used but 'dstBuffer' and 'srcBuffer' have different sizes");
+            REPORT_WARNING(this, "WHOLE_SIZE is used but 'dstBuffer' and 'srcBuffer' have different sizes");
     }
 
+    if (IsReplay())
+        return;
+
     Buffer* dstBufferImpl = NRI_GET_IMPL(Buffer, &dstBuffer);
     Buffer* srcBufferImpl = NRI_GET_IMPL(Buffer, &srcBuffer);
 
@@ -361,8 +801,15 @@ NRI_INLINE void CommandBufferVal::CopyBuffer(Buffer& dstBuffer, uint64_t dstOffs
 }
 
 NRI_INLINE void CommandBufferVal::CopyTexture(Texture& dstTexture, const TextureRegionDesc* dstRegionDesc, const Texture& srcTexture, const TextureRegionDesc* srcRegionDesc) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &dstTexture, &srcTexture](CommandBufferVal& replay) { replay.CopyTexture(dstTexture, nullptr, srcTexture, nullptr); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondary, ReturnVoid(), "can't be called in a secondary command buffer");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+
+    if (IsReplay())
+        return;
 
     Texture* dstTextureImpl = NRI_GET_IMPL(Texture, &dstTexture);
     Texture* srcTextureImpl = NRI_GET_IMPL(Texture, &srcTexture);
@@ -371,8 +818,15 @@ NRI_INLINE void CommandBufferVal::CopyTexture(Texture& dstTexture, const Texture
 }
 
 NRI_INLINE void CommandBufferVal::ResolveTexture(Texture& dstTexture, const TextureRegionDesc* dstRegionDesc, const Texture& srcTexture, const TextureRegionDesc* srcRegionDesc) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &dstTexture, &srcTexture](CommandBufferVal& replay) { replay.ResolveTexture(dstTexture, nullptr, srcTexture, nullptr); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondary, ReturnVoid(), "can't be called in a secondary command buffer");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+
+    if (IsReplay())
+        return;
 
     Texture* dstTextureImpl = NRI_GET_IMPL(Texture, &dstTexture);
     Texture* srcTextureImpl = NRI_GET_IMPL(Texture, &srcTexture);
@@ -381,8 +835,15 @@ NRI_INLINE void CommandBufferVal::ResolveTexture(Texture& dstTexture, const Text
 }
 
 NRI_INLINE void CommandBufferVal::UploadBufferToTexture(Texture& dstTexture, const TextureRegionDesc& dstRegionDesc, const Buffer& srcBuffer, const TextureDataLayoutDesc& srcDataLayoutDesc) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &dstTexture, &srcBuffer](CommandBufferVal& replay) { replay.UploadBufferToTexture(dstTexture, dstRegionDesc, srcBuffer, srcDataLayoutDesc); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondary, ReturnVoid(), "can't be called in a secondary command buffer");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+
+    if (IsReplay())
+        return;
 
     Texture* dstTextureImpl = NRI_GET_IMPL(Texture, &dstTexture);
     Buffer* srcBufferImpl = NRI_GET_IMPL(Buffer, &srcBuffer);
@@ -391,8 +852,15 @@ NRI_INLINE void CommandBufferVal::UploadBufferToTexture(Texture& dstTexture, con
 }
 
 NRI_INLINE void CommandBufferVal::ReadbackTextureToBuffer(Buffer& dstBuffer, const TextureDataLayoutDesc& dstDataLayoutDesc, const Texture& srcTexture, const TextureRegionDesc& srcRegionDesc) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &dstBuffer, &srcTexture](CommandBufferVal& replay) { replay.ReadbackTextureToBuffer(dstBuffer, dstDataLayoutDesc, srcTexture, srcRegionDesc); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondary, ReturnVoid(), "can't be called in a secondary command buffer");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+
+    if (IsReplay())
+        return;
 
     Buffer* dstBufferImpl = NRI_GET_IMPL(Buffer, &dstBuffer);
     Texture* srcTextureImpl = NRI_GET_IMPL(Texture, &srcTexture);
@@ -401,37 +869,65 @@ NRI_INLINE void CommandBufferVal::ReadbackTextureToBuffer(Buffer& dstBuffer, con
 }
 
 NRI_INLINE void CommandBufferVal::Dispatch(const DispatchDesc& dispatchDesc) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.Dispatch(dispatchDesc); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+
+    if (IsReplay())
+        return;
 
     GetCoreInterface().CmdDispatch(*GetImpl(), dispatchDesc);
 }
 
 NRI_INLINE void CommandBufferVal::DispatchIndirect(const Buffer& buffer, uint64_t offset) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &buffer](CommandBufferVal& replay) { replay.DispatchIndirect(buffer, offset); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
 
     const BufferDesc& bufferDesc = ((BufferVal&)buffer).GetDesc();
-    RETURN_ON_FAILURE(&m_Device, offset < bufferDesc.size, ReturnVoid(), "offset is greater than the buffer size");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, offset < bufferDesc.size, ReturnVoid(), "offset is greater than the buffer size");
+
+    if (IsReplay())
+        return;
 
     Buffer* bufferImpl = NRI_GET_IMPL(Buffer, &buffer);
     GetCoreInterface().CmdDispatchIndirect(*GetImpl(), *bufferImpl, offset);
 }
 
-NRI_INLINE void CommandBufferVal::Barrier(const BarrierGroupDesc& barrierGroupDesc) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
-
-    for (uint32_t i = 0; i < barrierGroupDesc.bufferNum; i++) {
-        if (!ValidateBufferBarrierDesc(m_Device, i, barrierGroupDesc.buffers[i]))
-            return;
+NRI_INLINE void CommandBufferVal::Barrier(const BarrierGroupDesc& barrierGroupDesc, const void* callSite) {
+    if (m_IsLogging) {
+        BarrierGroupDesc barrierGroupDescCopy = barrierGroupDesc;
+        barrierGroupDescCopy.globals = m_CommandLog->Copy(barrierGroupDesc.globals, barrierGroupDesc.globalNum);
+        barrierGroupDescCopy.buffers = m_CommandLog->Copy(barrierGroupDesc.buffers, barrierGroupDesc.bufferNum);
+        barrierGroupDescCopy.textures = m_CommandLog->Copy(barrierGroupDesc.textures, barrierGroupDesc.textureNum);
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.Barrier(barrierGroupDescCopy, callSite); });
     }
 
-    for (uint32_t i = 0; i < barrierGroupDesc.textureNum; i++) {
-        if (!ValidateTextureBarrierDesc(m_Device, i, barrierGroupDesc.textures[i]))
-            return;
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, BARRIERS, !m_IsSecondary, ReturnVoid(), "can't be called in a secondary command buffer");
+    RETURN_ON_FAILURE_IF(this, BARRIERS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+
+    if (IsValidationEnabled(ValidationBits::BARRIERS)) {
+        for (uint32_t i = 0; i < barrierGroupDesc.bufferNum; i++) {
+            if (!ValidateBufferBarrierDesc(*this, i, barrierGroupDesc.buffers[i]))
+                return;
+        }
+
+        for (uint32_t i = 0; i < barrierGroupDesc.textureNum; i++) {
+            if (!ValidateTextureBarrierDesc(*this, i, barrierGroupDesc.textures[i]))
+                return;
+        }
+
+        TrackBarriers(barrierGroupDesc, callSite);
     }
 
+    if (IsReplay())
+        return;
+
     Scratch<BufferBarrierDesc> buffers = AllocateScratch(m_Device, BufferBarrierDesc, barrierGroupDesc.bufferNum);
     memcpy(buffers, barrierGroupDesc.buffers, sizeof(BufferBarrierDesc) * barrierGroupDesc.bufferNum);
     for (uint32_t i = 0; i < barrierGroupDesc.bufferNum; i++)
@@ -450,37 +946,58 @@ NRI_INLINE void CommandBufferVal::Barrier(const BarrierGroupDesc& barrierGroupDe
 }
 
 NRI_INLINE void CommandBufferVal::BeginQuery(QueryPool& queryPool, uint32_t offset) {
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &queryPool](CommandBufferVal& replay) { replay.BeginQuery(queryPool, offset); });
+
     QueryPoolVal& queryPoolVal = (QueryPoolVal&)queryPool;
 
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, queryPoolVal.GetQueryType() != QueryType::TIMESTAMP, ReturnVoid(), "'BeginQuery' is not supported for timestamp queries");
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondary || m_Device.GetDesc().graphicsAPI != GraphicsAPI::D3D12, ReturnVoid(), "D3D12: can't be called in a secondary command buffer (bundle)");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, queryPoolVal.GetQueryType() != QueryType::TIMESTAMP, ReturnVoid(), "'BeginQuery' is not supported for timestamp queries");
 
     if (!queryPoolVal.IsImported())
-        RETURN_ON_FAILURE(&m_Device, offset < queryPoolVal.GetQueryNum(), ReturnVoid(), "'offset = %u' is out of range", offset);
+        RETURN_ON_FAILURE_IF(this, COMMANDS, offset < queryPoolVal.GetQueryNum(), ReturnVoid(), "'offset = %u' is out of range", offset);
+
+    if (IsReplay())
+        return;
 
     QueryPool* queryPoolImpl = NRI_GET_IMPL(QueryPool, &queryPool);
     GetCoreInterface().CmdBeginQuery(*GetImpl(), *queryPoolImpl, offset);
 }
 
 NRI_INLINE void CommandBufferVal::EndQuery(QueryPool& queryPool, uint32_t offset) {
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &queryPool](CommandBufferVal& replay) { replay.EndQuery(queryPool, offset); });
+
     QueryPoolVal& queryPoolVal = (QueryPoolVal&)queryPool;
 
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondary || m_Device.GetDesc().graphicsAPI != GraphicsAPI::D3D12, ReturnVoid(), "D3D12: can't be called in a secondary command buffer (bundle)");
 
     if (!queryPoolVal.IsImported())
-        RETURN_ON_FAILURE(&m_Device, offset < queryPoolVal.GetQueryNum(), ReturnVoid(), "'offset = %u' is out of range", offset);
+        RETURN_ON_FAILURE_IF(this, COMMANDS, offset < queryPoolVal.GetQueryNum(), ReturnVoid(), "'offset = %u' is out of range", offset);
+
+    if (IsReplay())
+        return;
 
     QueryPool* queryPoolImpl = NRI_GET_IMPL(QueryPool, &queryPool);
     GetCoreInterface().CmdEndQuery(*GetImpl(), *queryPoolImpl, offset);
 }
 
 NRI_INLINE void CommandBufferVal::CopyQueries(const QueryPool& queryPool, uint32_t offset, uint32_t num, Buffer& dstBuffer, uint64_t dstOffset) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &queryPool, &dstBuffer](CommandBufferVal& replay) { replay.CopyQueries(queryPool, offset, num, dstBuffer, dstOffset); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondary, ReturnVoid(), "can't be called in a secondary command buffer");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
 
     const QueryPoolVal& queryPoolVal = (const QueryPoolVal&)queryPool;
     if (!queryPoolVal.IsImported())
-        RETURN_ON_FAILURE(&m_Device, offset + num <= queryPoolVal.GetQueryNum(), ReturnVoid(), "'offset + num =  %u' is out of range", offset + num);
+        RETURN_ON_FAILURE_IF(this, COMMANDS, offset + num <= queryPoolVal.GetQueryNum(), ReturnVoid(), "'offset + num =  %u' is out of range", offset + num);
+
+    if (IsReplay())
+        return;
 
     QueryPool* queryPoolImpl = NRI_GET_IMPL(QueryPool, &queryPool);
     Buffer* dstBufferImpl = NRI_GET_IMPL(Buffer, &dstBuffer);
@@ -489,46 +1006,79 @@ NRI_INLINE void CommandBufferVal::CopyQueries(const QueryPool& queryPool, uint32
 }
 
 NRI_INLINE void CommandBufferVal::ResetQueries(QueryPool& queryPool, uint32_t offset, uint32_t num) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &queryPool](CommandBufferVal& replay) { replay.ResetQueries(queryPool, offset, num); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondary, ReturnVoid(), "can't be called in a secondary command buffer");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
 
     QueryPoolVal& queryPoolVal = (QueryPoolVal&)queryPool;
     if (!queryPoolVal.IsImported())
-        RETURN_ON_FAILURE(&m_Device, offset + num <= queryPoolVal.GetQueryNum(), ReturnVoid(), "'offset + num = %u' is out of range", offset + num);
+        RETURN_ON_FAILURE_IF(this, COMMANDS, offset + num <= queryPoolVal.GetQueryNum(), ReturnVoid(), "'offset + num = %u' is out of range", offset + num);
+
+    if (IsReplay())
+        return;
 
     QueryPool* queryPoolImpl = NRI_GET_IMPL(QueryPool, &queryPool);
     GetCoreInterface().CmdResetQueries(*GetImpl(), *queryPoolImpl, offset, num);
 }
 
 NRI_INLINE void CommandBufferVal::BeginAnnotation(const char* name, uint32_t bgra) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.BeginAnnotation(nullptr, bgra); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
 
     m_AnnotationStack++;
+
+    if (IsReplay())
+        return;
+
     GetCoreInterface().CmdBeginAnnotation(*GetImpl(), name, bgra);
 }
 
 NRI_INLINE void CommandBufferVal::EndAnnotation() {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.EndAnnotation(); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
 
-    GetCoreInterface().CmdEndAnnotation(*GetImpl());
     m_AnnotationStack--;
+
+    if (IsReplay())
+        return;
+
+    GetCoreInterface().CmdEndAnnotation(*GetImpl());
 }
 
 NRI_INLINE void CommandBufferVal::Annotation(const char* name, uint32_t bgra) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.Annotation(nullptr, bgra); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+
+    if (IsReplay())
+        return;
 
     GetCoreInterface().CmdAnnotation(*GetImpl(), name, bgra);
 }
 
 NRI_INLINE void CommandBufferVal::BuildTopLevelAccelerationStructure(uint32_t instanceNum, const Buffer& buffer, uint64_t bufferOffset, AccelerationStructureBuildBits flags, AccelerationStructure& dst, Buffer& scratch, uint64_t scratchOffset) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &buffer, &dst, &scratch](CommandBufferVal& replay) { replay.BuildTopLevelAccelerationStructure(instanceNum, buffer, bufferOffset, flags, dst, scratch, scratchOffset); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
 
     BufferVal& bufferVal = (BufferVal&)buffer;
     BufferVal& scratchVal = (BufferVal&)scratch;
 
-    RETURN_ON_FAILURE(&m_Device, bufferOffset < bufferVal.GetDesc().size, ReturnVoid(), "'bufferOffset = %llu' is out of bounds", bufferOffset);
-    RETURN_ON_FAILURE(&m_Device, scratchOffset < scratchVal.GetDesc().size, ReturnVoid(), "'scratchOffset = %llu' is out of bounds", scratchOffset);
+    RETURN_ON_FAILURE_IF(this, COMMANDS, bufferOffset < bufferVal.GetDesc().size, ReturnVoid(), "'bufferOffset = %llu' is out of bounds", bufferOffset);
+    RETURN_ON_FAILURE_IF(this, COMMANDS, scratchOffset < scratchVal.GetDesc().size, ReturnVoid(), "'scratchOffset = %llu' is out of bounds", scratchOffset);
+
+    if (IsReplay())
+        return;
 
     AccelerationStructure& dstImpl = *NRI_GET_IMPL(AccelerationStructure, &dst);
     Buffer& scratchImpl = *NRI_GET_IMPL(Buffer, &scratch);
@@ -538,12 +1088,20 @@ NRI_INLINE void CommandBufferVal::BuildTopLevelAccelerationStructure(uint32_t in
 }
 
 NRI_INLINE void CommandBufferVal::BuildBottomLevelAccelerationStructure(uint32_t geometryObjectNum, const GeometryObject* geometryObjects, AccelerationStructureBuildBits flags, AccelerationStructure& dst, Buffer& scratch, uint64_t scratchOffset) {
+    if (m_IsLogging) {
+        const GeometryObject* geometryObjectsCopy = geometryObjectNum ? m_CommandLog->Copy(geometryObjects, geometryObjectNum) : geometryObjects; // only the NULL check needs an empty one
+        m_CommandLog->Record([=, &dst, &scratch](CommandBufferVal& replay) { replay.BuildBottomLevelAccelerationStructure(geometryObjectNum, geometryObjectsCopy, flags, dst, scratch, scratchOffset); });
+    }
+
     BufferVal& scratchVal = (BufferVal&)scratch;
 
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
-    RETURN_ON_FAILURE(&m_Device, geometryObjects, ReturnVoid(), "'geometryObjects' is NULL");
-    RETURN_ON_FAILURE(&m_Device, scratchOffset < scratchVal.GetDesc().size, ReturnVoid(), "'scratchOffset = %llu' is out of bounds", scratchOffset);
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, geometryObjects, ReturnVoid(), "'geometryObjects' is NULL");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, scratchOffset < scratchVal.GetDesc().size, ReturnVoid(), "'scratchOffset = %llu' is out of bounds", scratchOffset);
+
+    if (IsReplay())
+        return;
 
     AccelerationStructure& dstImpl = *NRI_GET_IMPL(AccelerationStructure, &dst);
     Buffer& scratchImpl = *NRI_GET_IMPL(Buffer, &scratch);
@@ -556,14 +1114,20 @@ NRI_INLINE void CommandBufferVal::BuildBottomLevelAccelerationStructure(uint32_t
 
 NRI_INLINE void CommandBufferVal::UpdateTopLevelAccelerationStructure(uint32_t instanceNum, const Buffer& buffer, uint64_t bufferOffset, AccelerationStructureBuildBits flags,
     AccelerationStructure& dst, const AccelerationStructure& src, Buffer& scratch, uint64_t scratchOffset) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &buffer, &dst, &src, &scratch](CommandBufferVal& replay) { replay.UpdateTopLevelAccelerationStructure(instanceNum, buffer, bufferOffset, flags, dst, src, scratch, scratchOffset); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
 
     BufferVal& bufferVal = (BufferVal&)buffer;
     BufferVal& scratchVal = (BufferVal&)scratch;
 
-    RETURN_ON_FAILURE(&m_Device, bufferOffset < bufferVal.GetDesc().size, ReturnVoid(), "'bufferOffset = %llu' is out of bounds", bufferOffset);
-    RETURN_ON_FAILURE(&m_Device, scratchOffset < scratchVal.GetDesc().size, ReturnVoid(), "'scratchOffset = %llu' is out of bounds", scratchOffset);
+    RETURN_ON_FAILURE_IF(this, COMMANDS, bufferOffset < bufferVal.GetDesc().size, ReturnVoid(), "'bufferOffset = %llu' is out of bounds", bufferOffset);
+    RETURN_ON_FAILURE_IF(this, COMMANDS, scratchOffset < scratchVal.GetDesc().size, ReturnVoid(), "'scratchOffset = %llu' is out of bounds", scratchOffset);
+
+    if (IsReplay())
+        return;
 
     AccelerationStructure& dstImpl = *NRI_GET_IMPL(AccelerationStructure, &dst);
     AccelerationStructure& srcImpl = *NRI_GET_IMPL(AccelerationStructure, &src);
@@ -575,13 +1139,21 @@ NRI_INLINE void CommandBufferVal::UpdateTopLevelAccelerationStructure(uint32_t i
 
 NRI_INLINE void CommandBufferVal::UpdateBottomLevelAccelerationStructure(uint32_t geometryObjectNum, const GeometryObject* geometryObjects, AccelerationStructureBuildBits flags,
     AccelerationStructure& dst, const AccelerationStructure& src, Buffer& scratch, uint64_t scratchOffset) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
-    RETURN_ON_FAILURE(&m_Device, geometryObjects, ReturnVoid(), "'geometryObjects' is NULL");
+    if (m_IsLogging) {
+        const GeometryObject* geometryObjectsCopy = geometryObjectNum ? m_CommandLog->Copy(geometryObjects, geometryObjectNum) : geometryObjects; // only the NULL check needs an empty one
+        m_CommandLog->Record([=, &dst, &src, &scratch](CommandBufferVal& replay) { replay.UpdateBottomLevelAccelerationStructure(geometryObjectNum, geometryObjectsCopy, flags, dst, src, scratch, scratchOffset); });
+    }
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, geometryObjects, ReturnVoid(), "'geometryObjects' is NULL");
 
     BufferVal& scratchVal = (BufferVal&)scratch;
 
-    RETURN_ON_FAILURE(&m_Device, scratchOffset < scratchVal.GetDesc().size, ReturnVoid(), "'scratchOffset = %llu' is out of bounds", scratchOffset);
+    RETURN_ON_FAILURE_IF(this, COMMANDS, scratchOffset < scratchVal.GetDesc().size, ReturnVoid(), "'scratchOffset = %llu' is out of bounds", scratchOffset);
+
+    if (IsReplay())
+        return;
 
     AccelerationStructure& dstImpl = *NRI_GET_IMPL(AccelerationStructure, &dst);
     AccelerationStructure& srcImpl = *NRI_GET_IMPL(AccelerationStructure, &src);
@@ -594,9 +1166,15 @@ NRI_INLINE void CommandBufferVal::UpdateBottomLevelAccelerationStructure(uint32_
 }
 
 NRI_INLINE void CommandBufferVal::CopyAccelerationStructure(AccelerationStructure& dst, const AccelerationStructure& src, CopyMode copyMode) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
-    RETURN_ON_FAILURE(&m_Device, copyMode < CopyMode::MAX_NUM, ReturnVoid(), "'copyMode' is invalid");
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &dst, &src](CommandBufferVal& replay) { replay.CopyAccelerationStructure(dst, src, copyMode); });
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, copyMode < CopyMode::MAX_NUM, ReturnVoid(), "'copyMode' is invalid");
+
+    if (IsReplay())
+        return;
 
     AccelerationStructure& dstImpl = *NRI_GET_IMPL(AccelerationStructure, &dst);
     AccelerationStructure& srcImpl = *NRI_GET_IMPL(AccelerationStructure, &src);
@@ -605,33 +1183,47 @@ NRI_INLINE void CommandBufferVal::CopyAccelerationStructure(AccelerationStructur
 }
 
 NRI_INLINE void CommandBufferVal::WriteAccelerationStructureSize(const AccelerationStructure* const* accelerationStructures, uint32_t accelerationStructureNum, QueryPool& queryPool, uint32_t queryOffset) {
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
-    RETURN_ON_FAILURE(&m_Device, accelerationStructures, ReturnVoid(), "'accelerationStructures' is NULL");
+    if (m_IsLogging) {
+        const AccelerationStructure* const* accelerationStructuresCopy = m_CommandLog->Copy(accelerationStructures, accelerationStructureNum);
+        m_CommandLog->Record([=, &queryPool](CommandBufferVal& replay) { replay.WriteAccelerationStructureSize(accelerationStructuresCopy, accelerationStructureNum, queryPool, queryOffset); });
+    }
+
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, accelerationStructures, ReturnVoid(), "'accelerationStructures' is NULL");
 
     Scratch<AccelerationStructure*> accelerationStructureArray = AllocateScratch(m_Device, AccelerationStructure*, accelerationStructureNum);
     for (uint32_t i = 0; i < accelerationStructureNum; i++) {
-        RETURN_ON_FAILURE(&m_Device, accelerationStructures[i], ReturnVoid(), "'accelerationStructures[%u]' is NULL", i);
+        RETURN_ON_FAILURE_IF(this, COMMANDS, accelerationStructures[i], ReturnVoid(), "'accelerationStructures[%u]' is NULL", i);
 
         accelerationStructureArray[i] = NRI_GET_IMPL(AccelerationStructure, accelerationStructures[i]);
     }
 
+    if (IsReplay())
+        return;
+
     QueryPool& queryPoolImpl = *NRI_GET_IMPL(QueryPool, &queryPool);
 
     GetRayTracingInterface().CmdWriteAccelerationStructureSize(*GetImpl(), accelerationStructures, accelerationStructureNum, queryPoolImpl, queryOffset);
 }
 
 NRI_INLINE void CommandBufferVal::DispatchRays(const DispatchRaysDesc& dispatchRaysDesc) {
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.DispatchRays(dispatchRaysDesc); });
+
     const DeviceDesc& deviceDesc = m_Device.GetDesc();
     uint64_t align = deviceDesc.shaderBindingTableAlignment;
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
-    RETURN_ON_FAILURE(&m_Device, dispatchRaysDesc.raygenShader.buffer, ReturnVoid(), "'raygenShader.buffer' is NULL");
-    RETURN_ON_FAILURE(&m_Device, dispatchRaysDesc.raygenShader.size != 0, ReturnVoid(), "'raygenShader.size' is 0");
-    RETURN_ON_FAILURE(&m_Device, dispatchRaysDesc.raygenShader.offset % align == 0, ReturnVoid(), "'raygenShader.offset' is misaligned");
-    RETURN_ON_FAILURE(&m_Device, dispatchRaysDesc.missShaders.offset % align == 0, ReturnVoid(), "'missShaders.offset' is misaligned");
-    RETURN_ON_FAILURE(&m_Device, dispatchRaysDesc.hitShaderGroups.offset % align == 0, ReturnVoid(), "'hitShaderGroups.offset' is misaligned");
-    RETURN_ON_FAILURE(&m_Device, dispatchRaysDesc.callableShaders.offset % align == 0, ReturnVoid(), "'callableShaders.offset' is misaligned");
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsRenderPass, ReturnVoid(), "must be called outside of 'CmdBeginRendering/CmdEndRendering'");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, dispatchRaysDesc.raygenShader.buffer, ReturnVoid(), "'raygenShader.buffer' is NULL");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, dispatchRaysDesc.raygenShader.size != 0, ReturnVoid(), "'raygenShader.size' is 0");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, dispatchRaysDesc.raygenShader.offset % align == 0, ReturnVoid(), "'raygenShader.offset' is misaligned");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, dispatchRaysDesc.missShaders.offset % align == 0, ReturnVoid(), "'missShaders.offset' is misaligned");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, dispatchRaysDesc.hitShaderGroups.offset % align == 0, ReturnVoid(), "'hitShaderGroups.offset' is misaligned");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, dispatchRaysDesc.callableShaders.offset % align == 0, ReturnVoid(), "'callableShaders.offset' is misaligned");
+
+    if (IsReplay())
+        return;
 
     auto dispatchRaysDescImpl = dispatchRaysDesc;
     dispatchRaysDescImpl.raygenShader.buffer = NRI_GET_IMPL(Buffer, dispatchRaysDesc.raygenShader.buffer);
@@ -643,33 +1235,53 @@ NRI_INLINE void CommandBufferVal::DispatchRays(const DispatchRaysDesc& dispatchR
 }
 
 NRI_INLINE void CommandBufferVal::DispatchRaysIndirect(const Buffer& buffer, uint64_t offset) {
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &buffer](CommandBufferVal& replay) { replay.DispatchRaysIndirect(buffer, offset); });
+
     const DeviceDesc& deviceDesc = m_Device.GetDesc();
     const BufferDesc& bufferDesc = ((BufferVal&)buffer).GetDesc();
-    RETURN_ON_FAILURE(&m_Device, offset < bufferDesc.size, ReturnVoid(), "offset is greater than the buffer size");
-    RETURN_ON_FAILURE(&m_Device, deviceDesc.rayTracingTier >= 2, ReturnVoid(), "'rayTracingTier' must be >= 2");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, offset < bufferDesc.size, ReturnVoid(), "offset is greater than the buffer size");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, deviceDesc.rayTracingTier >= 2, ReturnVoid(), "'rayTracingTier' must be >= 2");
+
+    if (IsReplay())
+        return;
 
     Buffer* bufferImpl = NRI_GET_IMPL(Buffer, &buffer);
     GetRayTracingInterface().CmdDispatchRaysIndirect(*GetImpl(), *bufferImpl, offset);
 }
 
 NRI_INLINE void CommandBufferVal::DrawMeshTasks(const DrawMeshTasksDesc& drawMeshTasksDesc) {
+    if (m_IsLogging)
+        m_CommandLog->Record([=](CommandBufferVal& replay) { replay.DrawMeshTasks(drawMeshTasksDesc); });
+
     const DeviceDesc& deviceDesc = m_Device.GetDesc();
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, m_IsRenderPass, ReturnVoid(), "must be called inside 'CmdBeginRendering/CmdEndRendering'");
-    RETURN_ON_FAILURE(&m_Device, deviceDesc.isMeshShaderSupported, ReturnVoid(), "'isMeshShaderSupported' is false");
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, m_IsRenderPass, ReturnVoid(), "must be called inside 'CmdBeginRendering/CmdEndRendering'");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondaryCommandBuffersPass, ReturnVoid(), "the pass contents must be recorded in secondary command buffers ('AttachmentsDesc::secondaryCommandBuffers = true')");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, deviceDesc.isMeshShaderSupported, ReturnVoid(), "'isMeshShaderSupported' is false");
+
+    if (IsReplay())
+        return;
 
     GetMeshShaderInterface().CmdDrawMeshTasks(*GetImpl(), drawMeshTasksDesc);
 }
 
 NRI_INLINE void CommandBufferVal::DrawMeshTasksIndirect(const Buffer& buffer, uint64_t offset, uint32_t drawNum, uint32_t stride, const Buffer* countBuffer, uint64_t countBufferOffset) {
+    if (m_IsLogging)
+        m_CommandLog->Record([=, &buffer](CommandBufferVal& replay) { replay.DrawMeshTasksIndirect(buffer, offset, drawNum, stride, countBuffer, countBufferOffset); });
+
     const DeviceDesc& deviceDesc = m_Device.GetDesc();
-    RETURN_ON_FAILURE(&m_Device, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
-    RETURN_ON_FAILURE(&m_Device, m_IsRenderPass, ReturnVoid(), "must be called inside 'CmdBeginRendering/CmdEndRendering'");
-    RETURN_ON_FAILURE(&m_Device, deviceDesc.isMeshShaderSupported, ReturnVoid(), "'isMeshShaderSupported' is false");
-    RETURN_ON_FAILURE(&m_Device, !countBuffer || deviceDesc.isDrawIndirectCountSupported, ReturnVoid(), "'countBuffer' is not supported");
+    RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, m_IsRecordingStarted, ReturnVoid(), "the command buffer must be in the recording state");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, m_IsRenderPass, ReturnVoid(), "must be called inside 'CmdBeginRendering/CmdEndRendering'");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !m_IsSecondaryCommandBuffersPass, ReturnVoid(), "the pass contents must be recorded in secondary command buffers ('AttachmentsDesc::secondaryCommandBuffers = true')");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, deviceDesc.isMeshShaderSupported, ReturnVoid(), "'isMeshShaderSupported' is false");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, !countBuffer || deviceDesc.isDrawIndirectCountSupported, ReturnVoid(), "'countBuffer' is not supported");
 
     const BufferDesc& bufferDesc = ((BufferVal&)buffer).GetDesc();
-    RETURN_ON_FAILURE(&m_Device, offset < bufferDesc.size, ReturnVoid(), "'offset' is greater than the buffer size");
+    RETURN_ON_FAILURE_IF(this, COMMANDS, offset < bufferDesc.size, ReturnVoid(), "'offset' is greater than the buffer size");
+
+    if (IsReplay())
+        return;
 
     Buffer* bufferImpl = NRI_GET_IMPL(Buffer, &buffer);
     Buffer* countBufferImpl = NRI_GET_IMPL(Buffer, countBuffer);
@@ -678,11 +1290,11 @@ NRI_INLINE void CommandBufferVal::DrawMeshTasksIndirect(const Buffer& buffer, ui
 }
 
 NRI_INLINE void CommandBufferVal::ValidateReadonlyDepthStencil() {
-    if (m_Pipeline && m_DepthStencil) {
+    if (m_Pipeline && m_DepthStencil && IsValidationEnabled(ValidationBits::COMMANDS)) {
         if (m_DepthStencil->IsDepthReadonly() && m_Pipeline->WritesToDepth())
-            REPORT_WARNING(&m_Device, "Depth is read-only, but the pipeline writes to depth. Writing happens only in VK!");
+            REPORT_WARNING(this, "Depth is read-only, but the pipeline writes to depth. Writing happens only in VK!");
 
         if (m_DepthStencil->IsStencilReadonly() && m_Pipeline->WritesToStencil())
-            REPORT_WARNING(&m_Device, "Stencil is read-only, but the pipeline writes to stencil. Writing happens only in VK!");
+            REPORT_WARNING(this, "Stencil is read-only, but the pipeline writes to stencil. Writing happens only in VK!");
     }
 }
@@ -0,0 +1,86 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+struct CommandBufferVal;
+
+constexpr size_t COMMAND_LOG_PAGE_SIZE = 64 * 1024;
+
+// Compact log of commands recorded in the async validation mode and replayed on the validation thread.
+// A command is a closure over the arguments, it's placed in a page together with copies of the arrays it references.
+// Pages are never moved or freed until destruction, i.e. "Reset" only rewinds the log
+struct CommandLogVal {
+    inline CommandLogVal(DeviceVal& device)
+        : m_Device(device)
+        , m_Pages(device.GetStdAllocator()) {
+    }
+
+    ~CommandLogVal();
+
+    inline uint32_t GetCommandNum() const {
+        return m_CommandNum;
+    }
+
+    template <typename T>
+    inline const T* Copy(const T* data, size_t num) {
+        static_assert(std::is_trivially_copyable<T>::value, "Unexpected");
+
+        if (!data || !num)
+            return nullptr;
+
+        T* copy = (T*)Allocate(sizeof(T) * num, alignof(T));
+        memcpy(copy, data, sizeof(T) * num);
+
+        return copy;
+    }
+
+    template <typename Command>
+    inline void Record(const Command& command) {
+        static_assert(std::is_trivially_destructible<Command>::value, "Commands are never destroyed");
+
+        Entry* entry = (Entry*)Allocate(sizeof(Entry), alignof(Entry));
+        entry->replay = [](const void* command, CommandBufferVal& commandBuffer) {
+            (*(const Command*)command)(commandBuffer);
+        };
+        entry->command = new (Allocate(sizeof(Command), alignof(Command))) Command(command);
+        entry->next = nullptr;
+
+        if (m_Last)
+            m_Last->next = entry;
+        else
+            m_First = entry;
+
+        m_Last = entry;
+        m_CommandNum++;
+    }
+
+    void Replay(CommandBufferVal& commandBuffer, uint32_t& commandIndex) const;
+    void Reset();
+
+private:
+    struct Entry {
+        void (*replay)(const void* command, CommandBufferVal& commandBuffer);
+        const void* command;
+        Entry* next;
+    };
+
+    struct Page {
+        uint8_t* memory;
+        size_t size;
+    };
+
+    void* Allocate(size_t size, size_t alignment);
+
+private:
+    DeviceVal& m_Device;
+    Vector<Page> m_Pages;
+    Entry* m_First = nullptr;
+    Entry* m_Last = nullptr;
+    size_t m_PageIndex = 0;
+    size_t m_PageOffset = 0;
+    uint32_t m_CommandNum = 0;
+};
+
+} // namespace nri
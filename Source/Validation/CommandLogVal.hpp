@@ -0,0 +1,55 @@
+// © 2021 NVIDIA Corporation
+
+CommandLogVal::~CommandLogVal() {
+    const auto& allocationCallbacks = m_Device.GetAllocationCallbacks();
+    for (const Page& page : m_Pages)
+        allocationCallbacks.Free(allocationCallbacks.userArg, page.memory);
+}
+
+void CommandLogVal::Replay(CommandBufferVal& commandBuffer, uint32_t& commandIndex) const {
+    commandIndex = 0;
+
+    for (const Entry* entry = m_First; entry; entry = entry->next) {
+        entry->replay(entry->command, commandBuffer);
+        commandIndex++;
+    }
+}
+
+void CommandLogVal::Reset() {
+    m_First = nullptr;
+    m_Last = nullptr;
+    m_PageIndex = 0;
+    m_PageOffset = 0;
+    m_CommandNum = 0;
+}
+
+void* CommandLogVal::Allocate(size_t size, size_t alignment) {
+    // Current page
+    if (m_PageIndex < m_Pages.size()) {
+        const Page& page = m_Pages[m_PageIndex];
+
+        size_t offset = Align(m_PageOffset, alignment);
+        if (offset + size <= page.size) {
+            m_PageOffset = offset + size;
+            return page.memory + offset;
+        }
+
+        m_PageIndex++;
+    }
+
+    // Next page (recycled if big enough)
+    if (m_PageIndex == m_Pages.size() || m_Pages[m_PageIndex].size < size) {
+        const auto& allocationCallbacks = m_Device.GetAllocationCallbacks();
+
+        Page page = {};
+        page.size = std::max(COMMAND_LOG_PAGE_SIZE, Align(size, alignment));
+        page.memory = (uint8_t*)allocationCallbacks.Allocate(allocationCallbacks.userArg, page.size, std::max(alignment, alignof(std::max_align_t)));
+        CHECK(page.memory, "Out of memory");
+
+        m_Pages.insert(m_Pages.begin() + m_PageIndex, page);
+    }
+
+    m_PageOffset = size;
+
+    return m_Pages[m_PageIndex].memory;
+}
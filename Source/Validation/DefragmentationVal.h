@@ -0,0 +1,38 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+struct DefragmentationVal final : public ObjectVal {
+    inline DefragmentationVal(DeviceVal& device, Defragmentation* defragmentation)
+        : ObjectVal(device, defragmentation)
+        , m_Resources(device.GetStdAllocator())
+        , m_Moves(device.GetStdAllocator()) {
+    }
+
+    inline Defragmentation* GetImpl() const {
+        return (Defragmentation*)m_Impl;
+    }
+
+    ~DefragmentationVal();
+
+    void AddResource(Object* object, Object* objectImpl);
+
+    //================================================================================================================
+    // NRI
+    //================================================================================================================
+
+    Result GetPass(DefragmentationPass& defragmentationPass);
+    Result EndPass();
+    void End(DefragmentationStats& defragmentationStats);
+
+private:
+    void DestroyMoves();
+
+private:
+    UnorderedMap<Object*, Object*> m_Resources; // impl -> val
+    Vector<DefragmentationMove> m_Moves;        // the current pass, "dst" objects are owned
+};
+
+} // namespace nri
@@ -0,0 +1,78 @@
+// © 2021 NVIDIA Corporation
+
+DefragmentationVal::~DefragmentationVal() {
+    DestroyMoves();
+}
+
+void DefragmentationVal::AddResource(Object* object, Object* objectImpl) {
+    m_Resources[objectImpl] = object;
+}
+
+void DefragmentationVal::DestroyMoves() {
+    for (const DefragmentationMove& move : m_Moves) {
+        if (move.dstBuffer)
+            Destroy(m_Device.GetAllocationCallbacks(), (BufferVal*)move.dstBuffer);
+        else
+            Destroy(m_Device.GetAllocationCallbacks(), (TextureVal*)move.dstTexture);
+    }
+
+    m_Moves.clear();
+}
+
+NRI_INLINE Result DefragmentationVal::GetPass(DefragmentationPass& defragmentationPass) {
+    defragmentationPass = {};
+
+    if (m_Moves.empty()) {
+        DefragmentationPass defragmentationPassImpl = {};
+        Result result = GetResourceAllocatorInterface().GetDefragmentationPass(*GetImpl(), defragmentationPassImpl);
+        if (result != Result::SUCCESS)
+            return result;
+
+        for (uint32_t i = 0; i < defragmentationPassImpl.moveNum; i++) {
+            const DefragmentationMove& moveImpl = defragmentationPassImpl.moves[i];
+
+            DefragmentationMove move = {};
+            if (moveImpl.srcBuffer) {
+                move.srcBuffer = (Buffer*)m_Resources[(Object*)moveImpl.srcBuffer];
+                move.dstBuffer = (Buffer*)Allocate<BufferVal>(m_Device.GetAllocationCallbacks(), m_Device, moveImpl.dstBuffer, true);
+            } else {
+                move.srcTexture = (Texture*)m_Resources[(Object*)moveImpl.srcTexture];
+                move.dstTexture = (Texture*)Allocate<TextureVal>(m_Device.GetAllocationCallbacks(), m_Device, moveImpl.dstTexture, true);
+            }
+
+            m_Moves.push_back(move);
+        }
+    }
+
+    defragmentationPass.moves = m_Moves.data();
+    defragmentationPass.moveNum = (uint32_t)m_Moves.size();
+
+    return Result::SUCCESS;
+}
+
+NRI_INLINE Result DefragmentationVal::EndPass() {
+    Result result = GetResourceAllocatorInterface().EndDefragmentationPass(*GetImpl());
+
+    // Moved resources now refer to "dst" objects, i.e. they inherit states tracked for "dst" by the copy barriers
+    if (result == Result::SUCCESS) {
+        ExclusiveScope lockScope(m_Device.GetResourceStateLock());
+
+        for (const DefragmentationMove& move : m_Moves) {
+            if (move.dstBuffer)
+                ((BufferVal*)move.srcBuffer)->GetState() = ((BufferVal*)move.dstBuffer)->GetState();
+            else
+                ((TextureVal*)move.srcTexture)->CopyStates(*(TextureVal*)move.dstTexture);
+        }
+    }
+
+    // "dst" wrappers are not needed anymore, native objects are destroyed by the implementation
+    DestroyMoves();
+
+    return result;
+}
+
+NRI_INLINE void DefragmentationVal::End(DefragmentationStats& defragmentationStats) {
+    DestroyMoves();
+
+    GetResourceAllocatorInterface().EndDefragmentation(*GetImpl(), defragmentationStats);
+}
@@ -17,22 +17,22 @@ NRI_INLINE void DescriptorPoolVal::Reset() {
 }
 
 NRI_INLINE Result DescriptorPoolVal::AllocateDescriptorSets(const PipelineLayout& pipelineLayout, uint32_t setIndex, DescriptorSet** descriptorSets, uint32_t instanceNum, uint32_t variableDescriptorNum) {
-    RETURN_ON_FAILURE(&m_Device, instanceNum != 0, Result::INVALID_ARGUMENT, "'instanceNum' is 0");
+    RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, instanceNum != 0, Result::INVALID_ARGUMENT, "'instanceNum' is 0");
     RETURN_ON_FAILURE(&m_Device, m_DescriptorSetsNum + instanceNum <= m_Desc.descriptorSetMaxNum, Result::INVALID_ARGUMENT, "the maximum number of descriptor sets exceeded");
 
     const PipelineLayoutVal& pipelineLayoutVal = (const PipelineLayoutVal&)pipelineLayout;
     const PipelineLayoutDesc& pipelineLayoutDesc = pipelineLayoutVal.GetPipelineLayoutDesc();
-    RETURN_ON_FAILURE(&m_Device, m_SkipValidation || setIndex < pipelineLayoutDesc.descriptorSetNum, Result::INVALID_ARGUMENT, "'setIndex' is invalid");
+    RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, m_SkipValidation || setIndex < pipelineLayoutDesc.descriptorSetNum, Result::INVALID_ARGUMENT, "'setIndex' is invalid");
 
     const DescriptorSetDesc& descriptorSetDesc = pipelineLayoutDesc.descriptorSets[setIndex];
-    if (!m_SkipValidation) {
+    if (!m_SkipValidation && IsValidationEnabled(ValidationBits::DESCRIPTORS)) {
         for (uint32_t i = 0; i < instanceNum; i++) {
             for (uint32_t j = 0; j < descriptorSetDesc.rangeNum; j++) {
                 const DescriptorRangeDesc& rangeDesc = descriptorSetDesc.ranges[j];
-                RETURN_ON_FAILURE(&m_Device, (uint32_t)rangeDesc.descriptorType < (uint32_t)nri::DescriptorType::MAX_NUM, Result::INVALID_ARGUMENT, "Invalid DescriptorType=%u", (uint32_t)rangeDesc.descriptorType);
+                RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, (uint32_t)rangeDesc.descriptorType < (uint32_t)nri::DescriptorType::MAX_NUM, Result::INVALID_ARGUMENT, "Invalid DescriptorType=%u", (uint32_t)rangeDesc.descriptorType);
 
                 uint32_t descriptorNum = (rangeDesc.flags & DescriptorRangeBits::VARIABLE_SIZED_ARRAY) ? variableDescriptorNum : rangeDesc.descriptorNum;
-                RETURN_ON_FAILURE(&m_Device, descriptorNum <= rangeDesc.descriptorNum, Result::INVALID_ARGUMENT, "'variableDescriptorNum=%u' is greater than 'descriptorNum=%u'", variableDescriptorNum, rangeDesc.descriptorNum);
+                RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, descriptorNum <= rangeDesc.descriptorNum, Result::INVALID_ARGUMENT, "'variableDescriptorNum=%u' is greater than 'descriptorNum=%u'", variableDescriptorNum, rangeDesc.descriptorNum);
 
                 bool enoughDescriptors = false;
                 switch (rangeDesc.descriptorType) {
@@ -74,11 +74,11 @@ NRI_INLINE Result DescriptorPoolVal::AllocateDescriptorSets(const PipelineLayout
                         break;
                 }
 
-                RETURN_ON_FAILURE(&m_Device, enoughDescriptors, Result::INVALID_ARGUMENT, "the maximum number of '%s' descriptors in DescriptorPool exceeded at DescriptorSet instance #%u", GetDescriptorTypeName(rangeDesc.descriptorType), i);
+                RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, enoughDescriptors, Result::INVALID_ARGUMENT, "the maximum number of '%s' descriptors in DescriptorPool exceeded at DescriptorSet instance #%u", GetDescriptorTypeName(rangeDesc.descriptorType), i);
             }
 
             m_DynamicConstantBufferNum += descriptorSetDesc.dynamicConstantBufferNum;
-            RETURN_ON_FAILURE(&m_Device, m_DynamicConstantBufferNum <= m_Desc.dynamicConstantBufferMaxNum, Result::INVALID_ARGUMENT,
+            RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, m_DynamicConstantBufferNum <= m_Desc.dynamicConstantBufferMaxNum, Result::INVALID_ARGUMENT,
                 "the maximum number of 'DYNAMIC_CONSTANT_BUFFER' descriptors in DescriptorPool exceeded at DescriptorSet instance #%u", i);
         }
     }
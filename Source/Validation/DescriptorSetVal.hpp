@@ -1,8 +1,8 @@
 // © 2021 NVIDIA Corporation
 
 NRI_INLINE void DescriptorSetVal::UpdateDescriptorRanges(uint32_t rangeOffset, uint32_t rangeNum, const DescriptorRangeUpdateDesc* rangeUpdateDescs) {
-    RETURN_ON_FAILURE(&m_Device, rangeOffset < GetDesc().rangeNum, ReturnVoid(), "'rangeOffset=%u' is out of 'rangeNum=%u' in the set", rangeOffset, GetDesc().rangeNum);
-    RETURN_ON_FAILURE(&m_Device, rangeOffset + rangeNum <= GetDesc().rangeNum, ReturnVoid(), "'rangeOffset=%u' + 'rangeNum=%u' is greater than 'rangeNum=%u' in the set", rangeOffset, rangeNum, GetDesc().rangeNum);
+    RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, rangeOffset < GetDesc().rangeNum, ReturnVoid(), "'rangeOffset=%u' is out of 'rangeNum=%u' in the set", rangeOffset, GetDesc().rangeNum);
+    RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, rangeOffset + rangeNum <= GetDesc().rangeNum, ReturnVoid(), "'rangeOffset=%u' + 'rangeNum=%u' is greater than 'rangeNum=%u' in the set", rangeOffset, rangeNum, GetDesc().rangeNum);
 
     uint32_t descriptorNum = 0;
     uint32_t descriptorOffset = 0;
@@ -15,10 +15,10 @@ NRI_INLINE void DescriptorSetVal::UpdateDescriptorRanges(uint32_t rangeOffset, u
         const DescriptorRangeUpdateDesc& updateDesc = rangeUpdateDescs[i];
         const DescriptorRangeDesc& rangeDesc = GetDesc().ranges[rangeOffset + i];
 
-        RETURN_ON_FAILURE(&m_Device, updateDesc.descriptorNum != 0, ReturnVoid(), "'[%u].descriptorNum' is 0", i);
-        RETURN_ON_FAILURE(&m_Device, updateDesc.descriptors != nullptr, ReturnVoid(), "'[%u].descriptors' is NULL", i);
+        RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, updateDesc.descriptorNum != 0, ReturnVoid(), "'[%u].descriptorNum' is 0", i);
+        RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, updateDesc.descriptors != nullptr, ReturnVoid(), "'[%u].descriptors' is NULL", i);
 
-        RETURN_ON_FAILURE(&m_Device, updateDesc.baseDescriptor + updateDesc.descriptorNum <= rangeDesc.descriptorNum, ReturnVoid(),
+        RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, updateDesc.baseDescriptor + updateDesc.descriptorNum <= rangeDesc.descriptorNum, ReturnVoid(),
             "[%u]: 'baseDescriptor=%u' + 'descriptorNum=%u' is greater than 'descriptorNum=%u' in the range (descriptorType=%s)",
             i, updateDesc.baseDescriptor, updateDesc.descriptorNum, rangeDesc.descriptorNum, GetDescriptorTypeName(rangeDesc.descriptorType));
 
@@ -27,7 +27,7 @@ NRI_INLINE void DescriptorSetVal::UpdateDescriptorRanges(uint32_t rangeOffset, u
 
         Descriptor** descriptors = (Descriptor**)rangeUpdateDescsImpl[i].descriptors;
         for (uint32_t j = 0; j < updateDesc.descriptorNum; j++) {
-            RETURN_ON_FAILURE(&m_Device, updateDesc.descriptors[j] != nullptr, ReturnVoid(), "'[%u].descriptors[%u]' is NULL", i, j);
+            RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, updateDesc.descriptors[j] != nullptr, ReturnVoid(), "'[%u].descriptors[%u]' is NULL", i, j);
 
             descriptors[j] = NRI_GET_IMPL(Descriptor, updateDesc.descriptors[j]);
         }
@@ -42,15 +42,15 @@ NRI_INLINE void DescriptorSetVal::UpdateDynamicConstantBuffers(uint32_t baseDyna
     if (dynamicConstantBufferNum == 0)
         return;
 
-    RETURN_ON_FAILURE(&m_Device, baseDynamicConstantBuffer + dynamicConstantBufferNum <= GetDesc().dynamicConstantBufferNum, ReturnVoid(),
+    RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, baseDynamicConstantBuffer + dynamicConstantBufferNum <= GetDesc().dynamicConstantBufferNum, ReturnVoid(),
         "'baseDynamicConstantBuffer=%u' + 'dynamicConstantBufferNum=%u' is greater than 'dynamicConstantBufferNum=%u' in the set",
         baseDynamicConstantBuffer, dynamicConstantBufferNum, GetDesc().dynamicConstantBufferNum);
 
-    RETURN_ON_FAILURE(&m_Device, descriptors != nullptr, ReturnVoid(), "'descriptors' is NULL");
+    RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, descriptors != nullptr, ReturnVoid(), "'descriptors' is NULL");
 
     Scratch<Descriptor*> descriptorsImpl = AllocateScratch(m_Device, Descriptor*, dynamicConstantBufferNum);
     for (uint32_t i = 0; i < dynamicConstantBufferNum; i++) {
-        RETURN_ON_FAILURE(&m_Device, descriptors[i] != nullptr, ReturnVoid(), "'descriptors[%u]' is NULL", i);
+        RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, descriptors[i] != nullptr, ReturnVoid(), "'descriptors[%u]' is NULL", i);
 
         descriptorsImpl[i] = NRI_GET_IMPL(Descriptor, descriptors[i]);
     }
@@ -59,12 +59,12 @@ NRI_INLINE void DescriptorSetVal::UpdateDynamicConstantBuffers(uint32_t baseDyna
 }
 
 NRI_INLINE void DescriptorSetVal::Copy(const DescriptorSetCopyDesc& descriptorSetCopyDesc) {
-    RETURN_ON_FAILURE(&m_Device, descriptorSetCopyDesc.srcDescriptorSet != nullptr, ReturnVoid(), "'srcDescriptorSet' is NULL");
+    RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, descriptorSetCopyDesc.srcDescriptorSet != nullptr, ReturnVoid(), "'srcDescriptorSet' is NULL");
 
     DescriptorSetVal& srcDescriptorSetVal = *(DescriptorSetVal*)descriptorSetCopyDesc.srcDescriptorSet;
     const DescriptorSetDesc& srcDesc = srcDescriptorSetVal.GetDesc();
 
-    RETURN_ON_FAILURE(&m_Device, descriptorSetCopyDesc.srcBaseRange < srcDesc.rangeNum, ReturnVoid(), "'srcBaseRange' is invalid");
+    RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, descriptorSetCopyDesc.srcBaseRange < srcDesc.rangeNum, ReturnVoid(), "'srcBaseRange' is invalid");
 
     bool srcRangeValid = descriptorSetCopyDesc.srcBaseRange + descriptorSetCopyDesc.rangeNum < srcDesc.rangeNum;
     bool dstRangeValid = descriptorSetCopyDesc.dstBaseRange + descriptorSetCopyDesc.rangeNum < GetDesc().rangeNum;
@@ -73,13 +73,13 @@ NRI_INLINE void DescriptorSetVal::Copy(const DescriptorSetCopyDesc& descriptorSe
     bool dstOffsetValid = descriptorSetCopyDesc.dstBaseDynamicConstantBuffer < GetDesc().dynamicConstantBufferNum;
     bool dstDynamicConstantBufferValid = descriptorSetCopyDesc.dstBaseDynamicConstantBuffer + descriptorSetCopyDesc.dynamicConstantBufferNum < GetDesc().dynamicConstantBufferNum;
 
-    RETURN_ON_FAILURE(&m_Device, srcRangeValid, ReturnVoid(), "'rangeNum' is invalid");
-    RETURN_ON_FAILURE(&m_Device, descriptorSetCopyDesc.dstBaseRange < GetDesc().rangeNum, ReturnVoid(), "'dstBaseRange' is invalid");
-    RETURN_ON_FAILURE(&m_Device, dstRangeValid, ReturnVoid(), "'rangeNum' is invalid");
-    RETURN_ON_FAILURE(&m_Device, srcOffsetValid, ReturnVoid(), "'srcBaseDynamicConstantBuffer' is invalid");
-    RETURN_ON_FAILURE(&m_Device, srcDynamicConstantBufferValid, ReturnVoid(), "source range of dynamic constant buffers is invalid");
-    RETURN_ON_FAILURE(&m_Device, dstOffsetValid, ReturnVoid(), "'dstBaseDynamicConstantBuffer' is invalid");
-    RETURN_ON_FAILURE(&m_Device, dstDynamicConstantBufferValid, ReturnVoid(), "destination range of dynamic constant buffers is invalid");
+    RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, srcRangeValid, ReturnVoid(), "'rangeNum' is invalid");
+    RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, descriptorSetCopyDesc.dstBaseRange < GetDesc().rangeNum, ReturnVoid(), "'dstBaseRange' is invalid");
+    RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, dstRangeValid, ReturnVoid(), "'rangeNum' is invalid");
+    RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, srcOffsetValid, ReturnVoid(), "'srcBaseDynamicConstantBuffer' is invalid");
+    RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, srcDynamicConstantBufferValid, ReturnVoid(), "source range of dynamic constant buffers is invalid");
+    RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, dstOffsetValid, ReturnVoid(), "'dstBaseDynamicConstantBuffer' is invalid");
+    RETURN_ON_FAILURE_IF(&m_Device, DESCRIPTORS, dstDynamicConstantBufferValid, ReturnVoid(), "destination range of dynamic constant buffers is invalid");
 
     auto descriptorSetCopyDescImpl = descriptorSetCopyDesc;
     descriptorSetCopyDescImpl.srcDescriptorSet = NRI_GET_IMPL(DescriptorSet, descriptorSetCopyDesc.srcDescriptorSet);
@@ -90,3 +90,5 @@ private:
 };
 
 } // namespace nri
+
+NRI_OBJECT_POOL(nri::DescriptorVal, DESCRIPTOR);
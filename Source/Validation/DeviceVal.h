@@ -2,10 +2,27 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
+
 namespace nri {
 
+struct CommandBufferVal;
 struct QueueVal;
 
+// Barrier diagnostics, counted per call site of "CmdBarrier"
+enum class BarrierIssue : uint8_t {
+    REDUNDANT,      // "before" and "after" states are the same
+    MERGEABLE,      // a read-only transition, which can be merged with the previous one
+    STATE_MISMATCH, // "before" doesn't match the tracked state at "QueueSubmit"
+
+    MAX_NUM
+};
+
+struct BarrierCallSiteStats {
+    std::array<uint32_t, (size_t)BarrierIssue::MAX_NUM> issueNum;
+};
+
 struct IsExtSupported {
     uint32_t lowLatency : 1;
     uint32_t meshShader : 1;
@@ -24,10 +41,40 @@ struct DeviceVal final : public DeviceBase {
         return m_Impl;
     }
 
+    inline ValidationBits GetValidationCategories() const {
+        return m_ValidationCategories;
+    }
+
+    inline bool IsValidationEnabled(ValidationBits validationCategory) const {
+        return (m_ValidationCategories & validationCategory) != 0;
+    }
+
+    inline void SetValidationCategories(ValidationBits disabledValidationCategories, uint32_t validationSampleRate) {
+        m_ValidationCategories = (ValidationBits)((uint8_t)ValidationBits::ALL & ~(uint8_t)disabledValidationCategories);
+
+        m_ValidationSampleRate = std::max(validationSampleRate, 1u);
+    }
+
+    // Sampled mode: categories for the next recorded command buffer (none for skipped ones)
+    inline ValidationBits GetCommandBufferValidationCategories() {
+        if (m_ValidationSampleRate == 1 || m_CommandBufferNum.fetch_add(1, std::memory_order_relaxed) % m_ValidationSampleRate == 0)
+            return m_ValidationCategories;
+
+        return ValidationBits::NONE;
+    }
+
+    inline bool IsAsyncValidationEnabled() const {
+        return m_AsyncValidationThread.joinable();
+    }
+
     inline const CoreInterface& GetCoreInterface() const {
         return m_CoreAPI;
     }
 
+    inline const CoreInterface& GetCoreValInterface() const {
+        return m_CoreValAPI;
+    }
+
     inline const HelperInterface& GetHelperInterface() const {
         return m_HelperAPI;
     }
@@ -64,6 +111,10 @@ struct DeviceVal final : public DeviceBase {
         return m_LowLatencyAPI;
     }
 
+    inline const ResourceAllocatorInterface& GetResourceAllocatorInterface() const {
+        return m_ResourceAllocatorAPI;
+    }
+
     inline void* GetNativeObject() const {
         return m_CoreAPI.GetDeviceNativeObject(m_Impl);
     }
@@ -72,9 +123,30 @@ struct DeviceVal final : public DeviceBase {
         return m_Lock;
     }
 
+    inline Lock& GetResourceStateLock() {
+        return m_ResourceStateLock;
+    }
+
+    // Tracked resource states are valid only if their epoch matches the current one
+    inline uint32_t GetResourceStateEpoch() const {
+        return m_ResourceStateEpoch;
+    }
+
+    inline void InvalidateResourceStates() {
+        m_ResourceStateEpoch++;
+    }
+
     bool Create();
     void RegisterMemoryType(MemoryType memoryType, MemoryLocation memoryLocation);
 
+    // Async validation: logged command buffers are replayed on a background thread
+    void StartAsyncValidation();
+    void QueueAsyncValidation(CommandBufferVal& commandBuffer);
+    void WaitForAsyncValidation(const CommandBufferVal& commandBuffer);
+
+    // Returns "true" for the first occurrence of the issue at the call site
+    bool CountBarrierIssue(BarrierIssue barrierIssue, const void* callSite);
+
     //================================================================================================================
     // DebugNameBase
     //================================================================================================================
@@ -101,9 +173,12 @@ struct DeviceVal final : public DeviceBase {
 
     void Destruct() override;
     Result FillFunctionTable(CoreInterface& table) const override;
+    Result FillFunctionTable(CommandBufferPoolInterface& table) const override;
+    Result FillFunctionTable(DeferredReleaseInterface& table) const override;
     Result FillFunctionTable(HelperInterface& table) const override;
     Result FillFunctionTable(LowLatencyInterface& table) const override;
     Result FillFunctionTable(MeshShaderInterface& table) const override;
+    Result FillFunctionTable(ProfilerInterface& table) const override;
     Result FillFunctionTable(ResourceAllocatorInterface& table) const override;
     Result FillFunctionTable(RayTracingInterface& table) const override;
     Result FillFunctionTable(StreamerInterface& table) const override;
@@ -153,6 +228,8 @@ struct DeviceVal final : public DeviceBase {
     Result CreateCommandAllocator(const CommandAllocatorVKDesc& commandAllocatorDesc, CommandAllocator*& commandAllocator);
     Result CreateAccelerationStructure(const AccelerationStructureDesc& accelerationStructureDesc, AccelerationStructure*& accelerationStructure);
     Result AllocateAccelerationStructure(const AllocateAccelerationStructureDesc& accelerationStructureDesc, AccelerationStructure*& accelerationStructure);
+    Result CreateAllocatorPool(const AllocatorPoolDesc& allocatorPoolDesc, AllocatorPool*& allocatorPool);
+    Result BeginDefragmentation(const DefragmentationDesc& defragmentationDesc, Defragmentation*& defragmentation);
     Result CreateAccelerationStructure(const AccelerationStructureVKDesc& accelerationStructureDesc, AccelerationStructure*& accelerationStructure);
     Result CreateAccelerationStructure(const AccelerationStructureD3D12Desc& accelerationStructureDesc, AccelerationStructure*& accelerationStructure);
 
@@ -161,6 +238,7 @@ struct DeviceVal final : public DeviceBase {
     void DestroyTexture(Texture& texture);
     void DestroyPipeline(Pipeline& pipeline);
     void DestroyQueryPool(QueryPool& queryPool);
+    void DestroyAllocatorPool(AllocatorPool& allocatorPool);
     void DestroySwapChain(SwapChain& swapChain);
     void DestroyDescriptor(Descriptor& descriptor);
     void DestroyDescriptorPool(DescriptorPool& descriptorPool);
@@ -179,12 +257,19 @@ struct DeviceVal final : public DeviceBase {
     Result BindAccelerationStructureMemory(const AccelerationStructureMemoryBindingDesc* memoryBindingDescs, uint32_t memoryBindingDescNum);
     uint32_t CalculateAllocationNumber(const ResourceGroupDesc& resourceGroupDesc);
     FormatSupportBits GetFormatSupport(Format format) const;
+    Result FlushBufferRanges(const BufferRange* bufferRanges, uint32_t bufferRangeNum);
+    Result InvalidateBufferRanges(const BufferRange* bufferRanges, uint32_t bufferRangeNum);
+
+private:
+    void AsyncValidationThread();
+    Result ValidateBufferRanges(const BufferRange* bufferRanges, uint32_t bufferRangeNum, BufferRange* bufferRangesImpl);
 
 private:
     char* m_Name = nullptr; // .natvis
     DeviceDesc m_Desc = {}; // .natvis
     Device& m_Impl;
     CoreInterface m_CoreAPI = {};
+    CoreInterface m_CoreValAPI = {}; // validated entry points, used by shared helpers working on top of validation objects
     HelperInterface m_HelperAPI = {};
     StreamerInterface m_StreamerAPI = {};
     LowLatencyInterface m_LowLatencyAPI = {};
@@ -197,13 +282,25 @@ private:
     WrapperVKInterface m_WrapperVKAPI = {};
     std::array<QueueVal*, (size_t)QueueType::MAX_NUM> m_Queues = {};
     UnorderedMap<MemoryType, MemoryLocation> m_MemoryTypeMap;
+    UnorderedMap<const void*, BarrierCallSiteStats> m_BarrierCallSites;
 
     union {
         uint32_t m_IsExtSupportedStorage = 0;
         IsExtSupported m_IsExtSupported;
     };
 
-    Lock m_Lock;
+    ValidationBits m_ValidationCategories = ValidationBits::ALL;
+    uint32_t m_ValidationSampleRate = 1;
+    std::atomic_uint32_t m_CommandBufferNum{0};
+    Lock m_Lock{"DeviceVal"};
+    Lock m_ResourceStateLock{"DeviceVal::ResourceState"};
+    uint32_t m_ResourceStateEpoch = 1; // "0" is reserved for "unknown"
+    Vector<CommandBufferVal*> m_AsyncValidationQueue; // in order of "EndCommandBuffer"
+    std::thread m_AsyncValidationThread;
+    std::mutex m_AsyncValidationMutex;
+    std::condition_variable m_AsyncValidationWakeUp;
+    std::condition_variable m_AsyncValidationDone;
+    bool m_IsAsyncValidationExitRequested = false;
 };
 
 } // namespace nri
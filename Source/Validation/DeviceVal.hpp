@@ -40,10 +40,28 @@ QueryType GetQueryTypeVK(uint32_t queryTypeVK);
 DeviceVal::DeviceVal(const CallbackInterface& callbacks, const AllocationCallbacks& allocationCallbacks, DeviceBase& device)
     : DeviceBase(callbacks, allocationCallbacks, NRI_OBJECT_SIGNATURE)
     , m_Impl(*(Device*)&device)
-    , m_MemoryTypeMap(GetStdAllocator()) {
+    , m_MemoryTypeMap(GetStdAllocator())
+    , m_BarrierCallSites(GetStdAllocator())
+    , m_AsyncValidationQueue(GetStdAllocator()) {
 }
 
 DeviceVal::~DeviceVal() {
+    if (m_AsyncValidationThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_AsyncValidationMutex);
+            m_IsAsyncValidationExitRequested = true;
+        }
+
+        m_AsyncValidationWakeUp.notify_one();
+        m_AsyncValidationThread.join();
+    }
+
+    for (const auto& entry : m_BarrierCallSites) {
+        const BarrierCallSiteStats& stats = entry.second;
+        REPORT_WARNING(this, "barrier call site = %p: redundant = %u, mergeable = %u, state mismatch = %u", entry.first,
+            stats.issueNum[(size_t)BarrierIssue::REDUNDANT], stats.issueNum[(size_t)BarrierIssue::MERGEABLE], stats.issueNum[(size_t)BarrierIssue::STATE_MISMATCH]);
+    }
+
     for (size_t i = 0; i < m_Queues.size(); i++)
         Destroy(GetAllocationCallbacks(), m_Queues[i]);
 
@@ -52,6 +70,7 @@ DeviceVal::~DeviceVal() {
         allocationCallbacks.Free(allocationCallbacks.userArg, m_Name);
     }
 
+    ((DeviceBase*)&m_Impl)->GetBudgetMonitor().Stop();
     ((DeviceBase*)&m_Impl)->Destruct();
 }
 
@@ -78,6 +97,8 @@ bool DeviceVal::Create() {
         return false;
     }
 
+    FillFunctionTable(m_CoreValAPI);
+
     m_IsExtSupported.lowLatency = deviceBase.FillFunctionTable(m_LowLatencyAPI) == Result::SUCCESS;
     m_IsExtSupported.meshShader = deviceBase.FillFunctionTable(m_MeshShaderAPI) == Result::SUCCESS;
     m_IsExtSupported.rayTracing = deviceBase.FillFunctionTable(m_RayTracingAPI) == Result::SUCCESS;
@@ -96,8 +117,69 @@ void DeviceVal::RegisterMemoryType(MemoryType memoryType, MemoryLocation memoryL
     m_MemoryTypeMap[memoryType] = memoryLocation;
 }
 
+bool DeviceVal::CountBarrierIssue(BarrierIssue barrierIssue, const void* callSite) {
+    ExclusiveScope lockScope(m_Lock);
+
+    BarrierCallSiteStats& stats = m_BarrierCallSites[callSite];
+    return stats.issueNum[(size_t)barrierIssue]++ == 0;
+}
+
+void DeviceVal::StartAsyncValidation() {
+    m_AsyncValidationThread = std::thread(&DeviceVal::AsyncValidationThread, this);
+}
+
+void DeviceVal::QueueAsyncValidation(CommandBufferVal& commandBuffer) {
+    {
+        std::lock_guard<std::mutex> lock(m_AsyncValidationMutex);
+
+        commandBuffer.SetValidationPending(true);
+        m_AsyncValidationQueue.push_back(&commandBuffer);
+    }
+
+    m_AsyncValidationWakeUp.notify_one();
+}
+
+void DeviceVal::WaitForAsyncValidation(const CommandBufferVal& commandBuffer) {
+    if (!commandBuffer.IsValidationPending())
+        return;
+
+    std::unique_lock<std::mutex> lock(m_AsyncValidationMutex);
+    m_AsyncValidationDone.wait(lock, [&] { return !commandBuffer.IsValidationPending(); });
+}
+
+void DeviceVal::AsyncValidationThread() {
+    Vector<CommandBufferVal*> commandBuffers(GetStdAllocator());
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_AsyncValidationMutex);
+            m_AsyncValidationWakeUp.wait(lock, [&] { return m_IsAsyncValidationExitRequested || !m_AsyncValidationQueue.empty(); });
+
+            // Everything queued gets validated before exit
+            if (m_AsyncValidationQueue.empty())
+                break;
+
+            commandBuffers.insert(commandBuffers.end(), m_AsyncValidationQueue.begin(), m_AsyncValidationQueue.end());
+            m_AsyncValidationQueue.clear();
+        }
+
+        for (CommandBufferVal* commandBuffer : commandBuffers)
+            commandBuffer->ReplayCommandLog();
+
+        {
+            std::lock_guard<std::mutex> lock(m_AsyncValidationMutex);
+
+            for (CommandBufferVal* commandBuffer : commandBuffers)
+                commandBuffer->SetValidationPending(false);
+        }
+
+        m_AsyncValidationDone.notify_all();
+        commandBuffers.clear();
+    }
+}
+
 void DeviceVal::Destruct() {
-    Destroy(GetAllocationCallbacks(), this);
+    Destroy(GetApplicationAllocationCallbacks(), this);
 }
 
 NRI_INLINE Result DeviceVal::CreateSwapChain(const SwapChainDesc& swapChainDesc, SwapChain*& swapChain) {
@@ -178,8 +260,17 @@ NRI_INLINE Result DeviceVal::CreateBuffer(const BufferDesc& bufferDesc, Buffer*&
 NRI_INLINE Result DeviceVal::AllocateBuffer(const AllocateBufferDesc& bufferDesc, Buffer*& buffer) {
     RETURN_ON_FAILURE(this, bufferDesc.desc.size != 0, Result::INVALID_ARGUMENT, "'size' is 0");
 
+    auto bufferDescImpl = bufferDesc;
+    if (bufferDesc.pool) {
+        const AllocatorPoolVal& allocatorPool = *(AllocatorPoolVal*)bufferDesc.pool;
+        RETURN_ON_FAILURE(this, allocatorPool.IsBufferPool(), Result::INVALID_ARGUMENT, "'pool' is not a buffer pool");
+        RETURN_ON_FAILURE(this, allocatorPool.GetDesc().memoryLocation == bufferDesc.memoryLocation, Result::INVALID_ARGUMENT, "'memoryLocation' doesn't match 'pool' memory location");
+
+        bufferDescImpl.pool = allocatorPool.GetImpl();
+    }
+
     Buffer* bufferImpl = nullptr;
-    Result result = m_ResourceAllocatorAPI.AllocateBuffer(m_Impl, bufferDesc, bufferImpl);
+    Result result = m_ResourceAllocatorAPI.AllocateBuffer(m_Impl, bufferDescImpl, bufferImpl);
 
     if (result == Result::SUCCESS)
         buffer = (Buffer*)Allocate<BufferVal>(GetAllocationCallbacks(), *this, bufferImpl, true);
@@ -210,8 +301,17 @@ NRI_INLINE Result DeviceVal::AllocateTexture(const AllocateTextureDesc& textureD
     RETURN_ON_FAILURE(this, textureDesc.desc.width != 0, Result::INVALID_ARGUMENT, "'desc.width' is 0");
     RETURN_ON_FAILURE(this, textureDesc.desc.mipNum <= maxMipNum, Result::INVALID_ARGUMENT, "'desc.mipNum=%u' can't be > %u", textureDesc.desc.mipNum, maxMipNum);
 
+    auto textureDescImpl = textureDesc;
+    if (textureDesc.pool) {
+        const AllocatorPoolVal& allocatorPool = *(AllocatorPoolVal*)textureDesc.pool;
+        RETURN_ON_FAILURE(this, !allocatorPool.IsBufferPool(), Result::INVALID_ARGUMENT, "'pool' is not a texture pool");
+        RETURN_ON_FAILURE(this, allocatorPool.GetDesc().memoryLocation == textureDesc.memoryLocation, Result::INVALID_ARGUMENT, "'memoryLocation' doesn't match 'pool' memory location");
+
+        textureDescImpl.pool = allocatorPool.GetImpl();
+    }
+
     Texture* textureImpl = nullptr;
-    Result result = m_ResourceAllocatorAPI.AllocateTexture(m_Impl, textureDesc, textureImpl);
+    Result result = m_ResourceAllocatorAPI.AllocateTexture(m_Impl, textureDescImpl, textureImpl);
 
     if (result == Result::SUCCESS)
         texture = (Texture*)Allocate<TextureVal>(GetAllocationCallbacks(), *this, textureImpl, true);
@@ -234,7 +334,7 @@ NRI_INLINE Result DeviceVal::CreateDescriptor(const BufferViewDesc& bufferViewDe
     Result result = m_CoreAPI.CreateBufferView(bufferViewDescImpl, descriptorImpl);
 
     if (result == Result::SUCCESS)
-        bufferView = (Descriptor*)Allocate<DescriptorVal>(GetAllocationCallbacks(), *this, descriptorImpl, bufferViewDesc);
+        bufferView = (Descriptor*)AllocateObject<DescriptorVal>(*this, *this, descriptorImpl, bufferViewDesc);
 
     return result;
 }
@@ -259,7 +359,7 @@ NRI_INLINE Result DeviceVal::CreateDescriptor(const Texture1DViewDesc& textureVi
     Result result = m_CoreAPI.CreateTexture1DView(textureViewDescImpl, descriptorImpl);
 
     if (result == Result::SUCCESS)
-        textureView = (Descriptor*)Allocate<DescriptorVal>(GetAllocationCallbacks(), *this, descriptorImpl, textureViewDesc);
+        textureView = (Descriptor*)AllocateObject<DescriptorVal>(*this, *this, descriptorImpl, textureViewDesc);
 
     return result;
 }
@@ -284,7 +384,7 @@ NRI_INLINE Result DeviceVal::CreateDescriptor(const Texture2DViewDesc& textureVi
     Result result = m_CoreAPI.CreateTexture2DView(textureViewDescImpl, descriptorImpl);
 
     if (result == Result::SUCCESS)
-        textureView = (Descriptor*)Allocate<DescriptorVal>(GetAllocationCallbacks(), *this, descriptorImpl, textureViewDesc);
+        textureView = (Descriptor*)AllocateObject<DescriptorVal>(*this, *this, descriptorImpl, textureViewDesc);
 
     return result;
 }
@@ -309,7 +409,7 @@ NRI_INLINE Result DeviceVal::CreateDescriptor(const Texture3DViewDesc& textureVi
     Result result = m_CoreAPI.CreateTexture3DView(textureViewDescImpl, descriptorImpl);
 
     if (result == Result::SUCCESS)
-        textureView = (Descriptor*)Allocate<DescriptorVal>(GetAllocationCallbacks(), *this, descriptorImpl, textureViewDesc);
+        textureView = (Descriptor*)AllocateObject<DescriptorVal>(*this, *this, descriptorImpl, textureViewDesc);
 
     return result;
 }
@@ -334,7 +434,7 @@ NRI_INLINE Result DeviceVal::CreateDescriptor(const SamplerDesc& samplerDesc, De
     Result result = m_CoreAPI.CreateSampler(m_Impl, samplerDesc, samplerImpl);
 
     if (result == Result::SUCCESS)
-        sampler = (Descriptor*)Allocate<DescriptorVal>(GetAllocationCallbacks(), *this, samplerImpl);
+        sampler = (Descriptor*)AllocateObject<DescriptorVal>(*this, *this, samplerImpl);
 
     return result;
 }
@@ -532,7 +632,7 @@ NRI_INLINE Result DeviceVal::CreateFence(uint64_t initialValue, Fence*& fence) {
 
 NRI_INLINE void DeviceVal::DestroyCommandBuffer(CommandBuffer& commandBuffer) {
     m_CoreAPI.DestroyCommandBuffer(*NRI_GET_IMPL(CommandBuffer, &commandBuffer));
-    Destroy(GetAllocationCallbacks(), (CommandBufferVal*)&commandBuffer);
+    Destroy((CommandBufferVal*)&commandBuffer);
 }
 
 NRI_INLINE void DeviceVal::DestroyCommandAllocator(CommandAllocator& commandAllocator) {
@@ -557,7 +657,7 @@ NRI_INLINE void DeviceVal::DestroyTexture(Texture& texture) {
 
 NRI_INLINE void DeviceVal::DestroyDescriptor(Descriptor& descriptor) {
     m_CoreAPI.DestroyDescriptor(*NRI_GET_IMPL(Descriptor, &descriptor));
-    Destroy(GetAllocationCallbacks(), (DescriptorVal*)&descriptor);
+    Destroy((DescriptorVal*)&descriptor);
 }
 
 NRI_INLINE void DeviceVal::DestroyPipelineLayout(PipelineLayout& pipelineLayout) {
@@ -650,6 +750,44 @@ NRI_INLINE Result DeviceVal::BindBufferMemory(const BufferMemoryBindingDesc* mem
     return result;
 }
 
+Result DeviceVal::ValidateBufferRanges(const BufferRange* bufferRanges, uint32_t bufferRangeNum, BufferRange* bufferRangesImpl) {
+    for (uint32_t i = 0; i < bufferRangeNum; i++) {
+        const BufferRange& bufferRange = bufferRanges[i];
+        RETURN_ON_FAILURE(this, bufferRange.buffer != nullptr, Result::INVALID_ARGUMENT, "'[%u].buffer' is NULL", i);
+
+        const BufferVal& buffer = (const BufferVal&)*bufferRange.buffer;
+        const BufferDesc& bufferDesc = buffer.GetDesc();
+        RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, buffer.IsBoundToMemory(), Result::INVALID_ARGUMENT, "'[%u].buffer' is not bound to memory", i);
+        RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, bufferRange.offset < bufferDesc.size, Result::INVALID_ARGUMENT, "'[%u].offset' is out of bounds", i);
+        RETURN_ON_FAILURE_IF(this, OBJECT_LIFETIME, bufferRange.size == WHOLE_SIZE || bufferRange.offset + bufferRange.size <= bufferDesc.size, Result::INVALID_ARGUMENT, "'[%u].size' is out of bounds", i);
+
+        bufferRangesImpl[i] = bufferRange;
+        bufferRangesImpl[i].buffer = buffer.GetImpl();
+    }
+
+    return Result::SUCCESS;
+}
+
+NRI_INLINE Result DeviceVal::FlushBufferRanges(const BufferRange* bufferRanges, uint32_t bufferRangeNum) {
+    Scratch<BufferRange> bufferRangesImpl = AllocateScratch(*this, BufferRange, bufferRangeNum);
+
+    Result result = ValidateBufferRanges(bufferRanges, bufferRangeNum, bufferRangesImpl);
+    if (result != Result::SUCCESS)
+        return result;
+
+    return GetCoreInterface().FlushBufferRanges(m_Impl, bufferRangesImpl, bufferRangeNum);
+}
+
+NRI_INLINE Result DeviceVal::InvalidateBufferRanges(const BufferRange* bufferRanges, uint32_t bufferRangeNum) {
+    Scratch<BufferRange> bufferRangesImpl = AllocateScratch(*this, BufferRange, bufferRangeNum);
+
+    Result result = ValidateBufferRanges(bufferRanges, bufferRangeNum, bufferRangesImpl);
+    if (result != Result::SUCCESS)
+        return result;
+
+    return GetCoreInterface().InvalidateBufferRanges(m_Impl, bufferRangesImpl, bufferRangeNum);
+}
+
 NRI_INLINE Result DeviceVal::BindTextureMemory(const TextureMemoryBindingDesc* memoryBindingDescs, uint32_t memoryBindingDescNum) {
     Scratch<TextureMemoryBindingDesc> memoryBindingDescsImpl = AllocateScratch(*this, TextureMemoryBindingDesc, memoryBindingDescNum);
     for (uint32_t i = 0; i < memoryBindingDescNum; i++) {
@@ -737,7 +875,7 @@ NRI_INLINE Result DeviceVal::CreateCommandBuffer(const CommandBufferVKDesc& comm
     Result result = m_WrapperVKAPI.CreateCommandBufferVK(m_Impl, commandBufferVKDesc, commandBufferImpl);
 
     if (result == Result::SUCCESS)
-        commandBuffer = (CommandBuffer*)Allocate<CommandBufferVal>(GetAllocationCallbacks(), *this, commandBufferImpl, true);
+        commandBuffer = (CommandBuffer*)AllocateObject<CommandBufferVal>(*this, *this, commandBufferImpl, true);
 
     return result;
 }
@@ -860,7 +998,7 @@ NRI_INLINE Result DeviceVal::CreateCommandBuffer(const CommandBufferD3D11Desc& c
     Result result = m_WrapperD3D11API.CreateCommandBufferD3D11(m_Impl, commandBufferDesc, commandBufferImpl);
 
     if (result == Result::SUCCESS)
-        commandBuffer = (CommandBuffer*)Allocate<CommandBufferVal>(GetAllocationCallbacks(), *this, commandBufferImpl, true);
+        commandBuffer = (CommandBuffer*)AllocateObject<CommandBufferVal>(*this, *this, commandBufferImpl, true);
 
     return result;
 }
@@ -901,7 +1039,7 @@ NRI_INLINE Result DeviceVal::CreateCommandBuffer(const CommandBufferD3D12Desc& c
     Result result = m_WrapperD3D12API.CreateCommandBufferD3D12(m_Impl, commandBufferDesc, commandBufferImpl);
 
     if (result == Result::SUCCESS)
-        commandBuffer = (CommandBuffer*)Allocate<CommandBufferVal>(GetAllocationCallbacks(), *this, commandBufferImpl, true);
+        commandBuffer = (CommandBuffer*)AllocateObject<CommandBufferVal>(*this, *this, commandBufferImpl, true);
 
     return result;
 }
@@ -1111,6 +1249,13 @@ NRI_INLINE Result DeviceVal::AllocateAccelerationStructure(const AllocateAcceler
     RETURN_ON_FAILURE(this, accelerationStructureDesc.desc.instanceOrGeometryObjectNum != 0, Result::INVALID_ARGUMENT, "'instanceOrGeometryObjectNum' is 0");
 
     auto accelerationStructureDescImpl = accelerationStructureDesc;
+    if (accelerationStructureDesc.pool) {
+        const AllocatorPoolVal& allocatorPool = *(AllocatorPoolVal*)accelerationStructureDesc.pool;
+        RETURN_ON_FAILURE(this, allocatorPool.IsBufferPool(), Result::INVALID_ARGUMENT, "'pool' is not a buffer pool");
+        RETURN_ON_FAILURE(this, allocatorPool.GetDesc().memoryLocation == accelerationStructureDesc.memoryLocation, Result::INVALID_ARGUMENT, "'memoryLocation' doesn't match 'pool' memory location");
+
+        accelerationStructureDescImpl.pool = allocatorPool.GetImpl();
+    }
 
     uint32_t geometryObjectNum = accelerationStructureDesc.desc.type == AccelerationStructureType::BOTTOM_LEVEL ? accelerationStructureDesc.desc.instanceOrGeometryObjectNum : 0;
     Scratch<GeometryObject> objectImplArray = AllocateScratch(*this, GeometryObject, geometryObjectNum);
@@ -1133,6 +1278,71 @@ NRI_INLINE Result DeviceVal::AllocateAccelerationStructure(const AllocateAcceler
     return result;
 }
 
+NRI_INLINE Result DeviceVal::CreateAllocatorPool(const AllocatorPoolDesc& allocatorPoolDesc, AllocatorPool*& allocatorPool) {
+    bool isBufferPool = allocatorPoolDesc.bufferUsage != BufferUsageBits::NONE;
+    bool isTexturePool = allocatorPoolDesc.textureUsage != TextureUsageBits::NONE;
+
+    RETURN_ON_FAILURE(this, allocatorPoolDesc.memoryLocation < MemoryLocation::MAX_NUM, Result::INVALID_ARGUMENT, "'memoryLocation' is invalid");
+    RETURN_ON_FAILURE(this, isBufferPool != isTexturePool, Result::INVALID_ARGUMENT, "exactly one of 'bufferUsage' and 'textureUsage' must be set");
+    RETURN_ON_FAILURE(this, allocatorPoolDesc.blockMaxNum == 0 || allocatorPoolDesc.blockMinNum <= allocatorPoolDesc.blockMaxNum, Result::INVALID_ARGUMENT, "'blockMinNum=%u' can't be > 'blockMaxNum=%u'", allocatorPoolDesc.blockMinNum, allocatorPoolDesc.blockMaxNum);
+
+    AllocatorPool* allocatorPoolImpl = nullptr;
+    Result result = m_ResourceAllocatorAPI.CreateAllocatorPool(m_Impl, allocatorPoolDesc, allocatorPoolImpl);
+
+    if (result == Result::SUCCESS)
+        allocatorPool = (AllocatorPool*)Allocate<AllocatorPoolVal>(GetAllocationCallbacks(), *this, allocatorPoolImpl, allocatorPoolDesc);
+
+    return result;
+}
+
+NRI_INLINE Result DeviceVal::BeginDefragmentation(const DefragmentationDesc& defragmentationDesc, Defragmentation*& defragmentation) {
+    RETURN_ON_FAILURE(this, defragmentationDesc.bufferNum == 0 || defragmentationDesc.buffers != nullptr, Result::INVALID_ARGUMENT, "'buffers' is NULL");
+    RETURN_ON_FAILURE(this, defragmentationDesc.textureNum == 0 || defragmentationDesc.textures != nullptr, Result::INVALID_ARGUMENT, "'textures' is NULL");
+
+    Scratch<Buffer*> buffersImpl = AllocateScratch(*this, Buffer*, defragmentationDesc.bufferNum);
+    for (uint32_t i = 0; i < defragmentationDesc.bufferNum; i++) {
+        const BufferVal* bufferVal = (BufferVal*)defragmentationDesc.buffers[i];
+        RETURN_ON_FAILURE(this, bufferVal != nullptr, Result::INVALID_ARGUMENT, "'buffers[%u]' is NULL", i);
+        RETURN_ON_FAILURE(this, !bufferVal->IsMapped(), Result::INVALID_ARGUMENT, "'buffers[%u]' is mapped", i);
+
+        buffersImpl[i] = bufferVal->GetImpl();
+    }
+
+    Scratch<Texture*> texturesImpl = AllocateScratch(*this, Texture*, defragmentationDesc.textureNum);
+    for (uint32_t i = 0; i < defragmentationDesc.textureNum; i++) {
+        RETURN_ON_FAILURE(this, defragmentationDesc.textures[i] != nullptr, Result::INVALID_ARGUMENT, "'textures[%u]' is NULL", i);
+
+        texturesImpl[i] = NRI_GET_IMPL(Texture, defragmentationDesc.textures[i]);
+    }
+
+    auto defragmentationDescImpl = defragmentationDesc;
+    defragmentationDescImpl.buffers = buffersImpl;
+    defragmentationDescImpl.textures = texturesImpl;
+    defragmentationDescImpl.pool = NRI_GET_IMPL(AllocatorPool, defragmentationDesc.pool);
+
+    Defragmentation* defragmentationImpl = nullptr;
+    Result result = m_ResourceAllocatorAPI.BeginDefragmentation(m_Impl, defragmentationDescImpl, defragmentationImpl);
+
+    if (result == Result::SUCCESS) {
+        DefragmentationVal* defragmentationVal = Allocate<DefragmentationVal>(GetAllocationCallbacks(), *this, defragmentationImpl);
+
+        for (uint32_t i = 0; i < defragmentationDesc.bufferNum; i++)
+            defragmentationVal->AddResource((Object*)defragmentationDesc.buffers[i], (Object*)buffersImpl[i]);
+
+        for (uint32_t i = 0; i < defragmentationDesc.textureNum; i++)
+            defragmentationVal->AddResource((Object*)defragmentationDesc.textures[i], (Object*)texturesImpl[i]);
+
+        defragmentation = (Defragmentation*)defragmentationVal;
+    }
+
+    return result;
+}
+
+NRI_INLINE void DeviceVal::DestroyAllocatorPool(AllocatorPool& allocatorPool) {
+    m_ResourceAllocatorAPI.DestroyAllocatorPool(*NRI_GET_IMPL(AllocatorPool, &allocatorPool));
+    Destroy(GetAllocationCallbacks(), (AllocatorPoolVal*)&allocatorPool);
+}
+
 NRI_INLINE Result DeviceVal::BindAccelerationStructureMemory(const AccelerationStructureMemoryBindingDesc* memoryBindingDescs, uint32_t memoryBindingDescNum) {
     RETURN_ON_FAILURE(this, memoryBindingDescs != nullptr, Result::INVALID_ARGUMENT, "'' is NULL");
 
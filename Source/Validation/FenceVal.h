@@ -22,6 +22,9 @@ struct FenceVal final : public ObjectVal {
 
     uint64_t GetFenceValue() const;
     void Wait(uint64_t value);
+    void Wait(uint64_t value, const FenceWaitDesc& fenceWaitDesc);
+
+    static Result WaitMany(const Fence* const* fences, const uint64_t* values, uint32_t fenceNum, bool waitAll, uint64_t timeoutNs);
 };
 
 } // namespace nri
@@ -7,3 +7,37 @@ NRI_INLINE uint64_t FenceVal::GetFenceValue() const {
 NRI_INLINE void FenceVal::Wait(uint64_t value) {
     GetCoreInterface().Wait(*GetImpl(), value);
 }
+
+NRI_INLINE void FenceVal::Wait(uint64_t value, const FenceWaitDesc& fenceWaitDesc) {
+    RETURN_ON_FAILURE_IF(&m_Device, SUBMISSION, fenceWaitDesc.policy < FenceWaitPolicy::MAX_NUM, ReturnVoid(), "'fenceWaitDesc.policy' is invalid");
+
+    GetCoreInterface().WaitWithPolicy(*GetImpl(), value, fenceWaitDesc);
+}
+
+NRI_INLINE Result FenceVal::WaitMany(const Fence* const* fences, const uint64_t* values, uint32_t fenceNum, bool waitAll, uint64_t timeoutNs) {
+    if (!fenceNum)
+        return Result::SUCCESS;
+
+    if (!fences)
+        return Result::INVALID_ARGUMENT;
+
+    // Any non-NULL fence provides the device for reporting, if there is none nothing can be reported
+    const FenceVal* anyFence = nullptr;
+    for (uint32_t i = 0; i < fenceNum && !anyFence; i++)
+        anyFence = (const FenceVal*)fences[i];
+
+    if (!anyFence)
+        return Result::INVALID_ARGUMENT;
+
+    DeviceVal& device = anyFence->GetDevice();
+    RETURN_ON_FAILURE(&device, !device.IsValidationEnabled(ValidationBits::SUBMISSION) || values != nullptr, Result::INVALID_ARGUMENT, "'values' is NULL");
+
+    Scratch<Fence*> fencesImpl = AllocateScratch(device, Fence*, fenceNum);
+    for (uint32_t i = 0; i < fenceNum; i++) {
+        RETURN_ON_FAILURE(&device, fences[i] != nullptr, Result::INVALID_ARGUMENT, "'fences[%u]' is NULL", i);
+
+        fencesImpl[i] = NRI_GET_IMPL(Fence, fences[i]);
+    }
+
+    return device.GetCoreInterface().WaitMany(fencesImpl, values, fenceNum, waitAll, timeoutNs);
+}
@@ -3,9 +3,12 @@
 #include "SharedVal.h"
 
 #include "AccelerationStructureVal.h"
+#include "AllocatorPoolVal.h"
 #include "BufferVal.h"
 #include "CommandAllocatorVal.h"
 #include "CommandBufferVal.h"
+#include "CommandLogVal.h"
+#include "DefragmentationVal.h"
 #include "DescriptorPoolVal.h"
 #include "DescriptorSetVal.h"
 #include "DescriptorVal.h"
@@ -19,13 +22,20 @@
 #include "SwapChainVal.h"
 #include "TextureVal.h"
 
+#include "CommandBufferPool.h"
+#include "DeferredReleaseQueue.h"
+#include "Profiler.h"
+
 using namespace nri;
 
 #include "AccelerationStructureVal.hpp"
+#include "AllocatorPoolVal.hpp"
 #include "BufferVal.hpp"
 #include "CommandAllocatorVal.hpp"
 #include "CommandBufferVal.hpp"
+#include "CommandLogVal.hpp"
 #include "ConversionVal.hpp"
+#include "DefragmentationVal.hpp"
 #include "DescriptorPoolVal.hpp"
 #include "DescriptorSetVal.hpp"
 #include "DescriptorVal.hpp"
@@ -42,6 +52,14 @@ using namespace nri;
 DeviceBase* CreateDeviceValidation(const DeviceCreationDesc& desc, DeviceBase& device) {
     DeviceVal* deviceVal = Allocate<DeviceVal>(desc.allocationCallbacks, desc.callbackInterface, desc.allocationCallbacks, device);
 
+    if (desc.enableAllocationTracking)
+        deviceVal->EnableAllocationTracking(AllocationCategory::VALIDATION);
+
+    deviceVal->SetValidationCategories(desc.disabledValidationCategories, desc.validationSampleRate);
+
+    if (desc.enableNRIValidationAsync)
+        deviceVal->StartAsyncValidation();
+
     if (!deviceVal->Create()) {
         Destroy(desc.allocationCallbacks, deviceVal);
         return nullptr;
@@ -113,6 +131,10 @@ static Result NRI_CALL CreateCommandBuffer(CommandAllocator& commandAllocator, C
     return ((CommandAllocatorVal&)commandAllocator).CreateCommandBuffer(commandBuffer);
 }
 
+static Result NRI_CALL CreateSecondaryCommandBuffer(CommandAllocator& commandAllocator, CommandBuffer*& commandBuffer) {
+    return ((CommandAllocatorVal&)commandAllocator).CreateSecondaryCommandBuffer(commandBuffer);
+}
+
 static Result NRI_CALL CreateFence(Device& device, uint64_t initialValue, Fence*& fence) {
     return ((DeviceVal&)device).CreateFence(initialValue, fence);
 }
@@ -266,6 +288,10 @@ static Result NRI_CALL BeginCommandBuffer(CommandBuffer& commandBuffer, const De
     return ((CommandBufferVal&)commandBuffer).Begin(descriptorPool);
 }
 
+static Result NRI_CALL BeginSecondaryCommandBuffer(CommandBuffer& commandBuffer, const DescriptorPool* descriptorPool, const InheritanceDesc& inheritanceDesc) {
+    return ((CommandBufferVal&)commandBuffer).BeginSecondary(descriptorPool, inheritanceDesc);
+}
+
 static void NRI_CALL CmdSetDescriptorPool(CommandBuffer& commandBuffer, const DescriptorPool& descriptorPool) {
     ((CommandBufferVal&)commandBuffer).SetDescriptorPool(descriptorPool);
 }
@@ -291,7 +317,8 @@ static void NRI_CALL CmdSetPipeline(CommandBuffer& commandBuffer, const Pipeline
 }
 
 static void NRI_CALL CmdBarrier(CommandBuffer& commandBuffer, const BarrierGroupDesc& barrierGroupDesc) {
-    ((CommandBufferVal&)commandBuffer).Barrier(barrierGroupDesc);
+    const void* callSite = GetForwardedCallSite();
+    ((CommandBufferVal&)commandBuffer).Barrier(barrierGroupDesc, callSite ? callSite : NRI_CALL_SITE);
 }
 
 static void NRI_CALL CmdSetIndexBuffer(CommandBuffer& commandBuffer, const Buffer& buffer, uint64_t offset, IndexType indexType) {
@@ -358,6 +385,10 @@ static void NRI_CALL CmdDrawIndexedIndirect(CommandBuffer& commandBuffer, const
     ((CommandBufferVal&)commandBuffer).DrawIndexedIndirect(buffer, offset, drawNum, stride, countBuffer, countBufferOffset);
 }
 
+static void NRI_CALL CmdExecuteCommandBuffers(CommandBuffer& commandBuffer, const CommandBuffer* const* commandBuffers, uint32_t commandBufferNum) {
+    ((CommandBufferVal&)commandBuffer).ExecuteCommandBuffers(commandBuffers, commandBufferNum);
+}
+
 static void NRI_CALL CmdEndRendering(CommandBuffer& commandBuffer) {
     ((CommandBufferVal&)commandBuffer).EndRendering();
 }
@@ -416,9 +447,17 @@ static void NRI_CALL CmdCopyQueries(CommandBuffer& commandBuffer, const QueryPoo
 
 static void NRI_CALL CmdBeginAnnotation(CommandBuffer& commandBuffer, const char* name, uint32_t bgra) {
     ((CommandBufferVal&)commandBuffer).BeginAnnotation(name, bgra);
+
+    ProfilerImpl* profiler = ((CommandBufferVal&)commandBuffer).GetDevice().GetAnnotationProfiler();
+    if (profiler)
+        profiler->BeginZone(commandBuffer, ((CommandBufferVal&)commandBuffer).GetProfilerZoneState(), name);
 }
 
 static void NRI_CALL CmdEndAnnotation(CommandBuffer& commandBuffer) {
+    ProfilerImpl* profiler = ((CommandBufferVal&)commandBuffer).GetDevice().GetAnnotationProfiler();
+    if (profiler)
+        profiler->EndZone(commandBuffer, ((CommandBufferVal&)commandBuffer).GetProfilerZoneState());
+
     ((CommandBufferVal&)commandBuffer).EndAnnotation();
 }
 
@@ -447,17 +486,34 @@ static void NRI_CALL ResetQueries(QueryPool& queryPool, uint32_t offset, uint32_
 }
 
 static void NRI_CALL QueueSubmit(Queue& queue, const QueueSubmitDesc& queueSubmitDesc) {
-    ((QueueVal&)queue).Submit(queueSubmitDesc, nullptr);
+    ((QueueVal&)queue).Submit(&queueSubmitDesc, 1, nullptr);
+}
+
+static void NRI_CALL QueueSubmitBatch(Queue& queue, const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum) {
+    ((QueueVal&)queue).Submit(queueSubmitDescs, queueSubmitDescNum, nullptr);
 }
 
 static void NRI_CALL Wait(Fence& fence, uint64_t value) {
     ((FenceVal&)fence).Wait(value);
 }
 
+static Result NRI_CALL WaitMany(const Fence* const* fences, const uint64_t* values, uint32_t fenceNum, bool waitAll, uint64_t timeoutNs) {
+    return FenceVal::WaitMany(fences, values, fenceNum, waitAll, timeoutNs);
+}
+
 static uint64_t NRI_CALL GetFenceValue(Fence& fence) {
     return ((FenceVal&)fence).GetFenceValue();
 }
 
+static void NRI_CALL WaitWithPolicy(Fence& fence, uint64_t value, const FenceWaitDesc& fenceWaitDesc) {
+    ((FenceVal&)fence).Wait(value, fenceWaitDesc);
+}
+
+static void NRI_CALL GetFenceWaitStats(const Device& device, FenceWaitStats& fenceWaitStats) {
+    const DeviceVal& deviceVal = (const DeviceVal&)device;
+    deviceVal.GetCoreInterface().GetFenceWaitStats(deviceVal.GetImpl(), fenceWaitStats);
+}
+
 static void NRI_CALL UpdateDescriptorRanges(DescriptorSet& descriptorSet, uint32_t baseRange, uint32_t rangeNum, const DescriptorRangeUpdateDesc* rangeUpdateDescs) {
     ((DescriptorSetVal&)descriptorSet).UpdateDescriptorRanges(baseRange, rangeNum, rangeUpdateDescs);
 }
@@ -483,13 +539,30 @@ static void NRI_CALL ResetCommandAllocator(CommandAllocator& commandAllocator) {
 }
 
 static void* NRI_CALL MapBuffer(Buffer& buffer, uint64_t offset, uint64_t size) {
-    return ((BufferVal&)buffer).Map(offset, size);
+    return ((BufferVal&)buffer).Map(offset, size, MapMode::FLUSH_ON_UNMAP);
 }
 
 static void NRI_CALL UnmapBuffer(Buffer& buffer) {
     ((BufferVal&)buffer).Unmap();
 }
 
+static void* NRI_CALL MapBufferWithMode(Buffer& buffer, uint64_t offset, uint64_t size, MapMode mapMode) {
+    return ((BufferVal&)buffer).Map(offset, size, mapMode);
+}
+
+static Result NRI_CALL FlushBufferRanges(Device& device, const BufferRange* bufferRanges, uint32_t bufferRangeNum) {
+    return ((DeviceVal&)device).FlushBufferRanges(bufferRanges, bufferRangeNum);
+}
+
+static Result NRI_CALL InvalidateBufferRanges(Device& device, const BufferRange* bufferRanges, uint32_t bufferRangeNum) {
+    return ((DeviceVal&)device).InvalidateBufferRanges(bufferRanges, bufferRangeNum);
+}
+
+static void NRI_CALL GetMappedMemoryStats(const Device& device, MappedMemoryStats& mappedMemoryStats) {
+    const DeviceVal& deviceVal = (const DeviceVal&)device;
+    deviceVal.GetCoreInterface().GetMappedMemoryStats(deviceVal.GetImpl(), mappedMemoryStats);
+}
+
 static void NRI_CALL SetDebugName(Object* object, const char* name) {
     if (object) {
         CHECK(((uint64_t*)object)[1] == NRI_OBJECT_SIGNATURE, "Invalid NRI object!");
@@ -552,6 +625,7 @@ Result DeviceVal::FillFunctionTable(CoreInterface& table) const {
     table.GetQueue = ::GetQueue;
     table.CreateCommandAllocator = ::CreateCommandAllocator;
     table.CreateCommandBuffer = ::CreateCommandBuffer;
+    table.CreateSecondaryCommandBuffer = ::CreateSecondaryCommandBuffer;
     table.CreateDescriptorPool = ::CreateDescriptorPool;
     table.CreateBuffer = ::CreateBuffer;
     table.CreateTexture = ::CreateTexture;
@@ -580,6 +654,7 @@ Result DeviceVal::FillFunctionTable(CoreInterface& table) const {
     table.BindTextureMemory = ::BindTextureMemory;
     table.FreeMemory = ::FreeMemory;
     table.BeginCommandBuffer = ::BeginCommandBuffer;
+    table.BeginSecondaryCommandBuffer = ::BeginSecondaryCommandBuffer;
     table.CmdSetDescriptorPool = ::CmdSetDescriptorPool;
     table.CmdSetDescriptorSet = ::CmdSetDescriptorSet;
     table.CmdSetPipelineLayout = ::CmdSetPipelineLayout;
@@ -603,6 +678,7 @@ Result DeviceVal::FillFunctionTable(CoreInterface& table) const {
     table.CmdDrawIndexed = ::CmdDrawIndexed;
     table.CmdDrawIndirect = ::CmdDrawIndirect;
     table.CmdDrawIndexedIndirect = ::CmdDrawIndexedIndirect;
+    table.CmdExecuteCommandBuffers = ::CmdExecuteCommandBuffers;
     table.CmdEndRendering = ::CmdEndRendering;
     table.CmdDispatch = ::CmdDispatch;
     table.CmdDispatchIndirect = ::CmdDispatchIndirect;
@@ -626,8 +702,12 @@ Result DeviceVal::FillFunctionTable(CoreInterface& table) const {
     table.QueueAnnotation = ::QueueAnnotation;
     table.ResetQueries = ::ResetQueries;
     table.QueueSubmit = ::QueueSubmit;
+    table.QueueSubmitBatch = ::QueueSubmitBatch;
     table.Wait = ::Wait;
+    table.WaitMany = ::WaitMany;
     table.GetFenceValue = ::GetFenceValue;
+    table.WaitWithPolicy = ::WaitWithPolicy;
+    table.GetFenceWaitStats = ::GetFenceWaitStats;
     table.UpdateDescriptorRanges = ::UpdateDescriptorRanges;
     table.UpdateDynamicConstantBuffers = ::UpdateDynamicConstantBuffers;
     table.CopyDescriptorSet = ::CopyDescriptorSet;
@@ -636,6 +716,10 @@ Result DeviceVal::FillFunctionTable(CoreInterface& table) const {
     table.ResetCommandAllocator = ::ResetCommandAllocator;
     table.MapBuffer = ::MapBuffer;
     table.UnmapBuffer = ::UnmapBuffer;
+    table.MapBufferWithMode = ::MapBufferWithMode;
+    table.FlushBufferRanges = ::FlushBufferRanges;
+    table.InvalidateBufferRanges = ::InvalidateBufferRanges;
+    table.GetMappedMemoryStats = ::GetMappedMemoryStats;
     table.SetDebugName = ::SetDebugName;
     table.GetDeviceNativeObject = ::GetDeviceNativeObject;
     table.GetQueueNativeObject = ::GetQueueNativeObject;
@@ -649,6 +733,125 @@ Result DeviceVal::FillFunctionTable(CoreInterface& table) const {
 
 #pragma endregion
 
+//============================================================================================================================================================================================
+#pragma region[  CommandBufferPool  ]
+
+// The pool works on top of validation objects, i.e. handed out command buffers get validated as usual
+static Result CreateCommandBufferPool(Device& device, const CommandBufferPoolDesc& commandBufferPoolDesc, CommandBufferPool*& commandBufferPool) {
+    DeviceVal& deviceVal = (DeviceVal&)device;
+    RETURN_ON_FAILURE(&deviceVal, commandBufferPoolDesc.queue != nullptr, Result::INVALID_ARGUMENT, "'queue' is NULL");
+    RETURN_ON_FAILURE(&deviceVal, commandBufferPoolDesc.threadNum != 0, Result::INVALID_ARGUMENT, "'threadNum' is 0");
+    RETURN_ON_FAILURE(&deviceVal, commandBufferPoolDesc.frameInFlightNum != 0, Result::INVALID_ARGUMENT, "'frameInFlightNum' is 0");
+
+    CommandBufferPoolImpl* impl = Allocate<CommandBufferPoolImpl>(deviceVal.GetAllocationCallbacks(), device, deviceVal.GetCoreValInterface());
+    Result result = impl->Create(commandBufferPoolDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceVal.GetAllocationCallbacks(), impl);
+        commandBufferPool = nullptr;
+    } else
+        commandBufferPool = (CommandBufferPool*)impl;
+
+    return result;
+}
+
+static void DestroyCommandBufferPool(CommandBufferPool& commandBufferPool) {
+    Destroy(((DeviceBase&)((CommandBufferPoolImpl&)commandBufferPool).GetDevice()).GetAllocationCallbacks(), (CommandBufferPoolImpl*)&commandBufferPool);
+}
+
+static void BeginCommandBufferPoolFrame(CommandBufferPool& commandBufferPool) {
+    ((CommandBufferPoolImpl&)commandBufferPool).BeginFrame();
+}
+
+static void EndCommandBufferPoolFrame(CommandBufferPool& commandBufferPool, Fence& fence, uint64_t value) {
+    ((CommandBufferPoolImpl&)commandBufferPool).EndFrame(fence, value);
+}
+
+static Result AcquireCommandBuffer(CommandBufferPool& commandBufferPool, uint32_t threadIndex, CommandBuffer*& commandBuffer) {
+    CommandBufferPoolImpl& commandBufferPoolImpl = (CommandBufferPoolImpl&)commandBufferPool;
+    Result result = commandBufferPoolImpl.AcquireCommandBuffer(threadIndex, commandBuffer);
+    RETURN_ON_FAILURE((DeviceVal*)&commandBufferPoolImpl.GetDevice(), result != Result::INVALID_ARGUMENT, result, "'threadIndex' is out of bounds");
+
+    return result;
+}
+
+static void GetCommandBufferPoolStats(const CommandBufferPool& commandBufferPool, CommandBufferPoolStats& commandBufferPoolStats) {
+    ((const CommandBufferPoolImpl&)commandBufferPool).GetStats(commandBufferPoolStats);
+}
+
+Result DeviceVal::FillFunctionTable(CommandBufferPoolInterface& table) const {
+    table.CreateCommandBufferPool = ::CreateCommandBufferPool;
+    table.DestroyCommandBufferPool = ::DestroyCommandBufferPool;
+    table.BeginCommandBufferPoolFrame = ::BeginCommandBufferPoolFrame;
+    table.EndCommandBufferPoolFrame = ::EndCommandBufferPoolFrame;
+    table.AcquireCommandBuffer = ::AcquireCommandBuffer;
+    table.GetCommandBufferPoolStats = ::GetCommandBufferPoolStats;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
+//============================================================================================================================================================================================
+#pragma region[  DeferredRelease  ]
+
+// The queue works on top of validation objects, i.e. releases get validated as usual
+static Result CreateDeferredReleaseQueue(Device& device, const DeferredReleaseQueueDesc& deferredReleaseQueueDesc, DeferredReleaseQueue*& deferredReleaseQueue) {
+    DeviceVal& deviceVal = (DeviceVal&)device;
+
+    DeferredReleaseQueueImpl* impl = Allocate<DeferredReleaseQueueImpl>(deviceVal.GetAllocationCallbacks(), device, deviceVal.GetCoreValInterface());
+    Result result = impl->Create(deferredReleaseQueueDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceVal.GetAllocationCallbacks(), impl);
+        deferredReleaseQueue = nullptr;
+    } else
+        deferredReleaseQueue = (DeferredReleaseQueue*)impl;
+
+    return result;
+}
+
+static void DestroyDeferredReleaseQueue(DeferredReleaseQueue& deferredReleaseQueue) {
+    Destroy(((DeviceBase&)((DeferredReleaseQueueImpl&)deferredReleaseQueue).GetDevice()).GetAllocationCallbacks(), (DeferredReleaseQueueImpl*)&deferredReleaseQueue);
+}
+
+static void DeferRelease(DeferredReleaseQueue& deferredReleaseQueue, Fence& fence, uint64_t value, DeferredReleaseType type, Object* object) {
+    DeferredReleaseQueueImpl& deferredReleaseQueueImpl = (DeferredReleaseQueueImpl&)deferredReleaseQueue;
+    DeviceVal* deviceVal = (DeviceVal*)&deferredReleaseQueueImpl.GetDevice();
+    RETURN_ON_FAILURE(deviceVal, type < DeferredReleaseType::MAX_NUM, ReturnVoid(), "'type' is invalid");
+    RETURN_ON_FAILURE(deviceVal, object != nullptr, ReturnVoid(), "'object' is NULL");
+
+    deferredReleaseQueueImpl.DeferRelease(fence, value, type, object);
+}
+
+static void DeferCallback(DeferredReleaseQueue& deferredReleaseQueue, Fence& fence, uint64_t value, const DeferredReleaseCallback& callback) {
+    DeferredReleaseQueueImpl& deferredReleaseQueueImpl = (DeferredReleaseQueueImpl&)deferredReleaseQueue;
+    RETURN_ON_FAILURE((DeviceVal*)&deferredReleaseQueueImpl.GetDevice(), callback.Callback != nullptr, ReturnVoid(), "'callback.Callback' is NULL");
+
+    deferredReleaseQueueImpl.DeferCallback(fence, value, callback);
+}
+
+static uint32_t DrainDeferredReleases(DeferredReleaseQueue& deferredReleaseQueue) {
+    return ((DeferredReleaseQueueImpl&)deferredReleaseQueue).Drain();
+}
+
+static void GetDeferredReleaseQueueStats(const DeferredReleaseQueue& deferredReleaseQueue, DeferredReleaseQueueStats& deferredReleaseQueueStats) {
+    ((const DeferredReleaseQueueImpl&)deferredReleaseQueue).GetStats(deferredReleaseQueueStats);
+}
+
+Result DeviceVal::FillFunctionTable(DeferredReleaseInterface& table) const {
+    table.CreateDeferredReleaseQueue = ::CreateDeferredReleaseQueue;
+    table.DestroyDeferredReleaseQueue = ::DestroyDeferredReleaseQueue;
+    table.DeferRelease = ::DeferRelease;
+    table.DeferCallback = ::DeferCallback;
+    table.DrainDeferredReleases = ::DrainDeferredReleases;
+    table.GetDeferredReleaseQueueStats = ::GetDeferredReleaseQueueStats;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
 //============================================================================================================================================================================================
 #pragma region[  Helper  ]
 
@@ -675,12 +878,90 @@ static Result NRI_CALL QueryVideoMemoryInfo(const Device& device, MemoryLocation
     return ((DeviceVal&)device).QueryVideoMemoryInfo(memoryLocation, videoMemoryInfo);
 }
 
+static Result NRI_CALL SetBudgetMonitor(Device& device, const BudgetMonitorDesc& budgetMonitorDesc) {
+    DeviceVal& deviceVal = (DeviceVal&)device;
+
+    if (budgetMonitorDesc.BudgetCallback) {
+        RETURN_ON_FAILURE(&deviceVal, budgetMonitorDesc.highWatermark >= 0.0f && budgetMonitorDesc.highWatermark <= 1.0f, Result::INVALID_ARGUMENT, "'highWatermark' must be in [0; 1]");
+        RETURN_ON_FAILURE(&deviceVal, budgetMonitorDesc.lowWatermark >= 0.0f && budgetMonitorDesc.lowWatermark <= 1.0f, Result::INVALID_ARGUMENT, "'lowWatermark' must be in [0; 1]");
+        RETURN_ON_FAILURE(&deviceVal, budgetMonitorDesc.highWatermark == 0.0f || budgetMonitorDesc.lowWatermark <= budgetMonitorDesc.highWatermark, Result::INVALID_ARGUMENT, "'lowWatermark' is greater than 'highWatermark'");
+    }
+
+    return deviceVal.GetHelperInterface().SetBudgetMonitor(deviceVal.GetImpl(), budgetMonitorDesc);
+}
+
+static Result NRI_CALL GetTrackedVideoMemoryInfo(const Device& device, MemoryLocation memoryLocation, VideoMemoryInfo& videoMemoryInfo) {
+    const DeviceVal& deviceVal = (const DeviceVal&)device;
+    videoMemoryInfo = {};
+
+    RETURN_ON_FAILURE(&deviceVal, memoryLocation < MemoryLocation::MAX_NUM, Result::INVALID_ARGUMENT, "'memoryLocation' is invalid");
+
+    return deviceVal.GetHelperInterface().GetTrackedVideoMemoryInfo(deviceVal.GetImpl(), memoryLocation, videoMemoryInfo);
+}
+
+static void NRI_CALL GetObjectPoolStats(const Device& device, ObjectPoolType objectPoolType, ObjectPoolStats& objectPoolStats) {
+    const DeviceVal& deviceVal = (const DeviceVal&)device;
+    objectPoolStats = {};
+
+    RETURN_ON_FAILURE(&deviceVal, objectPoolType < ObjectPoolType::MAX_NUM, ReturnVoid(), "'objectPoolType' is invalid");
+
+    deviceVal.GetHelperInterface().GetObjectPoolStats(deviceVal.GetImpl(), objectPoolType, objectPoolStats);
+}
+
+static Result NRI_CALL GetAllocationStats(const Device& device, AllocationCategory allocationCategory, AllocationStats& allocationStats) {
+    const DeviceVal& deviceVal = (const DeviceVal&)device;
+    allocationStats = {};
+
+    RETURN_ON_FAILURE(&deviceVal, allocationCategory < AllocationCategory::MAX_NUM, Result::INVALID_ARGUMENT, "'allocationCategory' is invalid");
+
+    // Validation objects are tracked by the validation device, everything else - by the underlying implementation
+    if (allocationCategory != AllocationCategory::VALIDATION)
+        return deviceVal.GetHelperInterface().GetAllocationStats(deviceVal.GetImpl(), allocationCategory, allocationStats);
+
+    const AllocationTracker& allocationTracker = deviceVal.GetAllocationTracker();
+    if (!allocationTracker.IsEnabled())
+        return Result::UNSUPPORTED;
+
+    allocationTracker.GetStats(allocationCategory, allocationStats);
+
+    return Result::SUCCESS;
+}
+
+static void NRI_CALL ResetAllocationStats(Device& device) {
+    DeviceVal& deviceVal = (DeviceVal&)device;
+    deviceVal.GetAllocationTracker().ResetStats();
+    deviceVal.GetHelperInterface().ResetAllocationStats(deviceVal.GetImpl());
+}
+
+static void NRI_CALL GetMemoryDescCacheStats(const Device& device, MemoryDescCacheStats& memoryDescCacheStats) {
+    const DeviceVal& deviceVal = (const DeviceVal&)device;
+    deviceVal.GetHelperInterface().GetMemoryDescCacheStats(deviceVal.GetImpl(), memoryDescCacheStats);
+}
+
+static Result NRI_CALL GetDescriptorCacheStats(const Device& device, DescriptorCacheStats& descriptorCacheStats) {
+    const DeviceVal& deviceVal = (const DeviceVal&)device;
+    return deviceVal.GetHelperInterface().GetDescriptorCacheStats(deviceVal.GetImpl(), descriptorCacheStats);
+}
+
+static void NRI_CALL GetCommandBufferStats(const CommandBuffer& commandBuffer, CommandBufferStats& commandBufferStats) {
+    const CommandBufferVal& commandBufferVal = (const CommandBufferVal&)commandBuffer;
+    commandBufferVal.GetHelperInterface().GetCommandBufferStats(*commandBufferVal.GetImpl(), commandBufferStats);
+}
+
 Result DeviceVal::FillFunctionTable(HelperInterface& table) const {
     table.CalculateAllocationNumber = ::CalculateAllocationNumber;
     table.AllocateAndBindMemory = ::AllocateAndBindMemory;
     table.UploadData = ::UploadData;
     table.WaitForIdle = ::WaitForIdle;
     table.QueryVideoMemoryInfo = ::QueryVideoMemoryInfo;
+    table.SetBudgetMonitor = ::SetBudgetMonitor;
+    table.GetTrackedVideoMemoryInfo = ::GetTrackedVideoMemoryInfo;
+    table.GetObjectPoolStats = ::GetObjectPoolStats;
+    table.GetAllocationStats = ::GetAllocationStats;
+    table.ResetAllocationStats = ::ResetAllocationStats;
+    table.GetMemoryDescCacheStats = ::GetMemoryDescCacheStats;
+    table.GetDescriptorCacheStats = ::GetDescriptorCacheStats;
+    table.GetCommandBufferStats = ::GetCommandBufferStats;
 
     return Result::SUCCESS;
 }
@@ -691,7 +972,7 @@ Result DeviceVal::FillFunctionTable(HelperInterface& table) const {
 #pragma region[  Low latency  ]
 
 static void NRI_CALL QueueSubmitTrackable(Queue& queue, const QueueSubmitDesc& workSubmissionDesc, const SwapChain& swapChain) {
-    ((QueueVal&)queue).Submit(workSubmissionDesc, &swapChain);
+    ((QueueVal&)queue).Submit(&workSubmissionDesc, 1, &swapChain);
 }
 
 static Result SetLatencySleepMode(SwapChain& swapChain, const LatencySleepMode& latencySleepMode) {
@@ -748,6 +1029,72 @@ Result DeviceVal::FillFunctionTable(MeshShaderInterface& table) const {
 
 #pragma endregion
 
+//============================================================================================================================================================================================
+#pragma region[  Profiler  ]
+
+// The profiler works on top of validation objects, i.e. timestamp queries get validated as usual
+static Result CreateProfiler(Device& device, const ProfilerDesc& profilerDesc, Profiler*& profiler) {
+    DeviceVal& deviceVal = (DeviceVal&)device;
+    RETURN_ON_FAILURE(&deviceVal, profilerDesc.frameInFlightNum != 0, Result::INVALID_ARGUMENT, "'frameInFlightNum' is 0");
+    RETURN_ON_FAILURE(&deviceVal, profilerDesc.zoneMaxNum != 0, Result::INVALID_ARGUMENT, "'zoneMaxNum' is 0");
+    RETURN_ON_FAILURE(&deviceVal, profilerDesc.queueType < QueueType::MAX_NUM, Result::INVALID_ARGUMENT, "'queueType' is invalid");
+    RETURN_ON_FAILURE(&deviceVal, !profilerDesc.captureAnnotations || !deviceVal.GetAnnotationProfiler(), Result::INVALID_ARGUMENT, "another profiler already captures annotations");
+
+    ProfilerImpl* impl = Allocate<ProfilerImpl>(deviceVal.GetAllocationCallbacks(), device, deviceVal.GetCoreValInterface());
+    Result result = impl->Create(profilerDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceVal.GetAllocationCallbacks(), impl);
+        profiler = nullptr;
+    } else
+        profiler = (Profiler*)impl;
+
+    return result;
+}
+
+static void DestroyProfiler(Profiler& profiler) {
+    Destroy(((DeviceBase&)((ProfilerImpl&)profiler).GetDevice()).GetAllocationCallbacks(), (ProfilerImpl*)&profiler);
+}
+
+static void BeginProfilerFrame(Profiler& profiler) {
+    ((ProfilerImpl&)profiler).BeginFrame();
+}
+
+static void EndProfilerFrame(Profiler& profiler, Fence& fence, uint64_t value) {
+    ((ProfilerImpl&)profiler).EndFrame(fence, value);
+}
+
+static void CmdBeginProfilerZone(Profiler& profiler, CommandBuffer& commandBuffer, const char* name) {
+    ((ProfilerImpl&)profiler).BeginZone(commandBuffer, ((CommandBufferVal&)commandBuffer).GetProfilerZoneState(), name);
+}
+
+static void CmdEndProfilerZone(Profiler& profiler, CommandBuffer& commandBuffer) {
+    ((ProfilerImpl&)profiler).EndZone(commandBuffer, ((CommandBufferVal&)commandBuffer).GetProfilerZoneState());
+}
+
+static void CmdResolveProfilerFrame(Profiler& profiler, CommandBuffer& commandBuffer) {
+    ((ProfilerImpl&)profiler).ResolveFrame(commandBuffer);
+}
+
+static void GetProfilerFrame(const Profiler& profiler, ProfilerFrame& profilerFrame) {
+    ((const ProfilerImpl&)profiler).GetFrame(profilerFrame);
+}
+
+Result DeviceVal::FillFunctionTable(ProfilerInterface& table) const {
+    table.CreateProfiler = ::CreateProfiler;
+    table.DestroyProfiler = ::DestroyProfiler;
+    table.BeginProfilerFrame = ::BeginProfilerFrame;
+    table.EndProfilerFrame = ::EndProfilerFrame;
+    table.CmdBeginProfilerZone = ::CmdBeginProfilerZone;
+    table.CmdEndProfilerZone = ::CmdEndProfilerZone;
+    table.CmdResolveProfilerFrame = ::CmdResolveProfilerFrame;
+    table.GetProfilerFrame = ::GetProfilerFrame;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
 //============================================================================================================================================================================================
 #pragma region[  RayTracing  ]
 
@@ -896,10 +1243,59 @@ static Result AllocateAccelerationStructure(Device& device, const AllocateAccele
     return ((DeviceVal&)device).AllocateAccelerationStructure(acelerationStructureDesc, accelerationStructure);
 }
 
+static Result CreateAllocatorPool(Device& device, const AllocatorPoolDesc& allocatorPoolDesc, AllocatorPool*& allocatorPool) {
+    return ((DeviceVal&)device).CreateAllocatorPool(allocatorPoolDesc, allocatorPool);
+}
+
+static void DestroyAllocatorPool(AllocatorPool& allocatorPool) {
+    if (!(&allocatorPool))
+        return;
+
+    GetDeviceVal(allocatorPool).DestroyAllocatorPool(allocatorPool);
+}
+
+static Result GetAllocatorStats(Device& device, MemoryLocation memoryLocation, AllocatorStats& allocatorStats) {
+    DeviceVal& deviceVal = (DeviceVal&)device;
+    RETURN_ON_FAILURE(&deviceVal, memoryLocation < MemoryLocation::MAX_NUM, Result::INVALID_ARGUMENT, "'memoryLocation' is invalid");
+
+    return deviceVal.GetResourceAllocatorInterface().GetAllocatorStats(deviceVal.GetImpl(), memoryLocation, allocatorStats);
+}
+
+static void GetAllocatorPoolStats(const AllocatorPool& allocatorPool, AllocatorStats& allocatorStats) {
+    ((AllocatorPoolVal&)allocatorPool).GetStats(allocatorStats);
+}
+
+static Result BeginDefragmentation(Device& device, const DefragmentationDesc& defragmentationDesc, Defragmentation*& defragmentation) {
+    return ((DeviceVal&)device).BeginDefragmentation(defragmentationDesc, defragmentation);
+}
+
+static Result GetDefragmentationPass(Defragmentation& defragmentation, DefragmentationPass& defragmentationPass) {
+    return ((DefragmentationVal&)defragmentation).GetPass(defragmentationPass);
+}
+
+static Result EndDefragmentationPass(Defragmentation& defragmentation) {
+    return ((DefragmentationVal&)defragmentation).EndPass();
+}
+
+static void EndDefragmentation(Defragmentation& defragmentation, DefragmentationStats& defragmentationStats) {
+    DefragmentationVal& defragmentationVal = (DefragmentationVal&)defragmentation;
+    defragmentationVal.End(defragmentationStats);
+
+    Destroy(defragmentationVal.GetDevice().GetAllocationCallbacks(), &defragmentationVal);
+}
+
 Result DeviceVal::FillFunctionTable(ResourceAllocatorInterface& table) const {
     table.AllocateBuffer = ::AllocateBuffer;
     table.AllocateTexture = ::AllocateTexture;
     table.AllocateAccelerationStructure = ::AllocateAccelerationStructure;
+    table.CreateAllocatorPool = ::CreateAllocatorPool;
+    table.DestroyAllocatorPool = ::DestroyAllocatorPool;
+    table.GetAllocatorStats = ::GetAllocatorStats;
+    table.GetAllocatorPoolStats = ::GetAllocatorPoolStats;
+    table.BeginDefragmentation = ::BeginDefragmentation;
+    table.GetDefragmentationPass = ::GetDefragmentationPass;
+    table.EndDefragmentationPass = ::EndDefragmentationPass;
+    table.EndDefragmentation = ::EndDefragmentation;
 
     return Result::SUCCESS;
 }
@@ -39,7 +39,7 @@ private:
     Vector<AccelerationStructureVal*> m_AccelerationStructures;
     uint64_t m_Size = 0;
     MemoryLocation m_MemoryLocation = MemoryLocation::MAX_NUM; // wrapped object
-    Lock m_Lock;
+    Lock m_Lock{"MemoryVal"};
 };
 
 } // namespace nri
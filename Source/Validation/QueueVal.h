@@ -24,7 +24,7 @@ struct QueueVal final : public ObjectVal {
     void BeginAnnotation(const char* name, uint32_t bgra);
     void EndAnnotation();
     void Annotation(const char* name, uint32_t bgra);
-    void Submit(const QueueSubmitDesc& queueSubmitDesc, const SwapChain* swapChain);
+    void Submit(const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum, const SwapChain* swapChain);
 
     Result WaitForIdle();
     Result UploadData(const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum);
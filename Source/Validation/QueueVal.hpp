@@ -59,42 +59,72 @@ NRI_INLINE void QueueVal::Annotation(const char* name, uint32_t bgra) {
     GetCoreInterface().QueueAnnotation(*GetImpl(), name, bgra);
 }
 
-NRI_INLINE void QueueVal::Submit(const QueueSubmitDesc& queueSubmitDesc, const SwapChain* swapChain) {
-    auto queueSubmitDescImpl = queueSubmitDesc;
-
-    Scratch<FenceSubmitDesc> waitFences = AllocateScratch(m_Device, FenceSubmitDesc, queueSubmitDesc.waitFenceNum);
-    for (uint32_t i = 0; i < queueSubmitDesc.waitFenceNum; i++) {
-        waitFences[i] = queueSubmitDesc.waitFences[i];
-        waitFences[i].fence = NRI_GET_IMPL(Fence, waitFences[i].fence);
+NRI_INLINE void QueueVal::Submit(const QueueSubmitDesc* queueSubmitDescs, uint32_t queueSubmitDescNum, const SwapChain* swapChain) {
+    RETURN_ON_FAILURE_IF(&m_Device, SUBMISSION, queueSubmitDescNum == 0 || queueSubmitDescs != nullptr, ReturnVoid(), "'queueSubmitDescs' is NULL");
+
+    uint32_t fenceNum = 0;
+    uint32_t commandBufferNum = 0;
+    for (uint32_t i = 0; i < queueSubmitDescNum; i++) {
+        fenceNum += queueSubmitDescs[i].waitFenceNum + queueSubmitDescs[i].signalFenceNum;
+        commandBufferNum += queueSubmitDescs[i].commandBufferNum;
     }
-    queueSubmitDescImpl.waitFences = waitFences;
 
-    Scratch<CommandBuffer*> commandBuffers = AllocateScratch(m_Device, CommandBuffer*, queueSubmitDesc.commandBufferNum);
-    for (uint32_t i = 0; i < queueSubmitDesc.commandBufferNum; i++)
-        commandBuffers[i] = NRI_GET_IMPL(CommandBuffer, queueSubmitDesc.commandBuffers[i]);
-    queueSubmitDescImpl.commandBuffers = commandBuffers;
+    Scratch<QueueSubmitDesc> queueSubmitDescsImpl = AllocateScratch(m_Device, QueueSubmitDesc, queueSubmitDescNum);
+    Scratch<FenceSubmitDesc> fences = AllocateScratch(m_Device, FenceSubmitDesc, fenceNum);
+    Scratch<CommandBuffer*> commandBuffers = AllocateScratch(m_Device, CommandBuffer*, commandBufferNum);
+
+    FenceSubmitDesc* fence = fences;
+    CommandBuffer** commandBuffer = commandBuffers;
+
+    for (uint32_t i = 0; i < queueSubmitDescNum; i++) {
+        const QueueSubmitDesc& queueSubmitDesc = queueSubmitDescs[i];
+        QueueSubmitDesc& queueSubmitDescImpl = queueSubmitDescsImpl[i];
+        queueSubmitDescImpl = queueSubmitDesc;
+
+        queueSubmitDescImpl.waitFences = fence;
+        for (uint32_t j = 0; j < queueSubmitDesc.waitFenceNum; j++) {
+            *fence = queueSubmitDesc.waitFences[j];
+            fence->fence = NRI_GET_IMPL(Fence, fence->fence);
+            fence++;
+        }
+
+        queueSubmitDescImpl.commandBuffers = commandBuffer;
+        for (uint32_t j = 0; j < queueSubmitDesc.commandBufferNum; j++) {
+            const CommandBufferVal* commandBufferVal = (CommandBufferVal*)queueSubmitDesc.commandBuffers[j];
+            m_Device.WaitForAsyncValidation(*commandBufferVal); // async validation: errors are reported before the submission
 
-    Scratch<FenceSubmitDesc> signalFences = AllocateScratch(m_Device, FenceSubmitDesc, queueSubmitDesc.signalFenceNum);
-    for (uint32_t i = 0; i < queueSubmitDesc.signalFenceNum; i++) {
-        signalFences[i] = queueSubmitDesc.signalFences[i];
-        signalFences[i].fence = NRI_GET_IMPL(Fence, signalFences[i].fence);
+            RETURN_ON_FAILURE_IF(&m_Device, SUBMISSION, !commandBufferVal->IsSecondary(), ReturnVoid(), "'queueSubmitDescs[%u].commandBuffers[%u]' is a secondary command buffer", i, j);
+
+            if (m_Device.IsValidationEnabled(ValidationBits::BARRIERS))
+                commandBufferVal->ResolveTransitions();
+
+            *commandBuffer++ = NRI_GET_IMPL(CommandBuffer, commandBufferVal);
+        }
+
+        queueSubmitDescImpl.signalFences = fence;
+        for (uint32_t j = 0; j < queueSubmitDesc.signalFenceNum; j++) {
+            *fence = queueSubmitDesc.signalFences[j];
+            fence->fence = NRI_GET_IMPL(Fence, fence->fence);
+            fence++;
+        }
     }
-    queueSubmitDescImpl.signalFences = signalFences;
 
     if (swapChain) {
+        RETURN_ON_FAILURE_IF(&m_Device, SUBMISSION, queueSubmitDescNum == 1, ReturnVoid(), "'QueueSubmitTrackable' expects a single submit");
+
         SwapChain* swapChainImpl = NRI_GET_IMPL(SwapChain, swapChain);
-        m_Device.GetLowLatencyInterface().QueueSubmitTrackable(*GetImpl(), queueSubmitDescImpl, *swapChainImpl);
+        m_Device.GetLowLatencyInterface().QueueSubmitTrackable(*GetImpl(), queueSubmitDescsImpl[0], *swapChainImpl);
     } else
-        GetCoreInterface().QueueSubmit(*GetImpl(), queueSubmitDescImpl);
+        GetCoreInterface().QueueSubmitBatch(*GetImpl(), queueSubmitDescsImpl, queueSubmitDescNum);
 }
 
 NRI_INLINE Result QueueVal::UploadData(const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum) {
-    RETURN_ON_FAILURE(&m_Device, textureUploadDescNum == 0 || textureUploadDescs != nullptr, Result::INVALID_ARGUMENT, "'textureUploadDescs' is NULL");
-    RETURN_ON_FAILURE(&m_Device, bufferUploadDescNum == 0 || bufferUploadDescs != nullptr, Result::INVALID_ARGUMENT, "'bufferUploadDescs' is NULL");
+    RETURN_ON_FAILURE_IF(&m_Device, SUBMISSION, textureUploadDescNum == 0 || textureUploadDescs != nullptr, Result::INVALID_ARGUMENT, "'textureUploadDescs' is NULL");
+    RETURN_ON_FAILURE_IF(&m_Device, SUBMISSION, bufferUploadDescNum == 0 || bufferUploadDescs != nullptr, Result::INVALID_ARGUMENT, "'bufferUploadDescs' is NULL");
 
     Scratch<TextureUploadDesc> textureUploadDescsImpl = AllocateScratch(m_Device, TextureUploadDesc, textureUploadDescNum);
     for (uint32_t i = 0; i < textureUploadDescNum; i++) {
-        if (!ValidateTextureUploadDesc(m_Device, i, textureUploadDescs[i]))
+        if (IsValidationEnabled(ValidationBits::SUBMISSION) && !ValidateTextureUploadDesc(m_Device, i, textureUploadDescs[i]))
             return Result::INVALID_ARGUMENT;
 
         const TextureVal* textureVal = (TextureVal*)textureUploadDescs[i].texture;
@@ -105,7 +135,7 @@ NRI_INLINE Result QueueVal::UploadData(const TextureUploadDesc* textureUploadDes
 
     Scratch<BufferUploadDesc> bufferUploadDescsImpl = AllocateScratch(m_Device, BufferUploadDesc, bufferUploadDescNum);
     for (uint32_t i = 0; i < bufferUploadDescNum; i++) {
-        if (!ValidateBufferUploadDesc(m_Device, i, bufferUploadDescs[i]))
+        if (IsValidationEnabled(ValidationBits::SUBMISSION) && !ValidateBufferUploadDesc(m_Device, i, bufferUploadDescs[i]))
             return Result::INVALID_ARGUMENT;
 
         const BufferVal* bufferVal = (BufferVal*)bufferUploadDescs[i].buffer;
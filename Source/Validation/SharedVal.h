@@ -31,6 +31,10 @@ struct ObjectVal : public DebugNameBaseVal {
         return m_Device;
     }
 
+    inline bool IsValidationEnabled(ValidationBits validationCategory) const {
+        return m_Device.IsValidationEnabled(validationCategory);
+    }
+
     inline const CoreInterface& GetCoreInterface() const {
         return m_Device.GetCoreInterface();
     }
@@ -71,6 +75,10 @@ struct ObjectVal : public DebugNameBaseVal {
         return m_Device.GetLowLatencyInterface();
     }
 
+    inline const ResourceAllocatorInterface& GetResourceAllocatorInterface() const {
+        return m_Device.GetResourceAllocatorInterface();
+    }
+
     //================================================================================================================
     // DebugNameBase
     //================================================================================================================
@@ -96,8 +104,19 @@ protected:
     DeviceVal& m_Device;
 };
 
+// "RETURN_ON_FAILURE" for hot paths: "condition" is not evaluated if the category is disabled (needs "IsValidationEnabled" in the scope)
+#define RETURN_ON_FAILURE_IF(deviceBase, validationCategory, condition, returnCode, format, ...) \
+    RETURN_ON_FAILURE(deviceBase, !IsValidationEnabled(nri::ValidationBits::validationCategory) || (condition), returnCode, format, ##__VA_ARGS__)
+
 #define NRI_GET_IMPL(className, object) (object ? ((className##Val*)object)->GetImpl() : nullptr)
 
+// Tracked state of a buffer or a texture subresource ("epoch = 0" means "unknown", see "DeviceVal::InvalidateResourceStates")
+struct ResourceStateVal {
+    AccessBits access;
+    Layout layout;
+    uint32_t epoch;
+};
+
 template <typename T>
 inline DeviceVal& GetDeviceVal(T& object) {
     return ((ObjectVal&)object).GetDevice();
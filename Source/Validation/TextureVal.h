@@ -9,8 +9,12 @@ struct MemoryVal;
 struct TextureVal final : public ObjectVal {
     TextureVal(DeviceVal& device, Texture* texture, bool isBoundToMemory)
         : ObjectVal(device, texture)
+        , m_States(device.GetStdAllocator())
         , m_IsBoundToMemory(isBoundToMemory) {
         m_Desc = GetCoreInterface().GetTextureDesc(*texture);
+
+        if (device.IsValidationEnabled(ValidationBits::BARRIERS))
+            m_States.resize((size_t)m_Desc.layerNum * m_Desc.mipNum, ResourceStateVal{});
     }
 
     ~TextureVal();
@@ -36,9 +40,18 @@ struct TextureVal final : public ObjectVal {
         m_IsBoundToMemory = true;
     }
 
+    inline ResourceStateVal& GetState(Dim_t layer, Mip_t mip) {
+        return m_States[(size_t)layer * m_Desc.mipNum + mip];
+    }
+
+    inline void CopyStates(const TextureVal& texture) {
+        m_States.assign(texture.m_States.begin(), texture.m_States.end());
+    }
+
 private:
     TextureDesc m_Desc = {}; // (only for) .natvis
     MemoryVal* m_Memory = nullptr;
+    Vector<ResourceStateVal> m_States; // per subresource (layer, mip), resolved at "QueueSubmit"
     bool m_IsBoundToMemory = false;
 };
 